@@ -0,0 +1,408 @@
+/**
+ *  @file sz_bench.c
+ *  @date Oct, 2026
+ *  @brief Microbenchmarks of the stages of the (single-precision) compression pipeline: range,
+ *  interval optimization, prediction+quantization, Huffman encoding/decoding, lossless stage and
+ *  dequantization, each timed alone on synthetic fields or on a user-supplied field.
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_TSC
+#endif
+#include "sz.h"
+#include "rw.h"
+
+#define BENCH_MAX_RESULTS 256
+
+typedef struct benchResult
+{
+	char stage[32];
+	char field[64];
+	size_t nbEle;
+	double seconds; //best of the repetitions
+	double cycles; //time stamp counter ticks of the best repetition (0 if not available)
+} benchResult;
+
+static benchResult results[BENCH_MAX_RESULTS];
+static int nbResults = 0;
+
+static double benchTime(unsigned long long* ticks)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+#ifdef BENCH_HAVE_TSC
+	*ticks = __rdtsc();
+#else
+	*ticks = 0;
+#endif
+	return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+static benchResult* addResult(const char* stage, const char* field, size_t nbEle, double seconds, double cycles)
+{
+	benchResult* r = &results[nbResults];
+	if(nbResults < BENCH_MAX_RESULTS)
+		nbResults++;
+	snprintf(r->stage, sizeof(r->stage), "%s", stage);
+	snprintf(r->field, sizeof(r->field), "%s", field);
+	r->nbEle = nbEle;
+	r->seconds = seconds > 0 ? seconds : 0;
+	r->cycles = cycles > 0 ? cycles : 0;
+	return r;
+}
+
+static double throughput(benchResult* r)
+{
+	return r->seconds > 0 ? r->nbEle*sizeof(float)/r->seconds/1e6 : 0;
+}
+
+/**
+ * Time a stage: the statement is run reps times and the fastest run is kept.
+ * */
+#define BENCH_STAGE(best, bestTicks, reps, stmt) \
+	do { \
+		int rep_; \
+		unsigned long long t0_, t1_; \
+		(best) = -1; \
+		for(rep_=0;rep_<(reps);rep_++) \
+		{ \
+			double s_ = benchTime(&t0_); \
+			stmt; \
+			double e_ = benchTime(&t1_) - s_; \
+			if((best) < 0 || e_ < (best)) \
+			{ \
+				(best) = e_; \
+				(bestTicks) = (double)(t1_ - t0_); \
+			} \
+		} \
+	} while(0)
+
+/**
+ * Smooth waves plus a small deterministic noise, so that the quantization codes and the
+ * unpredictable values look like the ones of simulation fields.
+ * */
+static float* genField(size_t r3, size_t r2, size_t r1)
+{
+	size_t i, j, k, n = r3*r2*r1;
+	unsigned int seed = 12345;
+	float* data = (float*)malloc(n*sizeof(float));
+	for(i=0;i<r3;i++)
+		for(j=0;j<r2;j++)
+			for(k=0;k<r1;k++)
+			{
+				seed = seed*1103515245 + 12345;
+				double noise = ((seed>>16)&0x7FFF)/32768.0 - 0.5;
+				data[(i*r2+j)*r1+k] = (float)(sin(k*0.05)*cos(j*0.03) + 0.5*sin(i*0.07 + k*0.01) + 0.001*noise);
+			}
+	return data;
+}
+
+/**
+ * Run all the stages on one field (r3 is the slowest dimension, 0 for the unused dimensions).
+ * */
+static void benchField(const char* name, float* data, size_t r3, size_t r2, size_t r1, double relBound, int reps)
+{
+	size_t n = computeDataLength(0, 0, r3, r2, r1);
+	int dim = computeDimension(0, 0, r3, r2, r1);
+	double t = 0, ticks = 0, tMDQ = 0, ticksMDQ = 0;
+	float valueRangeSize = 0, medianValue = 0;
+	TightDataPointStorageF* tdps = NULL;
+
+	BENCH_STAGE(t, ticks, reps, computeRangeSize_float(data, n, &valueRangeSize, &medianValue));
+	addResult("range", name, n, t, ticks);
+	double realPrecision = relBound*valueRangeSize;
+
+	unsigned int intervals = 0;
+	if(dim==1)
+		BENCH_STAGE(t, ticks, reps, intervals = optimize_intervals_float_1D_opt(data, n, realPrecision));
+	else if(dim==2)
+		BENCH_STAGE(t, ticks, reps, intervals = optimize_intervals_float_2D_opt(data, r2, r1, realPrecision));
+	else
+		BENCH_STAGE(t, ticks, reps, intervals = optimize_intervals_float_3D_opt(data, r3, r2, r1, realPrecision));
+	addResult("intervals", name, n, t, ticks);
+
+	//prediction+quantization, including the Huffman encoding done by new_TightDataPointStorageF
+	//(the intervals are fixed, so that the interval optimization is not timed again)
+	int optQuantMode = exe_params->optQuantMode;
+	exe_params->optQuantMode = 0;
+	updateQuantizationInfo(intervals);
+	if(dim==1)
+		BENCH_STAGE(tMDQ, ticksMDQ, reps, if(tdps!=NULL) free_TightDataPointStorageF(tdps); tdps = SZ_compress_float_1D_MDQ(data, n, realPrecision, valueRangeSize, medianValue));
+	else if(dim==2)
+		BENCH_STAGE(tMDQ, ticksMDQ, reps, if(tdps!=NULL) free_TightDataPointStorageF(tdps); tdps = SZ_compress_float_2D_MDQ(data, r2, r1, realPrecision, valueRangeSize, medianValue));
+	else
+		BENCH_STAGE(tMDQ, ticksMDQ, reps, if(tdps!=NULL) free_TightDataPointStorageF(tdps); tdps = SZ_compress_float_3D_MDQ(data, r3, r2, r1, realPrecision, valueRangeSize, medianValue));
+	exe_params->optQuantMode = optQuantMode;
+
+	//the quantization codes are recovered from the Huffman-coded type array
+	int* codes = (int*)malloc(n*sizeof(int));
+	HuffmanTree* tree = NULL;
+	BENCH_STAGE(t, ticks, reps, if(tree!=NULL) SZ_ReleaseHuffman(tree); tree = createHuffmanTree(2*tdps->intervals); decode_withTree(tree, tdps->typeArray, n, codes));
+	SZ_ReleaseHuffman(tree);
+	tree = NULL;
+	double tHuffDec = t, ticksHuffDec = ticks;
+
+	unsigned char* huffBytes = NULL;
+	size_t huffSize = 0;
+	BENCH_STAGE(t, ticks, reps, if(tree!=NULL) SZ_ReleaseHuffman(tree); free(huffBytes); tree = createHuffmanTree(2*tdps->intervals); encode_withTree(tree, codes, n, &huffBytes, &huffSize));
+	SZ_ReleaseHuffman(tree);
+	free(huffBytes);
+	addResult("predquant", name, n, tMDQ - t, ticksMDQ - ticks); //the Huffman encoding is subtracted
+	addResult("huffman_encode", name, n, t, ticks);
+	addResult("huffman_decode", name, n, tHuffDec, ticksHuffDec);
+
+	unsigned char* flatBytes = NULL;
+	size_t flatSize = 0;
+	convertTDPStoFlatBytes_float(tdps, &flatBytes, &flatSize);
+	unsigned char* lossBytes = NULL;
+	unsigned long lossSize = 0;
+	BENCH_STAGE(t, ticks, reps, free(lossBytes); lossBytes = NULL; lossSize = sz_lossless_compress(confparams_cpr->losslessCompressor, confparams_cpr->gzipMode, flatBytes, flatSize, &lossBytes));
+	addResult("lossless_compress", name, n, t, ticks);
+	unsigned char* decBytes = NULL;
+	BENCH_STAGE(t, ticks, reps, free(decBytes); decBytes = NULL; sz_lossless_decompress(confparams_cpr->losslessCompressor, lossBytes, lossSize, &decBytes, flatSize));
+	addResult("lossless_decompress", name, n, t, ticks);
+	free(lossBytes);
+	free(decBytes);
+
+	//dequantization, including the Huffman decoding done by decompressDataSeries_float_*
+	if(confparams_dec==NULL)
+	{
+		confparams_dec = (sz_params*)malloc(sizeof(sz_params));
+		memset(confparams_dec, 0, sizeof(sz_params));
+	}
+	TightDataPointStorageF* dtdps = NULL;
+	new_TightDataPointStorageF_fromFlatBytes(&dtdps, flatBytes, flatSize);
+	float* decData = (float*)malloc(n*sizeof(float));
+	if(dim==1)
+		BENCH_STAGE(t, ticks, reps, decompressDataSeries_float_1D(&decData, n, NULL, dtdps));
+	else if(dim==2)
+		BENCH_STAGE(t, ticks, reps, decompressDataSeries_float_2D(&decData, r2, r1, NULL, dtdps));
+	else
+		BENCH_STAGE(t, ticks, reps, decompressDataSeries_float_3D(&decData, r3, r2, r1, NULL, dtdps));
+	addResult("dequant", name, n, t - tHuffDec, ticks - ticksHuffDec); //the Huffman decoding is subtracted
+
+	size_t i;
+	double maxErr = 0;
+	for(i=0;i<n;i++)
+		if(fabs(decData[i]-data[i]) > maxErr)
+			maxErr = fabs(decData[i]-data[i]);
+	if(maxErr > realPrecision*1.0001)
+		printf("Warning: %s: max error %g exceeds the error bound %g\n", name, maxErr, realPrecision);
+
+	free(decData);
+	free_TightDataPointStorageF2(dtdps);
+	free(flatBytes);
+	free(codes);
+	free_TightDataPointStorageF(tdps);
+}
+
+/**
+ * @return the throughput of the same stage and field in the baseline file, or 0
+ * */
+static double baselineThroughput(const char* baseline, benchResult* r)
+{
+	char line[512], stage[32], field[64];
+	double mbps = 0;
+	FILE* fp = fopen(baseline, "r");
+	if(fp==NULL)
+		return 0;
+	while(fgets(line, sizeof(line), fp)!=NULL)
+	{
+		double v;
+		//label,stage,field,elements,seconds,MB/s,cycles/element
+		char* p = strchr(line, ',');
+		if(p==NULL || sscanf(p+1, "%31[^,],%63[^,],%*[^,],%*[^,],%lf", stage, field, &v)!=3)
+			continue;
+		if(strcmp(stage, r->stage)==0 && strcmp(field, r->field)==0)
+			mbps = v;
+	}
+	fclose(fp);
+	return mbps;
+}
+
+static void usage()
+{
+	printf("Usage: sz_bench [options]\n");
+	printf("Options:\n");
+	printf("	-c <config file> : configuration file sz.config (default: built-in defaults)\n");
+	printf("	-e <rel bound> : value-range-based relative error bound (default: 1E-4)\n");
+	printf("	-r <repetitions> : repetitions of each stage, the fastest one is kept (default: 5)\n");
+	printf("	-s : small synthetic fields only (quick check)\n");
+	printf("	-i <file> : single-precision binary field instead of the synthetic fields, with\n");
+	printf("	-1 <nx> | -2 <nx> <ny> | -3 <nx> <ny> <nz> : its dimensions (fastest first)\n");
+	printf("	-o <csv file> : append the results (label,stage,field,elements,seconds,MB/s,cycles/element)\n");
+	printf("	-l <label> : label of the results in the csv file, e.g., the commit (default: current)\n");
+	printf("	-b <csv file> : print the speedups over the results of a previous run\n");
+	printf("* examples: \n");
+	printf("	sz_bench -o bench.csv -l `git rev-parse --short HEAD`\n");
+	printf("	sz_bench -i testdata/x86/testfloat_8_8_128.dat -3 8 8 128 -b bench.csv\n");
+}
+
+int main(int argc, char* argv[])
+{
+	char* cfgFile = NULL;
+	char* inPath = NULL;
+	char* outPath = NULL;
+	char* baseline = NULL;
+	char* label = "current";
+	double relBound = 1E-4;
+	int reps = 5, small = 0, i;
+	size_t r1 = 0, r2 = 0, r3 = 0;
+
+	for(i=1;i<argc;i++)
+	{
+		if(argv[i][0]!='-' || argv[i][2])
+		{
+			usage();
+			return 0;
+		}
+		switch(argv[i][1])
+		{
+		case 'c':
+			if(++i == argc) {usage(); return 0;}
+			cfgFile = argv[i];
+			break;
+		case 'e':
+			if(++i == argc) {usage(); return 0;}
+			relBound = atof(argv[i]);
+			break;
+		case 'r':
+			if(++i == argc) {usage(); return 0;}
+			reps = atoi(argv[i]);
+			break;
+		case 's':
+			small = 1;
+			break;
+		case 'i':
+			if(++i == argc) {usage(); return 0;}
+			inPath = argv[i];
+			break;
+		case '1':
+			if(++i == argc || sscanf(argv[i], "%zu", &r1) != 1) {usage(); return 0;}
+			break;
+		case '2':
+			if(++i == argc || sscanf(argv[i], "%zu", &r1) != 1 ||
+				++i == argc || sscanf(argv[i], "%zu", &r2) != 1) {usage(); return 0;}
+			break;
+		case '3':
+			if(++i == argc || sscanf(argv[i], "%zu", &r1) != 1 ||
+				++i == argc || sscanf(argv[i], "%zu", &r2) != 1 ||
+				++i == argc || sscanf(argv[i], "%zu", &r3) != 1) {usage(); return 0;}
+			break;
+		case 'o':
+			if(++i == argc) {usage(); return 0;}
+			outPath = argv[i];
+			break;
+		case 'l':
+			if(++i == argc) {usage(); return 0;}
+			label = argv[i];
+			break;
+		case 'b':
+			if(++i == argc) {usage(); return 0;}
+			baseline = argv[i];
+			break;
+		default:
+			usage();
+			return 0;
+		}
+	}
+	if(reps < 1)
+		reps = 1;
+
+	if(SZ_Init(cfgFile) == SZ_NSCS)
+	{
+		printf("Error: cannot initialize SZ with %s\n", cfgFile);
+		return 0;
+	}
+	confparams_cpr->errorBoundMode = REL;
+	confparams_cpr->relBoundRatio = relBound;
+	confparams_cpr->withRegression = SZ_NO_REGRESSION;
+
+	if(inPath != NULL)
+	{
+		int status;
+		size_t nbEle;
+		char name[64];
+		float* data = readFloatData(inPath, &nbEle, &status);
+		if(status != SZ_SCES || r1 == 0 || nbEle != computeDataLength(0, 0, r3, r2, r1))
+		{
+			printf("Error: cannot read %s or its dimensions do not match its size\n", inPath);
+			return 0;
+		}
+		if(r3 > 0)
+			snprintf(name, sizeof(name), "file_%zux%zux%zu", r3, r2, r1);
+		else if(r2 > 0)
+			snprintf(name, sizeof(name), "file_%zux%zu", r2, r1);
+		else
+			snprintf(name, sizeof(name), "file_%zu", r1);
+		benchField(name, data, r3, r2, r1, relBound, reps);
+		free(data);
+	}
+	else
+	{
+		//{r3, r2, r1}: 1D, 2D and 3D fields of about 64K, 1M and 4M elements
+		size_t dims[9][3] = {{0, 0, 65536}, {0, 256, 256}, {40, 40, 40},
+			{0, 0, 1048576}, {0, 1024, 1024}, {100, 100, 100},
+			{0, 0, 4194304}, {0, 2048, 2048}, {160, 160, 160}};
+		int k, nbFields = small ? 3 : 9;
+		for(k=0;k<nbFields;k++)
+		{
+			char name[64];
+			if(dims[k][1] == 0)
+				snprintf(name, sizeof(name), "synth_%zu", dims[k][2]);
+			else if(dims[k][0] == 0)
+				snprintf(name, sizeof(name), "synth_%zux%zu", dims[k][1], dims[k][2]);
+			else
+				snprintf(name, sizeof(name), "synth_%zux%zux%zu", dims[k][0], dims[k][1], dims[k][2]);
+			float* data = genField(dims[k][0]==0 ? 1 : dims[k][0], dims[k][1]==0 ? 1 : dims[k][1], dims[k][2]);
+			benchField(name, data, dims[k][0], dims[k][1], dims[k][2], relBound, reps);
+			free(data);
+		}
+	}
+
+	printf("%-20s %-22s %12s %12s %14s", "stage", "field", "elements", "MB/s", "cycles/elem");
+	if(baseline != NULL)
+		printf(" %10s", "speedup");
+	printf("\n");
+	for(i=0;i<nbResults;i++)
+	{
+		benchResult* r = &results[i];
+		printf("%-20s %-22s %12zu %12.2f %14.2f", r->stage, r->field, r->nbEle, throughput(r), r->cycles/r->nbEle);
+		if(baseline != NULL)
+		{
+			double base = baselineThroughput(baseline, r);
+			if(base > 0)
+				printf(" %9.2fx", throughput(r)/base);
+			else
+				printf(" %10s", "-");
+		}
+		printf("\n");
+	}
+
+	if(outPath != NULL)
+	{
+		FILE* fp = fopen(outPath, "a");
+		if(fp == NULL)
+		{
+			printf("Error: cannot write %s\n", outPath);
+			return 0;
+		}
+		for(i=0;i<nbResults;i++)
+		{
+			benchResult* r = &results[i];
+			fprintf(fp, "%s,%s,%s,%zu,%.9f,%.3f,%.3f\n", label, r->stage, r->field, r->nbEle, r->seconds, throughput(r), r->cycles/r->nbEle);
+		}
+		fclose(fp);
+	}
+
+	SZ_Finalize();
+	return 0;
+}
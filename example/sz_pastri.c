@@ -521,7 +521,11 @@ int main(int argc, char* argv[])
 				data = SZ_decompress(SZ_FLOAT, bytes, byteLength, r5, r4, r3, r2, r1);			
 			else if(confparams_cpr->sol_ID == PASTRI)
 			{
-				SZ_pastriDecompressBatch(bytes, &pastri_par, (unsigned char **)&data, &nbEle);
+				if(SZ_pastriDecompressBatch(bytes, &pastri_par, (unsigned char **)&data, &nbEle)!=0)
+				{
+					printf("Error: %s cannot be decompressed!\n", cmpPath);
+					exit(0);
+				}
 				nbEle=nbEle/4;
 			}
 			cost_end();
@@ -691,7 +695,11 @@ int main(int argc, char* argv[])
 					data = SZ_decompress(SZ_DOUBLE, bytes, byteLength, r5, r4, r3, r2, r1);			
 				else if(confparams_cpr->sol_ID == PASTRI)
 				{
-					SZ_pastriDecompressBatch(bytes, &pastri_par, (unsigned char**)&data, &nbEle);
+					if(SZ_pastriDecompressBatch(bytes, &pastri_par, (unsigned char**)&data, &nbEle)!=0)
+					{
+						printf("Error: %s cannot be decompressed!\n", cmpPath);
+						exit(0);
+					}
 					nbEle=nbEle/8;
 				}
 
@@ -16,6 +16,8 @@
 
 #define H5Z_FILTER_SZ 32017
 #define MAX_CHUNK_SIZE 4294967295 //2^32-1
+#define H5Z_SZ_ERR_NELMTS 11 //errorBoundMode + 5 doubles (absErrBound, relBoundRatio, pw_relBoundRatio, psnr, normErr), 2 words each
+#define H5Z_SZ_MAX_NELMTS (7+H5Z_SZ_ERR_NELMTS)
 static hid_t H5Z_SZ_ERRCLASS = -1;
 
 #ifdef __cplusplus
@@ -51,6 +53,10 @@ int H5Z_SZ_Finalize();
 void SZ_cdArrayToMetaData(size_t cd_nelmts, const unsigned int cd_values[], int* dimSize, int* dataType, size_t* r5, size_t* r4, size_t* r3, size_t* r2, size_t* r1);
 void SZ_metaDataToCdArray(size_t* cd_nelmts, unsigned int** cd_values, int dataType, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1);
 
+size_t SZ_cdArrayDimNelmts(int dimSize);
+void SZ_errConfigToCdArray(size_t* cd_nelmts, unsigned int** cd_values, int errorBoundMode, double absErrBound, double relBoundRatio, double pwrBoundRatio, double psnr, double normErr);
+int SZ_cdArrayToErrConfig(size_t cd_nelmts, const unsigned int cd_values[], int* errorBoundMode, double* absErrBound, double* relBoundRatio, double* pwrBoundRatio, double* psnr, double* normErr);
+
 static size_t H5Z_filter_sz(unsigned int flags, size_t cd_nelmts, const unsigned int cd_values[], size_t nbytes, size_t* buf_size, void** buf);
 static herr_t H5Z_sz_set_local(hid_t dcpl_id, hid_t type_id, hid_t space_id);
 
@@ -3,13 +3,17 @@
  *  @author Sheng Di
  *  @date July, 2017
  *  @brief SZ filter for HDF5
+ *  The filter cannot compress or decompress chunks of different datasets (or of the same dataset) concurrently:
+ *  all its SZ calls go through one process-wide mutex, so multithreaded HDF5 callers are served one chunk at a time.
  *  (C) 2017 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
  *      See COPYRIGHT in top-level directory.
  */
  
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
+#include <pthread.h>
 #include "H5Z_SZ.h"
 #include "H5PLextern.h"
 
@@ -40,6 +44,16 @@ void cost_end()
 int load_conffile_flag = 0; //0 means 'not yet', 1 means 'already loaded'
 char cfgFile[256] = "sz.config"; 
 
+//Held around every SZ_compress_args_to_buffer/SZ_decompress_args call of the filter (see the file header):
+//the dataset's error bounds are passed per call, but the SZ working parameters they are written to are shared.
+static pthread_mutex_t H5Z_SZ_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t H5Z_SZ_once = PTHREAD_ONCE_INIT;
+
+//the error bounds of the configuration (cfgFile or H5Z_SZ_Init_Params()), for the datasets without their own error bounds
+static int H5Z_SZ_errorBoundMode = REL;
+static double H5Z_SZ_absErrBound = 1E-4, H5Z_SZ_relBoundRatio = 1E-3, H5Z_SZ_pwrBoundRatio = 1E-4;
+static double H5Z_SZ_psnr = 0, H5Z_SZ_normErr = 0, H5Z_SZ_predThreshold = 0.99;
+
 const H5Z_class2_t H5Z_SZ[1] = {{
 	H5Z_CLASS_T_VERS,              /* H5Z_class_t version */
 	(H5Z_filter_t)H5Z_FILTER_SZ, /* Filter id number */
@@ -54,6 +68,35 @@ const H5Z_class2_t H5Z_SZ[1] = {{
 H5PL_type_t H5PLget_plugin_type(void) {return H5PL_TYPE_FILTER;}
 const void *H5PLget_plugin_info(void) {return H5Z_SZ;}
 
+/**
+ * keep the error bounds of the current configuration: SZ overwrites confparams_cpr->errorBoundMode and absErrBound
+ * in each compression, so they are read once, when the configuration is set.
+ * */
+static void H5Z_SZ_saveErrConfig()
+{
+	H5Z_SZ_errorBoundMode = confparams_cpr->errorBoundMode;
+	H5Z_SZ_absErrBound = confparams_cpr->absErrBound;
+	H5Z_SZ_relBoundRatio = confparams_cpr->relBoundRatio;
+	H5Z_SZ_pwrBoundRatio = confparams_cpr->pw_relBoundRatio;
+	H5Z_SZ_psnr = confparams_cpr->psnr;
+	H5Z_SZ_normErr = confparams_cpr->normErr;
+	H5Z_SZ_predThreshold = confparams_cpr->predThreshold;
+}
+
+/**
+ * run once (pthread_once()) by the filter callbacks: load cfgFile unless the application already initialized SZ.
+ * */
+static void H5Z_SZ_InitOnce()
+{
+	if(confparams_cpr == NULL)
+	{
+		load_conffile_flag = 1;
+		if(SZ_Init(cfgFile) == SZ_NSCS) //the datasets may carry their own error bounds in cd_values
+			SZ_Init(NULL);
+	}
+	H5Z_SZ_saveErrConfig();
+}
+
 int H5Z_SZ_Init(char* cfgFile) 
 { 
 	herr_t ret;
@@ -64,10 +107,17 @@ int H5Z_SZ_Init(char* cfgFile)
 		int status = SZ_Init(cfgFile);
 		//printf("cfgFile=%s\n", cfgFile);
 		//printf("szMode=%d, errorBoundMode=%d, relBoundRatio=%f\n", szMode, errorBoundMode, relBoundRatio);
-		if(status == SZ_NSCS)
+		if(status == SZ_NSCS) //the datasets may carry their own error bounds in cd_values, so go on with the default setting
+		{
+			SZ_Init(NULL);
+			H5Z_SZ_saveErrConfig();
 			return SZ_NSCS;
+		}
 		else
-			return SZ_SCES;		
+		{
+			H5Z_SZ_saveErrConfig();
+			return SZ_SCES;
+		}
 	}
 
 	ret = H5Zregister(H5Z_SZ); 
@@ -83,8 +133,8 @@ int H5Z_SZ_Init_Params(sz_params *params)
 	int status = SZ_Init_Params(params);
 	if(status == SZ_NSCS || ret < 0)
 		return SZ_NSCS;
-	else
-		return SZ_SCES;
+	H5Z_SZ_saveErrConfig();
+	return SZ_SCES;
 }
 
 sz_params* H5Z_SZ_Init_Default()
@@ -112,8 +162,8 @@ sz_params* H5Z_SZ_Init_Default()
 	int status = SZ_Init_Params(conf_params);
 	if(status == SZ_NSCS || ret < 0)
 		return NULL;
-	else
-		return confparams_cpr;
+	H5Z_SZ_saveErrConfig();
+	return confparams_cpr;
 }
 
 int H5Z_SZ_Finalize()
@@ -222,6 +272,84 @@ void SZ_metaDataToCdArray(size_t* cd_nelmts, unsigned int **cd_values, int dataT
 	}
 }
 
+/**
+ * the number of cd_values words used by the data type and the dimensions (the error bounds, if any, follow them).
+ * */
+size_t SZ_cdArrayDimNelmts(int dimSize)
+{
+	switch(dimSize)
+	{
+	case 1:
+	case 2:
+		return 4;
+	case 3:
+		return 5;
+	case 4:
+		return 6;
+	default:
+		return 7;
+	}
+}
+
+static void doubleToCdValues(unsigned int cd_values[2], double value)
+{
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(double));
+	cd_values[0] = (unsigned int)(bits >> 32);
+	cd_values[1] = (unsigned int)(bits & 0xFFFFFFFF);
+}
+
+static double cdValuesToDouble(const unsigned int cd_values[2])
+{
+	double value;
+	uint64_t bits = ((uint64_t)cd_values[0] << 32) | (uint64_t)cd_values[1];
+	memcpy(&value, &bits, sizeof(double));
+	return value;
+}
+
+/**
+ * to be called outside H5Z_filter_sz(): build the cd_values carrying the error bounds of one dataset,
+ * to be passed to H5Pset_filter(). H5Z_sz_set_local() then appends them to the data type and dimensions,
+ * so that each dataset keeps its own error bounds, independently of the configuration file.
+ * 
+ * @param psnr : only used when errorBoundMode==PSNR
+ * @param normErr : only used when errorBoundMode==NORM
+ * */
+void SZ_errConfigToCdArray(size_t* cd_nelmts, unsigned int **cd_values, int errorBoundMode, double absErrBound, double relBoundRatio, double pwrBoundRatio, double psnr, double normErr)
+{
+	*cd_values = (unsigned int*)malloc(sizeof(unsigned int)*H5Z_SZ_ERR_NELMTS);
+	(*cd_values)[0] = (unsigned int)errorBoundMode;
+	doubleToCdValues(&(*cd_values)[1], absErrBound);
+	doubleToCdValues(&(*cd_values)[3], relBoundRatio);
+	doubleToCdValues(&(*cd_values)[5], pwrBoundRatio);
+	doubleToCdValues(&(*cd_values)[7], psnr);
+	doubleToCdValues(&(*cd_values)[9], normErr);
+	*cd_nelmts = H5Z_SZ_ERR_NELMTS;
+}
+
+/**
+ * to be used in compression, inside the H5Z_filter_sz(): extract the error bounds stored after the dimensions.
+ * 
+ * @return 1 if the cd_values carry the error bounds, or 0 (files written by older versions of the filter), 
+ * in which case the error bounds of the current SZ configuration are to be used.
+ * */
+int SZ_cdArrayToErrConfig(size_t cd_nelmts, const unsigned int cd_values[], int* errorBoundMode, double* absErrBound, double* relBoundRatio, double* pwrBoundRatio, double* psnr, double* normErr)
+{
+	size_t k;
+	if(cd_nelmts < 4)
+		return 0;
+	k = SZ_cdArrayDimNelmts(cd_values[0]);
+	if(cd_nelmts < k + H5Z_SZ_ERR_NELMTS)
+		return 0;
+	*errorBoundMode = (int)cd_values[k];
+	*absErrBound = cdValuesToDouble(&cd_values[k+1]);
+	*relBoundRatio = cdValuesToDouble(&cd_values[k+3]);
+	*pwrBoundRatio = cdValuesToDouble(&cd_values[k+5]);
+	*psnr = cdValuesToDouble(&cd_values[k+7]);
+	*normErr = cdValuesToDouble(&cd_values[k+9]);
+	return 1;
+}
+
 static herr_t H5Z_sz_set_local(hid_t dcpl_id, hid_t type_id, hid_t chunk_space_id)
 {
 	//printf("start in H5Z_sz_set_local\n");
@@ -233,8 +361,13 @@ static herr_t H5Z_sz_set_local(hid_t dcpl_id, hid_t type_id, hid_t chunk_space_i
 	H5T_class_t dclass;
 	H5T_sign_t dsign;
 	unsigned int flags = 0;
+	size_t cd_nelmts = H5Z_SZ_MAX_NELMTS, dim_nelmts = 0;
+	unsigned int mem_cd_values[H5Z_SZ_MAX_NELMTS]; 
+	unsigned int* cd_values = NULL;
+	unsigned int* dim_cd_values = NULL;
+	unsigned int* err_cd_values = NULL;
 	//conf_params = H5Z_SZ_Init_Default();
-	H5Z_SZ_Init(cfgFile);
+	pthread_once(&H5Z_SZ_once, H5Z_SZ_InitOnce);
 	
 	int dataType = SZ_FLOAT;
 	
@@ -329,14 +462,30 @@ static herr_t H5Z_sz_set_local(hid_t dcpl_id, hid_t type_id, hid_t chunk_space_i
 		H5Z_SZ_PUSH_AND_GOTO(H5E_PLINE, H5E_BADVALUE, 0, "requires chunks w/1,2,3 or 4 non-unity dims");
 	}
 	
-	size_t cd_nelmts = 0;
-	unsigned int mem_cd_values[7]; 
-	unsigned int* cd_values;
-
 	if (0 > H5Pget_filter_by_id(dcpl_id, H5Z_FILTER_SZ, &flags, &cd_nelmts, mem_cd_values, 0, NULL, NULL))
 		H5Z_SZ_PUSH_AND_GOTO(H5E_PLINE, H5E_CANTGET, 0, "unable to get current SZ cd_values");
 
-	SZ_metaDataToCdArray(&cd_nelmts, &cd_values, dataType, r5, r4, r3, r2, r1);
+	//the error bounds are kept from the user's cd_values (built by SZ_errConfigToCdArray(), or copied from 
+	//an existing dataset), otherwise they are taken from the current configuration (cfgFile)
+	if(cd_nelmts == H5Z_SZ_ERR_NELMTS)
+	{
+		err_cd_values = (unsigned int*)malloc(sizeof(unsigned int)*H5Z_SZ_ERR_NELMTS);
+		memcpy(err_cd_values, mem_cd_values, sizeof(unsigned int)*H5Z_SZ_ERR_NELMTS);
+	}
+	else if(cd_nelmts > H5Z_SZ_ERR_NELMTS && cd_nelmts <= H5Z_SZ_MAX_NELMTS && cd_nelmts == SZ_cdArrayDimNelmts(mem_cd_values[0]) + H5Z_SZ_ERR_NELMTS)
+	{
+		err_cd_values = (unsigned int*)malloc(sizeof(unsigned int)*H5Z_SZ_ERR_NELMTS);
+		memcpy(err_cd_values, &mem_cd_values[cd_nelmts-H5Z_SZ_ERR_NELMTS], sizeof(unsigned int)*H5Z_SZ_ERR_NELMTS);
+	}
+	else
+		SZ_errConfigToCdArray(&cd_nelmts, &err_cd_values, H5Z_SZ_errorBoundMode, H5Z_SZ_absErrBound, 
+		H5Z_SZ_relBoundRatio, H5Z_SZ_pwrBoundRatio, H5Z_SZ_psnr, H5Z_SZ_normErr);
+
+	SZ_metaDataToCdArray(&dim_nelmts, &dim_cd_values, dataType, r5, r4, r3, r2, r1);
+	cd_nelmts = dim_nelmts + H5Z_SZ_ERR_NELMTS;
+	cd_values = (unsigned int*)malloc(sizeof(unsigned int)*cd_nelmts);
+	memcpy(cd_values, dim_cd_values, sizeof(unsigned int)*dim_nelmts);
+	memcpy(&cd_values[dim_nelmts], err_cd_values, sizeof(unsigned int)*H5Z_SZ_ERR_NELMTS);
 	
 	/* Now, update cd_values for the filter */
 	if (0 > H5Pmodify_filter(dcpl_id, H5Z_FILTER_SZ, flags, cd_nelmts, cd_values))
@@ -345,10 +494,52 @@ static herr_t H5Z_sz_set_local(hid_t dcpl_id, hid_t type_id, hid_t chunk_space_i
 	retval = 1;
 done:
 	free(cd_values);
+	free(dim_cd_values);
+	free(err_cd_values);
 	return retval;
 }
 
 
+static size_t H5Z_SZ_dataTypeSize(int dataType)
+{
+	if(dataType == SZ_FLOAT)
+		return sizeof(float);
+	else if(dataType == SZ_DOUBLE)
+		return sizeof(double);
+	else
+		return (size_t)getIntTypeSize(dataType); //0 for an unknown type
+}
+
+/**
+ * the PSNR and NORM error bounds of a dataset are turned into the equivalent ABS bound of the chunk, the way 
+ * SZ_compress_args() does from confparams_cpr->psnr and normErr, so that they are passed to SZ with the call.
+ * */
+static double H5Z_SZ_toABSErrBound(int dataType, void* data, size_t nbEle, int errBoundMode, double psnr, double normErr)
+{
+	if(errBoundMode == NORM)
+		return computeABSErrBoundFromNORM_ERR(normErr, nbEle);
+
+	double valueRangeSize = 0;
+	if(dataType == SZ_FLOAT)
+	{
+		float range = 0, median = 0;
+		computeRangeSize_float((float*)data, nbEle, &range, &median);
+		valueRangeSize = range;
+	}
+	else if(dataType == SZ_DOUBLE)
+	{
+		double median = 0;
+		computeRangeSize_double((double*)data, nbEle, &valueRangeSize, &median);
+	}
+	else
+	{
+		int64_t range = 0;
+		computeRangeSize_int(data, dataType, nbEle, &range);
+		valueRangeSize = (double)range;
+	}
+	return computeABSErrBoundFromPSNR(psnr, H5Z_SZ_predThreshold, valueRangeSize);
+}
+
 static size_t H5Z_filter_sz(unsigned int flags, size_t cd_nelmts, const unsigned int cd_values[], size_t nbytes, size_t* buf_size, void** buf)
 {
 	//printf("start in H5Z_filter_sz\n");
@@ -356,10 +547,13 @@ static size_t H5Z_filter_sz(unsigned int flags, size_t cd_nelmts, const unsigned
 	
 	size_t r1 = 0, r2 = 0, r3 = 0, r4 = 0, r5 = 0;
 	int dimSize = 0, dataType = 0;
+	int errBoundMode = 0, withErrConfig = 0;
+	double absErrBound = 0, relBoundRatio = 0, pwrBoundRatio = 0, psnr = 0, normErr = 0;
 
 	if(cd_nelmts==0) //this is special data such as string, which should not be treated as values.
 		return nbytes;
 	
+	pthread_once(&H5Z_SZ_once, H5Z_SZ_InitOnce);
 	SZ_cdArrayToMetaData(cd_nelmts, cd_values, &dimSize, &dataType, &r5, &r4, &r3, &r2, &r1);
 	
 /*	int i=0;
@@ -371,96 +565,57 @@ static size_t H5Z_filter_sz(unsigned int flags, size_t cd_nelmts, const unsigned
 	if(nbEle < 20)
 		return nbytes;
 
+	size_t elemSize = H5Z_SZ_dataTypeSize(dataType);
+	if(elemSize == 0)
+	{
+		printf("Error: unknown data type in H5Z_filter_sz: %d\n", dataType);
+		return 0;
+	}
+
 	if (flags & H5Z_FLAG_REVERSE) 
 	{ 
 		//cost_start();
 		/* decompress data */
-		if(dataType == SZ_FLOAT)//==0
-		{
-			float* data = SZ_decompress(dataType, *buf, nbytes, r5, r4, r3, r2, r1);
-
-			free(*buf);
-			*buf = data;
-			*buf_size = nbEle*sizeof(float);
+		//the decompressed data are written directly into the chunk buffer when it is large enough (the compressed 
+		//bytes are first moved aside, as the decoders read them while writing the data), otherwise into a new one
+		size_t dataSize = nbEle*elemSize;
+		void* data = NULL;
+		unsigned char* bytes = NULL;
+		if(*buf_size >= dataSize)
+		{
+			bytes = (unsigned char*)malloc(nbytes);
+			if(bytes == NULL)
+				return 0;
+			memcpy(bytes, *buf, nbytes);
+			data = *buf;
 		}
-		else if(dataType == SZ_DOUBLE)//==1
-		{
-			double* data = SZ_decompress(dataType, *buf, nbytes, r5, r4, r3, r2, r1);
-			free(*buf);
-			*buf = data;
-			*buf_size = nbEle*sizeof(double);			
-		}
-		else if(dataType == SZ_INT8)
-		{
-			char* data = SZ_decompress(dataType, *buf, nbytes, r5, r4, r3, r2, r1);
-										
-			free(*buf);
-			*buf = data;
-			*buf_size = nbEle*sizeof(char);
-		}
-		else if(dataType == SZ_UINT8)
-		{
-			unsigned char* data = SZ_decompress(dataType, *buf, nbytes, r5, r4, r3, r2, r1);
-										
-			free(*buf);
-			*buf = data;
-			*buf_size = nbEle*sizeof(unsigned char);
-		}
-		else if(dataType == SZ_INT16)
-		{
-			short* data = SZ_decompress(dataType, *buf, nbytes, r5, r4, r3, r2, r1);
-										
-			free(*buf);
-			*buf = data;
-			*buf_size = nbEle*sizeof(short);
-		}
-		else if(dataType == SZ_UINT16)
-		{
-			unsigned short* data = SZ_decompress(dataType, *buf, nbytes, r5, r4, r3, r2, r1);
-										
-			free(*buf);
-			*buf = data;
-			*buf_size = nbEle*sizeof(unsigned short);
-		}
-		else if(dataType == SZ_INT32)
+		else
 		{
-			int* data = SZ_decompress(dataType, *buf, nbytes, r5, r4, r3, r2, r1);
-										
-			free(*buf);
-			*buf = data;
-			*buf_size = nbEle*sizeof(int);
+			bytes = (unsigned char*)*buf;
+			data = malloc(dataSize);
+			if(data == NULL)
+				return 0;
 		}
-		else if(dataType == SZ_UINT32)
-		{
-			unsigned int* data = SZ_decompress(dataType, *buf, nbytes, r5, r4, r3, r2, r1);
-										
-			free(*buf);
-			*buf = data;
-			*buf_size = nbEle*sizeof(unsigned int);
+		pthread_mutex_lock(&H5Z_SZ_mutex);
+		size_t decEle = SZ_decompress_args(dataType, bytes, nbytes, data, r5, r4, r3, r2, r1);
+		pthread_mutex_unlock(&H5Z_SZ_mutex);
+		if(data == *buf)
+			free(bytes);
+		if(decEle == (size_t)SZ_NSCS)
+		{
+			if(data != *buf)
+				free(data);
+			return 0;
 		}
-		else if(dataType == SZ_INT64)
+		if(data != *buf)
 		{
-			long* data = SZ_decompress(dataType, *buf, nbytes, r5, r4, r3, r2, r1);
-										
 			free(*buf);
 			*buf = data;
-			*buf_size = nbEle*sizeof(long);
-		}
-		else if(dataType == SZ_UINT64)
-		{
-			unsigned long* data = SZ_decompress(dataType, *buf, nbytes, r5, r4, r3, r2, r1);
-										
-			free(*buf);
-			*buf = data;
-			*buf_size = nbEle*sizeof(unsigned long);
-		}
-		else
-		{
-			printf("Decompression error: unknown data type: %d\n", dataType);
-			exit(0);
+			*buf_size = dataSize;
 		}
 		//cost_end();
 		//printf("decompression time = %lf, decompression rate = %lf\n", totalCost, 1.0*nbEle*sizeof(float)/totalCost);
+		return dataSize;
 	}
 	else
 	{
@@ -468,97 +623,44 @@ static size_t H5Z_filter_sz(unsigned int flags, size_t cd_nelmts, const unsigned
 	
 		//printf("r5=%d, r4=%d, r3=%d, r2=%d, r1=%d, dataType=%d\n", r5, r4, r3, r2, r1, dataType);
 		//cost_start();
-		if(dataType == SZ_FLOAT)//==0
-		{
-			float* data = (float*)(*buf);
-			unsigned char *bytes = SZ_compress(dataType, data, &outSize, r5, r4, r3, r2, r1);
-			free(*buf);
-			*buf = bytes;
-			*buf_size = outSize;
-		}
-		else if(dataType == SZ_DOUBLE)//==1
-		{
-			double* data = (double*)(*buf);
-			unsigned char *bytes = SZ_compress(dataType, data, &outSize, r5, r4, r3, r2, r1);
-			free(*buf);
-			*buf = bytes;
-			*buf_size = outSize;
-		}
-		else if(dataType == SZ_INT8)
-		{
-			char* data = (char*)(*buf);
-			unsigned char *bytes = SZ_compress(dataType, data, &outSize, r5, r4, r3, r2, r1);
-			free(*buf);
-			*buf = bytes;
-			*buf_size = outSize;
-		}
-		else if(dataType == SZ_UINT8)
-		{
-			unsigned char* data = (unsigned char*)(*buf);
-			unsigned char *bytes = SZ_compress(dataType, data, &outSize, r5, r4, r3, r2, r1);
-			free(*buf);
-			*buf = bytes;
-			*buf_size = outSize;
-		}
-		else if(dataType == SZ_INT16)
-		{
-			short* data = (short*)(*buf);
-			unsigned char *bytes = SZ_compress(dataType, data, &outSize, r5, r4, r3, r2, r1);
-			free(*buf);
-			*buf = bytes;
-			*buf_size = outSize;
-		}
-		else if(dataType == SZ_UINT16)
-		{
-			unsigned short* data = (unsigned short*)(*buf);
-			unsigned char *bytes = SZ_compress(dataType, data, &outSize, r5, r4, r3, r2, r1);
-			free(*buf);
-			*buf = bytes;
-			*buf_size = outSize;
-		}
-		else if(dataType == SZ_INT32)
-		{
-			int* data = (int*)(*buf);
-			unsigned char *bytes = SZ_compress(dataType, data, &outSize, r5, r4, r3, r2, r1);
-			free(*buf);
-			*buf = bytes;
-			*buf_size = outSize;
-		}
-		else if(dataType == SZ_UINT32)
-		{
-			unsigned int* data = (unsigned int*)(*buf);
-			unsigned char *bytes = SZ_compress(dataType, data, &outSize, r5, r4, r3, r2, r1);
-			free(*buf);
-			*buf = bytes;
-			*buf_size = outSize;
+		//the error bounds of the dataset are passed with the call, instead of being set in confparams_cpr
+		withErrConfig = SZ_cdArrayToErrConfig(cd_nelmts, cd_values, &errBoundMode, &absErrBound, &relBoundRatio, &pwrBoundRatio, &psnr, &normErr);
+		if(!withErrConfig) //written by an older version of the filter: use the configuration
+		{
+			errBoundMode = H5Z_SZ_errorBoundMode;
+			absErrBound = H5Z_SZ_absErrBound;
+			relBoundRatio = H5Z_SZ_relBoundRatio;
+			pwrBoundRatio = H5Z_SZ_pwrBoundRatio;
+			psnr = H5Z_SZ_psnr;
+			normErr = H5Z_SZ_normErr;
 		}
-		else if(dataType == SZ_INT64)
+		if(errBoundMode == PSNR || errBoundMode == NORM)
 		{
-			long* data = (long*)(*buf);
-			unsigned char *bytes = SZ_compress(dataType, data, &outSize, r5, r4, r3, r2, r1);
-			free(*buf);
-			*buf = bytes;
-			*buf_size = outSize;
+			absErrBound = H5Z_SZ_toABSErrBound(dataType, *buf, nbEle, errBoundMode, psnr, normErr);
+			errBoundMode = ABS;
 		}
-		else if(dataType == SZ_UINT64)
-		{
-			unsigned long* data = (unsigned long*)(*buf);
-			unsigned char *bytes = SZ_compress(dataType, data, &outSize, r5, r4, r3, r2, r1);
-			free(*buf);
-			*buf = bytes;
-			*buf_size = outSize;
-		}
-		else 
-		{
-			printf("Compression error: unknown data type: %d\n", dataType);
-			exit(0);
+		//the chunk buffer holds the data to compress, so the stream is written into a new buffer of 
+		//SZ_compress_bound() bytes, which is handed over to HDF5 as the new chunk buffer instead of being copied
+		size_t capacity = SZ_compress_bound(dataType, r5, r4, r3, r2, r1);
+		unsigned char *bytes = (unsigned char*)malloc(capacity);
+		if(bytes == NULL)
+			return 0;
+		pthread_mutex_lock(&H5Z_SZ_mutex);
+		int status = SZ_compress_args_to_buffer(dataType, *buf, bytes, capacity, &outSize, errBoundMode, absErrBound, relBoundRatio, pwrBoundRatio, r5, r4, r3, r2, r1);
+		pthread_mutex_unlock(&H5Z_SZ_mutex);
+		if(status != SZ_SCES)
+		{
+			free(bytes);
+			return 0;
 		}
+
+		free(*buf);
+		*buf = bytes;
+		*buf_size = capacity;
 		//cost_end();
 		//printf("compression time = %lf, compression rate = %lf\n", totalCost, 1.0*nbEle*sizeof(float)/totalCost);
+		return outSize;
 	}
-	
-	//H5Z_SZ_Finalize();
-	return *buf_size;
 }
 
 void init_dims_chunk(int dim, hsize_t dims[5], hsize_t chunk[5], size_t nbEle, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
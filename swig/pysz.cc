@@ -74,6 +74,8 @@ ConfigBuilder& ConfigBuilder::sol_ID(int value) noexcept { building.params.sol_I
 ConfigBuilder& ConfigBuilder::szMode(int value) noexcept { building.params.szMode = value; return *this; }
 ConfigBuilder& ConfigBuilder::accelerate_pw_rel_compression(int value) noexcept { building.params.accelerate_pw_rel_compression = value; return *this; }
 ConfigBuilder& ConfigBuilder::plus_bits(int value) noexcept { building.params.plus_bits = value; return *this; }
+ConfigBuilder& ConfigBuilder::regressionBlockSize(int value) noexcept { building.params.regressionBlockSize = value; return *this; }
+ConfigBuilder& ConfigBuilder::huffTreeReuseTolerance(double value) noexcept { building.params.huffTreeReuseTolerance = value; return *this; }
 Config ConfigBuilder::build() { return building;} 
 
 Compressor::Compressor(Config config): app(config.app) {
@@ -38,6 +38,8 @@
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <mutex>
+#include <cstdlib>
 #include "sz.h"
 #include "exafelSZ.h"
 #include "pysz_private.h"
@@ -78,6 +80,8 @@ class ConfigBuilder {
 	ConfigBuilder& szMode(int value) noexcept;
   ConfigBuilder& accelerate_pw_rel_compression(int value) noexcept;
   ConfigBuilder& plus_bits(int value) noexcept;
+  ConfigBuilder& regressionBlockSize(int value) noexcept;
+  ConfigBuilder& huffTreeReuseTolerance(double value) noexcept;
   private:
   Config building;
 };
@@ -122,6 +126,19 @@ class ExaFELConfigBuilder {
   std::vector<uint8_t> calibPanel;
 };
 
+/*
+ * one array of a Compressor::CompressBatch call; data is borrowed from the caller,
+ * out is allocated by SZ and owned by the caller after the call
+ */
+struct CompressJob {
+  int dataType;
+  void* data;
+  size_t r1, r2, r3, r4;
+  unsigned char* out;
+  size_t outsize;
+  int status;
+};
+
 class Compressor {
   public:
   /*
@@ -144,63 +161,99 @@ class Compressor {
 
   template<class T>
   std::string Compress1(T* data, size_t r1, void* params=nullptr) {
-    size_t outsize = 0;
-    int status;
-    char* tmp = reinterpret_cast<char*>(SZ_compress_customize(app.c_str(), params, SZTypeToTypeID<T>::value, data, 0, 0, 0, 0, r1, &outsize, &status));
-    return std::string(tmp, outsize);
+    return compress(SZTypeToTypeID<T>::value, data, 0, 0, 0, 0, r1, params);
   }
   template<class T>
   std::string Compress2(T* data, size_t r1, size_t r2, void* params=nullptr) {
-    int status;
-    size_t outsize = 0;
-    auto tmp = reinterpret_cast<char*>(SZ_compress_customize(app.c_str(), params, SZTypeToTypeID<T>::value, data, 0, 0, 0, r2, r1, &outsize, &status));
-    return std::string(tmp, outsize);
+    return compress(SZTypeToTypeID<T>::value, data, 0, 0, 0, r2, r1, params);
   }
   template<class T>
   std::string Compress3(T* data, size_t r1, size_t r2, size_t r3, void* params=nullptr) {
-    int status;
-    size_t outsize = 0;
-    auto tmp = reinterpret_cast<char*>(SZ_compress_customize(app.c_str(), params, SZTypeToTypeID<T>::value, data, 0, 0, r3, r2, r1, &outsize, &status));
-    return std::string(tmp, outsize);
+    return compress(SZTypeToTypeID<T>::value, data, 0, 0, r3, r2, r1, params);
   }
   template<class T>
   std::string Compress4(T* data, size_t r1, size_t r2, size_t r3, size_t r4, void* params=nullptr) {
-    int status;
-    size_t outsize = 0;
-    auto tmp = reinterpret_cast<char*>(SZ_compress_customize(app.c_str(), params, SZTypeToTypeID<T>::value, data, 0, r4, r3, r2, r1, &outsize, &status));
-    return std::string(tmp, outsize);
-
+    return compress(SZTypeToTypeID<T>::value, data, 0, r4, r3, r2, r1, params);
   }
 
   template<class T>
   std::vector<T> Decompress(std::string data, std::vector<int> r, void* params=nullptr) {
-    T* decompressed = nullptr;
     size_t len = 0;
-    int status;
+    T* decompressed = (T*)DecompressBuffer(SZTypeToTypeID<T>::value, data.c_str(), data.length(), r, &len, params);
+    if(decompressed == nullptr) return std::vector<T>();
+    std::vector<T> values(decompressed, decompressed+len);
+    free(decompressed);
+    return values;
+  }
+
+  //
+  //The following methods do not use the Python API, so the bindings call them without holding the GIL.
+  //
+  
+  /*
+   * decompresses into an array allocated by SZ (to be released with free()) of len elements;
+   * returns nullptr on errors
+   */
+  void* DecompressBuffer(int dataType, const char* data, size_t data_len, std::vector<int> const& r, size_t* len, void* params=nullptr) {
+    void* decompressed = nullptr;
+    int status = SZ_NSCS;
+    size_t r4 = 0, r3 = 0, r2 = 0;
+    *len = 0;
     switch(r.size()) {
+      case 4: r4 = r[3]; //fall through
+      case 3: r3 = r[2]; //fall through
+      case 2: r2 = r[1]; //fall through
       case 1:
-
-        decompressed = (T*)SZ_decompress_customize(app.c_str(), params, SZTypeToTypeID<T>::value, (unsigned char*)(data.c_str()), data.length(), 0,0,0,0,r[0], &status);
-        len = r[0];
-        break;
-      case 2:
-        decompressed = (T*)SZ_decompress_customize(app.c_str(), params, SZTypeToTypeID<T>::value, (unsigned char*)(data.c_str()), data.length(), 0,0,0,r[1],r[0], &status);
-        len = r[0]*r[1];
-        break;
-      case 3:
-        decompressed = (T*)SZ_decompress_customize(app.c_str(), params, SZTypeToTypeID<T>::value, (unsigned char*)(data.c_str()), data.length(), 0,0,r[2],r[1],r[0], &status);
-        len = r[0]*r[1]*r[2];
-        break;
-      case 4:
-        decompressed = (T*)SZ_decompress_customize(app.c_str(), params, SZTypeToTypeID<T>::value, (unsigned char*)(data.c_str()), data.length(), 0,r[3],r[2],r[1],r[0], &status);
-        len = r[0]*r[1]*r[2]*r[3];
+        {
+          std::lock_guard<std::mutex> guard(sz_lock());
+          decompressed = SZ_decompress_customize(app.c_str(), params, dataType, (unsigned char*)data, data_len, 0, r4, r3, r2, r[0], &status);
+        }
+        *len = computeDataLength(0, r4, r3, r2, r[0]);
         break;
       default:
         printf("%zu dimensional arrays not supported\n", r.size());
     }
-    return std::vector<T>(decompressed, decompressed+len);
+    if(status != SZ_SCES) {
+      free(decompressed);
+      return nullptr;
+    }
+    return decompressed;
+  }
+
+  /*
+   * compresses each of the jobs, one after the other (serially, under sz_lock());
+   * a failed job has out==nullptr and status!=SZ_SCES
+   */
+  void CompressBatch(std::vector<CompressJob>& jobs, void* params=nullptr) {
+    std::lock_guard<std::mutex> guard(sz_lock());
+    for(auto& job: jobs) {
+      job.outsize = 0;
+      job.out = SZ_compress_customize(app.c_str(), params, job.dataType, job.data, 0, job.r4, job.r3, job.r2, job.r1, &job.outsize, &job.status);
+    }
   }
 
   private:
+  std::string compress(int dataType, void* data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, void* params) {
+    int status;
+    size_t outsize = 0;
+    unsigned char* tmp;
+    {
+      std::lock_guard<std::mutex> guard(sz_lock());
+      tmp = SZ_compress_customize(app.c_str(), params, dataType, data, r5, r4, r3, r2, r1, &outsize, &status);
+    }
+    if(tmp == nullptr) return std::string();
+    std::string compressed(reinterpret_cast<char*>(tmp), outsize);
+    free(tmp);
+    return compressed;
+  }
+
+  /*
+   * held around every SZ call of every Compressor: the SZ calls of a process never run concurrently
+   */
+  static std::mutex& sz_lock() {
+    static std::mutex lock;
+    return lock;
+  }
+
   std::string app;
 };
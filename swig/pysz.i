@@ -33,7 +33,7 @@
  * official policies, either expressed or implied, of Robert Underwood.
  */
 
-%module pysz
+%module(threads="1") pysz
 %feature("autodoc", 1);
 
 %{
@@ -43,6 +43,10 @@
 #include "defines.h"
 #include <vector>
 #include <cstdint>
+
+static void pysz_free_capsule(PyObject* capsule) {
+  free(PyCapsule_GetPointer(capsule, NULL));
+}
 %}
 
 %init %{
@@ -53,6 +57,26 @@ import_array();
 %include <std_string.i>
 %include "numpy.i"
 
+%{
+static int pysz_npy_to_sz_type(int typenum) {
+  switch(typenum) {
+    case NPY_FLOAT: return SZ_FLOAT;
+    case NPY_DOUBLE: return SZ_DOUBLE;
+    case NPY_BYTE: return SZ_INT8;
+    case NPY_UBYTE: return SZ_UINT8;
+    case NPY_SHORT: return SZ_INT16;
+    case NPY_USHORT: return SZ_UINT16;
+    case NPY_INT: return SZ_INT32;
+    case NPY_UINT: return SZ_UINT32;
+    case NPY_LONG: return sizeof(long) == 8 ? SZ_INT64 : SZ_INT32;
+    case NPY_ULONG: return sizeof(unsigned long) == 8 ? SZ_UINT64 : SZ_UINT32;
+    case NPY_LONGLONG: return SZ_INT64;
+    case NPY_ULONGLONG: return SZ_UINT64;
+    default: return -1;
+  }
+}
+%}
+
 namespace std {
   %template(vectori8) vector<int8_t>;
   %template(vectori16) vector<int16_t>;
@@ -108,6 +132,23 @@ namespace std {
 %apply (int64_t* INPLACE_ARRAY4, int DIM1, int DIM2, int DIM3, int DIM4 ) {(int64_t* data, size_t r1, size_t r2, size_t r3, size_t r4)}
 
 
+%apply (char *STRING, size_t LENGTH) { (const char* bytes, size_t bytes_len) }
+
+/*
+ * The wrapped compression/decompression calls do not hold the GIL (they only touch buffers pinned by
+ * the arguments), so other Python threads can run meanwhile; the SZ calls themselves are still serial.
+ */
+%nothread;
+%thread Compressor::Compress1;
+%thread Compressor::Compress2;
+%thread Compressor::Compress3;
+%thread Compressor::Compress4;
+%thread Compressor::Decompress;
+
+%ignore CompressJob;
+%ignore Compressor::CompressBatch;
+%ignore Compressor::DecompressBuffer;
+
 %include "pysz.h"
 %include "defines.h"
 %ignore ExaFELConfigBuilder::peaks;
@@ -172,6 +213,108 @@ namespace std {
   %template(DecompressUInt64) Decompress<uint64_t>;
   %template(DecompressInt64) Decompress<int64_t>;
 
+  /*
+   * decompresses into a 1d numpy array that owns SZ's buffer (no copy)
+   */
+  PyObject* DecompressArray(const char* bytes, size_t bytes_len, std::vector<int> const& r, int typenum, void* params=nullptr) {
+    int dataType = pysz_npy_to_sz_type(typenum);
+    if(dataType < 0) {
+      PyErr_SetString(PyExc_TypeError, "dtype not supported");
+      return NULL;
+    }
+    void* decompressed = nullptr;
+    size_t len = 0;
+    Py_BEGIN_ALLOW_THREADS
+    decompressed = $self->DecompressBuffer(dataType, bytes, bytes_len, r, &len, params);
+    Py_END_ALLOW_THREADS
+    if(decompressed == nullptr) {
+      PyErr_SetString(PyExc_RuntimeError, "SZ decompression failed");
+      return NULL;
+    }
+
+    npy_intp n = (npy_intp)len;
+    PyObject* array = PyArray_SimpleNewFromData(1, &n, typenum, decompressed);
+    if(array == NULL) {
+      free(decompressed);
+      return NULL;
+    }
+    PyObject* owner = PyCapsule_New(decompressed, NULL, pysz_free_capsule);
+    if(owner == NULL) {
+      Py_DECREF(array);
+      free(decompressed);
+      return NULL;
+    }
+    if(PyArray_SetBaseObject((PyArrayObject*)array, owner) < 0) { //steals owner even on failure
+      Py_DECREF(array);
+      return NULL;
+    }
+    return array;
+  }
+
+  /*
+   * compresses a sequence of numpy arrays (1 to 4 dimensions) into a list of bytes;
+   * the arrays are used in place when they are C-contiguous and are compressed one after the other (serially),
+   * and each compressed stream is copied once from SZ's buffer into its bytes object
+   */
+  PyObject* CompressMany(PyObject* arrays, void* params=nullptr) {
+    PyObject* seq = PySequence_Fast(arrays, "CompressMany expects a sequence of numpy arrays");
+    if(seq == NULL) return NULL;
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+    std::vector<PyArrayObject*> pinned;
+    std::vector<CompressJob> jobs(n);
+    PyObject* result = NULL;
+    bool ok = true;
+
+    for(Py_ssize_t i = 0; i < n && ok; i++) {
+      PyArrayObject* array = (PyArrayObject*)PyArray_FROM_OF(PySequence_Fast_GET_ITEM(seq, i), NPY_ARRAY_IN_ARRAY);
+      if(array == NULL) { ok = false; break; }
+      pinned.push_back(array);
+      int ndims = PyArray_NDIM(array);
+      npy_intp* shape = PyArray_DIMS(array);
+      CompressJob& job = jobs[i];
+      job.dataType = pysz_npy_to_sz_type(PyArray_TYPE(array));
+      if(job.dataType < 0) {
+        PyErr_SetString(PyExc_TypeError, "dtype not supported");
+        ok = false;
+      } else if(ndims < 1 || ndims > 4) {
+        PyErr_SetString(PyExc_ValueError, "only 1 to 4 dimensional arrays are supported");
+        ok = false;
+      }
+      //same dimension order as Compress1..4
+      job.data = PyArray_DATA(array);
+      job.r1 = ndims > 0 ? shape[0] : 0;
+      job.r2 = ndims > 1 ? shape[1] : 0;
+      job.r3 = ndims > 2 ? shape[2] : 0;
+      job.r4 = ndims > 3 ? shape[3] : 0;
+      job.out = nullptr;
+    }
+
+    if(ok) {
+      Py_BEGIN_ALLOW_THREADS
+      $self->CompressBatch(jobs, params);
+      Py_END_ALLOW_THREADS
+
+      result = PyList_New(n);
+      for(Py_ssize_t i = 0; i < n && result != NULL; i++) {
+        PyObject* compressed = NULL;
+        if(jobs[i].out == nullptr || jobs[i].status != SZ_SCES)
+          PyErr_Format(PyExc_RuntimeError, "SZ compression failed for array %zd", i);
+        else
+          compressed = PyBytes_FromStringAndSize((const char*)jobs[i].out, jobs[i].outsize);
+        if(compressed == NULL) {
+          Py_CLEAR(result);
+          break;
+        }
+        PyList_SET_ITEM(result, i, compressed);
+      }
+    }
+
+    for(auto& job: jobs) free(job.out);
+    for(auto array: pinned) Py_DECREF(array);
+    Py_DECREF(seq);
+    return result;
+  }
+
   %pythoncode %{
     import numpy
 
@@ -247,16 +390,20 @@ namespace std {
     }
 
     def Compress(self, array, userparams=None):
+      """compresses a 1 to 4 dimensional array into bytes (copied from SZ's buffer); only one SZ call
+      runs at a time in the process, whatever the number of threads and Compressors"""
       length = len(array.shape)
       dtype = array.dtype
       return self.__Compress[length, dtype](self, array, userparams)
 
     def Decompress(self, bytes, dims, dtype, userparams=None):
-      try:
-        values = self.__Decompress[dtype](self, bytes, list(dims), userparams)
-        return self.numpy.reshape(values, dims)
-      except KeyError as e:
-        raise TypeError("type {} not supported".format(i.args[0]))
+      values = self.DecompressArray(bytes, list(dims), self.numpy.dtype(dtype).num, userparams)
+      return self.numpy.reshape(values, dims)
+
+    def compress_many(self, arrays, userparams=None):
+      """compresses the arrays into a list of bytes, serially (one array after the other, not in parallel);
+      each result is copied once into its bytes object"""
+      return self.CompressMany(list(arrays), userparams)
 
 
       
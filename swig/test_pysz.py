@@ -0,0 +1,60 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import threading
+import unittest
+
+import numpy as np
+import pysz
+
+
+class TestPysz(unittest.TestCase):
+    """round trips through the bindings, compress_many, and Compress from several threads"""
+
+    bound = 1e-3
+
+    @classmethod
+    def setUpClass(cls):
+        cls.compressor = pysz.Compressor(pysz.ConfigBuilder().errorBoundMode(pysz.ABS)
+                                         .absErrBound(cls.bound).build())
+        x = np.linspace(0, 4 * np.pi, 40)
+        cls.arrays = [
+            np.sin(x).astype(np.float32),
+            np.outer(np.cos(x), np.sin(x[:30])).astype(np.float64),
+            (np.sin(x[:20])[:, None, None] * np.ones((20, 10, 8))).astype(np.float32),
+        ]
+
+    def test_roundtrip(self):
+        for array in self.arrays:
+            compressed = self.compressor.Compress(array)
+            result = self.compressor.Decompress(compressed, array.shape, array.dtype)
+            self.assertEqual(result.shape, array.shape)
+            self.assertLessEqual(np.max(np.abs(result - array)), self.bound * (1 + 1e-6))
+
+    def test_compress_many(self):
+        # a non contiguous view is copied once before compression, and gives the same stream
+        arrays = self.arrays + [self.arrays[1][:, ::2]]
+        many = self.compressor.compress_many(arrays)
+        self.assertEqual(len(many), len(arrays))
+        for array, compressed in zip(arrays, many):
+            self.assertEqual(compressed, self.compressor.Compress(np.ascontiguousarray(array)))
+
+    def test_threads(self):
+        # the SZ calls are serialized: the streams are the same as in a serial run
+        expected = [self.compressor.Compress(array) for array in self.arrays]
+        results = [None] * (4 * len(self.arrays))
+
+        def work(i):
+            results[i] = self.compressor.Compress(self.arrays[i % len(self.arrays)])
+
+        threads = [threading.Thread(target=work, args=(i,)) for i in range(len(results))]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        for i, compressed in enumerate(results):
+            self.assertEqual(compressed, expected[i % len(self.arrays)])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -66,6 +66,8 @@ void encode_withTree(HuffmanTree* huffmanTree, int *s, size_t length, unsigned c
 int encode_withTree_MSST19(HuffmanTree* huffmanTree, int *s, size_t length, unsigned char **out, size_t *outSize);
 void decode_withTree(HuffmanTree* huffmanTree, unsigned char *s, size_t targetLength, int *out);
 void decode_withTree_MSST19(HuffmanTree* huffmanTree, unsigned char *s, size_t targetLength, int *out, int maxBits);
+void encode_withTree_ts(HuffmanTree** prevTree, int stateNum, double tolerance, int *s, size_t length, unsigned char **out, size_t *outSize);
+int decode_withTree_ts(HuffmanTree** prevTree, unsigned char *s, size_t targetLength, int *out);
 void SZ_ReleaseHuffman(HuffmanTree* huffmanTree);
 
 #ifdef __cplusplus
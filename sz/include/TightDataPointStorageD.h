@@ -14,6 +14,8 @@
 extern "C" {
 #endif
 
+#include "Huffman.h"
+
 typedef struct TightDataPointStorageD
 {
 	size_t dataSeriesLength;
@@ -75,6 +77,14 @@ void new_TightDataPointStorageD(TightDataPointStorageD **self,
 		double realPrecision, double medianValue, char reqLength, unsigned int intervals, 
 		unsigned char* pwrErrBoundBytes, size_t pwrErrBoundBytes_size, unsigned char radExpo);
 
+void new_TightDataPointStorageD_ts(TightDataPointStorageD **self, HuffmanTree** prevTree,
+		size_t dataSeriesLength, size_t exactDataNum,
+		int* type, unsigned char* exactMidBytes, size_t exactMidBytes_size,
+		unsigned char* leadNumIntArray,  //leadNumIntArray contains readable numbers....
+		unsigned char* resiMidBits, size_t resiMidBits_size,
+		unsigned char resiBitLength,
+		double realPrecision, double medianValue, char reqLength, unsigned int intervals);
+
 void new_TightDataPointStorageD2(TightDataPointStorageD **self, 
 		size_t dataSeriesLength, size_t exactDataNum, 
 		int* type, unsigned char* exactMidBytes, size_t exactMidBytes_size,
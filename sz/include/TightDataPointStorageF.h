@@ -15,6 +15,7 @@ extern "C" {
 #endif
 
 #include <stdio.h> 
+#include "Huffman.h"
 
 typedef struct TightDataPointStorageF
 {
@@ -77,6 +78,14 @@ void new_TightDataPointStorageF(TightDataPointStorageF **self,
 		double realPrecision, float medianValue, char reqLength, unsigned int intervals, 
 		unsigned char* pwrErrBoundBytes, size_t pwrErrBoundBytes_size, unsigned char radExpo);
 
+void new_TightDataPointStorageF_ts(TightDataPointStorageF **self, HuffmanTree** prevTree,
+		size_t dataSeriesLength, size_t exactDataNum,
+		int* type, unsigned char* exactMidBytes, size_t exactMidBytes_size,
+		unsigned char* leadNumIntArray,  //leadNumIntArray contains readable numbers....
+		unsigned char* resiMidBits, size_t resiMidBits_size,
+		unsigned char resiBitLength,
+		double realPrecision, float medianValue, char reqLength, unsigned int intervals);
+
 /**
  * This function is designed for first-version of the point-wise relative error bound (developed by Sheng Di for TPDS18 paper)
  * 
@@ -37,7 +37,7 @@ typedef struct TightDataPointStorageI
 	
 	unsigned int intervals; //quantization_intervals
 	
-	unsigned char isLossless; //a mark to denote whether it's lossless compression (1 is yes, 0 is no)
+	unsigned char isLossless; //a mark to denote whether it's lossless compression (0: no, SZ_LOSSLESS_RAW or SZ_LOSSLESS_INT_DELTA)
 
 } TightDataPointStorageI;
 
@@ -15,6 +15,7 @@ extern "C" {
 #endif
 
 #include <stdio.h>
+#include "Huffman.h"
 
 typedef struct sz_multisteps
 {
@@ -24,7 +25,13 @@ typedef struct sz_multisteps
 	unsigned int currentStep; //current time step of the execution/simulation
 	
 	//void* ori_data; //original data pointer, which serve as the key for retrieving hist_data
-	void* hist_data; //historical data in past time steps
+	void* hist_data; //historical data in past time steps, i.e., the reference step of the compression
+	void* hist_dec; //decompressed data of the step being compressed, which becomes hist_data once the step is committed
+	char hist_dec_used; //1 if the step being compressed has written its decompressed data into hist_dec
+	size_t hist_bytes; //size of hist_data and hist_dec
+	void* dec_hist_data; //reference step of the decompression side (allocated by the first decompression)
+	HuffmanTree* cmprHuffTree; //Huffman tree of the previous time-series compressed step (compression side)
+	HuffmanTree* decHuffTree; //Huffman tree of the previous time-series compressed step (decompression side)
 } sz_multisteps;
 
 typedef struct SZ_Variable
@@ -74,6 +81,11 @@ void free_VarSet_vset(SZ_VarSet *vset, int mode);
 void SZ_freeVarSet(int mode);
 
 void free_multisteps(sz_multisteps* multisteps);
+int init_multisteps_hist(sz_multisteps* multisteps, size_t histBytes);
+void begin_hist_step(sz_multisteps* multisteps);
+void commit_hist_step(sz_multisteps* multisteps);
+void* getHistDecBuffer(sz_multisteps* multisteps);
+void* getDecHistData(sz_multisteps* multisteps);
 int checkVarID(unsigned char cur_var_id, unsigned char* var_ids, int var_count);
 SZ_Variable* SZ_getVariable(int var_id);
 
@@ -55,6 +55,10 @@ double getRealPrecision_int(long valueRangeSize, int errBoundMode, double absErr
 void symTransform_8bytes(unsigned char data[8]);
 void symTransform_2bytes(unsigned char data[2]);
 void symTransform_4bytes(unsigned char data[4]);
+void symTransformArray_2bytes(unsigned char* dst, unsigned char* src, size_t nbEle);
+void symTransformArray_4bytes(unsigned char* dst, unsigned char* src, size_t nbEle);
+void symTransformArray_8bytes(unsigned char* dst, unsigned char* src, size_t nbEle);
+void copyArrayWithEndian(unsigned char* dst, unsigned char* src, size_t nbEle, int typeSize, int reverseEndian);
 
 void compressInt8Value(int8_t tgtValue, int8_t minValue, int byteSize, unsigned char* bytes);
 void compressInt16Value(int16_t tgtValue, int16_t minValue, int byteSize, unsigned char* bytes);
@@ -72,6 +72,18 @@
 #define SZ_NO_REGRESSION 0
 #define SZ_WITH_LINEAR_REGRESSION 1
 
+//sample of the block size selection of the blocked regression (optimize_regression_block_size_*)
+#define REG_SAMPLE_GRID_2D 4 //the 2D sample is a grid of 4*4 squares
+#define REG_SAMPLE_SIDE_2D 64 //side of a square of the 2D sample
+#define REG_SAMPLE_GRID_3D 3 //the 3D sample is a grid of 3*3*3 cubes
+#define REG_SAMPLE_SIDE_3D 24 //side of a cube of the 3D sample
+#define REG_SAMPLE_MIN_POINTS 16777216 //smaller data keep the default block size (the sample would cost more than about 10% of their compression)
+#define REG_SAMPLE_GAIN 0.85 //another block size replaces the default only if its sample is below 0.85 times the default's
+
+//lossless storage modes (the value of isLossless in the TightDataPointStorage)
+#define SZ_LOSSLESS_RAW 1 //original values stored as they are
+#define SZ_LOSSLESS_INT_DELTA 2 //integer values stored by Lorenzo delta + zigzag + byte planes (error bound < 1)
+
 #define SZ_PWR_MIN_TYPE 0
 #define SZ_PWR_AVG_TYPE 1
 #define SZ_PWR_MAX_TYPE 2
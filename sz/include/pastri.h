@@ -108,13 +108,24 @@ void SZ_pastriCompressBatch(pastri_params *p,unsigned char *originalBuf, unsigne
 //INPUTS: p, originalBuf
 //OUTPUTS: compressedBufP, compressedBytes
 //Using the inputs, compressedBufP is allocated and populated by the compressed data. Compressed size is written into compressedBytes.
-//Parameters are also stored at the beginning part of the compressedBuf
+//Parameters are also stored at the beginning part of the compressedBuf, followed by a format marker (magic and version)
+//and the compressed size of every block.
 
-void SZ_pastriDecompressBatch(unsigned char*compressedBuf, pastri_params *p, unsigned char** decompressedBufP ,size_t *decompressedBytes);
+int SZ_pastriDecompressBatch(unsigned char*compressedBuf, pastri_params *p, unsigned char** decompressedBufP ,size_t *decompressedBytes);
 //INPUTS: compressedBuf
 //OUTPUTS: p, decompressedBufP, decompressedBytes
 //First, parameters are read from compressedBuf and written into p.
 //Then, decompressedBufP is allocated and populated by the decompressed data. Decompressed size is written into decompressedBytes.
+//Returns 0, or -1 (with decompressedBufP set to NULL and decompressedBytes to 0) if the batch has an unsupported format version.
+
+int SZ_pastriDecompressBlocks(unsigned char*compressedBuf, pastri_params *p, int firstBlock, int numBlocks, unsigned char** decompressedBufP ,size_t *decompressedBytes);
+//INPUTS: compressedBuf, firstBlock, numBlocks
+//OUTPUTS: p, decompressedBufP, decompressedBytes
+//Same as SZ_pastriDecompressBatch, but only blocks [firstBlock, firstBlock+numBlocks) are decompressed.
+//The other blocks are skipped using the block size table of the compressed batch. The batches written without the
+//table (no format marker) are decoded serially.
+//Returns 0, or -1 (with decompressedBufP set to NULL and decompressedBytes to 0) if the batch has an unsupported format version
+//or the blocks are out of range.
 
 void SZ_pastriCheckBatch(pastri_params *p,unsigned char*originalBuf,unsigned char*decompressedBuf); 
 //INPUTS: p, originalBuf, decompressedBuf
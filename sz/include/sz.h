@@ -34,6 +34,7 @@
 #include "sz_uint16.h"
 #include "sz_uint32.h"
 #include "sz_uint64.h"
+#include "sz_int_lossless.h"
 #include "sz_float.h"
 #include "sz_double.h"
 #include "szd_int8.h"
@@ -59,6 +60,13 @@
 #include "MultiLevelCacheTable.h"
 #include "MultiLevelCacheTableWideInterval.h"
 #include "exafelSZ.h"
+#include "sz_registry.h"
+#include "sz_stats.h"
+#include "sz_estimate.h"
+#include "sz_auto.h"
+#include "sz_target.h"
+#include "sz_verify.h"
+#include "sz_progressive.h"
 
 #ifdef _WIN32
 #define PATH_SEPARATOR ';'
@@ -95,6 +103,8 @@ extern "C" {
         NUM_BLOCKS = COUNT / BLOCK_SIZE;       \
     }                                   \
 
+#define SZ_DOWNSAMPLE_BLOCK_SIZE 6 //block size of the downsampled decompression of the streams not entirely predicted by regression
+
 #define SZ_COMPUTE_2D_NUMBER_OF_BLOCKS( COUNT, NUM_BLOCKS, BLOCK_SIZE ) \
     if (COUNT <= BLOCK_SIZE){                   \
         NUM_BLOCKS = 1;             \
@@ -183,6 +193,7 @@ typedef struct sz_params
 	double dmin, dmax;
 	
 	int snapshotCmprStep; //perform single-snapshot-based compression if time_step == snapshotCmprStep
+	double huffTreeReuseTolerance; //time-series compression: reuse the previous step's Huffman tree if it costs at most this fraction more (0: never)
 	int predictionMode;
 
 	int accelerate_pw_rel_compression;
@@ -190,6 +201,7 @@ typedef struct sz_params
 	
 	int randomAccess;
 	int withRegression;
+	int regressionBlockSize; //block size of the blocked regression predictor (0: chosen by sampling the data of 16M points or more, otherwise 16 for 2D data and 6 for 3D data)
 	
 } sz_params;
 
@@ -273,6 +285,12 @@ unsigned char *SZ_compress(int dataType, void *data, size_t *outSize, size_t r5,
 unsigned char* SZ_compress_args(int dataType, void *data, size_t *outSize, int errBoundMode, double absErrBound, 
 double relBoundRatio, double pwrBoundRatio, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1);
 
+size_t SZ_compress_bound(int dataType, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1);
+
+int SZ_compress_args_to_buffer(int dataType, void *data, unsigned char* compressed_bytes, size_t capacity, size_t *outSize, 
+int errBoundMode, double absErrBound, double relBoundRatio, double pwrBoundRatio, 
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1);
+
 int SZ_compress_args2(int dataType, void *data, unsigned char* compressed_bytes, size_t *outSize, 
 int errBoundMode, double absErrBound, double relBoundRatio, double pwrBoundRatio, 
 size_t r5, size_t r4, size_t r3, size_t r2, size_t r1);
@@ -293,6 +311,8 @@ void SZ_Create_ParamsExe(sz_params** conf_params, sz_exedata** exe_params);
 
 void *SZ_decompress(int dataType, unsigned char *bytes, size_t byteLength, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1);
 size_t SZ_decompress_args(int dataType, unsigned char *bytes, size_t byteLength, void* decompressed_array, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1);
+void *SZ_decompress_downsampled(int dataType, unsigned char *bytes, size_t byteLength, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, 
+size_t *d3, size_t *d2, size_t *d1);
 
 sz_metadata* SZ_getMetadata(unsigned char* bytes);
 void SZ_printMetadata(sz_metadata* metadata);
@@ -321,6 +341,7 @@ void convertSZParamsToBytes(sz_params* params, unsigned char* result);
 void convertBytesToSZParams(unsigned char* bytes, sz_params* params);
 
 unsigned char* SZ_compress_customize(const char* appName, void* userPara, int dataType, void* data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, size_t *outSize, int *status);
+size_t SZ_compress_customize_bound(const char* appName, void* userPara, int dataType, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1);
 
 void* SZ_decompress_customize(const char* appName, void* userPara, int dataType, unsigned char* bytes, size_t byteLength, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, int* status);
 
@@ -0,0 +1,56 @@
+/**
+ *  @file sz_async.h
+ *  @date Oct, 2026
+ *  @brief Header file for the sz_async.c (asynchronous compression).
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#ifndef _SZ_ASYNC_H
+#define _SZ_ASYNC_H
+
+#include <stddef.h>
+#include "sz.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SZ_ASYNC_PENDING 1 //status of a job which is not done yet
+
+/**
+ * An asynchronous compression job: the input data and the compression parameters are copied
+ * when the job is submitted, so the caller can reuse its buffer right after SZ_compress_async().
+ * */
+typedef struct sz_async_job
+{
+	int dataType;
+	void* data; //private copy of the input data (released once the job is done)
+	size_t r5, r4, r3, r2, r1;
+	int errBoundMode;
+	double absErrBound;
+	double relBoundRatio;
+	double pwrBoundRatio;
+	sz_params params; //private copy of the compression parameters
+
+	size_t memBytes; //memory held by the job while it is pending
+	int status; //SZ_ASYNC_PENDING, SZ_SCES or SZ_NSCS
+	unsigned char* bytes; //compressed bytes
+	size_t outSize;
+	struct sz_async_job* next;
+} sz_async_job;
+
+typedef sz_async_job* sz_async_handle;
+
+int SZ_async_init(size_t maxPendingBytes);
+sz_async_handle SZ_compress_async(int dataType, void *data, int errBoundMode, double absErrBound,
+double relBoundRatio, double pwrBoundRatio, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1);
+int SZ_test(sz_async_handle handle);
+int SZ_wait(sz_async_handle handle, unsigned char** bytes, size_t* outSize);
+void SZ_async_finalize();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ----- #ifndef _SZ_ASYNC_H  ----- */
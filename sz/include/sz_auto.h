@@ -0,0 +1,48 @@
+/**
+ *  @file sz_auto.h
+ *  @date Oct, 2026
+ *  @brief Header file for the sz_auto.c (automatic selection of the compression mode per variable).
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#ifndef _SZ_AUTO_H
+#define _SZ_AUTO_H
+
+#include <stddef.h>
+#include "sz_estimate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//goals of the automatic mode selection
+#define SZ_AUTO_MAX_RATIO 0 //the highest ratio among the modes compressing at minThroughput at least
+#define SZ_AUTO_MAX_SPEED 1 //the highest throughput among the modes reaching minRatio at least
+
+#define SZ_AUTO_MAX_MODES 12
+
+/**
+ * What the automatic mode selection optimizes.
+ * When no mode meets the constraint, the mode closest to it is selected (the fastest one for SZ_AUTO_MAX_RATIO,
+ * the one with the highest ratio for SZ_AUTO_MAX_SPEED).
+ * */
+typedef struct sz_auto_objective
+{
+	int goal; //SZ_AUTO_MAX_RATIO or SZ_AUTO_MAX_SPEED
+	double minThroughput; //MB/s of input (SZ_AUTO_MAX_RATIO; 0: no constraint)
+	double minRatio; //compression ratio (SZ_AUTO_MAX_SPEED; 0: no constraint)
+	int retuneInterval; //select the mode of a variable again after this number of compressions (0: never)
+} sz_auto_objective;
+
+int SZ_autoSelectMode(const char* varName, int dataType, void* data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1,
+sz_auto_objective* objective, sz_mode* mode);
+unsigned char* SZ_compress_auto(const char* varName, int dataType, void* data, size_t* outSize,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, sz_auto_objective* objective);
+void SZ_autoClearModes(const char* varName);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ----- #ifndef _SZ_AUTO_H  ----- */
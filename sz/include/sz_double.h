@@ -88,8 +88,26 @@ size_t r1, size_t r2, size_t r3, size_t r4, size_t s1, size_t s2, size_t s3, siz
 
 unsigned int optimize_intervals_double_2D_with_freq_and_dense_pos(double *oriData, size_t r1, size_t r2, double realPrecision, double * dense_pos, double * max_freq, double * mean_freq);
 unsigned int optimize_intervals_double_3D_with_freq_and_dense_pos(double *oriData, size_t r1, size_t r2, size_t r3, double realPrecision, double * dense_pos, double * max_freq, double * mean_freq);
+void fit_block_regression_double_2D(double * data_pos, size_t current_blockcount_x, size_t current_blockcount_y, 
+size_t dim0_offset, size_t num_blocks, double * reg_params_pos);
+void fit_block_regression_double_3D(double * data_pos, size_t current_blockcount_x, size_t current_blockcount_y, size_t current_blockcount_z, 
+size_t dim0_offset, size_t dim1_offset, size_t num_blocks, double * reg_params_pos);
+unsigned char choose_block_predictor_double_2D(double * data_pos, size_t current_blockcount_x, size_t current_blockcount_y, 
+size_t dim0_offset, size_t num_blocks, double * reg_params_pos, double noise, unsigned char use_mean, double mean);
+unsigned char choose_block_predictor_double_3D(double * data_pos, size_t current_blockcount_x, size_t current_blockcount_y, size_t current_blockcount_z, 
+size_t dim0_offset, size_t dim1_offset, size_t num_blocks, double * reg_params_pos, double noise, unsigned char use_mean, double mean);
+void select_block_predictors_double_2D(double *oriData, size_t r1, size_t r2, size_t block_size, double * reg_params, 
+double noise, unsigned char use_mean, double mean, unsigned char * indicator);
+void select_block_predictors_double_3D(double *oriData, size_t r1, size_t r2, size_t r3, size_t block_size, double * reg_params, 
+double noise, unsigned char use_mean, double mean, unsigned char * indicator);
+void sample_blocked_regression_double_2D(double *oriData, size_t r1, size_t r2, size_t block_size, double realPrecision, 
+unsigned char use_mean, double dense_pos, double noise, double * mean, double * reg_params, unsigned char * indicator);
+void sample_blocked_regression_double_3D(double *oriData, size_t r1, size_t r2, size_t r3, size_t block_size, double realPrecision, 
+unsigned char use_mean, double dense_pos, double noise, double * mean, double * reg_params, unsigned char * indicator);
 unsigned char * SZ_compress_double_2D_MDQ_nonblocked_with_blocked_regression(double *oriData, size_t r1, size_t r2, double realPrecision, size_t * comp_size);
 unsigned char * SZ_compress_double_3D_MDQ_nonblocked_with_blocked_regression(double *oriData, size_t r1, size_t r2, size_t r3, double realPrecision, size_t * comp_size);
+size_t optimize_regression_block_size_double_2D(double *oriData, size_t r1, size_t r2, double realPrecision);
+size_t optimize_regression_block_size_double_3D(double *oriData, size_t r1, size_t r2, size_t r3, double realPrecision);
 
 
 #ifdef __cplusplus
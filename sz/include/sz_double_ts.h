@@ -14,10 +14,62 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+
+/**
+ * 3D Lorenzo prediction of d[i][j][k] (r2*r3 being the size of a slice), neighbors out of the domain are 0.
+ * */
+static inline double lorenzo_double_3D_ts(double* d, size_t r2, size_t r3, size_t i, size_t j, size_t k)
+{
+	size_t r23 = r2*r3, index = i*r23+j*r3+k;
+	double pred = 0;
+	if(k>0)
+		pred += d[index-1];
+	if(j>0)
+	{
+		pred += d[index-r3];
+		if(k>0)
+			pred -= d[index-r3-1];
+	}
+	if(i>0)
+	{
+		pred += d[index-r23];
+		if(k>0)
+			pred -= d[index-r23-1];
+		if(j>0)
+		{
+			pred -= d[index-r23-r3];
+			if(k>0)
+				pred += d[index-r23-r3-1];
+		}
+	}
+	return pred;
+}
+
+static inline double predict_double_3D_ts(int predictor, double* cur, double* pre, size_t r2, size_t r3, size_t i, size_t j, size_t k)
+{
+	size_t index = i*r2*r3+j*r3+k;
+	switch(predictor)
+	{
+	case TS_PRED_HYBRID:
+		return pre[index] + lorenzo_double_3D_ts(cur, r2, r3, i, j, k) - lorenzo_double_3D_ts(pre, r2, r3, i, j, k);
+	case TS_PRED_SPATIAL:
+		return lorenzo_double_3D_ts(cur, r2, r3, i, j, k);
+	default: //TS_PRED_TEMPORAL
+		return pre[index];
+	}
+}
+
+int select_ts_predictor_double_3D(double* cur, double* pre, size_t r2, size_t r3,
+size_t i0, size_t j0, size_t k0, size_t ie, size_t je, size_t ke);
+
 unsigned int optimize_intervals_double_1D_ts(double *oriData, size_t dataLength, double* preData, double realPrecision);
 
 TightDataPointStorageD* SZ_compress_double_1D_MDQ_ts(double *oriData, size_t dataLength, sz_multisteps* multisteps,
 double realPrecision, double valueRangeSize, double medianValue_d);
+TightDataPointStorageD* SZ_compress_double_2D_MDQ_ts(double *oriData, size_t r1, size_t r2, sz_multisteps* multisteps,
+double realPrecision, double valueRangeSize, double medianValue_d);
+TightDataPointStorageD* SZ_compress_double_3D_MDQ_ts(double *oriData, size_t r1, size_t r2, size_t r3, sz_multisteps* multisteps,
+double realPrecision, double valueRangeSize, double medianValue_d);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,63 @@
+/**
+ *  @file sz_estimate.h
+ *  @date Oct, 2026
+ *  @brief Header file for the sz_estimate.c (estimation of the compression ratio and time by sampling).
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#ifndef _SZ_ESTIMATE_H
+#define _SZ_ESTIMATE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct sz_params;
+
+/**
+ * The predicted outcome of SZ_compress() on a field, and the statistics it is derived from.
+ * */
+typedef struct sz_estimate
+{
+	size_t compressedSize; //predicted size of the compressed bytes
+	double compressionRatio; //predicted compression ratio
+	double bitRate; //predicted bits per value
+	double compressionTime; //predicted time of the compression (seconds)
+
+	double entropy; //Shannon entropy of the sampled quantization codes (bits per code)
+	double huffmanBitRate; //average Huffman code length of the sampled quantization codes (bits per code)
+	double losslessRatio; //predicted ratio of the lossless stage (1 in SZ_BEST_SPEED mode)
+	double unpredRatio; //fraction of the sampled points which are unpredictable
+	double regressionBlockFraction; //fraction of the sampled blocks predicted by regression
+	unsigned int intervals; //number of the quantization intervals
+
+	double sampleRatio; //fraction of the points which were sampled
+	double estimateTime; //time spent by SZ_estimate() (seconds)
+} sz_estimate;
+
+/**
+ * The settings of SZ_compress() which SZ_estimateModes() compares: they do not change the error bound, and the
+ * decompressor finds them in the compressed bytes.
+ * */
+typedef struct sz_mode
+{
+	int withRegression; //SZ_WITH_LINEAR_REGRESSION or SZ_NO_REGRESSION (Lorenzo only)
+	int szMode; //SZ_BEST_SPEED (no lossless stage) or SZ_BEST_COMPRESSION
+	int losslessCompressor; //ZSTD_COMPRESSOR or GZIP_COMPRESSOR
+	int gzipMode; //level of the lossless compressor
+} sz_mode;
+
+int SZ_estimate(int dataType, void *data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, struct sz_params *params, sz_estimate *estimate);
+int SZ_estimateModes(int dataType, void *data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, struct sz_params *params,
+sz_mode *modes, int modeCount, sz_estimate *estimates);
+int sz_estimate_with_range(int dataType, void *data, size_t r4, size_t r3, size_t r2, size_t r1, struct sz_params *params,
+double valueRangeSize, sz_estimate *estimate);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ----- #ifndef _SZ_ESTIMATE_H  ----- */
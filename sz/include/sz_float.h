@@ -141,8 +141,26 @@ size_t r1, size_t r2, size_t r3, size_t r4, size_t s1, size_t s2, size_t s3, siz
 unsigned int optimize_intervals_float_2D_with_freq_and_dense_pos(float *oriData, size_t r1, size_t r2, double realPrecision, float * dense_pos, float * max_freq, float * mean_freq);
 unsigned int optimize_intervals_float_3D_with_freq_and_dense_pos(float *oriData, size_t r1, size_t r2, size_t r3, double realPrecision, float * dense_pos, float * max_freq, float * mean_freq);
 
+void fit_block_regression_float_2D(float * data_pos, size_t current_blockcount_x, size_t current_blockcount_y, 
+size_t dim0_offset, size_t num_blocks, float * reg_params_pos);
+void fit_block_regression_float_3D(float * data_pos, size_t current_blockcount_x, size_t current_blockcount_y, size_t current_blockcount_z, 
+size_t dim0_offset, size_t dim1_offset, size_t num_blocks, float * reg_params_pos);
+unsigned char choose_block_predictor_float_2D(float * data_pos, size_t current_blockcount_x, size_t current_blockcount_y, 
+size_t dim0_offset, size_t num_blocks, float * reg_params_pos, float noise, unsigned char use_mean, float mean);
+unsigned char choose_block_predictor_float_3D(float * data_pos, size_t current_blockcount_x, size_t current_blockcount_y, size_t current_blockcount_z, 
+size_t dim0_offset, size_t dim1_offset, size_t num_blocks, float * reg_params_pos, float noise, unsigned char use_mean, float mean);
+void select_block_predictors_float_2D(float *oriData, size_t r1, size_t r2, size_t block_size, float * reg_params, 
+float noise, unsigned char use_mean, float mean, unsigned char * indicator);
+void select_block_predictors_float_3D(float *oriData, size_t r1, size_t r2, size_t r3, size_t block_size, float * reg_params, 
+float noise, unsigned char use_mean, float mean, unsigned char * indicator);
+void sample_blocked_regression_float_2D(float *oriData, size_t r1, size_t r2, size_t block_size, float realPrecision, 
+unsigned char use_mean, float dense_pos, float noise, float * mean, float * reg_params, unsigned char * indicator);
+void sample_blocked_regression_float_3D(float *oriData, size_t r1, size_t r2, size_t r3, size_t block_size, float realPrecision, 
+unsigned char use_mean, float dense_pos, float noise, float * mean, float * reg_params, unsigned char * indicator);
 unsigned char * SZ_compress_float_2D_MDQ_nonblocked_with_blocked_regression(float *oriData, size_t r1, size_t r2, float realPrecision, size_t * comp_size);
 unsigned char * SZ_compress_float_3D_MDQ_nonblocked_with_blocked_regression(float *oriData, size_t r1, size_t r2, size_t r3, float realPrecision, size_t * comp_size);
+size_t optimize_regression_block_size_float_2D(float *oriData, size_t r1, size_t r2, float realPrecision);
+size_t optimize_regression_block_size_float_3D(float *oriData, size_t r1, size_t r2, size_t r3, float realPrecision);
 unsigned char * SZ_compress_float_3D_MDQ_random_access_with_blocked_regression(float *oriData, size_t r1, size_t r2, size_t r3, double realPrecision, size_t * comp_size);
 unsigned char * SZ_compress_float_3D_MDQ_decompression_random_access_with_blocked_regression(float *oriData, size_t r1, size_t r2, size_t r3, double realPrecision, size_t * comp_size);
 #ifdef __cplusplus
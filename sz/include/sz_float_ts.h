@@ -14,10 +14,72 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+
+/**
+ * Predictors of the multi-dimensional time-series compression (compressionType == 2):
+ * TS_PRED_TEMPORAL uses the previous step, TS_PRED_HYBRID corrects the previous step with the
+ * spatial (Lorenzo) change of the current step, TS_PRED_SPATIAL is the Lorenzo predictor of the current step.
+ * */
+#define TS_PRED_TEMPORAL 0
+#define TS_PRED_HYBRID 1
+#define TS_PRED_SPATIAL 2
+
+/**
+ * 3D Lorenzo prediction of d[i][j][k] (r2*r3 being the size of a slice), neighbors out of the domain are 0.
+ * */
+static inline float lorenzo_float_3D_ts(float* d, size_t r2, size_t r3, size_t i, size_t j, size_t k)
+{
+	size_t r23 = r2*r3, index = i*r23+j*r3+k;
+	float pred = 0;
+	if(k>0)
+		pred += d[index-1];
+	if(j>0)
+	{
+		pred += d[index-r3];
+		if(k>0)
+			pred -= d[index-r3-1];
+	}
+	if(i>0)
+	{
+		pred += d[index-r23];
+		if(k>0)
+			pred -= d[index-r23-1];
+		if(j>0)
+		{
+			pred -= d[index-r23-r3];
+			if(k>0)
+				pred += d[index-r23-r3-1];
+		}
+	}
+	return pred;
+}
+
+static inline float predict_float_3D_ts(int predictor, float* cur, float* pre, size_t r2, size_t r3, size_t i, size_t j, size_t k)
+{
+	size_t index = i*r2*r3+j*r3+k;
+	switch(predictor)
+	{
+	case TS_PRED_HYBRID:
+		return pre[index] + lorenzo_float_3D_ts(cur, r2, r3, i, j, k) - lorenzo_float_3D_ts(pre, r2, r3, i, j, k);
+	case TS_PRED_SPATIAL:
+		return lorenzo_float_3D_ts(cur, r2, r3, i, j, k);
+	default: //TS_PRED_TEMPORAL
+		return pre[index];
+	}
+}
+
+void computeBlockSize_ts(size_t r1, size_t* b1, size_t* b2, size_t* b3);
+int select_ts_predictor_float_3D(float* cur, float* pre, size_t r2, size_t r3,
+size_t i0, size_t j0, size_t k0, size_t ie, size_t je, size_t ke);
+
 unsigned int optimize_intervals_float_1D_ts(float *oriData, size_t dataLength, float* preData, double realPrecision);
 
 TightDataPointStorageF* SZ_compress_float_1D_MDQ_ts(float *oriData, size_t dataLength, sz_multisteps* multisteps,
 double realPrecision, float valueRangeSize, float medianValue_f);
+TightDataPointStorageF* SZ_compress_float_2D_MDQ_ts(float *oriData, size_t r1, size_t r2, sz_multisteps* multisteps,
+double realPrecision, float valueRangeSize, float medianValue_f);
+TightDataPointStorageF* SZ_compress_float_3D_MDQ_ts(float *oriData, size_t r1, size_t r2, size_t r3, sz_multisteps* multisteps,
+double realPrecision, float valueRangeSize, float medianValue_f);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,33 @@
+/**
+ *  @file sz_int_lossless.h
+ *  @date Oct, 2026
+ *  @brief Header file for the sz_int_lossless.c.
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#ifndef _SZ_Int_Lossless_H
+#define _SZ_Int_Lossless_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+
+int getIntTypeSize(int dataType);
+void collapseIntDims_lossless(size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, size_t* n3, size_t* n2, size_t* n1);
+
+void encodeLosslessIntResiduals(void* oriData, int intSize, size_t r3, size_t r2, size_t r1, unsigned char* planes);
+void decodeLosslessIntResiduals(unsigned char* planes, int intSize, size_t r3, size_t r2, size_t r1, void* data);
+
+int SZ_compress_args_int_lossless(unsigned char** newByteData, void* oriData, int dataType,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, size_t *outSize);
+void decompressDataSeries_int_lossless(void* data, int dataType, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, unsigned char* planes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ----- #ifndef _SZ_Int_Lossless_H  ----- */
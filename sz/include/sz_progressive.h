@@ -0,0 +1,31 @@
+/**
+ *  @file sz_progressive.h
+ *  @date Oct, 2026
+ *  @brief Header file for the sz_progressive.c (progressive streams of layers at decreasing error bounds).
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#ifndef _SZ_PROGRESSIVE_H
+#define _SZ_PROGRESSIVE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SZ_PROGRESSIVE_MAX_LAYERS 16
+#define SZ_PROGRESSIVE_HEADER_SIZE(nbLayers) (1 + 16*(size_t)(nbLayers)) //number of layers, then error bound and size per layer
+
+unsigned char* SZ_compress_progressive(int dataType, void *data, size_t *outSize, double *errBounds, int nbLayers,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1);
+int SZ_progressiveInfo(unsigned char *bytes, size_t byteLength, int *nbLayers, double *errBounds, size_t *layerEnds);
+void *SZ_decompress_progressive(int dataType, unsigned char *bytes, size_t byteLength, int nbLayers, double *errBound,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ----- #ifndef _SZ_PROGRESSIVE_H  ----- */
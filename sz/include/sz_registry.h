@@ -0,0 +1,68 @@
+/**
+ *  @file sz_registry.h
+ *  @date Oct, 2026
+ *  @brief Header file for the sz_registry.c (registry of the compressors behind SZ_compress_customize).
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#ifndef _SZ_REGISTRY_H
+#define _SZ_REGISTRY_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SZ_MAX_COMPRESSORS 32
+
+//IDs of the built-in compressors (the IDs from SZ_CMPR_USER_ID to 255 are left to the users' compressors)
+#define SZ_CMPR_SZ 1
+#define SZ_CMPR_SZ14 2
+#define SZ_CMPR_TRANSPOSE 3
+#define SZ_CMPR_EXAFEL 4
+#define SZ_CMPR_USER_ID 128
+
+//capability flags
+#define SZ_CMPR_TYPE(dataType) (1<<(dataType)) //the compressor supports the data type (SZ_FLOAT, SZ_DOUBLE, ...)
+#define SZ_CMPR_ALL_TYPES 0x3FF
+#define SZ_CMPR_SZ_FORMAT 0x10000 //the compressed bytes are an SZ stream (SZ_decompress() can read them)
+
+//the bytes of SZ_compress_customize() start with the magic number and the ID of the compressor
+#define SZ_CMPR_MAGIC "SZCR"
+#define SZ_CMPR_MAGIC_LENGTH 4
+#define SZ_CMPR_HEADER_LENGTH 5
+
+/**
+ * A compressor behind SZ_compress_customize()/SZ_decompress_customize().
+ * userPara is the compressor-specific parameter (e.g., sz_params* for SZ, exafelSZ_params* for ExaFEL).
+ * bound can be NULL if the compressor cannot bound the size of its compressed bytes.
+ * compress_to_buffer (optional, used with bound) writes the compressed bytes into a buffer of 'capacity' bytes
+ * and returns SZ_SCES, so that SZ_compress_customize() writes them right after its header without moving them.
+ * */
+typedef struct sz_compressor
+{
+	const char* name;
+	const char* alias; //another name of the compressor, or NULL
+	int id; //1..255, recorded in the compressed bytes
+	int flags;
+	unsigned char* (*compress)(void* userPara, int dataType, void* data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, size_t *outSize, int *status);
+	void* (*decompress)(void* userPara, int dataType, unsigned char* bytes, size_t byteLength, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, int *status);
+	size_t (*bound)(void* userPara, int dataType, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1);
+	int (*compress_to_buffer)(void* userPara, int dataType, void* data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, unsigned char* bytes, size_t capacity, size_t *outSize);
+} sz_compressor;
+
+int SZ_registerCompressor(sz_compressor* compressor);
+sz_compressor* SZ_getCompressor(const char* cmprName);
+sz_compressor* SZ_getCompressorByID(int id);
+int SZ_getCompressorID(const char* cmprName);
+
+int SZ_hasCompressorHeader(unsigned char* bytes, size_t byteLength);
+void SZ_writeCompressorHeader(unsigned char* bytes, int id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ----- #ifndef _SZ_REGISTRY_H  ----- */
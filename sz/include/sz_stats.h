@@ -0,0 +1,65 @@
+/**
+ *  @file sz_stats.h
+ *  @date Oct, 2026
+ *  @brief Header file for the sz_stats.c (per-stage timing and counters of the compression).
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#ifndef _SZ_STATS_H
+#define _SZ_STATS_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The breakdown of the last compression (times in seconds, sizes in bytes).
+ * The stages which did not run in the last compression are left 0.
+ * */
+typedef struct sz_stats
+{
+	double totalTime;
+	double rangeTime; //value range and median
+	double intervalTime; //optimization of the number of quantization intervals
+	double predQuantTime; //prediction, quantization and the packing of the stream (the rest of the SZ stage)
+	double huffmanTime; //construction of the Huffman tree(s) and encoding
+	double losslessTime; //lossless stage (Zstd/Gzip)
+
+	size_t rawBytes; //input of the compression
+	size_t huffmanBytes; //Huffman-coded quantization codes (with the trees)
+	size_t huffmanTreeBytes; //serialized Huffman tree(s)
+	size_t szBytes; //output of the SZ stage, i.e., input of the lossless stage
+	size_t outBytes; //output of the compression
+
+	size_t unpredCount; //number of the unpredictable points
+	unsigned int intervals; //number of the quantization intervals
+	double regressionBlockFraction; //fraction of the blocks predicted by regression (0 without regression)
+} sz_stats;
+
+typedef void (*sz_stats_callback)(const sz_stats* stats, void* userData);
+
+extern int sz_stats_enabled;
+extern sz_stats sz_curStats;
+
+//the instrumentation is a test of sz_stats_enabled when the statistics are disabled
+#define SZ_STATS_BEGIN(t) double t = sz_stats_enabled ? sz_stats_time() : 0
+#define SZ_STATS_END(field, t) do { if(sz_stats_enabled) sz_curStats.field += sz_stats_time() - (t); } while(0)
+#define SZ_STATS_SET(field, value) do { if(sz_stats_enabled) sz_curStats.field = (value); } while(0)
+#define SZ_STATS_ADD(field, value) do { if(sz_stats_enabled) sz_curStats.field += (value); } while(0)
+
+void SZ_enableStats(int enable);
+int SZ_getStats(sz_stats* stats);
+void SZ_setStatsCallback(sz_stats_callback callback, void* userData);
+
+double sz_stats_time();
+void sz_stats_begin(size_t rawBytes);
+void sz_stats_end(double start, size_t outBytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ----- #ifndef _SZ_STATS_H  ----- */
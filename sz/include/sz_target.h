@@ -0,0 +1,29 @@
+/**
+ *  @file sz_target.h
+ *  @date Oct, 2026
+ *  @brief Header file for the sz_target.c (compression to a target size or ratio).
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#ifndef _SZ_TARGET_H
+#define _SZ_TARGET_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SZ_TARGET_MAX_ESTIMATES 12 //estimations of the search of the error bound
+
+unsigned char* SZ_compress_target_size(int dataType, void *data, size_t targetSize, size_t *outSize, double *absErrBound,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1);
+unsigned char* SZ_compress_target_ratio(int dataType, void *data, double targetRatio, size_t *outSize, double *absErrBound,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ----- #ifndef _SZ_TARGET_H  ----- */
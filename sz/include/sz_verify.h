@@ -0,0 +1,72 @@
+/**
+ *  @file sz_verify.h
+ *  @date Oct, 2026
+ *  @brief Header file for the sz_verify.c (decompression with the error statistics against the original data).
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#ifndef _SZ_VERIFY_H
+#define _SZ_VERIFY_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SZ_VERIFY_OMP_THRESHOLD 1048576 //smaller arrays are not worth spawning threads
+
+/**
+ * The errors of the decompressed data against the original data.
+ * */
+typedef struct sz_error_stats
+{
+	size_t count; //number of the values
+	double minValue; //minimum of the original data
+	double maxValue; //maximum of the original data
+	double valueRange; //maxValue - minValue
+	double maxAbsError; //max |decompressed - original|
+	double maxRelError; //maxAbsError / valueRange (0 for constant data)
+	double mse; //mean squared error
+	double rmse; //root mean squared error
+	double nrmse; //rmse / valueRange (0 for constant data)
+	double psnr; //20*log10(valueRange) - 10*log10(mse), in dB (infinite for lossless data, 0 for constant data with errors)
+} sz_error_stats;
+
+/**
+ * The errors accumulated during a verify-mode decompression (see SZ_decompress_verify()): the decoders add each row,
+ * plane or slab of blocks they complete, in the order of the array, while it is still in the cache.
+ * */
+typedef struct sz_verify_state
+{
+	void *oriData; //the original data (NULL: no verification in progress)
+	int dataType;
+	size_t count; //number of the values accumulated
+	double minValue, maxValue; //range of the original data
+	double maxAbsError;
+	double sumSquare; //sum of the squared errors
+} sz_verify_state;
+
+extern sz_verify_state sz_verifyState;
+
+#define SZ_VERIFY_CHUNK 4096 //values accumulated at once by the 1D decoders
+
+//the instrumentation of the decoders is a test of sz_verifyState.oriData when no verification is in progress
+#define SZ_VERIFY_ADD(decData, end) do { if(sz_verifyState.oriData != NULL) sz_verify_accumulate(decData, end); } while(0)
+//for the decoders whose values are transformed afterwards (the logarithms of PW_REL)
+#define SZ_VERIFY_SUSPEND(saved) void *saved = sz_verifyState.oriData; sz_verifyState.oriData = NULL
+#define SZ_VERIFY_RESUME(saved) sz_verifyState.oriData = (saved)
+
+void sz_verify_accumulate(void *decData, size_t end);
+int SZ_computeErrorStats(int dataType, void *oriData, void *decData, size_t nbEle, sz_error_stats *stats);
+void *SZ_decompress_verify(int dataType, unsigned char *bytes, size_t byteLength, void *oriData,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, sz_error_stats *stats);
+size_t SZ_decompress_args_verify(int dataType, unsigned char *bytes, size_t byteLength, void *decompressed_array, void *oriData,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, sz_error_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ----- #ifndef _SZ_VERIFY_H  ----- */
@@ -31,6 +31,10 @@ void getSnapshotData_double_3D(double** data, size_t r1, size_t r2, size_t r3, T
 void getSnapshotData_double_4D(double** data, size_t r1, size_t r2, size_t r3, size_t r4, TightDataPointStorageD* tdps, int errBoundMode, int compressionType, double* hist_data);
 void decompressDataSeries_double_2D_nonblocked_with_blocked_regression(double** data, size_t r1, size_t r2, unsigned char* comp_data, double* hist_data);
 void decompressDataSeries_double_3D_nonblocked_with_blocked_regression(double** data, size_t r1, size_t r2, size_t r3, unsigned char* comp_data, double* hist_data);
+int decompressDataSeries_double_3D_downsampled_with_blocked_regression(double** data, size_t r1, size_t r2, size_t r3, unsigned char* comp_data, 
+size_t* num_blocks_x, size_t* num_blocks_y, size_t* num_blocks_z);
+int SZ_decompress_args_downsampled_double(double** newData, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, 
+unsigned char* cmpBytes, size_t cmpSize, size_t* d3, size_t* d2, size_t* d1);
 
 size_t decompressDataSeries_double_3D_RA_block(double * data, double mean, size_t dim_0, size_t dim_1, size_t dim_2, size_t block_dim_0, size_t block_dim_1, size_t block_dim_2, double realPrecision, int * type, double * unpredictable_data);
 
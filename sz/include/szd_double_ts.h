@@ -17,6 +17,8 @@ extern "C" {
 #include "TightDataPointStorageD.h"
 
 void decompressDataSeries_double_1D_ts(double** data, size_t dataSeriesLength, double* hist_data, TightDataPointStorageD* tdps);
+void decompressDataSeries_double_2D_ts(double** data, size_t r1, size_t r2, double* hist_data, TightDataPointStorageD* tdps);
+void decompressDataSeries_double_3D_ts(double** data, size_t r1, size_t r2, size_t r3, double* hist_data, TightDataPointStorageD* tdps);
 
 #ifdef __cplusplus
 }
@@ -17,6 +17,8 @@ extern "C" {
 #include "TightDataPointStorageF.h"
 
 void decompressDataSeries_float_1D_ts(float** data, size_t dataSeriesLength, float* hist_data, TightDataPointStorageF* tdps);
+void decompressDataSeries_float_2D_ts(float** data, size_t r1, size_t r2, float* hist_data, TightDataPointStorageF* tdps);
+void decompressDataSeries_float_3D_ts(float** data, size_t r1, size_t r2, size_t r3, float* hist_data, TightDataPointStorageF* tdps);
 
 #ifdef __cplusplus
 }
@@ -74,6 +74,14 @@ void sz_decompress_d2_double_(unsigned char *bytes, size_t *byteLength, double *
 void sz_decompress_d3_double_(unsigned char *bytes, size_t *byteLength, double *data, size_t *r1, size_t *r2, size_t *r3);
 void sz_decompress_d4_double_(unsigned char *bytes, size_t *byteLength, double *data, size_t *r1, size_t *r2, size_t *r3, size_t *r4);
 void sz_decompress_d5_double_(unsigned char *bytes, size_t *byteLength, double *data, size_t *r1, size_t *r2, size_t *r3, size_t *r4, size_t *r5);
+void sz_compress_bound_float_(size_t *bound, size_t *r1, size_t *r2, size_t *r3, size_t *r4, size_t *r5);
+void sz_compress_buffer_float_(float* data, unsigned char *bytes, size_t *capacity, size_t *outSize, int *errBoundMode, float *absErrBound, float *relBoundRatio, 
+size_t *r1, size_t *r2, size_t *r3, size_t *r4, size_t *r5, int *ierr);
+void sz_decompress_buffer_float_(unsigned char *bytes, size_t *byteLength, float *data, size_t *r1, size_t *r2, size_t *r3, size_t *r4, size_t *r5, int *ierr);
+void sz_compress_bound_double_(size_t *bound, size_t *r1, size_t *r2, size_t *r3, size_t *r4, size_t *r5);
+void sz_compress_buffer_double_(double* data, unsigned char *bytes, size_t *capacity, size_t *outSize, int *errBoundMode, double *absErrBound, double *relBoundRatio, 
+size_t *r1, size_t *r2, size_t *r3, size_t *r4, size_t *r5, int *ierr);
+void sz_decompress_buffer_double_(unsigned char *bytes, size_t *byteLength, double *data, size_t *r1, size_t *r2, size_t *r3, size_t *r4, size_t *r5, int *ierr);
 
 void sz_batchaddVar_d1_float_(int var_id, char* varName, int *len, float* data, int *errBoundMode, float *absErrBound, float *relBoundRatio, size_t *r1);
 void sz_batchaddvar_d2_float_(int var_id, char* varName, int *len, float* data, int *errBoundMode, float *absErrBound, float *relBoundRatio, size_t *r1, size_t *r2);
@@ -33,6 +33,9 @@ float calculate_delta_t(size_t size);//sihuan added
 
 int is_lossless_compressed_data(unsigned char* compressedBytes, size_t cmpSize);
 unsigned long sz_lossless_compress(int losslessCompressor, int level, unsigned char* data, unsigned long dataLength, unsigned char** compressBytes);
+unsigned long sz_lossless_compress_to_buffer(int losslessCompressor, int level, unsigned char* data, unsigned long dataLength, unsigned char* compressBytes, unsigned long capacity);
+unsigned long sz_lossless_compress_bound(unsigned long dataLength);
+int sz_move_to_buffer(unsigned char** bytes, size_t outSize, unsigned char* userBytes, size_t capacity);
 unsigned long sz_lossless_decompress(int losslessCompressor, unsigned char* compressBytes, unsigned long cmpSize, unsigned char** oriData, unsigned long targetOriSize);
 unsigned long sz_lossless_decompress65536bytes(int losslessCompressor, unsigned char* compressBytes, unsigned long cmpSize, unsigned char** oriData);
 void* detransposeData(void* data, int dataType, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1);
@@ -575,245 +575,50 @@ inline int getRightMovingCode(int kMod8, int resiBitLength)
 
 short* convertByteDataToShortArray(unsigned char* bytes, size_t byteLength)
 {
-	lint16 ls;
-	size_t i, stateLength = byteLength/2;
+	size_t stateLength = byteLength/2;
 	short* states = (short*)malloc(stateLength*sizeof(short));
-	if(sysEndianType==dataEndianType)
-	{	
-		for(i=0;i<stateLength;i++)
-		{
-			ls.byte[0] = bytes[i*2];
-			ls.byte[1] = bytes[i*2+1];
-			states[i] = ls.svalue;
-		}
-	}
-	else
-	{
-		for(i=0;i<stateLength;i++)
-		{
-			ls.byte[0] = bytes[i*2+1];
-			ls.byte[1] = bytes[i*2];
-			states[i] = ls.svalue;
-		}		
-	}
+	copyArrayWithEndian((unsigned char*)states, bytes, stateLength, 2, sysEndianType!=dataEndianType);
 	return states;
 } 
 
 unsigned short* convertByteDataToUShortArray(unsigned char* bytes, size_t byteLength)
 {
-	lint16 ls;
-	size_t i, stateLength = byteLength/2;
+	size_t stateLength = byteLength/2;
 	unsigned short* states = (unsigned short*)malloc(stateLength*sizeof(unsigned short));
-	if(sysEndianType==dataEndianType)
-	{	
-		for(i=0;i<stateLength;i++)
-		{
-			ls.byte[0] = bytes[i*2];
-			ls.byte[1] = bytes[i*2+1];
-			states[i] = ls.usvalue;
-		}
-	}
-	else
-	{
-		for(i=0;i<stateLength;i++)
-		{
-			ls.byte[0] = bytes[i*2+1];
-			ls.byte[1] = bytes[i*2];
-			states[i] = ls.usvalue;
-		}		
-	}
+	copyArrayWithEndian((unsigned char*)states, bytes, stateLength, 2, sysEndianType!=dataEndianType);
 	return states;
 } 
 
 void convertShortArrayToBytes(short* states, size_t stateLength, unsigned char* bytes)
 {
-	lint16 ls;
-	size_t i;
-	if(sysEndianType==dataEndianType)
-	{
-		for(i=0;i<stateLength;i++)
-		{
-			ls.svalue = states[i];
-			bytes[i*2] = ls.byte[0];
-			bytes[i*2+1] = ls.byte[1];
-		}		
-	}
-	else
-	{
-		for(i=0;i<stateLength;i++)
-		{
-			ls.svalue = states[i];
-			bytes[i*2] = ls.byte[1];
-			bytes[i*2+1] = ls.byte[0];
-		}			
-	}
+	copyArrayWithEndian(bytes, (unsigned char*)states, stateLength, 2, sysEndianType!=dataEndianType);
 }
 
 void convertUShortArrayToBytes(unsigned short* states, size_t stateLength, unsigned char* bytes)
 {
-	lint16 ls;
-	size_t i;
-	if(sysEndianType==dataEndianType)
-	{
-		for(i=0;i<stateLength;i++)
-		{
-			ls.usvalue = states[i];
-			bytes[i*2] = ls.byte[0];
-			bytes[i*2+1] = ls.byte[1];
-		}		
-	}
-	else
-	{
-		for(i=0;i<stateLength;i++)
-		{
-			ls.usvalue = states[i];
-			bytes[i*2] = ls.byte[1];
-			bytes[i*2+1] = ls.byte[0];
-		}			
-	}
+	copyArrayWithEndian(bytes, (unsigned char*)states, stateLength, 2, sysEndianType!=dataEndianType);
 }
 
 void convertIntArrayToBytes(int* states, size_t stateLength, unsigned char* bytes)
 {
-	lint32 ls;
-	size_t index = 0;
-	size_t i;
-	if(sysEndianType==dataEndianType)
-	{
-		for(i=0;i<stateLength;i++)
-		{
-			index = i << 2; //==i*4
-			ls.ivalue = states[i];
-			bytes[index] = ls.byte[0];
-			bytes[index+1] = ls.byte[1];
-			bytes[index+2] = ls.byte[2];
-			bytes[index+3] = ls.byte[3];
-		}		
-	}
-	else
-	{
-		for(i=0;i<stateLength;i++)
-		{
-			index = i << 2; //==i*4
-			ls.ivalue = states[i];
-			bytes[index] = ls.byte[3];
-			bytes[index+1] = ls.byte[2];
-			bytes[index+2] = ls.byte[1];
-			bytes[index+3] = ls.byte[0];
-		}			
-	}
+	copyArrayWithEndian(bytes, (unsigned char*)states, stateLength, 4, sysEndianType!=dataEndianType);
 }
 
 void convertUIntArrayToBytes(unsigned int* states, size_t stateLength, unsigned char* bytes)
 {
-	lint32 ls;
-	size_t index = 0;
-	size_t i;
-	if(sysEndianType==dataEndianType)
-	{
-		for(i=0;i<stateLength;i++)
-		{
-			index = i << 2; //==i*4
-			ls.uivalue = states[i];
-			bytes[index] = ls.byte[0];
-			bytes[index+1] = ls.byte[1];
-			bytes[index+2] = ls.byte[2];
-			bytes[index+3] = ls.byte[3];
-		}		
-	}
-	else
-	{
-		for(i=0;i<stateLength;i++)
-		{
-			index = i << 2; //==i*4
-			ls.uivalue = states[i];
-			bytes[index] = ls.byte[3];
-			bytes[index+1] = ls.byte[2];
-			bytes[index+2] = ls.byte[1];
-			bytes[index+3] = ls.byte[0];
-		}			
-	}
+	copyArrayWithEndian(bytes, (unsigned char*)states, stateLength, 4, sysEndianType!=dataEndianType);
 }
 
 void convertLongArrayToBytes(int64_t* states, size_t stateLength, unsigned char* bytes)
 {
-	lint64 ls;
-	size_t index = 0;
-	size_t i;
-	if(sysEndianType==dataEndianType)
-	{
-		for(i=0;i<stateLength;i++)
-		{
-			index = i << 3; //==i*8
-			ls.lvalue = states[i];
-			bytes[index] = ls.byte[0];
-			bytes[index+1] = ls.byte[1];
-			bytes[index+2] = ls.byte[2];
-			bytes[index+3] = ls.byte[3];
-			bytes[index+4] = ls.byte[4];
-			bytes[index+5] = ls.byte[5];
-			bytes[index+6] = ls.byte[6];
-			bytes[index+7] = ls.byte[7];	
-		}		
-	}
-	else
-	{
-		for(i=0;i<stateLength;i++)
-		{
-			index = i << 3; //==i*8
-			ls.lvalue = states[i];
-			bytes[index] = ls.byte[7];
-			bytes[index+1] = ls.byte[6];
-			bytes[index+2] = ls.byte[5];
-			bytes[index+3] = ls.byte[4];
-			bytes[index+4] = ls.byte[3];
-			bytes[index+5] = ls.byte[2];
-			bytes[index+6] = ls.byte[1];
-			bytes[index+7] = ls.byte[0];	
-		}			
-	}
+	copyArrayWithEndian(bytes, (unsigned char*)states, stateLength, 8, sysEndianType!=dataEndianType);
 }
 
 void convertULongArrayToBytes(uint64_t* states, size_t stateLength, unsigned char* bytes)
 {
-	lint64 ls;
-	size_t index = 0;
-	size_t i;
-	if(sysEndianType==dataEndianType)
-	{
-		for(i=0;i<stateLength;i++)
-		{
-			index = i << 3; //==i*8
-			ls.ulvalue = states[i];
-			bytes[index] = ls.byte[0];
-			bytes[index+1] = ls.byte[1];
-			bytes[index+2] = ls.byte[2];
-			bytes[index+3] = ls.byte[3];
-			bytes[index+4] = ls.byte[4];
-			bytes[index+5] = ls.byte[5];
-			bytes[index+6] = ls.byte[6];
-			bytes[index+7] = ls.byte[7];			
-		}		
-	}
-	else
-	{
-		for(i=0;i<stateLength;i++)
-		{
-			index = i << 3; //==i*8
-			ls.ulvalue = states[i];
-			bytes[index] = ls.byte[7];
-			bytes[index+1] = ls.byte[6];
-			bytes[index+2] = ls.byte[5];
-			bytes[index+3] = ls.byte[4];
-			bytes[index+4] = ls.byte[3];
-			bytes[index+5] = ls.byte[2];
-			bytes[index+6] = ls.byte[1];
-			bytes[index+7] = ls.byte[0];	
-		}			
-	}
+	copyArrayWithEndian(bytes, (unsigned char*)states, stateLength, 8, sysEndianType!=dataEndianType);
 }
 
-
 inline size_t bytesToSize(unsigned char* bytes)
 {
 	size_t result = 0;
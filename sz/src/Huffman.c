@@ -10,6 +10,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include "Huffman.h"
 #include "sz.h"
 
@@ -778,6 +779,7 @@ void encode_withTree(HuffmanTree* huffmanTree, int *s, size_t length, unsigned c
 	size_t i; 
 	int nodeCount = 0;
 	unsigned char *treeBytes, buffer[4];
+	SZ_STATS_BEGIN(startTime);
 	
 	init(huffmanTree, s, length);
 	for (i = 0; i < huffmanTree->stateNum; i++)
@@ -796,6 +798,9 @@ void encode_withTree(HuffmanTree* huffmanTree, int *s, size_t length, unsigned c
 	size_t enCodeSize = 0;
 	encode(huffmanTree, s, length, *out+8+treeByteSize, &enCodeSize);
 	*outSize = 8+treeByteSize+enCodeSize;
+	SZ_STATS_END(huffmanTime, startTime);
+	SZ_STATS_ADD(huffmanBytes, *outSize);
+	SZ_STATS_ADD(huffmanTreeBytes, treeByteSize);
 }
 
 int encode_withTree_MSST19(HuffmanTree* huffmanTree, int *s, size_t length, unsigned char **out, size_t *outSize)
@@ -805,6 +810,7 @@ int encode_withTree_MSST19(HuffmanTree* huffmanTree, int *s, size_t length, unsi
 	size_t i;
 	int nodeCount = 0;
 	unsigned char *treeBytes, buffer[4];
+	SZ_STATS_BEGIN(startTime);
 
 	init(huffmanTree, s, length);
 
@@ -834,6 +840,9 @@ int encode_withTree_MSST19(HuffmanTree* huffmanTree, int *s, size_t length, unsi
 	//TimeDurationStart("encode", &clockPointEncode);
 	encode(huffmanTree, s, length, *out+8+treeByteSize, &enCodeSize);
 	*outSize = 8+treeByteSize+enCodeSize;
+	SZ_STATS_END(huffmanTime, startTime);
+	SZ_STATS_ADD(huffmanBytes, *outSize);
+	SZ_STATS_ADD(huffmanTreeBytes, treeByteSize);
 	//TimeDurationEnd(&clockPointEncode);
 	//unsigned short state[length];
 	//decode(*out+4+treeByteSize, enCodeSize, qqq[0], state);
@@ -898,6 +907,121 @@ void decode_withTree_MSST19(HuffmanTree* huffmanTree, unsigned char *s, size_t t
 	decode_MSST19(s+8+encodeStartIndex, targetLength, root, out, maxBits);
 }
 
+/**
+ * The number of bytes taken by a Huffman tree of nodeCount nodes in the compressed stream
+ * (see convert_HuffTree_to_bytes_anyStates)
+ * */
+static size_t huffTreeByteSize(int nodeCount)
+{
+	if(nodeCount<=256)
+		return 1+3*nodeCount*sizeof(unsigned char)+nodeCount*sizeof(unsigned int);
+	else if(nodeCount<=65536)
+		return 1+2*nodeCount*sizeof(unsigned short)+nodeCount*sizeof(unsigned char)+nodeCount*sizeof(unsigned int);
+	else
+		return 1+3*nodeCount*sizeof(unsigned int)+nodeCount*sizeof(unsigned char);
+}
+
+/**
+ * Huffman encoding for time-series based compression: consecutive time steps usually have almost the same
+ * distribution of quantization codes, so the tree of the previous step (*prevTree) is reused if its coding
+ * cost is at most (1+tolerance) times the estimated cost of a new tree (entropy of s plus the tree bytes).
+ * In that case neither a tree is built nor stored: nodeCount is written as 0 and the decompressor uses the
+ * tree of its previous step (see decode_withTree_ts). Otherwise a new tree is built, stored and kept in
+ * *prevTree for the next step.
+ *
+ * @param HuffmanTree** prevTree (input/output)
+ * @param int stateNum (input): 2*quantization_intervals
+ * @param double tolerance (input): 0 means that the tree is never reused
+ * */
+void encode_withTree_ts(HuffmanTree** prevTree, int stateNum, double tolerance, int *s, size_t length, unsigned char **out, size_t *outSize)
+{
+	size_t i;
+	unsigned char buffer[4];
+	HuffmanTree* huffmanTree = *prevTree;
+	SZ_STATS_BEGIN(startTime);
+	
+	if(tolerance > 0 && huffmanTree != NULL && huffmanTree->stateNum == (unsigned int)stateNum && length > 0)
+	{
+		int reuse = 1, symbolCount = 0;
+		double reuseBits = 0, newBits = 0;
+		size_t *freq = (size_t *)malloc(stateNum*sizeof(size_t));
+		memset(freq, 0, stateNum*sizeof(size_t));
+		for(i = 0;i < length;i++)
+			freq[s[i]]++;
+		for(i = 0;i < (size_t)stateNum;i++)
+		{
+			if(freq[i]==0)
+				continue;
+			if(huffmanTree->code[i]==NULL) //this code did not appear in the previous step
+			{
+				reuse = 0;
+				break;
+			}
+			symbolCount++;
+			reuseBits += (double)freq[i]*huffmanTree->cout[i];
+			newBits += freq[i]*log2((double)length/freq[i]);
+		}
+		free(freq);
+		if(reuse)
+		{
+			newBits += 8.0*huffTreeByteSize(symbolCount*2-1);
+			reuse = reuseBits <= newBits*(1+tolerance);
+		}
+		if(reuse)
+		{
+			*out = (unsigned char*)malloc(length*sizeof(int)+8);
+			intToBytes_bigEndian(buffer, 0); //nodeCount==0: reuse the tree of the previous step
+			memcpy(*out, buffer, 4);
+			intToBytes_bigEndian(buffer, huffmanTree->stateNum/2); //real number of intervals
+			memcpy(*out+4, buffer, 4);
+			size_t enCodeSize = 0;
+			encode(huffmanTree, s, length, *out+8, &enCodeSize);
+			*outSize = 8+enCodeSize;
+			SZ_STATS_END(huffmanTime, startTime);
+			SZ_STATS_ADD(huffmanBytes, *outSize);
+			return;
+		}
+	}
+	
+	if(huffmanTree != NULL)
+		SZ_ReleaseHuffman(huffmanTree);
+	huffmanTree = createHuffmanTree(stateNum);
+	encode_withTree(huffmanTree, s, length, out, outSize);
+	if(tolerance > 0)
+		*prevTree = huffmanTree;
+	else
+	{
+		SZ_ReleaseHuffman(huffmanTree);
+		*prevTree = NULL;
+	}
+}
+
+/**
+ * Decoding counterpart of encode_withTree_ts: the tree is either read from s or is the one kept in
+ * *prevTree from the previous step. The tree that was used is kept in *prevTree.
+ *
+ * @return SZ_SCES, or SZ_NSCS if s reuses a tree but there is no previous one
+ * */
+int decode_withTree_ts(HuffmanTree** prevTree, unsigned char *s, size_t targetLength, int *out)
+{
+	size_t nodeCount = bytesToInt_bigEndian(s);
+	if(nodeCount==0)
+	{
+		if(*prevTree==NULL)
+		{
+			printf("Error: the time step reuses the Huffman tree of the previous step, which has not been decompressed.\n");
+			return SZ_NSCS;
+		}
+		decode(s+8, targetLength, (*prevTree)->pool, out); //the root of a reconstructed tree is its first node
+		return SZ_SCES;
+	}
+	if(*prevTree != NULL)
+		SZ_ReleaseHuffman(*prevTree);
+	*prevTree = createHuffmanTree((nodeCount+1)/2);
+	decode_withTree(*prevTree, s, targetLength, out);
+	return SZ_SCES;
+}
+
 void SZ_ReleaseHuffman(HuffmanTree* huffmanTree)
 {
 	size_t i;
@@ -286,6 +286,8 @@ void new_TightDataPointStorageF(TightDataPointStorageF **this,
 
 	(*this)->dataSeriesLength = dataSeriesLength;
 	(*this)->exactDataNum = exactDataNum;
+	SZ_STATS_ADD(unpredCount, exactDataNum);
+	SZ_STATS_SET(intervals, intervals);
 
 	(*this)->rtypeArray = NULL;
 	(*this)->rtypeArray_size = 0;
@@ -319,6 +321,51 @@ void new_TightDataPointStorageF(TightDataPointStorageF **this,
 	(*this)->pwrErrBoundBytes_size = pwrErrBoundBytes_size;
 }
 
+/**
+ * Same as new_TightDataPointStorageF, for one step of the time-series based compression:
+ * the quantization codes are encoded by encode_withTree_ts, so the Huffman tree of the previous
+ * time step (*prevTree) is reused whenever it is (almost) as good as a new one.
+ * */
+void new_TightDataPointStorageF_ts(TightDataPointStorageF **this, HuffmanTree** prevTree,
+		size_t dataSeriesLength, size_t exactDataNum, 
+		int* type, unsigned char* exactMidBytes, size_t exactMidBytes_size,
+		unsigned char* leadNumIntArray,  //leadNumIntArray contains readable numbers....
+		unsigned char* resiMidBits, size_t resiMidBits_size,
+		unsigned char resiBitLength, 
+		double realPrecision, float medianValue, char reqLength, unsigned int intervals) {
+	
+	*this = (TightDataPointStorageF *)malloc(sizeof(TightDataPointStorageF));
+	(*this)->allSameData = 0;
+	(*this)->realPrecision = realPrecision;
+	(*this)->medianValue = medianValue;
+	(*this)->reqLength = reqLength;
+
+	(*this)->dataSeriesLength = dataSeriesLength;
+	(*this)->exactDataNum = exactDataNum;
+	SZ_STATS_ADD(unpredCount, exactDataNum);
+	SZ_STATS_SET(intervals, intervals);
+
+	(*this)->rtypeArray = NULL;
+	(*this)->rtypeArray_size = 0;
+
+	encode_withTree_ts(prevTree, 2*intervals, confparams_cpr->huffTreeReuseTolerance, type, dataSeriesLength, &(*this)->typeArray, &(*this)->typeArray_size);
+		
+	(*this)->exactMidBytes = exactMidBytes;
+	(*this)->exactMidBytes_size = exactMidBytes_size;
+
+	(*this)->leadNumArray_size = convertIntArray2ByteArray_fast_2b(leadNumIntArray, exactDataNum, &((*this)->leadNumArray));
+
+	(*this)->residualMidBits_size = convertIntArray2ByteArray_fast_dynamic(resiMidBits, resiBitLength, exactDataNum, &((*this)->residualMidBits));
+	
+	(*this)->intervals = intervals;
+	
+	(*this)->isLossless = 0;
+	
+	(*this)->pwrErrBoundBytes = NULL;
+	(*this)->radExpo = 0;
+	(*this)->pwrErrBoundBytes_size = 0;
+}
+
 void new_TightDataPointStorageF2(TightDataPointStorageF **this,
 		size_t dataSeriesLength, size_t exactDataNum, 
 		int* type, unsigned char* exactMidBytes, size_t exactMidBytes_size,
@@ -336,6 +383,8 @@ void new_TightDataPointStorageF2(TightDataPointStorageF **this,
 
 	(*this)->dataSeriesLength = dataSeriesLength;
 	(*this)->exactDataNum = exactDataNum;
+	SZ_STATS_ADD(unpredCount, exactDataNum);
+	SZ_STATS_SET(intervals, intervals);
 
 	(*this)->rtypeArray = NULL;
 	(*this)->rtypeArray_size = 0;
@@ -125,6 +125,8 @@ int new_TightDataPointStorageI_fromFlatBytes(TightDataPointStorageI **this, unsi
 	int dataByteSizeCode = (sameRByte & 0x0C)>>2;
 	convertDataTypeSizeCode(dataByteSizeCode); //in bytes
 	(*this)->isLossless = (sameRByte & 0x10)>>4;
+	if((*this)->isLossless==1 && (sameRByte & 0x20)) //0011,0000: delta-coded lossless integers
+		(*this)->isLossless = SZ_LOSSLESS_INT_DELTA;
 
 	exe_params->SZ_SIZE_TYPE = ((sameRByte & 0x40)>>6)==1?8:4;
 	int errorBoundMode = ABS;
@@ -153,7 +155,7 @@ int new_TightDataPointStorageI_fromFlatBytes(TightDataPointStorageI **this, unsi
 	for (i = 0; i < exe_params->SZ_SIZE_TYPE; i++)
 		dsLengthBytes[i] = flatBytes[index++];
 	(*this)->dataSeriesLength = bytesToSize(dsLengthBytes);// ST
-	if((*this)->isLossless==1)
+	if((*this)->isLossless) //SZ_LOSSLESS_RAW or SZ_LOSSLESS_INT_DELTA: no quantization header
 	{
 		//(*this)->exactMidBytes = flatBytes+8;
 		return errorBoundMode;
@@ -87,15 +87,9 @@ void SZ_batchAddVar(int var_id, char* varName, int dataType, void* data,
 	
 	size_t dataLen = computeDataLength(r5, r4, r3, r2, r1);
 	if(dataType==SZ_FLOAT)
-	{
-		var->multisteps->hist_data = (float*)malloc(sizeof(float)*dataLen);
-		memset(var->multisteps->hist_data, 0, sizeof(float)*dataLen);
-	}
+		init_multisteps_hist(var->multisteps, sizeof(float)*dataLen);
 	else if(dataType==SZ_DOUBLE)
-	{
-		var->multisteps->hist_data = (double*)malloc(sizeof(double)*dataLen);
-		memset(var->multisteps->hist_data, 0, sizeof(double)*dataLen);
-	}
+		init_multisteps_hist(var->multisteps, sizeof(double)*dataLen);
 	var->compressedBytes = NULL;
 	var->next = NULL;
 	
@@ -192,6 +186,7 @@ void* SZ_getVarData(char* varName, size_t *r5, size_t *r4, size_t *r3, size_t *r
 void SZ_freeVarSet(int mode)
 {
 	free_VarSet_vset(sz_varset, mode);
+	sz_varset = NULL;
 }
 
 //free_VarSet will completely destroy the SZ_VarSet, so don't do it until you really don't need it any more!
@@ -221,9 +216,73 @@ void free_multisteps(sz_multisteps* multisteps)
 {
 	if(multisteps->hist_data!=NULL)
 		free(multisteps->hist_data);
+	if(multisteps->hist_dec!=NULL)
+		free(multisteps->hist_dec);
+	if(multisteps->dec_hist_data!=NULL)
+		free(multisteps->dec_hist_data);
+	if(multisteps->cmprHuffTree!=NULL)
+		SZ_ReleaseHuffman(multisteps->cmprHuffTree);
+	if(multisteps->decHuffTree!=NULL)
+		SZ_ReleaseHuffman(multisteps->decHuffTree);
 	free(multisteps);
 }
 
+/**
+ * Allocate the reference step (all zeros) and the buffer of the step being compressed.
+ * */
+int init_multisteps_hist(sz_multisteps* multisteps, size_t histBytes)
+{
+	multisteps->hist_bytes = histBytes;
+	multisteps->hist_data = calloc(1, histBytes);
+	multisteps->hist_dec = malloc(histBytes);
+	return (multisteps->hist_data==NULL || multisteps->hist_dec==NULL) ? SZ_NSCS : SZ_SCES;
+}
+
+/**
+ * Start the compression of a step: the step reads hist_data and writes its decompressed data into hist_dec.
+ * */
+void begin_hist_step(sz_multisteps* multisteps)
+{
+	multisteps->hist_dec_used = 0;
+}
+
+/**
+ * Make the decompressed data of the step the new reference step by swapping the two buffers.
+ * If the compressor did not produce the decompressed data (e.g., regression-based or pw_rel
+ * snapshots), the reference step is kept as it is.
+ * */
+void commit_hist_step(sz_multisteps* multisteps)
+{
+	void* tmp;
+	if(!multisteps->hist_dec_used)
+		return;
+	tmp = multisteps->hist_data;
+	multisteps->hist_data = multisteps->hist_dec;
+	multisteps->hist_dec = tmp;
+	multisteps->hist_dec_used = 0;
+}
+
+/**
+ * The buffer receiving the decompressed data of the step being compressed, which is never the
+ * reference step, so the reference stays valid during the whole compression of the step.
+ * */
+void* getHistDecBuffer(sz_multisteps* multisteps)
+{
+	multisteps->hist_dec_used = 1;
+	return multisteps->hist_dec;
+}
+
+/**
+ * The reference step of the decompression side, which is kept apart from the compression side
+ * so that decompressing a step does not change the reference of the compressor.
+ * */
+void* getDecHistData(sz_multisteps* multisteps)
+{
+	if(multisteps->dec_hist_data==NULL)
+		multisteps->dec_hist_data = calloc(1, multisteps->hist_bytes);
+	return multisteps->dec_hist_data;
+}
+
 inline int checkVarID(unsigned char cur_var_id, unsigned char* var_ids, int var_count)
 {
 	int j = 0;
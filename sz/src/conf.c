@@ -128,8 +128,10 @@ int SZ_ReadConf(const char* sz_cfgFile) {
 		confparams_cpr->pwr_type = SZ_PWR_MIN_TYPE;
 		
 		confparams_cpr->snapshotCmprStep = 5;
+		confparams_cpr->huffTreeReuseTolerance = 0;
 		
 		confparams_cpr->withRegression = SZ_WITH_LINEAR_REGRESSION;
+		confparams_cpr->regressionBlockSize = 0; //0: default block size
 	
 		confparams_cpr->randomAccess = 0; //0: no random access , 1: support random access
 	
@@ -250,6 +252,13 @@ int SZ_ReadConf(const char* sz_cfgFile) {
 			confparams_cpr->withRegression = SZ_WITH_LINEAR_REGRESSION;
 		else
 			confparams_cpr->withRegression = SZ_NO_REGRESSION;
+		confparams_cpr->regressionBlockSize = (int)iniparser_getint(ini, "PARAMETER:regressionBlockSize", 0);
+		if(confparams_cpr->regressionBlockSize < 0 || confparams_cpr->regressionBlockSize == 1)
+		{
+			printf("[SZ] Error: regressionBlockSize must be 0 (default) or at least 2 (please check sz.config file)\n");
+			iniparser_freedict(ini);
+			return SZ_NSCS;
+		}
 		
 		modeBuf = iniparser_getstring(ini, "PARAMETER:gzipMode", "Gzip_BEST_SPEED");
 		if(modeBuf==NULL)
@@ -299,6 +308,13 @@ int SZ_ReadConf(const char* sz_cfgFile) {
 		
 		//TODO
 		confparams_cpr->snapshotCmprStep = (int)iniparser_getint(ini, "PARAMETER:snapshotCmprStep", 5);
+		confparams_cpr->huffTreeReuseTolerance = iniparser_getdouble(ini, "PARAMETER:huffTreeReuseTolerance", 0);
+		if(confparams_cpr->huffTreeReuseTolerance < 0)
+		{
+			printf("[SZ] Error: huffTreeReuseTolerance cannot be negative (please check sz.config file)\n");
+			iniparser_freedict(ini);
+			return SZ_NSCS;
+		}
 				
 		errBoundMode = iniparser_getstring(ini, "PARAMETER:errorBoundMode", NULL);
 		if(errBoundMode==NULL)
@@ -17,6 +17,9 @@
 #include "TightDataPointStorageD.h"
 #include "CompressElement.h"
 #include "dataCompression.h"
+#ifdef _OPENMP
+#include "omp.h"
+#endif
 
 int computeByteSizePerIntValue(long valueRangeSize)
 {
@@ -388,6 +391,112 @@ inline void symTransform_4bytes(unsigned char data[4])
 	data[2] = tmp;
 }
 
+#define SYM_TRANSFORM_OMP_BLOCK 65536 //elements per OpenMP task
+#define SYM_TRANSFORM_OMP_THRESHOLD 1048576 //smaller arrays are not worth spawning threads
+
+#if defined(__GNUC__)
+#define SZ_BSWAP16(x) __builtin_bswap16(x)
+#define SZ_BSWAP32(x) __builtin_bswap32(x)
+#define SZ_BSWAP64(x) __builtin_bswap64(x)
+#else
+#define SZ_BSWAP16(x) ((uint16_t)(((x) >> 8) | ((x) << 8)))
+#define SZ_BSWAP32(x) ((((x) & 0xFF000000u) >> 24) | (((x) & 0x00FF0000u) >> 8) | (((x) & 0x0000FF00u) << 8) | (((x) & 0x000000FFu) << 24))
+#define SZ_BSWAP64(x) (((uint64_t)SZ_BSWAP32((uint32_t)(x)) << 32) | (uint64_t)SZ_BSWAP32((uint32_t)((x) >> 32)))
+#endif
+
+/**
+ * byte-swap n elements of typeSize bytes from src to dst (dst may be equal to src, i.e., in place)
+ * */
+static void symTransformBlock(unsigned char* dst, unsigned char* src, size_t n, int typeSize)
+{
+	size_t i = 0, nbBytes = n*typeSize;
+	//the compiler vectorizes these loops by itself at -O3 (into pshufb when the target has SSSE3, e.g. -march=native)
+	if(typeSize==2)
+	{
+		uint16_t v;
+		for(;i<nbBytes;i+=2)
+		{
+			memcpy(&v, src+i, 2);
+			v = SZ_BSWAP16(v);
+			memcpy(dst+i, &v, 2);
+		}
+	}
+	else if(typeSize==4)
+	{
+		uint32_t v;
+		for(;i<nbBytes;i+=4)
+		{
+			memcpy(&v, src+i, 4);
+			v = SZ_BSWAP32(v);
+			memcpy(dst+i, &v, 4);
+		}
+	}
+	else
+	{
+		uint64_t v;
+		for(;i<nbBytes;i+=8)
+		{
+			memcpy(&v, src+i, 8);
+			v = SZ_BSWAP64(v);
+			memcpy(dst+i, &v, 8);
+		}
+	}
+}
+
+static void symTransformArray(unsigned char* dst, unsigned char* src, size_t nbEle, int typeSize)
+{
+#ifdef _OPENMP
+	if(nbEle >= SYM_TRANSFORM_OMP_THRESHOLD)
+	{
+		long long b, nbBlocks = (long long)((nbEle + SYM_TRANSFORM_OMP_BLOCK - 1)/SYM_TRANSFORM_OMP_BLOCK);
+		#pragma omp parallel for schedule(static)
+		for(b=0;b<nbBlocks;b++)
+		{
+			size_t start = (size_t)b*SYM_TRANSFORM_OMP_BLOCK;
+			size_t n = nbEle - start < SYM_TRANSFORM_OMP_BLOCK ? nbEle - start : SYM_TRANSFORM_OMP_BLOCK;
+			symTransformBlock(dst+start*typeSize, src+start*typeSize, n, typeSize);
+		}
+		return;
+	}
+#endif
+	symTransformBlock(dst, src, nbEle, typeSize);
+}
+
+/**
+ * Bulk versions of symTransform_2bytes/4bytes/8bytes: reverse the byte order of each of the nbEle elements of src 
+ * and store them in dst. dst can be the same as src (in-place conversion), but the two must not partially overlap.
+ * */
+void symTransformArray_2bytes(unsigned char* dst, unsigned char* src, size_t nbEle)
+{
+	symTransformArray(dst, src, nbEle, 2);
+}
+
+void symTransformArray_4bytes(unsigned char* dst, unsigned char* src, size_t nbEle)
+{
+	symTransformArray(dst, src, nbEle, 4);
+}
+
+void symTransformArray_8bytes(unsigned char* dst, unsigned char* src, size_t nbEle)
+{
+	symTransformArray(dst, src, nbEle, 8);
+}
+
+/**
+ * copy nbEle elements of typeSize bytes, reversing the byte order of each element if reverseEndian is not 0
+ * (a plain memcpy otherwise). The raw data stored in the compressed streams (lossless and unpredictable data)
+ * are in big-endian byte order, so they are read and written with reverseEndian set on the little-endian systems.
+ * */
+void copyArrayWithEndian(unsigned char* dst, unsigned char* src, size_t nbEle, int typeSize, int reverseEndian)
+{
+	if(!reverseEndian || typeSize==1)
+	{
+		if(dst!=src)
+			memcpy(dst, src, nbEle*typeSize);
+	}
+	else
+		symTransformArray(dst, src, nbEle, typeSize);
+}
+
 inline void compressInt8Value(int8_t tgtValue, int8_t minValue, int byteSize, unsigned char* bytes)
 {
 	uint8_t data = tgtValue - minValue;
@@ -2,7 +2,12 @@
 extern "C" {
 #endif
 
+#include <string.h>
+#include <assert.h>
 #include "sz.h"
+#ifdef _OPENMP
+#include "omp.h"
+#endif
 
 void exafelSZ_params_process(exafelSZ_params*pr, size_t panels, size_t rows, size_t cols){
   pr->binnedRows=(rows+pr->binSize-1)/pr->binSize;
@@ -79,6 +84,93 @@ static inline size_t calcIdx_2D(int i1, int i0, int size0){
   return i0+size0*i1;
 }
 
+//ROI bitmask helpers: one bit per pixel of a single event (panels x rows x cols).
+//NOTE: Unlike the uint8_t mask of the python scripts, a SET bit means the pixel IS in the ROI.
+#define EXAFELSZ_MASK_WORDS(n) (((n)+63)/64)
+#define EXAFELSZ_MASK_TEST(m,i) (((m)[(i)>>6]>>((i)&63))&1)
+#define EXAFELSZ_MASK_SET(m,i) ((m)[(i)>>6]|=((uint64_t)1<<((i)&63)))
+
+//The calibration panel part of the ROI mask is the same for every event, so it is built only once.
+static uint64_t* exafelSZ_buildCalibMask(exafelSZ_params *pr, size_t panels, size_t rows, size_t cols){
+  size_t panelSize=rows*cols;
+  size_t p,i;
+  uint64_t *calibMask=(uint64_t*)calloc(EXAFELSZ_MASK_WORDS(panels*panelSize),sizeof(uint64_t));
+  for(p=0;p<panels;p++)
+    for(i=0;i<panelSize;i++)
+      if(!pr->calibPanel[i])
+        EXAFELSZ_MASK_SET(calibMask,p*panelSize+i);
+  return calibMask;
+}
+
+//Peaks are stored as variable-length records per event: nPeaks(uint64_t) followed by nPeaks x (panel,row,col)(uint16_t x 3).
+//Returns the byte offset of each event's record (nEvents+1 entries, the last one is the total length).
+static uint64_t* exafelSZ_locatePeaks(uint8_t *peaks, size_t nEvents, uint64_t *nPeaksTotal){
+  uint64_t *peaksOffsets=(uint64_t*)malloc((nEvents+1)*sizeof(uint64_t));
+  uint64_t peaksBytePos=0;
+  size_t e;
+  *nPeaksTotal=0;
+  for(e=0;e<nEvents;e++){
+    uint64_t nPeaks=*(uint64_t*)(&peaks[peaksBytePos]);
+    peaksOffsets[e]=peaksBytePos;
+    peaksBytePos+=8+nPeaks*(2+2+2);
+    (*nPeaksTotal)+=nPeaks;
+  }
+  peaksOffsets[nEvents]=peaksBytePos;
+  return peaksOffsets;
+}
+
+//Build the ROI mask of one event (calibration panel + peaks) and return the number of ROI pixels in it.
+static size_t exafelSZ_buildEventMask(exafelSZ_params *pr, uint64_t *calibMask, uint8_t *eventPeaks,
+                                      size_t panels, size_t rows, size_t cols, uint64_t *roiMask){
+  size_t eventSize=panels*rows*cols;
+  size_t pk,ri,ci,i;
+  size_t roiCount=0;
+  uint64_t peaksBytePos=0;
+  
+  memcpy(roiMask,calibMask,EXAFELSZ_MASK_WORDS(eventSize)*sizeof(uint64_t));
+  
+  uint64_t nPeaks=*(uint64_t*)(&eventPeaks[peaksBytePos]);
+  peaksBytePos+=8;
+  for(pk=0;pk<nPeaks;pk++){
+    uint16_t p_=*(uint16_t*)(&eventPeaks[peaksBytePos]); //Panel for the current peak
+    peaksBytePos+=2;
+    uint16_t r_=*(uint16_t*)(&eventPeaks[peaksBytePos]); //Row for the current peak
+    peaksBytePos+=2;
+    uint16_t c_=*(uint16_t*)(&eventPeaks[peaksBytePos]); //Col for the current peak
+    peaksBytePos+=2;
+    
+    if(p_>=panels){
+      printf("ERROR: Peak coordinate out of bounds: Panel=%d, Valid range: 0,%d\n",(int)p_,(int)panels-1);
+      assert(0);
+    }
+    if(r_>=rows){
+      printf("ERROR: Peak coordinate out of bounds: Row=%d, Valid range: 0,%d\n",(int)r_,(int)rows-1);
+      assert(0);
+    }
+    if(c_>=cols){
+      printf("ERROR: Peak coordinate out of bounds: Col=%d, Valid range: 0,%d\n",(int)c_,(int)cols-1);
+      assert(0);
+    }
+    
+    //NOTE: ri and ci are unsigned (as in the original mask generation), so a peak closer than peakRadius
+    //      to the top/left edge does not mark anything. Compressor and decompressor must agree on this.
+    for(ri=r_-pr->peakRadius;ri<=r_+pr->peakRadius;ri++){  //ri: row index. Just a temporary variable.
+      for(ci=c_-pr->peakRadius;ci<=c_+pr->peakRadius;ci++){  //ci: column index. Just a temporary variable.
+        if(ri<rows && ci<cols){  //Check whether inside bounds or not
+          EXAFELSZ_MASK_SET(roiMask,calcIdx_3D(p_,ri,ci,rows,cols));
+        }
+      }
+    }
+  }
+  
+  for(i=0;i<EXAFELSZ_MASK_WORDS(eventSize);i++){
+    uint64_t word=roiMask[i];
+    for(;word;word&=word-1)
+      roiCount++;
+  }
+  return roiCount;
+}
+
 unsigned char * exafelSZ_Compress(void* _pr,
                        void* _origData,
                        size_t nEvents, size_t panels, size_t rows, size_t cols,
@@ -88,104 +180,59 @@ unsigned char * exafelSZ_Compress(void* _pr,
   exafelSZ_params *pr=(exafelSZ_params*)_pr;
   
   exafelSZ_params_process(pr, panels, rows, cols); 
-  exafelSZ_params_checkDecomp(pr, panels, rows, cols); 
+  exafelSZ_params_checkComp(pr, panels, rows, cols); 
   
-  uint8_t *roiM=(uint8_t*)malloc(nEvents*panels*rows*cols) ;
-  float *roiData=(float*)malloc(nEvents*panels*rows*cols*sizeof(float)) ;
-  float *binnedData=(float*)malloc(nEvents*panels*pr->binnedRows*pr->binnedCols*sizeof(float)) ;
-  //float *binnedData=(float*)malloc(nEvents*panels*rows*cols*sizeof(float)) ;
+  size_t eventSize=panels*rows*cols;
+  size_t binnedEventSize=panels*pr->binnedRows*pr->binnedCols;
+  float *binnedData=(float*)malloc(nEvents*binnedEventSize*sizeof(float)) ;
   
-  size_t e,p,r,c,pk,ri,ci,br,bc,roii,bi;
-  
-  //Generate the ROI mask: NOTE: 0 means affirmative in ROI mask! This comes from the python scripts!
-  //First, initialize with calibration panel:
-  for(e=0;e<nEvents;e++){ //Event
-    for(p=0;p<panels;p++){ //Panel
-      for(r=0;r<rows;r++){ //Row
-        for(c=0;c<cols;c++){ //Column
-          roiM[calcIdx_4D(e,p,r,c,panels,rows,cols)]=pr->calibPanel[calcIdx_2D(r,c,cols)];
-        }
-      }
-    }
-  }
-  uint64_t peaksBytePos=0; //Position in the peaks buffer
-  //Now process the peaks and generate the mask:
+  //Events are independent of each other: each one gets its own (bit-packed) ROI mask, which is rebuilt
+  //on the fly instead of keeping a mask or a copy of the ROI data for the whole batch.
+  uint64_t *calibMask=exafelSZ_buildCalibMask(pr, panels, rows, cols);
   uint64_t nPeaksTotal=0;  //Total number of peaks
-  for(e=0;e<nEvents;e++){ //Event
-    uint64_t nPeaks=*(uint64_t*)(&pr->peaks[peaksBytePos]);
-    peaksBytePos+=8;
-    //peaksBytePos+=8;//Skip the second one! This is due to the problem in Python.
-
-    nPeaksTotal+=nPeaks;
-    for(pk=0;pk<nPeaks;pk++){
-      uint16_t p_=*(uint16_t*)(&pr->peaks[peaksBytePos]); //Panel for the current peak
-      peaksBytePos+=2;
-      uint16_t r_=*(uint16_t*)(&pr->peaks[peaksBytePos]); //Row for the current peak
-      peaksBytePos+=2;
-      uint16_t c_=*(uint16_t*)(&pr->peaks[peaksBytePos]); //Col for the current peak
-      peaksBytePos+=2;
+  uint64_t *peaksOffsets=exafelSZ_locatePeaks(pr->peaks, nEvents, &nPeaksTotal);
+  uint64_t *roiOffsets=(uint64_t*)malloc((nEvents+1)*sizeof(uint64_t)); //roiOffsets[e]: index of the first ROI value of event e
+  long e;
+  
+  roiOffsets[0]=0;
+#ifdef _OPENMP
+  #pragma omp parallel
+#endif
+  {
+    uint64_t *roiMask=(uint64_t*)malloc(EXAFELSZ_MASK_WORDS(eventSize)*sizeof(uint64_t));
+#ifdef _OPENMP
+    #pragma omp for schedule(static)
+#endif
+    for(e=0;e<(long)nEvents;e++){ //Event
+      size_t p,r,c,br,bc;
+      float *eventData=&origData[e*eventSize];
+      float *eventBinned=&binnedData[e*binnedEventSize];
       
-      if(p_>=panels){
-        printf("ERROR: Peak coordinate out of bounds: Panel=%d, Valid range: 0,%d\n",(int)p_,(int)panels-1);
-        assert(0);
-      }
-      if(r_>=rows){
-        printf("ERROR: Peak coordinate out of bounds: Row=%d, Valid range: 0,%d\n",(int)r_,(int)rows-1);
-        assert(0);
-      }
-      if(c_>=cols){
-        printf("ERROR: Peak coordinate out of bounds: Col=%d, Valid range: 0,%d\n",(int)c_,(int)cols-1);
-        assert(0);
-      }
+      //Generate the ROI mask (calibration panel + peaks) and count the ROI pixels:
+      roiOffsets[e+1]=exafelSZ_buildEventMask(pr, calibMask, &pr->peaks[peaksOffsets[e]], panels, rows, cols, roiMask);
       
-      for(ri=r_-pr->peakRadius;ri<=r_+pr->peakRadius;ri++){  //ri: row index. Just a temporary variable.
-        for(ci=c_-pr->peakRadius;ci<=c_+pr->peakRadius;ci++){  //ci: column index. Just a temporary variable.
-          if(ri<rows && ci<cols){  //Check whether inside bounds or not
-            roiM[calcIdx_4D(e,p_,ri,ci,panels,rows,cols)]=0;
-          }
-        }
-      }
-    }
-  }
-  
-  //Save ROI:
-  uint64_t roiSavedCount=0;
-  for(e=0;e<nEvents;e++){ //Event
-    for(p=0;p<panels;p++){ //Panel
-      for(r=0;r<rows;r++){ //Row
-        for(c=0;c<cols;c++){ //Column
-          if(!roiM[calcIdx_4D(e,p,r,c,panels,rows,cols)]){
-            roiData[roiSavedCount]=origData[calcIdx_4D(e,p,r,c,panels,rows,cols)];
-            roiSavedCount++;
+      //Binning:
+      for(p=0;p<panels;p++){  //Panel
+        for(r=0;r<pr->binnedRows;r++){ //Row of the binnedData
+          for(c=0;c<pr->binnedCols;c++){ //Column of the binnedData
+            float sum=0;
+            int nPts=0;
+            for(br=0;br<pr->binSize;br++) //Bin Row (from origData)
+              for(bc=0;bc<pr->binSize;bc++) //Bin Column (from origData)
+                if(r*pr->binSize+br<rows && c*pr->binSize+bc<cols){
+                  sum+=eventData[calcIdx_3D(p,r*pr->binSize+br,c*pr->binSize+bc,rows,cols)];
+                  nPts++;
+                }
+            eventBinned[calcIdx_3D(p,r,c,pr->binnedRows,pr->binnedCols)]=sum/nPts;
           }
-          
-          //AMG: Replace ROI and RONI pixels with avg values!
-          
-        }
-      }
-    }
-  }
-  
-  //Binning:
-  for(e=0;e<nEvents;e++){ //Event
-    for(p=0;p<panels;p++){  //Panel
-      for(r=0;r<pr->binnedRows;r++){ //Row of the binnedData
-        for(c=0;c<pr->binnedCols;c++){ //Column of the binnedData
-          float sum=0;
-          int nPts=0;
-          for(br=0;br<pr->binSize;br++) //Bin Row (from origData)
-            for(bc=0;bc<pr->binSize;bc++) //Bin Column (from origData)
-              if(r*pr->binSize+br<rows && c*pr->binSize+bc<cols){
-                // cout<<p<<" "<<r<<" "<<c<<" "<<br<<" "<<bc<<" "<<r*pr->binSize+br<<" "<<c*pr->binSize+bc<<endl;
-                sum+=origData[calcIdx_4D(e,p,r*pr->binSize+br,c*pr->binSize+bc,panels,rows,cols)];
-                nPts++;
-              }
-          // cout<<"p:"<<p<<" r:"<<r<<" c:"<<c<<" nPts:"<<nPts<<endl;
-          binnedData[calcIdx_4D(e,p,r,c,panels,pr->binnedRows,pr->binnedCols)]=sum/nPts;
         }
       }
     }
+    free(roiMask);
   }
+  for(e=0;e<(long)nEvents;e++)
+    roiOffsets[e+1]+=roiOffsets[e];
+  uint64_t roiSavedCount=roiOffsets[nEvents];
 
   //Additional compression using SZ:    
   size_t szCompressedSize=0;
@@ -193,21 +240,19 @@ unsigned char * exafelSZ_Compress(void* _pr,
    
   switch(pr->szDim){
     case 1:
-      // szComp=sz_compress_3D(binnedData, 0, 0, nEvents * panels * pr->binnedRows * pr->binnedCols, pr->tolerance, szCompressedSize); //1D
       szComp=SZ_compress_args(SZ_FLOAT, binnedData, &szCompressedSize, ABS, pr->tolerance, 0, 0, 0, 0,0,0, nEvents * panels * pr->binnedRows * pr->binnedCols);
       break;
     case 2:
-      // szComp=sz_compress_3D(binnedData, 0, nEvents * panels * pr->binnedRows, pr->binnedCols, pr->tolerance, szCompressedSize); //2D
       szComp=SZ_compress_args(SZ_FLOAT, binnedData, &szCompressedSize, ABS, pr->tolerance, 0, 0, 0, 0,0, nEvents * panels * pr->binnedRows, pr->binnedCols);
       break;
     case 3:
-      // szComp=sz_compress_3D(binnedData, nEvents * panels, pr->binnedRows, pr->binnedCols, pr->tolerance, szCompressedSize); //3D
       szComp=SZ_compress_args(SZ_FLOAT, binnedData, &szCompressedSize, ABS, pr->tolerance, 0, 0, 0, 0, nEvents * panels, pr->binnedRows, pr->binnedCols);
       break;
     default:
       printf("ERROR: Wrong szDim : %d It must be 1,2 or 3.\n",(int)pr->szDim);
       assert(0);
   }
+  free(binnedData);
   
   /*      
   Compressed buffer format: (Types are indicated in parenthesis)
@@ -220,8 +265,7 @@ unsigned char * exafelSZ_Compress(void* _pr,
        }
     }
     WRITE: roiSavedCount  (uint64_t) (How many pixels there are in the ROI data.)
-       (roiSavedCount is the same # as # of 0's in ROI mask.) 
-       (NOTE:0 means affirmative in ROI mask!)
+       (roiSavedCount is the same # as # of pixels in the ROI mask.) 
     for(roii=0;roii<roiSavedCount;roii++){  (roii for "ROI data index")
       WRITE: ROI_data[roii]  (float, 32-bit)
     }
@@ -239,90 +283,60 @@ unsigned char * exafelSZ_Compress(void* _pr,
     szComp : szComp x 1 : szComp x (unsigned char)
   */
   (*compressedSize)=8+nEvents*8+nPeaksTotal*(2+2+2)+8+roiSavedCount*4+8+szCompressedSize;
-  //compressedBuffer=new uint8_t[(*compressedSize)];
   uint8_t * compressedBuffer=(uint8_t*)malloc(*compressedSize);
   uint64_t bytePos;
   
   bytePos=0;
-  //*(uint64_t*)(&compressedBuffer[bytePos])=nEvents;
-  //bytePos+=8;
   *(uint64_t*)(&compressedBuffer[bytePos])=nPeaksTotal;
   bytePos+=8;
-  // cout<<endl;
-  // cout<<"COMPRESS:"<<endl;
-  // cout<<"nPeaksTotal="<<nPeaksTotal<<endl;
-  // cout<<"bytePos="<<bytePos<<endl;
-  //printf("\nCOMPRESS:\n");
-  //printf("nPeaksTotal=%d\n",nPeaksTotal);
-  //printf("bytePos=%d\n",bytePos);
   
-  peaksBytePos=0;
-  for(e=0;e<nEvents;e++){
-    uint64_t nPeaks=*(uint64_t*)(&pr->peaks[peaksBytePos]);
-    peaksBytePos+=8;
-    //peaksBytePos+=8;//Skip the second one. This is due to the error in Python!
-    
-    *(uint64_t*)(&compressedBuffer[bytePos])=nPeaks;
-    bytePos+=8;
-    for(pk=0;pk<nPeaks;pk++){
-      *(uint16_t*)(&compressedBuffer[bytePos])=*(uint16_t*)(&pr->peaks[peaksBytePos]); //Panel for the current peak
-      bytePos+=2;
-      peaksBytePos+=2;
-      *(uint16_t*)(&compressedBuffer[bytePos])=*(uint16_t*)(&pr->peaks[peaksBytePos]); //Row for the current peak
-      bytePos+=2;
-      peaksBytePos+=2;      
-      *(uint16_t*)(&compressedBuffer[bytePos])=*(uint16_t*)(&pr->peaks[peaksBytePos]); //Column for the current peak
-      bytePos+=2;
-      peaksBytePos+=2;
-    }
-  }
-  // cout<<"peaks"<<endl;
-  // cout<<"bytePos="<<bytePos<<endl;
-  //printf("peaks\n");
-  //printf("bytePos=%d\n",bytePos);
+  //The peaks are stored exactly as they are given in pr->peaks:
+  memcpy(&compressedBuffer[bytePos],pr->peaks,peaksOffsets[nEvents]);
+  bytePos+=peaksOffsets[nEvents];
 
   *(uint64_t*)(&compressedBuffer[bytePos])=roiSavedCount;
   bytePos+=8;
-  // cout<<"roiSavedCount="<<roiSavedCount<<endl;
-  // cout<<"bytePos="<<bytePos<<endl;
-  // cout<<"roiData"<<endl;
-  //printf("roiSavedCount=%d\n",roiSavedCount);
-  //printf("bytePos=%d\n",bytePos);
-  //printf("roiData\n");
-  for(roii=0;roii<roiSavedCount;roii++){
-    *(float*)(&compressedBuffer[bytePos])=roiData[roii];
-    // cout<<roiData[roii]<<",";
-    bytePos+=4;
+  
+  //Save ROI: every event writes its own ROI pixels directly to its slot of the output.
+  uint8_t *roiBytes=&compressedBuffer[bytePos];
+#ifdef _OPENMP
+  #pragma omp parallel
+#endif
+  {
+    uint64_t *roiMask=(uint64_t*)malloc(EXAFELSZ_MASK_WORDS(eventSize)*sizeof(uint64_t));
+#ifdef _OPENMP
+    #pragma omp for schedule(static)
+#endif
+    for(e=0;e<(long)nEvents;e++){ //Event
+      size_t i;
+      float *eventData=&origData[e*eventSize];
+      uint8_t *eventRoi=&roiBytes[roiOffsets[e]*4];
+      
+      exafelSZ_buildEventMask(pr, calibMask, &pr->peaks[peaksOffsets[e]], panels, rows, cols, roiMask);
+      for(i=0;i<eventSize;i++)
+        if(EXAFELSZ_MASK_TEST(roiMask,i)){
+          memcpy(eventRoi,&eventData[i],4);
+          eventRoi+=4;
+        }
+    }
+    free(roiMask);
   }
-  // cout<<"bytePos="<<bytePos<<endl;
-  //printf("bytePos=%d\n",bytePos);
+  bytePos+=roiSavedCount*4;
+  
   *(uint64_t*)(&compressedBuffer[bytePos])=szCompressedSize;
   bytePos+=8;
-  // cout<<"szCompressedSize="<<szCompressedSize<<endl;
-  // cout<<"bytePos="<<bytePos<<endl;
-  //printf("szCompressedSize=%d\n",szCompressedSize);
-  //printf("bytePos=%d\n",bytePos);
-  for(bi=0;bi<szCompressedSize;bi++){  //bi for "byte index"
-    *(unsigned char*)(&compressedBuffer[bytePos])=szComp[bi];
-    bytePos+=1;
-  }
-  // cout<<"szComp"<<endl;
-  // cout<<"bytePos="<<bytePos<<endl;
-  //printf("szComp\n");
-  //printf("bytePos=%d\n",bytePos);
+  memcpy(&compressedBuffer[bytePos],szComp,szCompressedSize);
+  bytePos+=szCompressedSize;
   
   if(bytePos!=(*compressedSize)){
-    printf("ERROR: bytePos = %ld != %ld = compressedSize\n",(long)bytePos,(long)compressedSize);
+    printf("ERROR: bytePos = %ld != %ld = compressedSize\n",(long)bytePos,(long)(*compressedSize));
     assert(0);
   }
   
   free(szComp);
-  free(roiM);
-  free(roiData);
-  free(binnedData);
-  // delete [] roiM;
-  // delete [] roiData;
-  // delete [] binnedData;
+  free(calibMask);
+  free(peaksOffsets);
+  free(roiOffsets);
   
   return compressedBuffer;
 }
@@ -337,11 +351,9 @@ void* exafelSZ_Decompress(void *_pr,
   exafelSZ_params_process(pr, panels, rows, cols); 
   exafelSZ_params_checkDecomp(pr, panels, rows, cols); 
   
-  float *decompressedBuffer=(float*)malloc(nEvents*panels*rows*cols*sizeof(float));
-  
-  uint8_t *roiM=(uint8_t*)malloc(nEvents*panels*rows*cols);
-  size_t e,p,r,c,pk,ri,ci,br,bc;
-  
+  size_t eventSize=panels*rows*cols;
+  size_t binnedEventSize=panels*pr->binnedRows*pr->binnedCols;
+  float *decompressedBuffer=(float*)malloc(nEvents*eventSize*sizeof(float));
   
   /*
   Compressed Data Layout:
@@ -355,109 +367,53 @@ void* exafelSZ_Decompress(void *_pr,
   uint64_t bytePos=0;
   uint64_t nPeaksTotal=*(uint64_t*)(&compressedBuffer[bytePos]);
   bytePos += 8; 
-  // cout<<endl;
-  // cout<<"DECOMPRESS:"<<endl;
-  // cout<<"nPeaksTotal="<<nPeaksTotal<<endl;
-  // cout<<"bytePos="<<bytePos<<endl;
-  //printf("\nDECOMPRESS:\n");
-  //printf("nPeaksTotal=%d\n",nPeaksTotal);
-  //printf("bytePos=%d\n",bytePos);
   
   uint8_t *peaks=(uint8_t*)(&compressedBuffer[bytePos]);
   bytePos += (8 * nEvents + nPeaksTotal * 3 * 2);
-  // cout<<"peaks"<<endl;
-  // cout<<"bytePos="<<bytePos<<endl;
-  //printf("peaks\n");
-  //printf("bytePos=%d\n",bytePos);
   
   uint64_t roiSavedCount=*(uint64_t*)(&compressedBuffer[bytePos]);
   bytePos+=8;
-  // cout<<"roiSavedCount="<<roiSavedCount<<endl;
-  // cout<<"bytePos="<<bytePos<<endl;
-  //printf("roiSavedCount=%d\n",roiSavedCount);
-  //printf("bytePos=%d\n",bytePos);
   
-  // cout<<"roiData"<<endl;
-  float *roiData=(float*)(&compressedBuffer[bytePos]);
+  uint8_t *roiBytes=(uint8_t*)(&compressedBuffer[bytePos]);
   bytePos+=(roiSavedCount*4);
-  // for(uint64_t roii=0;roii<roiSavedCount;roii++){
-    // cout<<roiData[roii]<<",";
-  // }
-  // cout<<"bytePos="<<bytePos<<endl;
-  //printf("bytePos=%d\n",bytePos);
   
   uint64_t szCompressedSize=*(uint64_t*)(&compressedBuffer[bytePos]);
   bytePos+=8;
-  // cout<<"szCompressedSize="<<szCompressedSize<<endl;
-  // cout<<"bytePos="<<bytePos<<endl;
-  //printf("szCompressedSize=%d\n",szCompressedSize);
-  //printf("bytePos=%d\n",bytePos);
   
   unsigned char *szComp=(unsigned char*)(&compressedBuffer[bytePos]);
   bytePos+=szCompressedSize;
-  // cout<<"szComp"<<endl;
-  // cout<<"bytePos="<<bytePos<<endl;
-  // cout<<endl;
-  //printf("szComp\n");
-  //printf("bytePos=%d\n\n",bytePos);
   
   //We should have inputs ready by now. Now process them:
+  uint64_t *calibMask=exafelSZ_buildCalibMask(pr, panels, rows, cols);
+  uint64_t nPeaksCheck=0;
+  uint64_t *peaksOffsets=exafelSZ_locatePeaks(peaks, nEvents, &nPeaksCheck);
+  uint64_t *roiOffsets=(uint64_t*)malloc((nEvents+1)*sizeof(uint64_t));
+  long e;
   
-  //Generate the ROI mask: NOTE: 0 means affirmative in ROI mask! This comes from the python scripts!
-  //First, initialize with calibration panel:
-  for(e=0;e<nEvents;e++){ //Event
-    for(p=0;p<panels;p++){ //Panel
-      for(r=0;r<rows;r++){ //Row
-        for(c=0;c<cols;c++){ //Column
-          if(calcIdx_2D(r,c,cols)<0 ||calcIdx_2D(r,c,cols)>=rows*cols){
-            printf("ERROR: calcIdx_2D(r,c,cols) = calcIdx_2D(%d,%d,%d) = %d",(int)r,(int)c,(int)cols,(int)calcIdx_2D(r,c,cols));
-            printf("       is NOT in the correct range: [0,%ld]",(int)rows*cols-1);
-            assert(0);
-          }
-          if(calcIdx_4D(e,p,r,c,panels,rows,cols)<0 ||calcIdx_4D(e,p,r,c,panels,rows,cols)>=nEvents*panels*rows*cols){
-            printf("ERROR: calcIdx_4D(e,p,r,c,panels,rows,cols) = calcIdx_4D(%d,%d,%d,%d,%d,%d,%d) = %d",(int)e,(int)p,(int)r,(int)c,(int)panels,(int)rows,(int)cols,(int)calcIdx_4D(e,p,r,c,panels,rows,cols));
-            assert(0);
-          }
-          roiM[calcIdx_4D(e,p,r,c,panels,rows,cols)]=pr->calibPanel[calcIdx_2D(r,c,cols)];
-        }
-      }
-    }
+  if(nPeaksCheck!=nPeaksTotal){
+    printf("ERROR: nPeaksTotal = %ld does not match the peaks of the %ld events (%ld)\n",(long)nPeaksTotal,(long)nEvents,(long)nPeaksCheck);
+    assert(0);
   }
-  uint64_t peaksBytePos=0; //Position in the peaks buffer
-  //Now process the peaks and generate the mask:
-  for(e=0;e<nEvents;e++){ //Event
-    uint64_t nPeaks=*(uint64_t*)(&peaks[peaksBytePos]);
-    peaksBytePos+=8;
-    
-    for(pk=0;pk<nPeaks;pk++){
-      uint16_t p_=*(uint16_t*)(&peaks[peaksBytePos]); //Panel for the current peak
-      peaksBytePos+=2;
-      uint16_t r_=*(uint16_t*)(&peaks[peaksBytePos]); //Row for the current peak
-      peaksBytePos+=2;
-      uint16_t c_=*(uint16_t*)(&peaks[peaksBytePos]); //Col for the current peak
-      peaksBytePos+=2;
-      
-      if(p_<0 || p_>=panels){
-        printf("ERROR: Peak coordinate out of bounds: Panel=%d, Valid range: 0,%d\n",(int)p_,(int)panels-1);
-        assert(0);
-      }
-      if(r_<0 || r_>=rows){
-        printf("ERROR: Peak coordinate out of bounds: Row=%d, Valid range: 0,%d\n",(int)r_,(int)rows-1);
-        assert(0);
-      }
-      if(c_<0 || c_>=cols){
-        printf("ERROR: Peak coordinate out of bounds: Col=%d, Valid range: 0,%d\n",(int)c_,(int)cols-1);
-        assert(0);
-      }
-      
-      for(ri=r_-pr->peakRadius;ri<=r_+pr->peakRadius;ri++){  //ri: row index. Just a temporary variable.
-        for(ci=c_-pr->peakRadius;ci<=c_+pr->peakRadius;ci++){  //ci: column index. Just a temporary variable.
-          if(ri>=0 && ri<rows && ci>=0 && ci<cols){  //Check whether inside bounds or not
-            roiM[calcIdx_4D(e,p_,ri,ci,panels,rows,cols)]=0;
-          }
-        }
-      }
-    }
+  
+  //Count the ROI pixels of each event to know where its ROI data starts:
+  roiOffsets[0]=0;
+#ifdef _OPENMP
+  #pragma omp parallel
+#endif
+  {
+    uint64_t *roiMask=(uint64_t*)malloc(EXAFELSZ_MASK_WORDS(eventSize)*sizeof(uint64_t));
+#ifdef _OPENMP
+    #pragma omp for schedule(static)
+#endif
+    for(e=0;e<(long)nEvents;e++) //Event
+      roiOffsets[e+1]=exafelSZ_buildEventMask(pr, calibMask, &peaks[peaksOffsets[e]], panels, rows, cols, roiMask);
+    free(roiMask);
+  }
+  for(e=0;e<(long)nEvents;e++)
+    roiOffsets[e+1]+=roiOffsets[e];
+  if(roiOffsets[nEvents]!=roiSavedCount){
+    printf("ERROR: roiSavedCount = %ld != %ld = # of pixels in the ROI mask\n",(long)roiSavedCount,(long)roiOffsets[nEvents]);
+    assert(0);
   }
   
   //De-compress using SZ:
@@ -477,38 +433,44 @@ void* exafelSZ_Decompress(void *_pr,
       printf("ERROR: Wrong szDim : %d It must be 1,2 or 3.\n",(int)pr->szDim);
       assert(0);
   }
-  //szDecomp=(void*)malloc(nEvents*panels*rows*cols*sizeof(float));
-  
-  // double max_err = 0;
-  // for(int i=0; i<nEvents * panels * pr->binnedRows * pr->binnedCols; i++){
-    // double err = fabs(szDecomp[i]-binnedData[i]);
-    // if(err > max_err) max_err = err;
-  // }
-  // cout << "Max err = \t\t\t" << max_err << endl;
-  
 
-  //De-binning:
-  for(e=0;e<nEvents;e++)//Event
-    for(p=0;p<panels;p++)  //Panel
-      for(r=0;r<pr->binnedRows;r++) //Row of the binnedData
-        for(c=0;c<pr->binnedCols;c++) //Column of the binnedData
+#ifdef _OPENMP
+  #pragma omp parallel
+#endif
+  {
+    uint64_t *roiMask=(uint64_t*)malloc(EXAFELSZ_MASK_WORDS(eventSize)*sizeof(uint64_t));
+#ifdef _OPENMP
+    #pragma omp for schedule(static)
+#endif
+    for(e=0;e<(long)nEvents;e++){ //Event
+      size_t p,r,c,br,bc,i;
+      float *eventDecomp=&decompressedBuffer[e*eventSize];
+      float *eventBinned=&szDecomp[e*binnedEventSize];
+      uint8_t *eventRoi=&roiBytes[roiOffsets[e]*4];
+      
+      //De-binning:
+      for(p=0;p<panels;p++)  //Panel
+        for(r=0;r<pr->binnedRows;r++) //Row of the binnedData
+          for(c=0;c<pr->binnedCols;c++) //Column of the binnedData
             for(br=0;br<pr->binSize;br++) //Bin Row (from origData)
               for(bc=0;bc<pr->binSize;bc++) //Bin Column (from origData)
                 if(r*pr->binSize+br<rows && c*pr->binSize+bc<cols){
-                  decompressedBuffer[calcIdx_4D(e,p,r*pr->binSize+br,c*pr->binSize+bc,panels,rows,cols)] = szDecomp[calcIdx_4D(e,p,r,c,panels,pr->binnedRows,pr->binnedCols)];
+                  eventDecomp[calcIdx_3D(p,r*pr->binSize+br,c*pr->binSize+bc,rows,cols)] = eventBinned[calcIdx_3D(p,r,c,pr->binnedRows,pr->binnedCols)];
                 }
-  //Restore ROI:
-  uint64_t current=0;
-  for(e=0;e<nEvents;e++)//Event
-    for(p=0;p<panels;p++)  //Panel
-      for(r=0;r<rows;r++) //Row of the binnedData
-        for(c=0;c<cols;c++) //Column of the binnedData
-          if(!roiM[calcIdx_4D(e,p,r,c,panels,rows,cols)]){
-            decompressedBuffer[calcIdx_4D(e,p,r,c,panels,rows,cols)]=roiData[current];
-            current++;
-          }
-  // delete [] roiM;
-  free(roiM);
+      //Restore ROI:
+      exafelSZ_buildEventMask(pr, calibMask, &peaks[peaksOffsets[e]], panels, rows, cols, roiMask);
+      for(i=0;i<eventSize;i++)
+        if(EXAFELSZ_MASK_TEST(roiMask,i)){
+          memcpy(&eventDecomp[i],eventRoi,4);
+          eventRoi+=4;
+        }
+    }
+    free(roiMask);
+  }
+  
+  free(calibMask);
+  free(peaksOffsets);
+  free(roiOffsets);
   free(szDecomp);
   
   return ((void*)decompressedBuffer);
@@ -1,6 +1,9 @@
 #include "pastri.h"
 #include "pastriD.h"
 #include "pastriF.h"
+#ifdef _OPENMP
+#include "omp.h"
+#endif
 
 void SZ_pastriReadParameters(char paramsFilename[512],pastri_params *paramsPtr){
   FILE *paramsF;
@@ -30,49 +33,182 @@ void SZ_pastriPreprocessParameters(pastri_params *p){
   p->usedEb=p->originalEb*0.999;  //This is needed just to eliminate some rounding errors. It has almost no effect on compression rate/ratios.
 }
 
+//Compressed batch layout:
+//  pastri_params | magic "PSTB" | version (uint32_t) | blockBytes[numBlocks] (uint32_t) | block_0 | ... | block_(numBlocks-1)
+//The block size table makes every block addressable on its own, so the blocks can be compressed and
+//decompressed in parallel, and any range of blocks can be decompressed without touching the others.
+//Batches without the magic (written before the table was added) are pastri_params followed by the blocks,
+//and are decoded serially.
+#define PASTRI_BATCH_MAGIC "PSTB"
+#define PASTRI_BATCH_VERSION 1
+#define PASTRI_BATCH_MARKER_BYTES (4+sizeof(uint32_t))
+
+//Returns 1 if the batch has the block size table, 0 if it has no format marker, -1 if its version is not supported.
+static inline int pastri_hasBlockTable(unsigned char *compressedBuf){
+  uint32_t version;
+  if(memcmp(compressedBuf+sizeof(pastri_params), PASTRI_BATCH_MAGIC, 4)!=0)
+    return 0;
+  memcpy(&version, compressedBuf+sizeof(pastri_params)+4, sizeof(uint32_t));
+  if(version!=PASTRI_BATCH_VERSION){
+    printf("ERROR: Unsupported PaSTRI batch version %u.\n",version);
+    return -1;
+  }
+  return 1;
+}
+
+//Upper bound of the compressed size of one block (the "Uncompressed, NonSparse" mode is never exceeded).
+static inline size_t pastri_maxBlockBytes(pastri_params *p){
+  return (size_t)p->bSize*p->dataSize+p->dataSize;
+}
+
 void SZ_pastriCompressBatch(pastri_params *p,unsigned char *originalBuf, unsigned char** compressedBufP,size_t *compressedBytes){
-  (*compressedBufP) = (unsigned char*)calloc(p->numBlocks*p->bSize*p->dataSize,sizeof(char));
-  int bytes; //bytes for this block
-  int i;
-  size_t bytePos=0; //Current byte pos in the outBuf
+  size_t headerBytes=sizeof(pastri_params)+PASTRI_BATCH_MARKER_BYTES+(size_t)p->numBlocks*sizeof(uint32_t);
+  uint32_t version=PASTRI_BATCH_VERSION;
+  size_t blockBytes=(size_t)p->bSize*p->dataSize; //Uncompressed bytes per block
+  uint32_t *blockSizes;
+  size_t *chunkOffsets;
+  unsigned char **chunkBufs;
+  int nChunks=1;
+  long t;
   
+#ifdef _OPENMP
+  nChunks=4*omp_get_max_threads(); //A few chunks per thread, since the block sizes vary a lot
+#endif
+  if(nChunks>p->numBlocks)
+    nChunks=p->numBlocks>0?p->numBlocks:1;
+  
+  (*compressedBufP)=(unsigned char*)malloc(headerBytes);
   memcpy(*compressedBufP, p, sizeof(pastri_params));
-  bytePos+=sizeof(pastri_params);
+  memcpy((*compressedBufP)+sizeof(pastri_params), PASTRI_BATCH_MAGIC, 4);
+  memcpy((*compressedBufP)+sizeof(pastri_params)+4, &version, sizeof(uint32_t));
+  blockSizes=(uint32_t*)malloc(((size_t)p->numBlocks+1)*sizeof(uint32_t));
+  chunkOffsets=(size_t*)calloc(nChunks+1,sizeof(size_t));
+  chunkBufs=(unsigned char**)malloc(nChunks*sizeof(unsigned char*));
   
-  for(i=0;i<p->numBlocks;i++){
-    if(p->dataSize==8){
-      pastri_double_Compress(originalBuf + (i*p->bSize*p->dataSize),p,(*compressedBufP) + bytePos,&bytes);
-    }else if(p->dataSize==4){
-      pastri_float_Compress(originalBuf + (i*p->bSize*p->dataSize),p,(*compressedBufP) + bytePos,&bytes);
+  //Each chunk of consecutive blocks is compressed into its own buffer:
+#ifdef _OPENMP
+  #pragma omp parallel for schedule(dynamic)
+#endif
+  for(t=0;t<nChunks;t++){
+    int first=(int)((long)p->numBlocks*t/nChunks);
+    int last=(int)((long)p->numBlocks*(t+1)/nChunks);
+    int bytes; //bytes for this block
+    int i;
+    size_t bytePos=0; //Current byte pos in the chunk buffer
+    //writeBits_Fast needs a zero-initialized buffer and may touch up to 8 bytes beyond the last block.
+    chunkBufs[t]=(unsigned char*)calloc((last-first)*pastri_maxBlockBytes(p)+8,sizeof(char));
+    for(i=first;i<last;i++){
+      if(p->dataSize==8){
+        pastri_double_Compress(originalBuf + (i*blockBytes),p,chunkBufs[t] + bytePos,&bytes);
+      }else if(p->dataSize==4){
+        pastri_float_Compress(originalBuf + (i*blockBytes),p,chunkBufs[t] + bytePos,&bytes);
+      }
+      blockSizes[i]=bytes;
+      bytePos+=bytes;
     }
-    bytePos+=bytes;
-    //printf("bytes:%d\n",bytes);
+    chunkOffsets[t+1]=bytePos;
   }
-  *compressedBytes=bytePos;
+  
+  //Prefix sum of the chunk sizes gives the position of each chunk in the output:
+  for(t=0;t<nChunks;t++)
+    chunkOffsets[t+1]+=chunkOffsets[t];
+  *compressedBytes=headerBytes+chunkOffsets[nChunks];
+  (*compressedBufP)=(unsigned char*)realloc(*compressedBufP,*compressedBytes);
+  memcpy((*compressedBufP)+sizeof(pastri_params)+PASTRI_BATCH_MARKER_BYTES, blockSizes, (size_t)p->numBlocks*sizeof(uint32_t));
+  
+#ifdef _OPENMP
+  #pragma omp parallel for schedule(static)
+#endif
+  for(t=0;t<nChunks;t++){
+    memcpy((*compressedBufP)+headerBytes+chunkOffsets[t], chunkBufs[t], chunkOffsets[t+1]-chunkOffsets[t]);
+    free(chunkBufs[t]);
+  }
+  
+  free(chunkBufs);
+  free(chunkOffsets);
+  free(blockSizes);
   //printf("totalBytesWritten:%d\n",*compressedBytes);
 }
 
-void SZ_pastriDecompressBatch(unsigned char*compressedBuf, pastri_params *p, unsigned char** decompressedBufP ,size_t *decompressedBytes){
-  int bytePos=0; //Current byte pos in the outBuf 
+int SZ_pastriDecompressBatch(unsigned char*compressedBuf, pastri_params *p, unsigned char** decompressedBufP ,size_t *decompressedBytes){
   memcpy(p, compressedBuf, sizeof(pastri_params));
-  bytePos+=sizeof(pastri_params);	
-	
-  (*decompressedBufP) = (unsigned char*)malloc(p->numBlocks*p->bSize*p->dataSize*sizeof(char)); 
+  return SZ_pastriDecompressBlocks(compressedBuf, p, 0, p->numBlocks, decompressedBufP, decompressedBytes);
+}
+
+//Batches without the block size table: the blocks are decoded one after the other, as their positions are only
+//known once the previous blocks are decoded (the blocks before firstBlock are decoded into a scratch buffer).
+static void pastri_decompressBlocksSerial(unsigned char*compressedBuf, pastri_params *p, int firstBlock, int numBlocks, unsigned char** decompressedBufP){
+  size_t blockBytes=(size_t)p->bSize*p->dataSize;
+  size_t bytePos=sizeof(pastri_params);
+  unsigned char *scratch=(unsigned char*)malloc(blockBytes);
   int bytes; //bytes for this block
   int i;
   
-  for(i=0;i<p->numBlocks;i++){
+  (*decompressedBufP) = (unsigned char*)malloc((size_t)numBlocks*blockBytes*sizeof(char)); 
+  for(i=0;i<firstBlock+numBlocks;i++){
+    unsigned char *out=i<firstBlock?scratch:(*decompressedBufP)+((size_t)(i-firstBlock)*blockBytes);
+    if(p->dataSize==8){
+      pastri_double_Decompress(compressedBuf + bytePos,p->dataSize,p,out,&bytes);
+    }else if(p->dataSize==4){
+      pastri_float_Decompress(compressedBuf + bytePos,p->dataSize,p,out,&bytes);
+    }
+    bytePos+=bytes;
+  }
+  free(scratch);
+}
+
+int SZ_pastriDecompressBlocks(unsigned char*compressedBuf, pastri_params *p, int firstBlock, int numBlocks, unsigned char** decompressedBufP ,size_t *decompressedBytes){
+  int hasBlockTable;
+  memcpy(p, compressedBuf, sizeof(pastri_params));
+  (*decompressedBufP)=NULL;
+  *decompressedBytes=0;
+  if(firstBlock<0 || numBlocks<0 || firstBlock+numBlocks>p->numBlocks){
+    printf("ERROR: Blocks [%d,%d) are out of range. The batch has %d blocks.\n",firstBlock,firstBlock+numBlocks,p->numBlocks);
+    return -1;
+  }
+  hasBlockTable=pastri_hasBlockTable(compressedBuf);
+  if(hasBlockTable<0)
+    return -1;
+  
+  size_t blockBytes=(size_t)p->bSize*p->dataSize; //Decompressed bytes per block
+  
+  if(!hasBlockTable){
+    pastri_decompressBlocksSerial(compressedBuf, p, firstBlock, numBlocks, decompressedBufP);
+    *decompressedBytes=(size_t)numBlocks*blockBytes;
+    return 0;
+  }
+  
+  uint32_t *blockSizes=(uint32_t*)(compressedBuf+sizeof(pastri_params)+PASTRI_BATCH_MARKER_BYTES);
+  unsigned char *blockData=(unsigned char*)blockSizes+(size_t)p->numBlocks*sizeof(uint32_t);
+  size_t *blockOffsets=(size_t*)malloc(((size_t)numBlocks+1)*sizeof(size_t));
+  size_t bytePos=0;
+  long i;
+  
+  //Locate the requested blocks using the block size table:
+  for(i=0;i<firstBlock;i++)
+    bytePos+=blockSizes[i];
+  for(i=0;i<numBlocks;i++){
+    blockOffsets[i]=bytePos;
+    bytePos+=blockSizes[firstBlock+i];
+  }
+  blockOffsets[numBlocks]=bytePos;
+  
+  (*decompressedBufP) = (unsigned char*)malloc((size_t)numBlocks*blockBytes*sizeof(char)); 
+  
+#ifdef _OPENMP
+  #pragma omp parallel for schedule(dynamic,64)
+#endif
+  for(i=0;i<numBlocks;i++){
+    int bytes; //bytes for this block
     if(p->dataSize==8){
-      pastri_double_Decompress(compressedBuf + bytePos,p->dataSize,p,(*decompressedBufP) + (i*p->bSize*p->dataSize),&bytes);
+      pastri_double_Decompress(blockData + blockOffsets[i],p->dataSize,p,(*decompressedBufP) + (i*blockBytes),&bytes);
     }else if(p->dataSize==4){
-      pastri_float_Decompress(compressedBuf + bytePos,p->dataSize,p,(*decompressedBufP) + (i*p->bSize*p->dataSize),&bytes);
+      pastri_float_Decompress(blockData + blockOffsets[i],p->dataSize,p,(*decompressedBufP) + (i*blockBytes),&bytes);
     }
-          
-    bytePos += bytes;
-    //printf("bytes:%d\n",bytes);
   }
-  //printf("totalBytesRead:%d\n",bytePos);
-  *decompressedBytes=p->numBlocks*p->bSize*p->dataSize;
+  free(blockOffsets);
+  *decompressedBytes=(size_t)numBlocks*blockBytes;
+  return 0;
 }
 
 void SZ_pastriCheckBatch(pastri_params *p,unsigned char*originalBuf,unsigned char*decompressedBuf){        
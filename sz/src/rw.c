@@ -168,28 +168,17 @@ double *readDoubleData(char *srcFilePath, size_t *nbEle, int *status)
 	}
 	else
 	{
-		size_t i,j;
-		
 		size_t byteLength;
 		unsigned char* bytes = readByteData(srcFilePath, &byteLength, &state);
-		if(state==SZ_FERR)
+		if(state == SZ_FERR)
 		{
 			*status = SZ_FERR;
 			return NULL;
 		}
-		double *daBuf = (double *)malloc(byteLength);
 		*nbEle = byteLength/8;
-		
-		ldouble buf;
-		for(i = 0;i<*nbEle;i++)
-		{
-			j = i*8;
-			memcpy(buf.byte, bytes+j, 8);
-			symTransform_8bytes(buf.byte);
-			daBuf[i] = buf.value;
-		}
-		free(bytes);
-		return daBuf;
+		symTransformArray_8bytes(bytes, bytes, *nbEle); //in place
+		*status = SZ_SCES;
+		return (double*)bytes;
 	}
 }
 
@@ -213,8 +202,6 @@ int16_t *readInt16Data(char *srcFilePath, size_t *nbEle, int *status)
 	}
 	else
 	{
-		size_t i,j;
-
 		size_t byteLength;
 		unsigned char* bytes = readByteData(srcFilePath, &byteLength, &state);
 		if(state == SZ_FERR)
@@ -222,19 +209,10 @@ int16_t *readInt16Data(char *srcFilePath, size_t *nbEle, int *status)
 			*status = SZ_FERR;
 			return NULL;
 		}
-		int16_t *daBuf = (int16_t *)malloc(byteLength);
 		*nbEle = byteLength/2;
-
-		lint16 buf;
-		for(i = 0;i<*nbEle;i++)
-		{
-			j = i << 1;//*2
-			memcpy(buf.byte, bytes+j, 2);
-			symTransform_2bytes(buf.byte);
-			daBuf[i] = buf.svalue;
-		}
-		free(bytes);
-		return daBuf;
+		symTransformArray_2bytes(bytes, bytes, *nbEle); //in place
+		*status = SZ_SCES;
+		return (int16_t*)bytes;
 	}
 }
 
@@ -249,8 +227,6 @@ uint16_t *readUInt16Data(char *srcFilePath, size_t *nbEle, int *status)
 	}
 	else
 	{
-		size_t i,j;
-
 		size_t byteLength;
 		unsigned char* bytes = readByteData(srcFilePath, &byteLength, &state);
 		if(state == SZ_FERR)
@@ -258,19 +234,10 @@ uint16_t *readUInt16Data(char *srcFilePath, size_t *nbEle, int *status)
 			*status = SZ_FERR;
 			return NULL;
 		}
-		uint16_t *daBuf = (uint16_t *)malloc(byteLength);
 		*nbEle = byteLength/2;
-
-		lint16 buf;
-		for(i = 0;i<*nbEle;i++)
-		{
-			j = i << 1;//*2
-			memcpy(buf.byte, bytes+j, 2);
-			symTransform_2bytes(buf.byte);
-			daBuf[i] = buf.usvalue;
-		}
-		free(bytes);
-		return daBuf;
+		symTransformArray_2bytes(bytes, bytes, *nbEle); //in place
+		*status = SZ_SCES;
+		return (uint16_t*)bytes;
 	}
 }
 
@@ -285,8 +252,6 @@ int32_t *readInt32Data(char *srcFilePath, size_t *nbEle, int *status)
 	}
 	else
 	{
-		size_t i,j;
-
 		size_t byteLength;
 		unsigned char* bytes = readByteData(srcFilePath, &byteLength, &state);
 		if(state == SZ_FERR)
@@ -294,19 +259,10 @@ int32_t *readInt32Data(char *srcFilePath, size_t *nbEle, int *status)
 			*status = SZ_FERR;
 			return NULL;
 		}
-		int32_t *daBuf = (int32_t *)malloc(byteLength);
 		*nbEle = byteLength/4;
-
-		lint32 buf;
-		for(i = 0;i<*nbEle;i++)
-		{
-			j = i*4;
-			memcpy(buf.byte, bytes+j, 4);
-			symTransform_4bytes(buf.byte);
-			daBuf[i] = buf.ivalue;
-		}
-		free(bytes);
-		return daBuf;
+		symTransformArray_4bytes(bytes, bytes, *nbEle); //in place
+		*status = SZ_SCES;
+		return (int32_t*)bytes;
 	}
 }
 
@@ -321,8 +277,6 @@ uint32_t *readUInt32Data(char *srcFilePath, size_t *nbEle, int *status)
 	}
 	else
 	{
-		size_t i,j;
-
 		size_t byteLength;
 		unsigned char* bytes = readByteData(srcFilePath, &byteLength, &state);
 		if(state == SZ_FERR)
@@ -330,19 +284,10 @@ uint32_t *readUInt32Data(char *srcFilePath, size_t *nbEle, int *status)
 			*status = SZ_FERR;
 			return NULL;
 		}
-		uint32_t *daBuf = (uint32_t *)malloc(byteLength);
 		*nbEle = byteLength/4;
-
-		lint32 buf;
-		for(i = 0;i<*nbEle;i++)
-		{
-			j = i << 2; //*4
-			memcpy(buf.byte, bytes+j, 4);
-			symTransform_4bytes(buf.byte);
-			daBuf[i] = buf.uivalue;
-		}
-		free(bytes);
-		return daBuf;
+		symTransformArray_4bytes(bytes, bytes, *nbEle); //in place
+		*status = SZ_SCES;
+		return (uint32_t*)bytes;
 	}
 }
 
@@ -357,8 +302,6 @@ int64_t *readInt64Data(char *srcFilePath, size_t *nbEle, int *status)
 	}
 	else
 	{
-		size_t i,j;
-
 		size_t byteLength;
 		unsigned char* bytes = readByteData(srcFilePath, &byteLength, &state);
 		if(state == SZ_FERR)
@@ -366,19 +309,10 @@ int64_t *readInt64Data(char *srcFilePath, size_t *nbEle, int *status)
 			*status = SZ_FERR;
 			return NULL;
 		}
-		int64_t *daBuf = (int64_t *)malloc(byteLength);
 		*nbEle = byteLength/8;
-
-		lint64 buf;
-		for(i = 0;i<*nbEle;i++)
-		{
-			j = i << 3; //*8
-			memcpy(buf.byte, bytes+j, 8);
-			symTransform_8bytes(buf.byte);
-			daBuf[i] = buf.lvalue;
-		}
-		free(bytes);
-		return daBuf;
+		symTransformArray_8bytes(bytes, bytes, *nbEle); //in place
+		*status = SZ_SCES;
+		return (int64_t*)bytes;
 	}
 }
 
@@ -393,8 +327,6 @@ uint64_t *readUInt64Data(char *srcFilePath, size_t *nbEle, int *status)
 	}
 	else
 	{
-		size_t i,j;
-
 		size_t byteLength;
 		unsigned char* bytes = readByteData(srcFilePath, &byteLength, &state);
 		if(state == SZ_FERR)
@@ -402,19 +334,10 @@ uint64_t *readUInt64Data(char *srcFilePath, size_t *nbEle, int *status)
 			*status = SZ_FERR;
 			return NULL;
 		}
-		uint64_t *daBuf = (uint64_t *)malloc(byteLength);
 		*nbEle = byteLength/8;
-
-		lint64 buf;
-		for(i = 0;i<*nbEle;i++)
-		{
-			j = i << 3; //*8
-			memcpy(buf.byte, bytes+j, 8);
-			symTransform_8bytes(buf.byte);
-			daBuf[i] = buf.ulvalue;
-		}
-		free(bytes);
-		return daBuf;
+		symTransformArray_8bytes(bytes, bytes, *nbEle); //in place
+		*status = SZ_SCES;
+		return (uint64_t*)bytes;
 	}
 }
 
@@ -430,8 +353,6 @@ float *readFloatData(char *srcFilePath, size_t *nbEle, int *status)
 	}
 	else
 	{
-		size_t i,j;
-		
 		size_t byteLength;
 		unsigned char* bytes = readByteData(srcFilePath, &byteLength, &state);
 		if(state == SZ_FERR)
@@ -439,19 +360,10 @@ float *readFloatData(char *srcFilePath, size_t *nbEle, int *status)
 			*status = SZ_FERR;
 			return NULL;
 		}
-		float *daBuf = (float *)malloc(byteLength);
 		*nbEle = byteLength/4;
-		
-		lfloat buf;
-		for(i = 0;i<*nbEle;i++)
-		{
-			j = i*4;
-			memcpy(buf.byte, bytes+j, 4);
-			symTransform_4bytes(buf.byte);
-			daBuf[i] = buf.value;
-		}
-		free(bytes);
-		return daBuf;
+		symTransformArray_4bytes(bytes, bytes, *nbEle); //in place
+		*status = SZ_SCES;
+		return (float*)bytes;
 	}
 }
 
@@ -860,48 +772,18 @@ void writeData(void *data, int dataType, size_t nbEle, char *tgtFilePath, int *s
 
 void writeFloatData_inBytes(float *data, size_t nbEle, char* tgtFilePath, int *status)
 {
-	size_t i = 0; 
 	int state = SZ_SCES;
-	lfloat buf;
-	unsigned char* bytes = (unsigned char*)malloc(nbEle*sizeof(float));
-	for(i=0;i<nbEle;i++)
-	{
-		buf.value = data[i];
-		bytes[i*4+0] = buf.byte[0];
-		bytes[i*4+1] = buf.byte[1];
-		bytes[i*4+2] = buf.byte[2];
-		bytes[i*4+3] = buf.byte[3];					
-	}
-
+	//the bytes are written in the system's byte order, so there is nothing to convert
 	size_t byteLength = nbEle*sizeof(float);
-	writeByteData(bytes, byteLength, tgtFilePath, &state);
-	free(bytes);
+	writeByteData((unsigned char*)data, byteLength, tgtFilePath, &state);
 	*status = state;
 }
 
 void writeDoubleData_inBytes(double *data, size_t nbEle, char* tgtFilePath, int *status)
 {
-	size_t i = 0, index = 0; 
 	int state = SZ_SCES;
-	ldouble buf;
-	unsigned char* bytes = (unsigned char*)malloc(nbEle*sizeof(double));
-	for(i=0;i<nbEle;i++)
-	{
-		index = i*8;
-		buf.value = data[i];
-		bytes[index+0] = buf.byte[0];
-		bytes[index+1] = buf.byte[1];
-		bytes[index+2] = buf.byte[2];
-		bytes[index+3] = buf.byte[3];
-		bytes[index+4] = buf.byte[4];
-		bytes[index+5] = buf.byte[5];
-		bytes[index+6] = buf.byte[6];
-		bytes[index+7] = buf.byte[7];
-	}
-
 	size_t byteLength = nbEle*sizeof(double);
-	writeByteData(bytes, byteLength, tgtFilePath, &state);
-	free(bytes);
+	writeByteData((unsigned char*)data, byteLength, tgtFilePath, &state);
 	*status = state;
 }
 
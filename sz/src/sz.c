@@ -24,6 +24,7 @@
 #include "conf.h"
 #include "utility.h"
 #include "exafelSZ.h"
+#include "sz_async.h"
 //#include "CurveFillingCompressStorage.h"
 
 int versionNumber[4] = {SZ_VER_MAJOR,SZ_VER_MINOR,SZ_VER_BUILD,SZ_VER_REVISION};
@@ -87,6 +88,18 @@ int SZ_Init_Params(sz_params *params)
 		return SZ_NSCS;
 	}
 
+	if(params->regressionBlockSize < 0 || params->regressionBlockSize == 1)
+	{
+		printf("Error: regressionBlockSize must be 0 (default) or at least 2!\n");
+		return SZ_NSCS;
+	}
+
+	if(params->huffTreeReuseTolerance < 0)
+	{
+		printf("Error: huffTreeReuseTolerance cannot be negative!\n");
+		return SZ_NSCS;
+	}
+
 	return SZ_SCES;
 }
 
@@ -150,17 +163,10 @@ size_t computeDataLength(size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
 	return dataLength;
 }
 
-/*-------------------------------------------------------------------------*/
 /**
-    @brief      Perform Compression 
-    @param      data           data to be compressed
-    @param      outSize        the size (in bytes) after compression
-    @param		r5,r4,r3,r2,r1	the sizes of each dimension (supporting only 5 dimensions at most in this version.
-    @return     compressed data (in binary stream) or NULL(0) if any errors
-
- **/
-/*-------------------------------------------------------------------------*/
-unsigned char* SZ_compress_args(int dataType, void *data, size_t *outSize, int errBoundMode, double absErrBound, 
+ * userBytes: the caller's buffer (of *outSize bytes) receiving the compressed float or double data, or NULL
+ * */
+static unsigned char* compressData(int dataType, void *data, unsigned char* userBytes, size_t *outSize, int errBoundMode, double absErrBound, 
 double relBoundRatio, double pwrBoundRatio, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
 {
 	if(confparams_cpr == NULL)
@@ -180,7 +186,7 @@ double relBoundRatio, double pwrBoundRatio, size_t r5, size_t r4, size_t r3, siz
 	confparams_cpr->dataType = dataType;
 	if(dataType==SZ_FLOAT)
 	{
-		unsigned char *newByteData = NULL;
+		unsigned char *newByteData = userBytes;
 		
 		SZ_compress_args_float(-1, &newByteData, (float *)data, r5, r4, r3, r2, r1, 
 		outSize, errBoundMode, absErrBound, relBoundRatio, pwrBoundRatio);
@@ -189,7 +195,7 @@ double relBoundRatio, double pwrBoundRatio, size_t r5, size_t r4, size_t r3, siz
 	}
 	else if(dataType==SZ_DOUBLE)
 	{
-		unsigned char *newByteData;
+		unsigned char *newByteData = userBytes;
 		SZ_compress_args_double(-1, &newByteData, (double *)data, r5, r4, r3, r2, r1, 
 		outSize, errBoundMode, absErrBound, relBoundRatio, pwrBoundRatio);
 		
@@ -250,6 +256,71 @@ double relBoundRatio, double pwrBoundRatio, size_t r5, size_t r4, size_t r3, siz
 	}
 }
 
+/**
+ * compressData() with the statistics of the compression (see SZ_enableStats())
+ * */
+static unsigned char* compressArgs(int dataType, void *data, unsigned char* userBytes, size_t *outSize, int errBoundMode, double absErrBound, 
+double relBoundRatio, double pwrBoundRatio, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	if(!sz_stats_enabled)
+		return compressData(dataType, data, userBytes, outSize, errBoundMode, absErrBound, relBoundRatio, pwrBoundRatio, r5, r4, r3, r2, r1);
+	
+	size_t typeSize = dataType==SZ_DOUBLE ? sizeof(double) : (dataType==SZ_FLOAT ? sizeof(float) : (size_t)getIntTypeSize(dataType));
+	double startTime = sz_stats_time();
+	sz_stats_begin(computeDataLength(r5,r4,r3,r2,r1)*typeSize);
+	unsigned char* bytes = compressData(dataType, data, userBytes, outSize, errBoundMode, absErrBound, relBoundRatio, pwrBoundRatio, r5, r4, r3, r2, r1);
+	sz_stats_end(startTime, bytes==NULL ? 0 : *outSize);
+	return bytes;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+    @brief      Perform Compression 
+    @param      data           data to be compressed
+    @param      outSize        the size (in bytes) after compression
+    @param		r5,r4,r3,r2,r1	the sizes of each dimension (supporting only 5 dimensions at most in this version.
+    @return     compressed data (in binary stream) or NULL(0) if any errors
+
+ **/
+/*-------------------------------------------------------------------------*/
+unsigned char* SZ_compress_args(int dataType, void *data, size_t *outSize, int errBoundMode, double absErrBound, 
+double relBoundRatio, double pwrBoundRatio, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	return compressArgs(dataType, data, NULL, outSize, errBoundMode, absErrBound, relBoundRatio, pwrBoundRatio, r5, r4, r3, r2, r1);
+}
+
+/**
+ * Largest size of the compressed bytes of r5*r4*r3*r2*r1 elements, i.e. the size of the buffer 
+ * to be provided to SZ_compress_args_to_buffer().
+ * */
+size_t SZ_compress_bound(int dataType, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	size_t dataLength = computeDataLength(r5, r4, r3, r2, r1);
+	size_t typeSize = dataType==SZ_DOUBLE ? sizeof(double) : (dataType==SZ_FLOAT ? sizeof(float) : (size_t)getIntTypeSize(dataType));
+	//the compressor stores the original data if they cannot be compressed: version(3)+sameRByte(1)+meta data+dataLength+flag(1)
+	size_t oriDataSize = dataLength*typeSize + 3 + 1 + MetaDataByteLength_double + 8 + 1;
+	return sz_lossless_compress_bound(oriDataSize);
+}
+
+/**
+ * Same as SZ_compress_args(), but the compressed bytes are written into the caller's buffer 
+ * compressed_bytes (of 'capacity' bytes, see SZ_compress_bound()), without any temporary copy
+ * of the compressed bytes for the float and double data.
+ * 
+ * @return SZ_SCES, or SZ_NSCS if the compression fails or the buffer is too small
+ * */
+int SZ_compress_args_to_buffer(int dataType, void *data, unsigned char* compressed_bytes, size_t capacity, size_t *outSize, 
+int errBoundMode, double absErrBound, double relBoundRatio, double pwrBoundRatio, 
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	*outSize = capacity;
+	unsigned char* bytes = compressArgs(dataType, data, compressed_bytes, outSize, errBoundMode, absErrBound, relBoundRatio, pwrBoundRatio, r5, r4, r3, r2, r1);
+	if(bytes==NULL)
+		return SZ_NSCS;
+	//the integer data are compressed into a new array
+	return sz_move_to_buffer(&bytes, *outSize, compressed_bytes, capacity);
+}
+
 int SZ_compress_args2(int dataType, void *data, unsigned char* compressed_bytes, size_t *outSize, 
 int errBoundMode, double absErrBound, double relBoundRatio, double pwrBoundRatio, 
 size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
@@ -343,7 +414,7 @@ unsigned char *SZ_compress_rev(int dataType, void *data, void *reservedValue, si
 	return newByteData;
 }
 
-void *SZ_decompress(int dataType, unsigned char *bytes, size_t byteLength, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+static void initDecompression()
 {
 	if(confparams_dec==NULL)
 		confparams_dec = (sz_params*)malloc(sizeof(sz_params));
@@ -359,65 +430,132 @@ void *SZ_decompress(int dataType, unsigned char *bytes, size_t byteLength, size_
 		sysEndianType = LITTLE_ENDIAN_SYSTEM;
 	else //=0
 		sysEndianType = BIG_ENDIAN_SYSTEM;
+}
+
+/**
+ * Skip the header written by SZ_compress_customize() if the compressor behind it produces SZ streams.
+ *
+ * @return SZ_SCES, or SZ_NSCS if the bytes can only be decompressed by SZ_decompress_customize()
+ * */
+static int skipCompressorHeader(unsigned char** bytes, size_t* byteLength)
+{
+	if(!SZ_hasCompressorHeader(*bytes, *byteLength))
+		return SZ_SCES;
+	sz_compressor* cmpr = SZ_getCompressorByID((*bytes)[SZ_CMPR_MAGIC_LENGTH]);
+	if(cmpr == NULL || (cmpr->flags & SZ_CMPR_SZ_FORMAT) == 0)
+	{
+		printf("Error: the bytes were produced by SZ_compress_customize(), please use SZ_decompress_customize()\n");
+		return SZ_NSCS;
+	}
+	*bytes += SZ_CMPR_HEADER_LENGTH;
+	*byteLength -= SZ_CMPR_HEADER_LENGTH;
+	return SZ_SCES;
+}
+
+void *SZ_decompress(int dataType, unsigned char *bytes, size_t byteLength, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	if(skipCompressorHeader(&bytes, &byteLength)!=SZ_SCES)
+		return NULL;
+	initDecompression();
 	
 	if(dataType == SZ_FLOAT)
 	{
-		float *newFloatData;
-		SZ_decompress_args_float(&newFloatData, r5, r4, r3, r2, r1, bytes, byteLength, 0, NULL);
-		return newFloatData;	
+		float *newFloatData = NULL;
+		if(SZ_decompress_args_float(&newFloatData, r5, r4, r3, r2, r1, bytes, byteLength, 0, NULL)!=SZ_SCES)
+		{
+			free(newFloatData);
+			return NULL;
+		}
+		return newFloatData;
 	}
 	else if(dataType == SZ_DOUBLE)
 	{
-		double *newDoubleData;
-		SZ_decompress_args_double(&newDoubleData, r5, r4, r3, r2, r1, bytes, byteLength, 0, NULL);
-		return newDoubleData;	
+		double *newDoubleData = NULL;
+		if(SZ_decompress_args_double(&newDoubleData, r5, r4, r3, r2, r1, bytes, byteLength, 0, NULL)!=SZ_SCES)
+		{
+			free(newDoubleData);
+			return NULL;
+		}
+		return newDoubleData;
 	}
 	else if(dataType == SZ_INT8)
 	{
-		int8_t *newInt8Data;
-		SZ_decompress_args_int8(&newInt8Data, r5, r4, r3, r2, r1, bytes, byteLength);
+		int8_t *newInt8Data = NULL;
+		if(SZ_decompress_args_int8(&newInt8Data, r5, r4, r3, r2, r1, bytes, byteLength)!=SZ_SCES)
+		{
+			free(newInt8Data);
+			return NULL;
+		}
 		return newInt8Data;
 	}
 	else if(dataType == SZ_INT16)
 	{
-		int16_t *newInt16Data;
-		SZ_decompress_args_int16(&newInt16Data, r5, r4, r3, r2, r1, bytes, byteLength);
+		int16_t *newInt16Data = NULL;
+		if(SZ_decompress_args_int16(&newInt16Data, r5, r4, r3, r2, r1, bytes, byteLength)!=SZ_SCES)
+		{
+			free(newInt16Data);
+			return NULL;
+		}
 		return newInt16Data;
 	}
 	else if(dataType == SZ_INT32)
 	{
-		int32_t *newInt32Data;
-		SZ_decompress_args_int32(&newInt32Data, r5, r4, r3, r2, r1, bytes, byteLength);
+		int32_t *newInt32Data = NULL;
+		if(SZ_decompress_args_int32(&newInt32Data, r5, r4, r3, r2, r1, bytes, byteLength)!=SZ_SCES)
+		{
+			free(newInt32Data);
+			return NULL;
+		}
 		return newInt32Data;
 	}
 	else if(dataType == SZ_INT64)
 	{
-		int64_t *newInt64Data;
-		SZ_decompress_args_int64(&newInt64Data, r5, r4, r3, r2, r1, bytes, byteLength);
+		int64_t *newInt64Data = NULL;
+		if(SZ_decompress_args_int64(&newInt64Data, r5, r4, r3, r2, r1, bytes, byteLength)!=SZ_SCES)
+		{
+			free(newInt64Data);
+			return NULL;
+		}
 		return newInt64Data;
 	}
 	else if(dataType == SZ_UINT8)
 	{
-		uint8_t *newUInt8Data;
-		SZ_decompress_args_uint8(&newUInt8Data, r5, r4, r3, r2, r1, bytes, byteLength);
+		uint8_t *newUInt8Data = NULL;
+		if(SZ_decompress_args_uint8(&newUInt8Data, r5, r4, r3, r2, r1, bytes, byteLength)!=SZ_SCES)
+		{
+			free(newUInt8Data);
+			return NULL;
+		}
 		return newUInt8Data;
 	}
 	else if(dataType == SZ_UINT16)
 	{
-		uint16_t *newUInt16Data;
-		SZ_decompress_args_uint16(&newUInt16Data, r5, r4, r3, r2, r1, bytes, byteLength);
+		uint16_t *newUInt16Data = NULL;
+		if(SZ_decompress_args_uint16(&newUInt16Data, r5, r4, r3, r2, r1, bytes, byteLength)!=SZ_SCES)
+		{
+			free(newUInt16Data);
+			return NULL;
+		}
 		return newUInt16Data;
 	}
 	else if(dataType == SZ_UINT32)
 	{
-		uint32_t *newUInt32Data;
-		SZ_decompress_args_uint32(&newUInt32Data, r5, r4, r3, r2, r1, bytes, byteLength);
+		uint32_t *newUInt32Data = NULL;
+		if(SZ_decompress_args_uint32(&newUInt32Data, r5, r4, r3, r2, r1, bytes, byteLength)!=SZ_SCES)
+		{
+			free(newUInt32Data);
+			return NULL;
+		}
 		return newUInt32Data;
 	}
 	else if(dataType == SZ_UINT64)
 	{
-		uint64_t *newUInt64Data;
-		SZ_decompress_args_uint64(&newUInt64Data, r5, r4, r3, r2, r1, bytes, byteLength);
+		uint64_t *newUInt64Data = NULL;
+		if(SZ_decompress_args_uint64(&newUInt64Data, r5, r4, r3, r2, r1, bytes, byteLength)!=SZ_SCES)
+		{
+			free(newUInt64Data);
+			return NULL;
+		}
 		return newUInt64Data;
 	}
 	else 
@@ -428,94 +566,84 @@ void *SZ_decompress(int dataType, unsigned char *bytes, size_t byteLength, size_
 }
 
 /**
+ * Decompress a coarse view of the data: one value per block of the blocked regression (about 1/6 of the points
+ * per axis), read from the regression coefficients without decoding the data points when all the blocks have them
+ * (3D and 4D data, within about the error bound of the block means), or averaged per block of
+ * SZ_DOWNSAMPLE_BLOCK_SIZE points per axis after a full decompression otherwise. The 4th and 5th dimensions are merged into the 3rd one.
  * 
+ * @param size_t* d3, d2, d1 : the dimensions of the downsampled data (d1 the fastest)
  * 
- * return number of elements or -1 if any errors
+ * return the downsampled data (d3*d2*d1 values), or NULL if any errors or for the integer types
  * */
-size_t SZ_decompress_args(int dataType, unsigned char *bytes, size_t byteLength, void* decompressed_array, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+void *SZ_decompress_downsampled(int dataType, unsigned char *bytes, size_t byteLength, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, 
+size_t *d3, size_t *d2, size_t *d1)
 {
-	//size_t i;
-	size_t nbEle = computeDataLength(r5,r4,r3,r2,r1);
+	if(skipCompressorHeader(&bytes, &byteLength)!=SZ_SCES)
+		return NULL;
+	initDecompression();
 	
 	if(dataType == SZ_FLOAT)
 	{
-		float* data = (float *)SZ_decompress(dataType, bytes, byteLength, r5, r4, r3, r2, r1);
-		float* data_array = (float *)decompressed_array;
-		memcpy(data_array, data, nbEle*sizeof(float));
-		//for(i=0;i<nbEle;i++)
-		//	data_array[i] = data[i];	
-		free(data); //this free operation seems to not work with BlueG/Q system.	
-	}
-	else if (dataType == SZ_DOUBLE)
-	{
-		double* data = (double *)SZ_decompress(dataType, bytes, byteLength, r5, r4, r3, r2, r1);
-		double* data_array = (double *)decompressed_array;
-		memcpy(data_array, data, nbEle*sizeof(double));
-		//for(i=0;i<nbEle;i++)
-		//	data_array[i] = data[i];
-		free(data); //this free operation seems to not work with BlueG/Q system.	
+		float *newFloatData = NULL;
+		if(SZ_decompress_args_downsampled_float(&newFloatData, r5, r4, r3, r2, r1, bytes, byteLength, d3, d2, d1)!=SZ_SCES)
+			return NULL;
+		return newFloatData;
 	}
-	else if(dataType == SZ_INT8)
+	else if(dataType == SZ_DOUBLE)
 	{
-		int8_t* data = (int8_t*)SZ_decompress(dataType, bytes, byteLength, r5, r4, r3, r2, r1);
-		int8_t* data_array = (int8_t *)decompressed_array;
-		memcpy(data_array, data, nbEle*sizeof(int8_t));
-		free(data);
+		double *newDoubleData = NULL;
+		if(SZ_decompress_args_downsampled_double(&newDoubleData, r5, r4, r3, r2, r1, bytes, byteLength, d3, d2, d1)!=SZ_SCES)
+			return NULL;
+		return newDoubleData;
 	}
-	else if(dataType == SZ_INT16)
+	else
 	{
-		int16_t* data = (int16_t*)SZ_decompress(dataType, bytes, byteLength, r5, r4, r3, r2, r1);
-		int16_t* data_array = (int16_t *)decompressed_array;
-		memcpy(data_array, data, nbEle*sizeof(int16_t));
-		free(data);	
+		printf("Error: SZ_decompress_downsampled() only supports SZ_FLOAT and SZ_DOUBLE\n");
+		return NULL;
 	}
-	else if(dataType == SZ_INT32)
+}
+
+/**
+ * 
+ * 
+ * return number of elements or -1 if any errors
+ * */
+size_t SZ_decompress_args(int dataType, unsigned char *bytes, size_t byteLength, void* decompressed_array, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	//size_t i;
+	size_t nbEle = computeDataLength(r5,r4,r3,r2,r1);
+	if(skipCompressorHeader(&bytes, &byteLength)!=SZ_SCES)
+		return SZ_NSCS;
+	
+	if(dataType == SZ_FLOAT)
 	{
-		int32_t* data = (int32_t*)SZ_decompress(dataType, bytes, byteLength, r5, r4, r3, r2, r1);
-		int32_t* data_array = (int32_t *)decompressed_array;
-		memcpy(data_array, data, nbEle*sizeof(int32_t));
-		free(data);	
+		float* data_array = (float *)decompressed_array; //decompressed in place
+		initDecompression();
+		if(SZ_decompress_args_float(&data_array, r5, r4, r3, r2, r1, bytes, byteLength, 0, NULL)!=SZ_SCES)
+			return SZ_NSCS;
 	}
-	else if(dataType == SZ_INT64)
+	else if (dataType == SZ_DOUBLE)
 	{
-		int64_t* data = (int64_t*)SZ_decompress(dataType, bytes, byteLength, r5, r4, r3, r2, r1);
-		int64_t* data_array = (int64_t *)decompressed_array;
-		memcpy(data_array, data, nbEle*sizeof(int64_t));
-		free(data);		
+		double* data_array = (double *)decompressed_array; //decompressed in place
+		initDecompression();
+		if(SZ_decompress_args_double(&data_array, r5, r4, r3, r2, r1, bytes, byteLength, 0, NULL)!=SZ_SCES)
+			return SZ_NSCS;
 	}
-	else if(dataType == SZ_UINT8)
+	else
 	{
-		uint8_t* data = (uint8_t*)SZ_decompress(dataType, bytes, byteLength, r5, r4, r3, r2, r1);
-		uint8_t* data_array = (uint8_t *)decompressed_array;
-		memcpy(data_array, data, nbEle*sizeof(uint8_t));
+		size_t typeSize = (size_t)getIntTypeSize(dataType);
+		if(typeSize == 0)
+		{
+			printf("Error: data type cannot be the types other than SZ_FLOAT, SZ_DOUBLE or the integer types\n");
+			return SZ_NSCS; //indicating error
+		}
+		//the integer data are decompressed into a new array
+		void* data = SZ_decompress(dataType, bytes, byteLength, r5, r4, r3, r2, r1);
+		if(data == NULL)
+			return SZ_NSCS;
+		memcpy(decompressed_array, data, nbEle*typeSize);
 		free(data);
 	}
-	else if(dataType == SZ_UINT16)
-	{
-		uint16_t* data = (uint16_t*)SZ_decompress(dataType, bytes, byteLength, r5, r4, r3, r2, r1);
-		uint16_t* data_array = (uint16_t *)decompressed_array;
-		memcpy(data_array, data, nbEle*sizeof(uint16_t));
-		free(data);		
-	}
-	else if(dataType == SZ_UINT32)
-	{
-		uint32_t* data = (uint32_t*)SZ_decompress(dataType, bytes, byteLength, r5, r4, r3, r2, r1);
-		uint32_t* data_array = (uint32_t *)decompressed_array;
-		memcpy(data_array, data, nbEle*sizeof(uint32_t));
-		free(data);		
-	}
-	else if(dataType == SZ_UINT64)
-	{
-		uint64_t* data = (uint64_t*)SZ_decompress(dataType, bytes, byteLength, r5, r4, r3, r2, r1);
-		uint64_t* data_array = (uint64_t *)decompressed_array;
-		memcpy(data_array, data, nbEle*sizeof(uint64_t));
-		free(data);			
-	}
-	else
-	{ 
-		printf("Error: data type cannot be the types other than SZ_FLOAT or SZ_DOUBLE\n");
-		return SZ_NSCS; //indicating error		
-	}
 
 	return nbEle;
 }
@@ -840,6 +968,33 @@ int SZ_deregisterVar(char* varName)
 }
 
 #ifdef HAVE_TIMECMPR
+/**
+ * Compress the current step of the variable v into v->compressedBytes. The decompressed data of the
+ * step go to the second history buffer of the variable, so the reference step is not overwritten
+ * during the compression; the buffers are swapped when the compression is done.
+ * */
+static void compressVarStep_ts(int cmprType, SZ_Variable* v)
+{
+	multisteps = v->multisteps; //assign the v's multisteps to the global variable 'multisteps', which will be used in the following compression.
+	begin_hist_step(multisteps);
+	if(v->compressedBytes!=NULL) //the bytes of the previous step have been packed already
+	{
+		free(v->compressedBytes);
+		v->compressedBytes = NULL;
+	}
+
+	if(v->dataType==SZ_FLOAT)
+	{
+		SZ_compress_args_float(cmprType, &(v->compressedBytes), (float*)v->data, v->r5, v->r4, v->r3, v->r2, v->r1, &(v->compressedSize), v->errBoundMode, v->absErrBound, v->relBoundRatio, v->pwRelBoundRatio);
+	}
+	else if(v->dataType==SZ_DOUBLE)
+	{
+		SZ_compress_args_double(cmprType, &(v->compressedBytes), (double*)v->data, v->r5, v->r4, v->r3, v->r2, v->r1, &(v->compressedSize), v->errBoundMode, v->absErrBound, v->relBoundRatio, v->pwRelBoundRatio);
+	}
+
+	commit_hist_step(multisteps);
+}
+
 /**
  * process multiple variables
  * */
@@ -859,15 +1014,7 @@ int SZ_compress_ts_select_var(int cmprType, unsigned char* var_ids, unsigned cha
 		int found = checkVarID(v->var_id, var_ids, var_count);
 		if (found)
 		{
-			multisteps = v->multisteps;
-			if(v->dataType==SZ_FLOAT)
-			{
-				SZ_compress_args_float(cmprType, &(v->compressedBytes), (float*)v->data, v->r5, v->r4, v->r3, v->r2, v->r1, &(v->compressedSize), v->errBoundMode, v->absErrBound, v->relBoundRatio, v->pwRelBoundRatio);
-			}
-			else if(v->dataType==SZ_DOUBLE)
-			{
-				SZ_compress_args_double(cmprType, &(v->compressedBytes), (double*)v->data, v->r5, v->r4, v->r3, v->r2, v->r1, &(v->compressedSize), v->errBoundMode, v->absErrBound, v->relBoundRatio, v->pwRelBoundRatio);
-			}
+			compressVarStep_ts(cmprType, v);
 		
 			totalSize += v->compressedSize;
 			v->compressType = multisteps->compressionType;
@@ -925,16 +1072,7 @@ int SZ_compress_ts(int cmprType, unsigned char** newByteData, size_t *outSize)
 	SZ_Variable* v = vset->header->next;	
 	for(i=0;i<vset->count;i++)
 	{
-		multisteps = v->multisteps; //assign the v's multisteps to the global variable 'multisteps', which will be used in the following compression.
-
-		if(v->dataType==SZ_FLOAT)
-		{
-			SZ_compress_args_float(cmprType, &(v->compressedBytes), (float*)v->data, v->r5, v->r4, v->r3, v->r2, v->r1, &(v->compressedSize), v->errBoundMode, v->absErrBound, v->relBoundRatio, v->pwRelBoundRatio);
-		}
-		else if(v->dataType==SZ_DOUBLE)
-		{
-			SZ_compress_args_double(cmprType, &(v->compressedBytes), (double*)v->data, v->r5, v->r4, v->r3, v->r2, v->r1, &(v->compressedSize), v->errBoundMode, v->absErrBound, v->relBoundRatio, v->pwRelBoundRatio);
-		}
+		compressVarStep_ts(cmprType, v);
 		//sprintf(metadata_str, "%s:%d,%d,%zu", metadata_str, i, multisteps->lastSnapshotStep, outSize_[i]);
 		
 		totalSize += v->compressedSize;
@@ -1015,7 +1153,7 @@ void SZ_decompress_ts(unsigned char *bytes, size_t bytesLength)
 	{
 		unsigned char var_id = *(q++);
 		SZ_Variable* p = SZ_getVariable(var_id);
-		sz_multisteps* multisteps = p->multisteps;
+		multisteps = p->multisteps; //the global 'multisteps' is used by the time-series based decompression
 		multisteps->compressionType = *(q++);
 		unsigned char dataType = *(q++);
 		size_t cmpSize = bytesToSize(q);
@@ -1025,26 +1163,22 @@ void SZ_decompress_ts(unsigned char *bytes, size_t bytesLength)
 			q += cmpSize;
 		else
 		{
-			sz_multisteps* multisteps = p->multisteps;
 			r5 = p->r5;
 			r4 = p->r4;
 			r3 = p->r3;
 			r2 = p->r2;
 			r1 = p->r1;
-			size_t dataLen = computeDataLength(r5, r4, r3, r2, r1);				
 			
 			unsigned char* cmpBytes = q;			
 			switch(dataType)
 			{
 			case SZ_FLOAT:
-					SZ_decompress_args_float(&newFloatData, r5, r4, r3, r2, r1, cmpBytes, cmpSize, multisteps->compressionType, multisteps->hist_data);
-					memcpy(p->data, newFloatData, dataLen*sizeof(float));
-					free(newFloatData);
+					newFloatData = (float*)p->data; //decompressed into the variable's array
+					SZ_decompress_args_float(&newFloatData, r5, r4, r3, r2, r1, cmpBytes, cmpSize, multisteps->compressionType, getDecHistData(multisteps));
 					break;
 			case SZ_DOUBLE:
-					SZ_decompress_args_double(&newDoubleData, r5, r4, r3, r2, r1, cmpBytes, cmpSize, multisteps->compressionType, multisteps->hist_data);
-					memcpy(p->data, newDoubleData, dataLen*sizeof(double));
-					free(newDoubleData);
+					newDoubleData = (double*)p->data; //decompressed into the variable's array
+					SZ_decompress_args_double(&newDoubleData, r5, r4, r3, r2, r1, cmpBytes, cmpSize, multisteps->compressionType, getDecHistData(multisteps));
 					break;
 			default:
 					printf("Error: data type cannot be the types other than SZ_FLOAT or SZ_DOUBLE\n");
@@ -1091,7 +1225,7 @@ void SZ_decompress_ts_select_var(unsigned char* var_ids, unsigned char var_count
 		unsigned char var_id = *(q++);
 		int selected = checkVarID(var_id, var_ids, var_count);
 		SZ_Variable* p = SZ_getVariable(var_id);
-		sz_multisteps* multisteps = p->multisteps;
+		multisteps = p->multisteps; //the global 'multisteps' is used by the time-series based decompression
 		multisteps->compressionType = *(q++);
 		unsigned char dataType = *(q++);
 		size_t cmpSize = bytesToSize(q);
@@ -1101,26 +1235,22 @@ void SZ_decompress_ts_select_var(unsigned char* var_ids, unsigned char var_count
 			q += cmpSize;
 		else // p!=NULL && selected == 1
 		{
-			sz_multisteps* multisteps = p->multisteps;
 			r5 = p->r5;
 			r4 = p->r4;
 			r3 = p->r3;
 			r2 = p->r2;
 			r1 = p->r1;
-			size_t dataLen = computeDataLength(r5, r4, r3, r2, r1);				
 			
 			unsigned char* cmpBytes = q;			
 			switch(dataType)
 			{
 			case SZ_FLOAT:
-					SZ_decompress_args_float(&newFloatData, r5, r4, r3, r2, r1, cmpBytes, cmpSize, multisteps->compressionType, multisteps->hist_data);
-					memcpy(p->data, newFloatData, dataLen*sizeof(float));
-					free(newFloatData);
+					newFloatData = (float*)p->data; //decompressed into the variable's array
+					SZ_decompress_args_float(&newFloatData, r5, r4, r3, r2, r1, cmpBytes, cmpSize, multisteps->compressionType, getDecHistData(multisteps));
 					break;
 			case SZ_DOUBLE:
-					SZ_decompress_args_double(&newDoubleData, r5, r4, r3, r2, r1, cmpBytes, cmpSize, multisteps->compressionType, multisteps->hist_data);
-					memcpy(p->data, newDoubleData, dataLen*sizeof(double));
-					free(newDoubleData);
+					newDoubleData = (double*)p->data; //decompressed into the variable's array
+					SZ_decompress_args_double(&newDoubleData, r5, r4, r3, r2, r1, cmpBytes, cmpSize, multisteps->compressionType, getDecHistData(multisteps));
 					break;
 			default:
 					printf("Error: data type cannot be the types other than SZ_FLOAT or SZ_DOUBLE\n");
@@ -1136,10 +1266,14 @@ void SZ_decompress_ts_select_var(unsigned char* var_ids, unsigned char var_count
 
 void SZ_Finalize()
 {
+#ifdef HAVE_ASYNC
+	SZ_async_finalize();
+#endif
 #ifdef HAVE_TIMECMPR		
 	if(sz_varset!=NULL)
 		SZ_freeVarSet(SZ_MAINTAIN_VAR_DATA);
 #endif
+	SZ_autoClearModes(NULL);
 
 	if(confparams_dec!=NULL)
 	{
@@ -1164,30 +1298,11 @@ void SZ_Finalize()
 }
 
 
-/**
- *
- * Inits the compressor for SZ_compress_customize
- *
- * with SZ_Init(NULL) if not previously initialized and no params passed
- * with SZ_InitParam(userPara) otherwise if params are passed
- * and doesn't not initialize otherwise
- *
- * @param sz_params* userPara : the user configuration or null
- * @param sz_params* confparams : the current configuration
- */
-static void sz_maybe_init_with_user_params(struct sz_params* userPara, struct sz_params* current_params) {
-		if(userPara==NULL && current_params == NULL)
-			SZ_Init(NULL);
-		else if(userPara != NULL)
-			SZ_Init_Params((sz_params*)userPara);
-}
-
-
 /**
  * 
  * The interface for the user-customized compression method 
  * 
- * @param char* comprName : the name of the specific compression approach
+ * @param char* comprName : the name of the specific compression approach (see SZ_registerCompressor())
  * @param void* userPara : the pointer of the user-customized data stracture containing the cusotmized compressors' requried input parameters
  * @param int dataType : data type (SZ_FLOAT, SZ_DOUBLE, SZ_INT8, SZ_UINT8, SZ_INT16, SZ_UINT16, ....)
  * @param void* data : input dataset
@@ -1202,47 +1317,73 @@ static void sz_maybe_init_with_user_params(struct sz_params* userPara, struct sz
  * */
 unsigned char* SZ_compress_customize(const char* cmprName, void* userPara, int dataType, void* data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, size_t *outSize, int *status)
 {
-	unsigned char* result = NULL;
-	if(strcmp(cmprName, "SZ2.0")==0 || strcmp(cmprName, "SZ")==0)
+	sz_compressor* cmpr = SZ_getCompressor(cmprName);
+	if(cmpr == NULL || (cmpr->flags & SZ_CMPR_TYPE(dataType)) == 0)
+	{
+		printf("Error: the compressor %s is not registered or does not support the data type %d\n", cmprName, dataType);
+		*status = SZ_NSCS;
+		return NULL;
+	}
+	size_t payloadSize = 0;
+	size_t bound = cmpr->bound == NULL ? 0 : cmpr->bound(userPara, dataType, r5, r4, r3, r2, r1);
+	if(cmpr->compress_to_buffer != NULL && bound > 0)
 	{
-		sz_maybe_init_with_user_params(userPara, confparams_cpr);
-		result = SZ_compress(dataType, data, outSize, r5, r4, r3, r2, r1);
+		//the bytes are written after the header reserved at the start of the buffer, which is then shrunk to their size
+		unsigned char* result = (unsigned char*)malloc(bound + SZ_CMPR_HEADER_LENGTH);
+		if(result == NULL || cmpr->compress_to_buffer(userPara, dataType, data, r5, r4, r3, r2, r1, result + SZ_CMPR_HEADER_LENGTH, bound, &payloadSize) != SZ_SCES)
+		{
+			free(result);
+			*status = SZ_NSCS;
+			return NULL;
+		}
+		SZ_writeCompressorHeader(result, cmpr->id);
+		*outSize = payloadSize + SZ_CMPR_HEADER_LENGTH;
+		unsigned char* shrunk = (unsigned char*)realloc(result, *outSize);
 		*status = SZ_SCES;
+		return shrunk == NULL ? result : shrunk;
 	}
-	else if(strcmp(cmprName, "SZ1.4")==0)
+	unsigned char* payload = cmpr->compress(userPara, dataType, data, r5, r4, r3, r2, r1, &payloadSize, status);
+	if(payload == NULL || *status != SZ_SCES)
 	{
-		sz_maybe_init_with_user_params(userPara, confparams_cpr);
-		confparams_cpr->withRegression = SZ_NO_REGRESSION;
-		
-		result = SZ_compress(dataType, data, outSize, r5, r4, r3, r2, r1);
-		*status = SZ_SCES;		
-    }
-    else if(strcmp(cmprName, "SZ_Transpose")==0)
-    {
-		void* transData = transposeData(data, dataType, r5, r4, r3, r2, r1);
-		sz_maybe_init_with_user_params(userPara, confparams_cpr);
-		size_t n = computeDataLength(r5, r4, r3, r2, r1);
-		result = SZ_compress(dataType, transData, outSize, 0, 0, 0, 0, n);
-	}
-    else if(strcmp(cmprName, "ExaFEL")==0){
-    	assert(dataType==SZ_FLOAT);
-    	assert(r5==0);
-    	result = exafelSZ_Compress(userPara,data, r4, r3, r2, r1,outSize);
-    	*status = SZ_SCES;
+		free(payload);
+		*status = SZ_NSCS;
+		return NULL;
 	}
-	else
+	//the ID of the compressor is recorded ahead of its bytes, so that SZ_decompress_customize() can find it back
+	//(the compressor allocated its bytes itself, so they are moved behind the header)
+	unsigned char* result = (unsigned char*)realloc(payload, payloadSize + SZ_CMPR_HEADER_LENGTH);
+	if(result == NULL)
 	{
+		free(payload);
 		*status = SZ_NSCS;
+		return NULL;
 	}
+	memmove(result + SZ_CMPR_HEADER_LENGTH, result, payloadSize);
+	SZ_writeCompressorHeader(result, cmpr->id);
+	*outSize = payloadSize + SZ_CMPR_HEADER_LENGTH;
 	return result;
 }
 
+/**
+ * 
+ * @return the maximum number of bytes produced by SZ_compress_customize() with the compressor cmprName,
+ * or 0 if the compressor is unknown or cannot bound its compressed size
+ * 
+ * */
+size_t SZ_compress_customize_bound(const char* cmprName, void* userPara, int dataType, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	sz_compressor* cmpr = SZ_getCompressor(cmprName);
+	if(cmpr == NULL || cmpr->bound == NULL)
+		return 0;
+	return cmpr->bound(userPara, dataType, r5, r4, r3, r2, r1) + SZ_CMPR_HEADER_LENGTH;
+}
 
 /**
  * 
  * The interface for the user-customized decompression method 
  * 
- * @param char* comprName : the name of the specific compression approach
+ * @param char* comprName : the name of the specific compression approach (only used by the bytes of
+ * older versions: the compressor is otherwise given by the ID in the header of the bytes, and comprName can be NULL)
  * @param void* userPara : the pointer of the user-customized data stracture containing the cusotmized compressors' requried input parameters
  * @param int dataType : data type (SZ_FLOAT, SZ_DOUBLE, SZ_INT8, SZ_UINT8, SZ_INT16, SZ_UINT16, ....)
  * @param unsigned char* bytes : input bytes (the compressed data)
@@ -1256,27 +1397,20 @@ unsigned char* SZ_compress_customize(const char* cmprName, void* userPara, int d
  * */
 void* SZ_decompress_customize(const char* cmprName, void* userPara, int dataType, unsigned char* bytes, size_t byteLength, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, int *status)
 {
-	void* result = NULL;
-	if(strcmp(cmprName, "SZ2.0")==0 || strcmp(cmprName, "SZ")==0 || strcmp(cmprName, "SZ1.4")==0)
+	sz_compressor* cmpr = NULL;
+	if(SZ_hasCompressorHeader(bytes, byteLength))
 	{
-		result = SZ_decompress(dataType, bytes, byteLength, r5, r4, r3, r2, r1);
-		* status = SZ_SCES;
-	}
-    else if(strcmp(cmprName, "SZ_Transpose")==0)
-    {
-		size_t n = computeDataLength(r5, r4, r3, r2, r1);
-		void* tmpData = SZ_decompress(dataType, bytes, byteLength, 0, 0, 0, 0, n);
-		result = detransposeData(tmpData, dataType, r5, r4, r3, r2, r1);
+		cmpr = SZ_getCompressorByID(bytes[SZ_CMPR_MAGIC_LENGTH]);
+		bytes += SZ_CMPR_HEADER_LENGTH;
+		byteLength -= SZ_CMPR_HEADER_LENGTH;
 	}
-  	else if(strcmp(cmprName, "ExaFEL")==0){
-    	assert(dataType==SZ_FLOAT);
-   		assert(r5==0);
-    	result = exafelSZ_Decompress(userPara,bytes, r4, r3, r2, r1,byteLength);
-    	*status = SZ_SCES;
-	}
-	else
+	else if(cmprName != NULL) //bytes produced by older versions, without the ID of the compressor
+		cmpr = SZ_getCompressor(cmprName);
+	if(cmpr == NULL || (cmpr->flags & SZ_CMPR_TYPE(dataType)) == 0)
 	{
+		printf("Error: cannot find the compressor of the bytes or it does not support the data type %d\n", dataType);
 		*status = SZ_NSCS;
+		return NULL;
 	}
-	return result;	
+	return cmpr->decompress(userPara, dataType, bytes, byteLength, r5, r4, r3, r2, r1, status);
 }
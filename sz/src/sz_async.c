@@ -0,0 +1,251 @@
+/**
+ *  @file sz_async.c
+ *  @date Oct, 2026
+ *  @brief Asynchronous compression: SZ_compress_async() queues a job to a worker thread and returns
+ *  at once, so that the compression of a time step overlaps with the computation of the next one.
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "sz.h"
+#include "sz_async.h"
+
+static pthread_mutex_t asyncMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t asyncJobCond = PTHREAD_COND_INITIALIZER; //a job is queued (or the worker has to stop)
+static pthread_cond_t asyncDoneCond = PTHREAD_COND_INITIALIZER; //a job is done
+static pthread_t asyncWorker;
+static int asyncStarted = 0;
+static int asyncStop = 0;
+
+static sz_async_job* asyncQueueHead = NULL;
+static sz_async_job* asyncQueueTail = NULL;
+static int asyncUnfinished = 0; //number of the jobs queued or running
+static size_t asyncPendingBytes = 0; //memory held by the jobs (input copies and compressed bytes not collected yet)
+
+static size_t asyncMaxPendingBytes = 0; //0: no limit
+static sz_params asyncUserParams; //snapshot of the caller's parameters, taken when no job is pending
+
+static void* asyncWorkerLoop(void* arg)
+{
+	sz_async_job* job;
+	size_t inputBytes;
+	(void)arg;
+	while(1)
+	{
+		pthread_mutex_lock(&asyncMutex);
+		while(asyncQueueHead==NULL && !asyncStop)
+			pthread_cond_wait(&asyncJobCond, &asyncMutex);
+		if(asyncQueueHead==NULL) //asyncStop
+		{
+			pthread_mutex_unlock(&asyncMutex);
+			break;
+		}
+		job = asyncQueueHead;
+		asyncQueueHead = job->next;
+		if(asyncQueueHead==NULL)
+			asyncQueueTail = NULL;
+		pthread_mutex_unlock(&asyncMutex);
+
+		//the compressor reads (and writes) the global parameters: the job's snapshot is copied into them,
+		//the pointer confparams_cpr itself is never changed
+		memcpy(confparams_cpr, &(job->params), sizeof(sz_params));
+		job->bytes = SZ_compress_args(job->dataType, job->data, &(job->outSize), job->errBoundMode, job->absErrBound,
+		job->relBoundRatio, job->pwrBoundRatio, job->r5, job->r4, job->r3, job->r2, job->r1);
+
+		free(job->data);
+		job->data = NULL;
+		inputBytes = job->memBytes;
+
+		pthread_mutex_lock(&asyncMutex);
+		if(asyncQueueHead==NULL) //last job: give the caller its parameters back before it is told the job is done
+			memcpy(confparams_cpr, &asyncUserParams, sizeof(sz_params));
+		job->memBytes = job->bytes==NULL ? 0 : job->outSize;
+		asyncPendingBytes = asyncPendingBytes - inputBytes + job->memBytes;
+		job->status = job->bytes==NULL ? SZ_NSCS : SZ_SCES;
+		asyncUnfinished--;
+		pthread_cond_broadcast(&asyncDoneCond);
+		pthread_mutex_unlock(&asyncMutex);
+	}
+	return NULL;
+}
+
+/**
+ * Set the memory limit of the asynchronous compression (optional, to be called before the first job).
+ * The jobs are compressed one after another by a single worker thread (see SZ_compress_async()).
+ *
+ * @param size_t maxPendingBytes : memory held by the pending jobs (their copies of the input data
+ * and the compressed bytes not collected by SZ_wait() yet), SZ_compress_async() blocks until
+ * some jobs are done if the limit would be exceeded (0: no limit)
+ *
+ * @return SZ_SCES, or SZ_NSCS if jobs have been submitted already
+ * */
+int SZ_async_init(size_t maxPendingBytes)
+{
+	int status = SZ_SCES;
+	pthread_mutex_lock(&asyncMutex);
+	if(asyncStarted)
+		status = SZ_NSCS;
+	else
+	{
+		asyncMaxPendingBytes = maxPendingBytes;
+	}
+	pthread_mutex_unlock(&asyncMutex);
+	return status;
+}
+
+/**
+ * Queue the compression of the data and return at once. The data and the compression parameters are
+ * copied, so the caller can modify its buffer right after the call.
+ *
+ * The parameters are those of confparams_cpr when no job is pending; while jobs are pending, the worker
+ * thread uses confparams_cpr and exe_params (SZ keeps its working state in globals), so the new jobs get
+ * the same parameters as the pending ones, and no other SZ function (compression, decompression, SZ_Init(),
+ * SZ_Finalize(), ...) may be called before all the jobs are done (SZ_test() or SZ_wait()).
+ *
+ * If maxPendingBytes is set (see SZ_async_init()), the call blocks before copying the data until the
+ * pending jobs leave room for it.
+ *
+ * @return the handle of the job, or NULL if the job cannot be created
+ * */
+sz_async_handle SZ_compress_async(int dataType, void *data, int errBoundMode, double absErrBound,
+double relBoundRatio, double pwrBoundRatio, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	if(confparams_cpr == NULL)
+		SZ_Init(NULL);
+	else if(exe_params == NULL)
+	{
+		exe_params = (sz_exedata*)malloc(sizeof(sz_exedata));
+		memset(exe_params, 0, sizeof(sz_exedata));
+	}
+
+	size_t dataLength = computeDataLength(r5, r4, r3, r2, r1);
+	size_t typeSize = dataType==SZ_DOUBLE ? sizeof(double) : (dataType==SZ_FLOAT ? sizeof(float) : (size_t)getIntTypeSize(dataType));
+	if(typeSize == 0)
+	{
+		printf("Error: unsupported data type in SZ_compress_async()\n");
+		return NULL;
+	}
+	size_t inputBytes = dataLength*typeSize;
+
+	//reserve the memory of the job before copying the data, waiting for the pending jobs if needed
+	pthread_mutex_lock(&asyncMutex);
+	while(asyncMaxPendingBytes>0 && asyncUnfinished>0 && asyncPendingBytes+inputBytes>asyncMaxPendingBytes)
+		pthread_cond_wait(&asyncDoneCond, &asyncMutex);
+	if(asyncUnfinished==0) //no job is running, so the global parameters are the caller's
+		memcpy(&asyncUserParams, confparams_cpr, sizeof(sz_params));
+	asyncPendingBytes += inputBytes;
+	pthread_mutex_unlock(&asyncMutex);
+
+	sz_async_job* job = (sz_async_job*)malloc(sizeof(sz_async_job));
+	if(job != NULL)
+	{
+		memset(job, 0, sizeof(sz_async_job));
+		job->data = malloc(inputBytes);
+	}
+	if(job == NULL || job->data == NULL)
+	{
+		free(job);
+		pthread_mutex_lock(&asyncMutex);
+		asyncPendingBytes -= inputBytes;
+		pthread_cond_broadcast(&asyncDoneCond);
+		pthread_mutex_unlock(&asyncMutex);
+		return NULL;
+	}
+	memcpy(job->data, data, inputBytes);
+	job->dataType = dataType;
+	job->r5 = r5;
+	job->r4 = r4;
+	job->r3 = r3;
+	job->r2 = r2;
+	job->r1 = r1;
+	job->errBoundMode = errBoundMode;
+	job->absErrBound = absErrBound;
+	job->relBoundRatio = relBoundRatio;
+	job->pwrBoundRatio = pwrBoundRatio;
+	job->memBytes = inputBytes;
+	job->status = SZ_ASYNC_PENDING;
+
+	pthread_mutex_lock(&asyncMutex);
+	memcpy(&(job->params), &asyncUserParams, sizeof(sz_params));
+	if(!asyncStarted)
+	{
+		asyncStop = 0;
+		if(pthread_create(&asyncWorker, NULL, asyncWorkerLoop, NULL)!=0)
+		{
+			asyncPendingBytes -= inputBytes;
+			pthread_mutex_unlock(&asyncMutex);
+			printf("Error: cannot start the compression thread in SZ_compress_async()\n");
+			free(job->data);
+			free(job);
+			return NULL;
+		}
+		asyncStarted = 1;
+	}
+	if(asyncQueueTail==NULL)
+		asyncQueueHead = job;
+	else
+		asyncQueueTail->next = job;
+	asyncQueueTail = job;
+	asyncUnfinished++;
+	pthread_cond_signal(&asyncJobCond);
+	pthread_mutex_unlock(&asyncMutex);
+	return job;
+}
+
+/**
+ * @return 1 if the job is done (SZ_wait() will not block), 0 otherwise
+ * */
+int SZ_test(sz_async_handle handle)
+{
+	int done;
+	pthread_mutex_lock(&asyncMutex);
+	done = handle->status!=SZ_ASYNC_PENDING;
+	pthread_mutex_unlock(&asyncMutex);
+	return done;
+}
+
+/**
+ * Wait for the job and collect its compressed bytes (to be released by the caller with free()).
+ * The handle is released and cannot be used any more.
+ *
+ * @return SZ_SCES, or SZ_NSCS if the compression failed
+ * */
+int SZ_wait(sz_async_handle handle, unsigned char** bytes, size_t* outSize)
+{
+	int status;
+	pthread_mutex_lock(&asyncMutex);
+	while(handle->status==SZ_ASYNC_PENDING)
+		pthread_cond_wait(&asyncDoneCond, &asyncMutex);
+	asyncPendingBytes -= handle->memBytes;
+	pthread_cond_broadcast(&asyncDoneCond);
+	pthread_mutex_unlock(&asyncMutex);
+
+	status = handle->status;
+	*bytes = handle->bytes;
+	*outSize = handle->outSize;
+	free(handle);
+	return status;
+}
+
+/**
+ * Wait for all the jobs and stop the worker thread (the handles must still be collected by SZ_wait()).
+ * */
+void SZ_async_finalize()
+{
+	pthread_mutex_lock(&asyncMutex);
+	if(!asyncStarted)
+	{
+		pthread_mutex_unlock(&asyncMutex);
+		return;
+	}
+	asyncStop = 1;
+	pthread_cond_signal(&asyncJobCond);
+	pthread_mutex_unlock(&asyncMutex);
+
+	pthread_join(asyncWorker, NULL);
+	asyncStarted = 0;
+}
@@ -0,0 +1,228 @@
+/**
+ *  @file sz_auto.c
+ *  @date Oct, 2026
+ *  @brief Automatic selection of the predictor and of the lossless stage per variable, from the estimation of
+ *  the candidate modes on a sample of the blocks (see SZ_estimateModes()). The selected modes are cached by
+ *  variable name, so that the later time steps of a variable are compressed without new trials.
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sz.h"
+#include "sz_auto.h"
+
+#define SZ_AUTO_RATIO_TOLERANCE 0.01 //ratios within 1% are equal: the faster mode wins
+
+/**
+ * The mode selected for a variable.
+ * */
+typedef struct sz_auto_entry
+{
+	char* varName;
+	int dataType;
+	size_t dataLength;
+	sz_auto_objective objective;
+	sz_mode mode;
+	int uses; //compressions since the selection
+	struct sz_auto_entry* next;
+} sz_auto_entry;
+
+static sz_auto_entry* autoModes = NULL;
+
+static void set_mode(sz_mode* mode, int withRegression, int szMode, int losslessCompressor, int gzipMode)
+{
+	mode->withRegression = withRegression;
+	mode->szMode = szMode;
+	mode->losslessCompressor = losslessCompressor;
+	mode->gzipMode = gzipMode;
+}
+
+/**
+ * The candidate modes: no lossless stage, Zstd at levels 1, 3 and 19 and Gzip at levels 1 and 9, each with and
+ * without the regression predictor (only without for the 1D fields, which have no regression).
+ * */
+static int candidate_modes(int withRegression, sz_mode* modes)
+{
+	int count = 0;
+	int predictors[2] = {SZ_WITH_LINEAR_REGRESSION, SZ_NO_REGRESSION};
+	for(int r = withRegression ? 0 : 1; r<2; r++)
+	{
+		set_mode(&modes[count++], predictors[r], SZ_BEST_SPEED, ZSTD_COMPRESSOR, 3);
+		set_mode(&modes[count++], predictors[r], SZ_BEST_COMPRESSION, ZSTD_COMPRESSOR, 1);
+		set_mode(&modes[count++], predictors[r], SZ_BEST_COMPRESSION, ZSTD_COMPRESSOR, 3);
+		set_mode(&modes[count++], predictors[r], SZ_BEST_COMPRESSION, ZSTD_COMPRESSOR, 19);
+		set_mode(&modes[count++], predictors[r], SZ_BEST_COMPRESSION, GZIP_COMPRESSOR, 1);
+		set_mode(&modes[count++], predictors[r], SZ_BEST_COMPRESSION, GZIP_COMPRESSOR, 9);
+	}
+	return count;
+}
+
+/**
+ * Choose the mode which best meets the objective from the estimates.
+ * */
+static int select_mode(size_t rawBytes, sz_estimate* estimates, int count, sz_auto_objective* objective)
+{
+	int best = -1, closest = 0;
+	double bestRatio = 0;
+	for(int i=0; i<count; i++)
+	{
+		double throughput = estimates[i].compressionTime > 0 ? rawBytes / 1000000.0 / estimates[i].compressionTime : 0;
+		double closestThroughput = estimates[closest].compressionTime > 0 ? rawBytes / 1000000.0 / estimates[closest].compressionTime : 0;
+		if(objective->goal == SZ_AUTO_MAX_SPEED)
+		{
+			if(estimates[i].compressionRatio > estimates[closest].compressionRatio)
+				closest = i;
+			if(estimates[i].compressionRatio >= objective->minRatio
+			&& (best < 0 || estimates[i].compressionTime < estimates[best].compressionTime))
+				best = i;
+		}
+		else
+		{
+			if(throughput > closestThroughput)
+				closest = i;
+			if(throughput < objective->minThroughput)
+				continue;
+			if(best < 0 || estimates[i].compressionRatio > bestRatio * (1 + SZ_AUTO_RATIO_TOLERANCE)
+			|| (estimates[i].compressionRatio >= bestRatio * (1 - SZ_AUTO_RATIO_TOLERANCE) && estimates[i].compressionTime < estimates[best].compressionTime))
+			{
+				best = i;
+				if(estimates[i].compressionRatio > bestRatio)
+					bestRatio = estimates[i].compressionRatio;
+			}
+		}
+	}
+	return best >= 0 ? best : closest;
+}
+
+static int same_objective(sz_auto_objective* a, sz_auto_objective* b)
+{
+	return a->goal == b->goal && a->minThroughput == b->minThroughput && a->minRatio == b->minRatio && a->retuneInterval == b->retuneInterval;
+}
+
+static sz_auto_entry* find_entry(const char* varName, int dataType)
+{
+	sz_auto_entry* entry;
+	for(entry = autoModes; entry != NULL; entry = entry->next)
+		if(entry->dataType == dataType && strcmp(entry->varName, varName) == 0)
+			return entry;
+	return NULL;
+}
+
+/**
+ * Select the mode (predictor and lossless stage) of SZ_compress() which best meets the objective for a variable,
+ * with the error bound and the other settings of SZ_Init(). The candidate modes are estimated on a sample of the
+ * blocks (see SZ_estimateModes()), which costs from half of a compression to a few compressions (the slow lossless
+ * levels on very compressible data); the selection is then cached by variable name and reused while the variable
+ * keeps its type, its size and its objective, up to objective->retuneInterval compressions.
+ * Like the compression parameters, the cache is global: it is not meant for concurrent compressions.
+ *
+ * @param char* varName : the name of the variable (NULL: no caching)
+ * @param sz_auto_objective* objective : the goal and its constraint
+ * @param sz_mode* mode : the selected mode (the mode of SZ_Init() if the data cannot be estimated)
+ *
+ * @return SZ_SCES, or the error status of SZ_estimateModes()
+ * */
+int SZ_autoSelectMode(const char* varName, int dataType, void* data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1,
+sz_auto_objective* objective, sz_mode* mode)
+{
+	if(confparams_cpr == NULL)
+	{
+		printf("Error: SZ_Init() has to be called before SZ_autoSelectMode()\n");
+		return SZ_NSCS;
+	}
+	set_mode(mode, confparams_cpr->withRegression, confparams_cpr->szMode, confparams_cpr->losslessCompressor, confparams_cpr->gzipMode);
+	if(confparams_cpr->szMode == SZ_TEMPORAL_COMPRESSION)
+	{
+		printf("Error: SZ_autoSelectMode() does not support the time-series compression\n");
+		return SZ_NSCS;
+	}
+	size_t dataLength = computeDataLength(r5, r4, r3, r2, r1);
+	sz_auto_entry* entry = varName == NULL ? NULL : find_entry(varName, dataType);
+	if(entry != NULL && entry->dataLength == dataLength && same_objective(&entry->objective, objective)
+	&& (objective->retuneInterval <= 0 || entry->uses < objective->retuneInterval))
+	{
+		entry->uses++;
+		*mode = entry->mode;
+		return SZ_SCES;
+	}
+
+	sz_mode modes[SZ_AUTO_MAX_MODES];
+	sz_estimate estimates[SZ_AUTO_MAX_MODES];
+	int count = candidate_modes(r2 != 0, modes);
+	int status = SZ_estimateModes(dataType, data, r5, r4, r3, r2, r1, NULL, modes, count, estimates);
+	if(status != SZ_SCES)
+		return status;
+	size_t rawBytes = dataLength * (dataType == SZ_FLOAT ? sizeof(float) : sizeof(double));
+	*mode = modes[select_mode(rawBytes, estimates, count, objective)];
+
+	if(varName == NULL)
+		return SZ_SCES;
+	if(entry == NULL)
+	{
+		entry = (sz_auto_entry*) malloc(sizeof(sz_auto_entry));
+		entry->varName = (char*) malloc(strlen(varName) + 1);
+		strcpy(entry->varName, varName);
+		entry->dataType = dataType;
+		entry->next = autoModes;
+		autoModes = entry;
+	}
+	entry->dataLength = dataLength;
+	entry->objective = *objective;
+	entry->mode = *mode;
+	entry->uses = 1;
+	return SZ_SCES;
+}
+
+/**
+ * Compress a variable in the mode selected by SZ_autoSelectMode(), with the error bound of SZ_Init().
+ * The settings of SZ_Init() are restored afterwards; the decompression needs no setting, as the mode is recorded
+ * in the compressed bytes.
+ *
+ * @return the compressed bytes, or NULL in case of error
+ * */
+unsigned char* SZ_compress_auto(const char* varName, int dataType, void* data, size_t* outSize,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, sz_auto_objective* objective)
+{
+	sz_mode mode;
+	int status = SZ_autoSelectMode(varName, dataType, data, r5, r4, r3, r2, r1, objective, &mode);
+	if(confparams_cpr == NULL)
+		return NULL;
+	if(status != SZ_SCES) //not supported by the estimation: compress in the mode of SZ_Init()
+		return SZ_compress(dataType, data, outSize, r5, r4, r3, r2, r1);
+
+	sz_mode saved;
+	set_mode(&saved, confparams_cpr->withRegression, confparams_cpr->szMode, confparams_cpr->losslessCompressor, confparams_cpr->gzipMode);
+	confparams_cpr->withRegression = mode.withRegression;
+	confparams_cpr->szMode = mode.szMode;
+	confparams_cpr->losslessCompressor = mode.losslessCompressor;
+	confparams_cpr->gzipMode = mode.gzipMode;
+	unsigned char* bytes = SZ_compress(dataType, data, outSize, r5, r4, r3, r2, r1);
+	confparams_cpr->withRegression = saved.withRegression;
+	confparams_cpr->szMode = saved.szMode;
+	confparams_cpr->losslessCompressor = saved.losslessCompressor;
+	confparams_cpr->gzipMode = saved.gzipMode;
+	return bytes;
+}
+
+/**
+ * Forget the mode selected for a variable (NULL: for all the variables).
+ * */
+void SZ_autoClearModes(const char* varName)
+{
+	sz_auto_entry** prev = &autoModes;
+	while(*prev != NULL)
+	{
+		sz_auto_entry* entry = *prev;
+		if(varName == NULL || strcmp(entry->varName, varName) == 0)
+		{
+			*prev = entry->next;
+			free(entry->varName);
+			free(entry);
+		}
+		else
+			prev = &entry->next;
+	}
+}
@@ -200,6 +200,7 @@ unsigned int optimize_intervals_double_3D(double *oriData, size_t r1, size_t r2,
 
 unsigned int optimize_intervals_double_4D(double *oriData, size_t r1, size_t r2, size_t r3, size_t r4, double realPrecision)
 {
+	SZ_STATS_BEGIN(intervalStart);
 	size_t i,j,k,l, index;
 	size_t radiusIndex;
 	size_t r234=r2*r3*r4;
@@ -250,6 +251,7 @@ unsigned int optimize_intervals_double_4D(double *oriData, size_t r1, size_t r2,
 		powerOf2 = 32;
 
 	free(intervals);
+	SZ_STATS_END(intervalTime, intervalStart);
 	return powerOf2;
 }
 
@@ -259,7 +261,7 @@ size_t dataLength, double realPrecision, double valueRangeSize, double medianVal
 #ifdef HAVE_TIMECMPR
 	double* decData = NULL;	
 	if(confparams_cpr->szMode == SZ_TEMPORAL_COMPRESSION)
-		decData = (double*)(multisteps->hist_data);
+		decData = (double*)getHistDecBuffer(multisteps);
 #endif	
 	
 	unsigned int quantization_intervals;
@@ -425,14 +427,7 @@ void SZ_compress_args_double_StoreOriData(double* oriData, size_t dataLength, un
 	for (i = 0; i < exe_params->SZ_SIZE_TYPE; i++)//ST: 4 or 8
 		(*newByteData)[k++] = dsLengthBytes[i];
 
-	if(sysEndianType==BIG_ENDIAN_SYSTEM)
-		memcpy((*newByteData)+4+MetaDataByteLength_double+exe_params->SZ_SIZE_TYPE, oriData, dataLength*doubleSize);
-	else
-	{
-		unsigned char* p = (*newByteData)+4+MetaDataByteLength_double+exe_params->SZ_SIZE_TYPE;
-		for(i=0;i<dataLength;i++,p+=doubleSize)
-			doubleToBytes(p, oriData[i]);
-	}
+	copyArrayWithEndian((*newByteData)+4+MetaDataByteLength_double+exe_params->SZ_SIZE_TYPE, (unsigned char*)oriData, dataLength, doubleSize, sysEndianType==LITTLE_ENDIAN_SYSTEM);
 	*outSize = totalByteLength;
 }
 
@@ -491,7 +486,7 @@ TightDataPointStorageD* SZ_compress_double_2D_MDQ(double *oriData, size_t r1, si
 #ifdef HAVE_TIMECMPR	
 	double* decData = NULL;
 	if(confparams_cpr->szMode == SZ_TEMPORAL_COMPRESSION)
-		decData = (double*)(multisteps->hist_data);
+		decData = (double*)getHistDecBuffer(multisteps);
 #endif	
 	
 	double recip_realPrecision = 1/realPrecision;
@@ -739,8 +734,8 @@ char SZ_compress_args_double_NoCkRngeNoGzip_2D(int cmprType, unsigned char** new
 		{
 			if(timestep % confparams_cpr->snapshotCmprStep != 0)
 			{
-				tdps = SZ_compress_double_1D_MDQ_ts(oriData, dataLength, multisteps, realPrecision, valueRangeSize, medianValue_d);
-				compressionType = 1; //time-series based compression 
+				tdps = SZ_compress_double_2D_MDQ_ts(oriData, r1, r2, multisteps, realPrecision, valueRangeSize, medianValue_d);
+				compressionType = 2; //multi-dimensional time-series based compression 
 			}
 			else
 			{	
@@ -757,8 +752,8 @@ char SZ_compress_args_double_NoCkRngeNoGzip_2D(int cmprType, unsigned char** new
 		}
 		else if(cmprType == SZ_FORCE_TEMPORAL_COMPRESSION)
 		{
-			tdps = SZ_compress_double_1D_MDQ_ts(oriData, dataLength, multisteps, realPrecision, valueRangeSize, medianValue_d);
-			compressionType = 1; //time-series based compression 			
+			tdps = SZ_compress_double_2D_MDQ_ts(oriData, r1, r2, multisteps, realPrecision, valueRangeSize, medianValue_d);
+			compressionType = 2; //multi-dimensional time-series based compression 			
 		}
 	}
 	else
@@ -779,7 +774,7 @@ TightDataPointStorageD* SZ_compress_double_3D_MDQ(double *oriData, size_t r1, si
 #ifdef HAVE_TIMECMPR
 	double* decData = NULL;
 	if(confparams_cpr->szMode == SZ_TEMPORAL_COMPRESSION)
-		decData = (double*)(multisteps->hist_data);
+		decData = (double*)getHistDecBuffer(multisteps);
 #endif		
 
 	double recip_realPrecision = 1/realPrecision;
@@ -1144,8 +1139,8 @@ char SZ_compress_args_double_NoCkRngeNoGzip_3D(int cmprType, unsigned char** new
 		{
 			if(timestep % confparams_cpr->snapshotCmprStep != 0)
 			{
-				tdps = SZ_compress_double_1D_MDQ_ts(oriData, dataLength, multisteps, realPrecision, valueRangeSize, medianValue_d);
-				compressionType = 1; //time-series based compression 
+				tdps = SZ_compress_double_3D_MDQ_ts(oriData, r1, r2, r3, multisteps, realPrecision, valueRangeSize, medianValue_d);
+				compressionType = 2; //multi-dimensional time-series based compression 
 			}
 			else
 			{	
@@ -1168,8 +1163,8 @@ char SZ_compress_args_double_NoCkRngeNoGzip_3D(int cmprType, unsigned char** new
 		}
 		else if(cmprType == SZ_FORCE_TEMPORAL_COMPRESSION)
 		{
-			tdps = SZ_compress_double_1D_MDQ_ts(oriData, dataLength, multisteps, realPrecision, valueRangeSize, medianValue_d);
-			compressionType = 1; //time-series based compression 			
+			tdps = SZ_compress_double_3D_MDQ_ts(oriData, r1, r2, r3, multisteps, realPrecision, valueRangeSize, medianValue_d);
+			compressionType = 2; //multi-dimensional time-series based compression 			
 		}		
 	}
 	else
@@ -1538,7 +1533,7 @@ size_t dataLength, double realPrecision, double valueRangeSize, double medianVal
 #ifdef HAVE_TIMECMPR	
 	double* decData = NULL;
 	if(confparams_cpr->szMode == SZ_TEMPORAL_COMPRESSION)
-		decData = (double*)(multisteps->hist_data);
+		decData = (double*)getHistDecBuffer(multisteps);
 #endif	
 
 	//struct ClockPoint clockPointBuild;
@@ -1703,7 +1698,7 @@ TightDataPointStorageD* SZ_compress_double_2D_MDQ_MSST19(double *oriData, size_t
 #ifdef HAVE_TIMECMPR
 	double* decData = NULL;	
 	if(confparams_cpr->szMode == SZ_TEMPORAL_COMPRESSION)
-		decData = (double*)(multisteps->hist_data);
+		decData = (double*)getHistDecBuffer(multisteps);
 #endif	
 	
 	unsigned int quantization_intervals;
@@ -1976,7 +1971,7 @@ TightDataPointStorageD* SZ_compress_double_3D_MDQ_MSST19(double *oriData, size_t
 #ifdef HAVE_TIMECMPR	
 	double* decData = NULL;
 	if(confparams_cpr->szMode == SZ_TEMPORAL_COMPRESSION)
-		decData = (double*)(multisteps->hist_data);
+		decData = (double*)getHistDecBuffer(multisteps);
 #endif		
 
 	unsigned int quantization_intervals;
@@ -2503,6 +2498,10 @@ int errBoundMode, double absErr_Bound, double relBoundRatio, double pwrErrRatio)
 	return status;
 }*/
 
+/**
+ * If *newByteData is not NULL, the compressed bytes are written into the caller's buffer *newByteData, 
+ * whose size is given by *outSize (see SZ_compress_bound()); *newByteData is set to NULL if the buffer is too small.
+ * */
 int SZ_compress_args_double(int cmprType, unsigned char** newByteData, double *oriData, 
 size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, size_t *outSize, 
 int errBoundMode, double absErr_Bound, double relBoundRatio, double pwRelBoundRatio)
@@ -2515,11 +2514,13 @@ int errBoundMode, double absErr_Bound, double relBoundRatio, double pwRelBoundRa
 		
 	int status = SZ_SCES;
 	size_t dataLength = computeDataLength(r5,r4,r3,r2,r1);
+	unsigned char* userBytes = *newByteData;
+	size_t userCapacity = userBytes==NULL ? 0 : *outSize;
 	
 	if(dataLength <= MIN_NUM_OF_ELEMENTS)
 	{
 		*newByteData = SZ_skip_compress_double(oriData, dataLength, outSize);
-		return status;
+		return sz_move_to_buffer(newByteData, *outSize, userBytes, userCapacity);
 	}
 	
 	double valueRangeSize = 0, medianValue = 0;
@@ -2531,6 +2532,7 @@ int errBoundMode, double absErr_Bound, double relBoundRatio, double pwRelBoundRa
 	if(pwRelBoundRatio < 0.000009999)
 		confparams_cpr->accelerate_pw_rel_compression = 0;
 		
+	SZ_STATS_BEGIN(rangeStart);
 	if(confparams_cpr->errorBoundMode == PW_REL && confparams_cpr->accelerate_pw_rel_compression == 1)
 	{
 		signs = (unsigned char *) malloc(dataLength);
@@ -2539,6 +2541,7 @@ int errBoundMode, double absErr_Bound, double relBoundRatio, double pwRelBoundRa
 	}
 	else
 		min = computeRangeSize_double(oriData, dataLength, &valueRangeSize, &medianValue);	
+	SZ_STATS_END(rangeTime, rangeStart);
 	double max = min+valueRangeSize;
 	confparams_cpr->dmin = min;
 	confparams_cpr->dmax = max;
@@ -2565,7 +2568,9 @@ int errBoundMode, double absErr_Bound, double relBoundRatio, double pwRelBoundRa
 	{
 		if(confparams_cpr->errorBoundMode>=PW_REL && confparams_cpr->accelerate_pw_rel_compression == 1)
 			free(signs);		
+		*newByteData = NULL;
 		SZ_compress_args_double_withinRange(newByteData, oriData, dataLength, outSize);
+		status = sz_move_to_buffer(newByteData, *outSize, userBytes, userCapacity);
 	}
 	else
 	{
@@ -2686,12 +2691,30 @@ int errBoundMode, double absErr_Bound, double relBoundRatio, double pwRelBoundRa
 		//Call Gzip to do the further compression.
 		if(confparams_cpr->szMode==SZ_BEST_SPEED)
 		{
+			SZ_STATS_SET(szBytes, tmpOutSize);
 			*outSize = tmpOutSize;
 			*newByteData = tmpByteData;			
+			status = sz_move_to_buffer(newByteData, *outSize, userBytes, userCapacity);
 		}
 		else if(confparams_cpr->szMode==SZ_BEST_COMPRESSION || confparams_cpr->szMode==SZ_DEFAULT_COMPRESSION || confparams_cpr->szMode==SZ_TEMPORAL_COMPRESSION)
 		{
-			*outSize = sz_lossless_compress(confparams_cpr->losslessCompressor, confparams_cpr->gzipMode, tmpByteData, tmpOutSize, newByteData);
+			SZ_STATS_SET(szBytes, tmpOutSize);
+			SZ_STATS_BEGIN(losslessStart);
+			if(userBytes==NULL)
+				*outSize = sz_lossless_compress(confparams_cpr->losslessCompressor, confparams_cpr->gzipMode, tmpByteData, tmpOutSize, newByteData);
+			else //no temporary array: the lossless compressor writes into the caller's buffer directly
+			{
+				*outSize = sz_lossless_compress_to_buffer(confparams_cpr->losslessCompressor, confparams_cpr->gzipMode, tmpByteData, tmpOutSize, userBytes, userCapacity);
+				if(*outSize==0)
+				{
+					printf("Error: the output buffer is too small (%zu bytes) in the double compression\n", userCapacity);
+					*newByteData = NULL;
+					status = SZ_NSCS;
+				}
+				else
+					*newByteData = userBytes;
+			}
+			SZ_STATS_END(losslessTime, losslessStart);
 			free(tmpByteData);
 		}
 		else
@@ -4296,6 +4319,7 @@ unsigned int optimize_intervals_double_3D_opt_MSST19(double *oriData, size_t r1,
 	return powerOf2;
 }
 unsigned int optimize_intervals_double_3D_opt(double *oriData, size_t r1, size_t r2, size_t r3, double realPrecision){	
+	SZ_STATS_BEGIN(intervalStart);
 	size_t i;
 	size_t radiusIndex;
 	size_t r23=r2*r3;
@@ -4351,6 +4375,7 @@ unsigned int optimize_intervals_double_3D_opt(double *oriData, size_t r1, size_t
 	if(powerOf2<32)
 		powerOf2 = 32;
 	free(intervals);
+	SZ_STATS_END(intervalTime, intervalStart);
 	return powerOf2;
 }
 
@@ -4652,6 +4677,7 @@ size_t SZ_compress_double_3D_MDQ_RA_block(double * block_ori_data, double * mean
 
 unsigned int optimize_intervals_double_2D_opt(double *oriData, size_t r1, size_t r2, double realPrecision)
 {	
+	SZ_STATS_BEGIN(intervalStart);
 	size_t i;
 	size_t radiusIndex;
 	double pred_value = 0, pred_err;
@@ -4702,11 +4728,13 @@ unsigned int optimize_intervals_double_2D_opt(double *oriData, size_t r1, size_t
 		powerOf2 = 32;
 
 	free(intervals);
+	SZ_STATS_END(intervalTime, intervalStart);
 	return powerOf2;
 }
 
 unsigned int optimize_intervals_double_1D_opt(double *oriData, size_t dataLength, double realPrecision)
 {	
+	SZ_STATS_BEGIN(intervalStart);
 	size_t i = 0, radiusIndex;
 	double pred_value = 0, pred_err;
 	size_t *intervals = (size_t*)malloc(confparams_cpr->maxRangeRadius*sizeof(size_t));
@@ -4744,12 +4772,14 @@ unsigned int optimize_intervals_double_1D_opt(double *oriData, size_t dataLength
 		powerOf2 = 32;
 	
 	free(intervals);
+	SZ_STATS_END(intervalTime, intervalStart);
 	return powerOf2;
 }
 
 /*The above code is for sz 1.4.13; the following code is for sz 2.0*/
 unsigned int optimize_intervals_double_2D_with_freq_and_dense_pos(double *oriData, size_t r1, size_t r2, double realPrecision, double * dense_pos, double * max_freq, double * mean_freq)
 {	
+	SZ_STATS_BEGIN(intervalStart);
 	double mean = 0.0;
 	size_t len = r1 * r2;
 	size_t mean_distance = (int) (sqrt(len));
@@ -4854,11 +4884,13 @@ unsigned int optimize_intervals_double_2D_with_freq_and_dense_pos(double *oriDat
 
 	free(freq_intervals);
 	free(intervals);
+	SZ_STATS_END(intervalTime, intervalStart);
 	return powerOf2;
 }
 
 unsigned int optimize_intervals_double_3D_with_freq_and_dense_pos(double *oriData, size_t r1, size_t r2, size_t r3, double realPrecision, double * dense_pos, double * max_freq, double * mean_freq)
 {	
+	SZ_STATS_BEGIN(intervalStart);
 	double mean = 0.0;
 	size_t len = r1 * r2 * r3;
 	size_t mean_distance = (int) (sqrt(len));
@@ -4983,15 +5015,306 @@ unsigned int optimize_intervals_double_3D_with_freq_and_dense_pos(double *oriDat
 
 	free(freq_intervals);
 	free(intervals);
+	SZ_STATS_END(intervalTime, intervalStart);
 	return powerOf2;
 }
 
 #define MIN(a, b) a<b? a : b
+/**
+ * Fit the linear regression coefficients of one block; they are stored with a stride of num_blocks in reg_params.
+ * */
+void fit_block_regression_double_2D(double * data_pos, size_t current_blockcount_x, size_t current_blockcount_y, 
+size_t dim0_offset, size_t num_blocks, double * reg_params_pos)
+{
+	size_t params_offset_b = num_blocks;
+	size_t params_offset_c = 2*num_blocks;
+	double * cur_data_pos = data_pos;
+	double fx = 0.0;
+	double fy = 0.0;
+	double f = 0;
+	double sum_x;
+	double curData;
+	for(size_t ii=0; ii<current_blockcount_x; ii++){
+		sum_x = 0;
+		for(size_t jj=0; jj<current_blockcount_y; jj++){
+			curData = *cur_data_pos;
+			sum_x += curData;
+			fy += curData * jj;
+			cur_data_pos ++;
+		}
+		fx += sum_x * ii;
+		f += sum_x;
+		cur_data_pos += dim0_offset - current_blockcount_y;
+	}
+	double coeff = 1.0 / (current_blockcount_x * current_blockcount_y);
+	reg_params_pos[0] = (2 * fx / (current_blockcount_x - 1) - f) * 6 * coeff / (current_blockcount_x + 1);
+	reg_params_pos[params_offset_b] = (2 * fy / (current_blockcount_y - 1) - f) * 6 * coeff / (current_blockcount_y + 1);
+	reg_params_pos[params_offset_c] = f * coeff - ((current_blockcount_x - 1) * reg_params_pos[0] / 2 + (current_blockcount_y - 1) * reg_params_pos[params_offset_b] / 2);
+}
+
+/**
+ * Compare the errors of the regression and the Lorenzo predictors on the two diagonals of a block.
+ * Return 1 if Lorenzo should be used, 0 for regression.
+ * */
+unsigned char choose_block_predictor_double_2D(double * data_pos, size_t current_blockcount_x, size_t current_blockcount_y, 
+size_t dim0_offset, size_t num_blocks, double * reg_params_pos, double noise, unsigned char use_mean, double mean)
+{
+	size_t params_offset_b = num_blocks;
+	size_t params_offset_c = 2*num_blocks;
+	// [1, 1] [3, 3] [5, 5] [7, 7] [9, 9]
+	// [1, 9] [3, 7]		[7, 3] [9, 1]
+	double * cur_data_pos;
+	double curData;
+	double pred_reg, pred_sz;
+	double err_sz = 0.0, err_reg = 0.0;
+	int bmi = 0;
+	int min_size = MIN(current_blockcount_x, current_blockcount_y);
+	for(int s=1; s<min_size; s++){
+		cur_data_pos = data_pos + s * dim0_offset + s;
+		curData = *cur_data_pos;
+		pred_sz = cur_data_pos[-1] + cur_data_pos[-dim0_offset] - cur_data_pos[-dim0_offset - 1];
+		pred_reg = reg_params_pos[0] * s + reg_params_pos[params_offset_b] * s + reg_params_pos[params_offset_c];
+		err_sz += use_mean ? MIN(fabs(pred_sz - curData) + noise, fabs(mean - curData)) : fabs(pred_sz - curData) + noise;
+		err_reg += fabs(pred_reg - curData);
+
+		bmi = min_size - s;
+		cur_data_pos = data_pos + s*dim0_offset + bmi;
+		curData = *cur_data_pos;
+		pred_sz = cur_data_pos[-1] + cur_data_pos[-dim0_offset] - cur_data_pos[-dim0_offset - 1];
+		// the sampling without mean has always used row s-1 for the anti-diagonal regression error
+		pred_reg = reg_params_pos[0] * (use_mean ? s : s-1) + reg_params_pos[params_offset_b] * bmi + reg_params_pos[params_offset_c];
+		err_sz += use_mean ? MIN(fabs(pred_sz - curData) + noise, fabs(mean - curData)) : fabs(pred_sz - curData) + noise;
+		err_reg += fabs(pred_reg - curData);
+	}
+	return (err_reg < err_sz) ? 0 : 1;
+}
+
+/**
+ * Choose the predictor of every block of a 2D field (see choose_block_predictor_double_2D).
+ * indicator[b] is set to 1 for the blocks using Lorenzo and to 0 for the blocks using regression.
+ * */
+void select_block_predictors_double_2D(double *oriData, size_t r1, size_t r2, size_t block_size, double * reg_params, 
+double noise, unsigned char use_mean, double mean, unsigned char * indicator)
+{
+	size_t num_x, num_y;
+	SZ_COMPUTE_2D_NUMBER_OF_BLOCKS(r1, num_x, block_size);
+	SZ_COMPUTE_2D_NUMBER_OF_BLOCKS(r2, num_y, block_size);
+
+	size_t split_index_x, split_index_y;
+	size_t early_blockcount_x, early_blockcount_y;
+	size_t late_blockcount_x, late_blockcount_y;
+	SZ_COMPUTE_BLOCKCOUNT(r1, num_x, split_index_x, early_blockcount_x, late_blockcount_x);
+	SZ_COMPUTE_BLOCKCOUNT(r2, num_y, split_index_y, early_blockcount_y, late_blockcount_y);
+
+	size_t num_blocks = num_x * num_y;
+	size_t dim0_offset = r2;
+	long b;
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for(b=0; b<(long)num_blocks; b++){
+		size_t i = b / num_y;
+		size_t j = b % num_y;
+		size_t current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
+		size_t current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
+		size_t offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
+		size_t offset_y = (j < split_index_y) ? j * early_blockcount_y : j * late_blockcount_y + split_index_y;
+		double * data_pos = oriData + offset_x * dim0_offset + offset_y;
+		indicator[b] = choose_block_predictor_double_2D(data_pos, current_blockcount_x, current_blockcount_y, dim0_offset, num_blocks, reg_params + b, noise, use_mean, mean);
+	}
+}
+
+/**
+ * Fused sampling stage of the 2D blocked regression compressor (see sample_blocked_regression_double_3D).
+ * */
+void sample_blocked_regression_double_2D(double *oriData, size_t r1, size_t r2, size_t block_size, double realPrecision, 
+unsigned char use_mean, double dense_pos, double noise, double * mean, double * reg_params, unsigned char * indicator)
+{
+	size_t num_x, num_y;
+	SZ_COMPUTE_2D_NUMBER_OF_BLOCKS(r1, num_x, block_size);
+	SZ_COMPUTE_2D_NUMBER_OF_BLOCKS(r2, num_y, block_size);
+
+	size_t split_index_x, split_index_y;
+	size_t early_blockcount_x, early_blockcount_y;
+	size_t late_blockcount_x, late_blockcount_y;
+	SZ_COMPUTE_BLOCKCOUNT(r1, num_x, split_index_x, early_blockcount_x, late_blockcount_x);
+	SZ_COMPUTE_BLOCKCOUNT(r2, num_y, split_index_y, early_blockcount_y, late_blockcount_y);
+
+	size_t num_blocks = num_x * num_y;
+	size_t dim0_offset = r2;
+	double * mean_sum = NULL;
+	size_t * mean_count = NULL;
+	if(use_mean){
+		mean_sum = (double *) malloc(num_blocks * sizeof(double));
+		mean_count = (size_t *) malloc(num_blocks * sizeof(size_t));
+	}
+	long b;
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for(b=0; b<(long)num_blocks; b++){
+		size_t i = b / num_y;
+		size_t j = b % num_y;
+		size_t current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
+		size_t current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
+		size_t offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
+		size_t offset_y = (j < split_index_y) ? j * early_blockcount_y : j * late_blockcount_y + split_index_y;
+		double * data_pos = oriData + offset_x * dim0_offset + offset_y;
+		fit_block_regression_double_2D(data_pos, current_blockcount_x, current_blockcount_y, dim0_offset, num_blocks, reg_params + b);
+		if(use_mean){
+			double sum = 0;
+			size_t count = 0;
+			for(size_t ii=0; ii<current_blockcount_x; ii++){
+				double * cur_data_pos = data_pos + ii*dim0_offset;
+				for(size_t jj=0; jj<current_blockcount_y; jj++){
+					if(fabs(cur_data_pos[jj] - dense_pos) < realPrecision){
+						sum += cur_data_pos[jj];
+						count ++;
+					}
+				}
+			}
+			mean_sum[b] = sum;
+			mean_count[b] = count;
+		}
+		else
+			indicator[b] = choose_block_predictor_double_2D(data_pos, current_blockcount_x, current_blockcount_y, dim0_offset, num_blocks, reg_params + b, noise, 0, 0);
+	}
+	*mean = 0;
+	if(use_mean){
+		double sum = 0;
+		size_t count = 0;
+		for(size_t i=0; i<num_blocks; i++){
+			sum += mean_sum[i];
+			count += mean_count[i];
+		}
+		if(count > 0) *mean = sum / count;
+		free(mean_sum);
+		free(mean_count);
+		select_block_predictors_double_2D(oriData, r1, r2, block_size, reg_params, noise, use_mean, *mean, indicator);
+	}
+}
+
+/**
+ * Compressed size of the sample with the current settings (including the lossless stage):
+ * r3==0 means 2D (r1*r2) data.
+ * */
+static size_t compress_regression_sample_double(double *sample, size_t r1, size_t r2, size_t r3, double realPrecision)
+{
+	size_t tmpSize = 0, cmprSize;
+	unsigned char *tmp;
+	if(r3 == 0)
+		tmp = SZ_compress_double_2D_MDQ_nonblocked_with_blocked_regression(sample, r1, r2, realPrecision, &tmpSize);
+	else
+		tmp = SZ_compress_double_3D_MDQ_nonblocked_with_blocked_regression(sample, r1, r2, r3, realPrecision, &tmpSize);
+	cmprSize = tmpSize;
+	if(confparams_cpr->szMode != SZ_BEST_SPEED)
+	{
+		unsigned char *cmpr = NULL;
+		cmprSize = sz_lossless_compress(confparams_cpr->losslessCompressor, confparams_cpr->gzipMode, tmp, tmpSize, &cmpr);
+		free(cmpr);
+	}
+	free(tmp);
+	return cmprSize;
+}
+
+/**
+ * Compress the sample with each candidate block size and return the one giving the smallest stream,
+ * or default_size unless the smallest stream is under REG_SAMPLE_GAIN times the one of default_size.
+ * The compressions of the sample leave no trace in the settings or the statistics of the compression.
+ * */
+static size_t select_regression_block_size_double(double *sample, size_t r1, size_t r2, size_t r3, double realPrecision, size_t *candidates, int nbCandidates, size_t default_size)
+{
+	int savedBlockSize = confparams_cpr->regressionBlockSize;
+	int savedIntvCapacity = exe_params->intvCapacity, savedIntvRadius = exe_params->intvRadius;
+	int savedStatsEnabled = sz_stats_enabled;
+	size_t best = default_size, bestSize = 0, defaultSize = 0;
+	int c;
+	sz_stats_enabled = 0;
+	for(c=0;c<nbCandidates;c++)
+	{
+		confparams_cpr->regressionBlockSize = candidates[c];
+		size_t cmprSize = compress_regression_sample_double(sample, r1, r2, r3, realPrecision);
+		if(candidates[c] == default_size)
+			defaultSize = cmprSize;
+		if(c == 0 || cmprSize < bestSize)
+		{
+			best = candidates[c];
+			bestSize = cmprSize;
+		}
+	}
+	confparams_cpr->regressionBlockSize = savedBlockSize;
+	exe_params->intvCapacity = savedIntvCapacity;
+	exe_params->intvRadius = savedIntvRadius;
+	sz_stats_enabled = savedStatsEnabled;
+	if(bestSize < REG_SAMPLE_GAIN*defaultSize)
+		return best;
+	return default_size;
+}
+
+/**
+ * Choose the block size of SZ_compress_double_2D_MDQ_nonblocked_with_blocked_regression (8, 16, 24 or 32; 16 by default)
+ * by compressing a sample made of a grid of REG_SAMPLE_GRID_2D^2 squares of REG_SAMPLE_SIDE_2D^2 points.
+ * Data of fewer than REG_SAMPLE_MIN_POINTS points, and the temporal compression, keep the default.
+ * */
+size_t optimize_regression_block_size_double_2D(double *oriData, size_t r1, size_t r2, double realPrecision)
+{
+	size_t candidates[4] = {8, 16, 24, 32};
+	size_t s = REG_SAMPLE_SIDE_2D, g = REG_SAMPLE_GRID_2D, n = g*g, a, b, i;
+	if(confparams_cpr->szMode == SZ_TEMPORAL_COMPRESSION || r1 < s || r2 < s || r1*r2 < REG_SAMPLE_MIN_POINTS)
+		return 16;
+
+	//the squares are centered in the cells of a g*g grid over the data, and stacked along the first dimension
+	double *sample = (double *) malloc(n*s*s*sizeof(double));
+	double *p = sample;
+	for(a=0;a<g;a++)
+		for(b=0;b<g;b++)
+		{
+			size_t x = (r1 - s) * (2*a + 1) / (2*g);
+			size_t y = (r2 - s) * (2*b + 1) / (2*g);
+			for(i=0;i<s;i++, p+=s)
+				memcpy(p, oriData + (x + i)*r2 + y, s*sizeof(double));
+		}
+	size_t block_size = select_regression_block_size_double(sample, n*s, s, 0, realPrecision, candidates, 4, 16);
+	free(sample);
+	return block_size;
+}
+
+/**
+ * Choose the block size of SZ_compress_double_3D_MDQ_nonblocked_with_blocked_regression (4, 6, 8 or 12; 6 by default)
+ * by compressing a sample made of a grid of REG_SAMPLE_GRID_3D^3 cubes of REG_SAMPLE_SIDE_3D^3 points.
+ * Data of fewer than REG_SAMPLE_MIN_POINTS points, and the temporal compression, keep the default.
+ * */
+size_t optimize_regression_block_size_double_3D(double *oriData, size_t r1, size_t r2, size_t r3, double realPrecision)
+{
+	size_t candidates[4] = {4, 6, 8, 12};
+	size_t s = REG_SAMPLE_SIDE_3D, g = REG_SAMPLE_GRID_3D, n = g*g*g, a, b, c, i, j;
+	if(confparams_cpr->szMode == SZ_TEMPORAL_COMPRESSION || r1 < s || r2 < s || r3 < s || r1*r2*r3 < REG_SAMPLE_MIN_POINTS)
+		return 6;
+
+	//the cubes are centered in the cells of a g*g*g grid over the data, and stacked along the first dimension
+	double *sample = (double *) malloc(n*s*s*s*sizeof(double));
+	double *p = sample;
+	for(a=0;a<g;a++)
+		for(b=0;b<g;b++)
+			for(c=0;c<g;c++)
+			{
+				size_t x = (r1 - s) * (2*a + 1) / (2*g);
+				size_t y = (r2 - s) * (2*b + 1) / (2*g);
+				size_t z = (r3 - s) * (2*c + 1) / (2*g);
+				for(i=0;i<s;i++)
+					for(j=0;j<s;j++, p+=s)
+						memcpy(p, oriData + ((x + i)*r2 + y + j)*r3 + z, s*sizeof(double));
+			}
+	size_t block_size = select_regression_block_size_double(sample, n*s, s, s, realPrecision, candidates, 4, 6);
+	free(sample);
+	return block_size;
+}
+
 unsigned char * SZ_compress_double_2D_MDQ_nonblocked_with_blocked_regression(double *oriData, size_t r1, size_t r2, double realPrecision, size_t * comp_size){
 
 	unsigned int quantization_intervals;
 	double sz_sample_correct_freq = -1;//0.5; //-1
-	double dense_pos;
+	double dense_pos = 0;
 	double mean_flush_freq;
 	unsigned char use_mean = 0;
 
@@ -5007,7 +5330,11 @@ unsigned char * SZ_compress_double_2D_MDQ_nonblocked_with_blocked_regression(dou
 
 	// calculate block dims
 	size_t num_x, num_y;
-	size_t block_size = 16;
+	size_t block_size;
+	if(confparams_cpr->regressionBlockSize > 0)
+		block_size = confparams_cpr->regressionBlockSize;
+	else
+		block_size = optimize_regression_block_size_double_2D(oriData, r1, r2, realPrecision);
 
 	SZ_COMPUTE_2D_NUMBER_OF_BLOCKS(r1, num_x, block_size);
 	SZ_COMPUTE_2D_NUMBER_OF_BLOCKS(r2, num_y, block_size);
@@ -5031,52 +5358,11 @@ unsigned char * SZ_compress_double_2D_MDQ_nonblocked_with_blocked_regression(dou
 	size_t unpredictable_count;
 	double * data_pos = oriData;
 	int * type = result_type;
-	size_t offset_x, offset_y;
+	size_t offset_x;
 	size_t current_blockcount_x, current_blockcount_y;
 
 	double * reg_params = (double *) malloc(num_blocks * 4 * sizeof(double));
-	double * reg_params_pos = reg_params;
-	// move regression part out
-	size_t params_offset_b = num_blocks;
-	size_t params_offset_c = 2*num_blocks;
-	for(size_t i=0; i<num_x; i++){
-		for(size_t j=0; j<num_y; j++){
-			current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
-			current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
-			offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
-			offset_y = (j < split_index_y) ? j * early_blockcount_y : j * late_blockcount_y + split_index_y;
-
-			data_pos = oriData + offset_x * dim0_offset + offset_y;
-
-			{
-				double * cur_data_pos = data_pos;
-				double fx = 0.0;
-				double fy = 0.0;
-				double f = 0;
-				double sum_x; 
-				double curData;
-				for(size_t i=0; i<current_blockcount_x; i++){
-					sum_x = 0;
-					for(size_t j=0; j<current_blockcount_y; j++){
-						curData = *cur_data_pos;
-						sum_x += curData;
-						fy += curData * j;
-						cur_data_pos ++;
-					}
-					fx += sum_x * i;
-					f += sum_x;
-					cur_data_pos += dim0_offset - current_blockcount_y;
-				}
-				double coeff = 1.0 / (current_blockcount_x * current_blockcount_y);
-				reg_params_pos[0] = (2 * fx / (current_blockcount_x - 1) - f) * 6 * coeff / (current_blockcount_x + 1);
-				reg_params_pos[params_offset_b] = (2 * fy / (current_blockcount_y - 1) - f) * 6 * coeff / (current_blockcount_y + 1);
-				reg_params_pos[params_offset_c] = f * coeff - ((current_blockcount_x - 1) * reg_params_pos[0] / 2 + (current_blockcount_y - 1) * reg_params_pos[params_offset_b] / 2);
-			}
-
-			reg_params_pos ++;
-		}
-	}
-
+	double * reg_params_pos;
 	//Compress coefficient arrays
 	double precision_a, precision_b, precision_c;
 	double rel_param_err = 0.15/3;
@@ -5086,18 +5372,6 @@ unsigned char * SZ_compress_double_2D_MDQ_nonblocked_with_blocked_regression(dou
 
 	double mean = 0;
 	use_mean = 0;
-	if(use_mean){
-		// compute mean
-		double sum = 0.0;
-		size_t mean_count = 0;
-		for(size_t i=0; i<num_elements; i++){
-			if(fabs(oriData[i] - dense_pos) < realPrecision){
-				sum += oriData[i];
-				mean_count ++;
-			}
-		}
-		if(mean_count > 0) mean = sum / mean_count;
-	}
 
 	// use two prediction buffers for higher performance
 	double * unpredictable_data = result_unpredictable_data;
@@ -5141,6 +5415,8 @@ unsigned char * SZ_compress_double_2D_MDQ_nonblocked_with_blocked_regression(dou
 	int coeff_index = 0;
 	unsigned int coeff_unpredictable_count[3] = {0};
 	double noise = realPrecision * 0.81;
+	// fit the coefficients, compute the mean and choose the predictor of each block in one sweep
+	sample_blocked_regression_double_2D(oriData, r1, r2, block_size, realPrecision, use_mean, dense_pos, noise, &mean, reg_params, indicator);
 	if(use_mean){
 		type = result_type;
 		int intvCapacity_sz = intvCapacity - 2;
@@ -5155,37 +5431,9 @@ unsigned char * SZ_compress_double_2D_MDQ_nonblocked_with_blocked_regression(dou
 			double * next_pb_pos = next_pb_buf_pos;
 
 			for(size_t j=0; j<num_y; j++){
-				offset_y = (j < split_index_y) ? j * early_blockcount_y : j * late_blockcount_y + split_index_y;
 				current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
 				
-				/*sampling: decide which predictor to use (regression or lorenzo)*/
-				{
-					double * cur_data_pos;
-					double curData;
-					double pred_reg, pred_sz;
-					double err_sz = 0.0, err_reg = 0.0;
-					// [1, 1] [3, 3] [5, 5] [7, 7] [9, 9]
-					// [1, 9] [3, 7]		[7, 3] [9, 1]
-					int bmi = 0;
-					int block_size = MIN(current_blockcount_x, current_blockcount_y);
-					for(int i=1; i<block_size; i++){
-						cur_data_pos = data_pos + i * dim0_offset + i;
-						curData = *cur_data_pos;
-						pred_sz = cur_data_pos[-1] + cur_data_pos[-dim0_offset] - cur_data_pos[-dim0_offset - 1];
-						pred_reg = reg_params_pos[0] * i + reg_params_pos[params_offset_b] * i + reg_params_pos[params_offset_c];							
-						err_sz += MIN(fabs(pred_sz - curData) + noise, fabs(mean - curData));
-						err_reg += fabs(pred_reg - curData);
-
-						bmi = block_size - i;
-						cur_data_pos = data_pos + i*dim0_offset + bmi;
-						curData = *cur_data_pos;
-						pred_sz = cur_data_pos[-1] + cur_data_pos[-dim0_offset] - cur_data_pos[-dim0_offset - 1];
-						pred_reg = reg_params_pos[0] * i + reg_params_pos[params_offset_b] * bmi + reg_params_pos[params_offset_c];							
-						err_sz += MIN(fabs(pred_sz - curData) + noise, fabs(mean - curData));
-						err_reg += fabs(pred_reg - curData);								
-					}
-					use_reg = (err_reg < err_sz);
-				}
+				use_reg = !indicator_pos[j];
 				if(use_reg)
 				{
 					{
@@ -5434,8 +5682,6 @@ unsigned char * SZ_compress_double_2D_MDQ_nonblocked_with_blocked_regression(dou
 					}
 					total_unpred += unpredictable_count;
 					unpredictable_data += unpredictable_count;
-					// change indicator
-					indicator_pos[j] = 1;
 				}// end SZ
 				reg_params_pos ++;
 				data_pos += current_blockcount_y;
@@ -5464,37 +5710,8 @@ unsigned char * SZ_compress_double_2D_MDQ_nonblocked_with_blocked_regression(dou
 			double * next_pb_pos = next_pb_buf_pos;
 
 			for(size_t j=0; j<num_y; j++){
-				offset_y = (j < split_index_y) ? j * early_blockcount_y : j * late_blockcount_y + split_index_y;
 				current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
-				/*sampling*/
-				{
-					// sample [2i + 1, 2i + 1] [2i + 1, bs - 2i]
-					double * cur_data_pos;
-					double curData;
-					double pred_reg, pred_sz;
-					double err_sz = 0.0, err_reg = 0.0;
-					// [1, 1] [3, 3] [5, 5] [7, 7] [9, 9]
-					// [1, 9] [3, 7]		[7, 3] [9, 1]
-					int bmi = 0;
-					int block_size = MIN(current_blockcount_x, current_blockcount_y);
-					for(int i=1; i<block_size; i++){
-						cur_data_pos = data_pos + i * dim0_offset + i;
-						curData = *cur_data_pos;
-						pred_sz = cur_data_pos[-1] + cur_data_pos[-dim0_offset] - cur_data_pos[-dim0_offset - 1];
-						pred_reg = reg_params_pos[0] * i + reg_params_pos[params_offset_b] * i + reg_params_pos[params_offset_c];							
-						err_sz += fabs(pred_sz - curData) + noise;
-						err_reg += fabs(pred_reg - curData);
-
-						bmi = block_size - i;
-						cur_data_pos = data_pos + i*dim0_offset + bmi;
-						curData = *cur_data_pos;
-						pred_sz = cur_data_pos[-1] + cur_data_pos[-dim0_offset] - cur_data_pos[-dim0_offset - 1];
-						pred_reg = reg_params_pos[0] * (i-1) + reg_params_pos[params_offset_b] * bmi + reg_params_pos[params_offset_c];							
-						err_sz += fabs(pred_sz - curData) + noise;
-						err_reg += fabs(pred_reg - curData);								
-					}
-					use_reg = (err_reg < err_sz);
-				}
+				use_reg = !indicator_pos[j];
 				if(use_reg)
 				{
 					{
@@ -5730,8 +5947,6 @@ unsigned char * SZ_compress_double_2D_MDQ_nonblocked_with_blocked_regression(dou
 					}
 					total_unpred += unpredictable_count;
 					unpredictable_data += unpredictable_count;
-					// change indicator
-					indicator_pos[j] = 1;
 				}// end SZ
 				reg_params_pos ++;
 				data_pos += current_blockcount_y;
@@ -5750,6 +5965,7 @@ unsigned char * SZ_compress_double_2D_MDQ_nonblocked_with_blocked_regression(dou
 	free(prediction_buffer_2);
 
 	int stateNum = 2*quantization_intervals;
+	SZ_STATS_BEGIN(huffmanStart);
 	HuffmanTree* huffmanTree = createHuffmanTree(stateNum);
 
 	size_t nodeCount = 0;
@@ -5761,6 +5977,7 @@ unsigned char * SZ_compress_double_2D_MDQ_nonblocked_with_blocked_regression(dou
 
 	unsigned char *treeBytes;
 	unsigned int treeByteSize = convert_HuffTree_to_bytes_anyStates(huffmanTree, nodeCount, &treeBytes);
+	SZ_STATS_END(huffmanTime, huffmanStart);
 
 	unsigned int meta_data_offset = 3 + 1 + MetaDataByteLength_double;
 	// total size 										metadata		  # elements   real precision		intervals	nodeCount		huffman 	 	block index 						unpredicatable count						mean 					 	unpred size 				elements
@@ -5838,7 +6055,9 @@ unsigned char * SZ_compress_double_2D_MDQ_nonblocked_with_blocked_regression(dou
 	memcpy(result_pos, result_unpredictable_data, total_unpred * sizeof(double));
 	result_pos += total_unpred * sizeof(double);
 	size_t typeArray_size = 0;
+	SZ_STATS_BEGIN(encodeStart);
 	encode(huffmanTree, result_type, num_elements, result_pos, &typeArray_size);
+	SZ_STATS_END(huffmanTime, encodeStart);
 	result_pos += typeArray_size;
 
 	size_t totalEncodeSize = result_pos - result;
@@ -5848,28 +6067,254 @@ unsigned char * SZ_compress_double_2D_MDQ_nonblocked_with_blocked_regression(dou
 	free(reg_params);
 	
 	SZ_ReleaseHuffman(huffmanTree);
+	SZ_STATS_ADD(huffmanBytes, treeByteSize + typeArray_size);
+	SZ_STATS_ADD(huffmanTreeBytes, treeByteSize);
+	SZ_STATS_ADD(unpredCount, total_unpred);
+	SZ_STATS_SET(intervals, quantization_intervals);
+	SZ_STATS_SET(regressionBlockFraction, (double)reg_count/num_blocks);
 	*comp_size = totalEncodeSize;
 
 	return result;
 }
 
+/**
+ * Fit the linear regression coefficients of one block; they are stored with a stride of num_blocks in reg_params.
+ * */
+void fit_block_regression_double_3D(double * data_pos, size_t current_blockcount_x, size_t current_blockcount_y, size_t current_blockcount_z, 
+size_t dim0_offset, size_t dim1_offset, size_t num_blocks, double * reg_params_pos)
+{
+	size_t params_offset_b = num_blocks;
+	size_t params_offset_c = 2*num_blocks;
+	size_t params_offset_d = 3*num_blocks;
+	double * cur_data_pos = data_pos;
+	double fx = 0.0;
+	double fy = 0.0;
+	double fz = 0.0;
+	double f = 0;
+	double sum_x, sum_y;
+	double curData;
+	for(size_t ii=0; ii<current_blockcount_x; ii++){
+		sum_x = 0;
+		for(size_t jj=0; jj<current_blockcount_y; jj++){
+			sum_y = 0;
+			for(size_t kk=0; kk<current_blockcount_z; kk++){
+				curData = *cur_data_pos;
+				sum_y += curData;
+				fz += curData * kk;
+				cur_data_pos ++;
+			}
+			fy += sum_y * jj;
+			sum_x += sum_y;
+			cur_data_pos += dim1_offset - current_blockcount_z;
+		}
+		fx += sum_x * ii;
+		f += sum_x;
+		cur_data_pos += dim0_offset - current_blockcount_y * dim1_offset;
+	}
+	double coeff = 1.0 / (current_blockcount_x * current_blockcount_y * current_blockcount_z);
+	reg_params_pos[0] = (2 * fx / (current_blockcount_x - 1) - f) * 6 * coeff / (current_blockcount_x + 1);
+	reg_params_pos[params_offset_b] = (2 * fy / (current_blockcount_y - 1) - f) * 6 * coeff / (current_blockcount_y + 1);
+	reg_params_pos[params_offset_c] = (2 * fz / (current_blockcount_z - 1) - f) * 6 * coeff / (current_blockcount_z + 1);
+	reg_params_pos[params_offset_d] = f * coeff - ((current_blockcount_x - 1) * reg_params_pos[0] / 2 + (current_blockcount_y - 1) * reg_params_pos[params_offset_b] / 2 + (current_blockcount_z - 1) * reg_params_pos[params_offset_c] / 2);
+}
+
+/**
+ * Compare the errors of the regression and the Lorenzo predictors on the diagonal sample points of a block
+ * (the Lorenzo error is measured on the original data). Return 1 if Lorenzo should be used, 0 for regression.
+ * */
+unsigned char choose_block_predictor_double_3D(double * data_pos, size_t current_blockcount_x, size_t current_blockcount_y, size_t current_blockcount_z, 
+size_t dim0_offset, size_t dim1_offset, size_t num_blocks, double * reg_params_pos, double noise, unsigned char use_mean, double mean)
+{
+	size_t params_offset_b = num_blocks;
+	size_t params_offset_c = 2*num_blocks;
+	size_t params_offset_d = 3*num_blocks;
+	// sample point [1, 1, 1] [1, 1, 4] [1, 4, 1] [1, 4, 4] [4, 1, 1] [4, 1, 4] [4, 4, 1] [4, 4, 4]
+	double * cur_data_pos;
+	double curData;
+	double pred_reg, pred_sz;
+	double err_sz = 0.0, err_reg = 0.0;
+	int bmi = 0;
+	int min_size = MIN(current_blockcount_x, (MIN(current_blockcount_y, current_blockcount_z)));
+	for(int s=1; s<min_size; s++){
+		cur_data_pos = data_pos + s*dim0_offset + s*dim1_offset + s;
+		curData = *cur_data_pos;
+		pred_sz = cur_data_pos[-1] + cur_data_pos[-dim1_offset]+ cur_data_pos[-dim0_offset] - cur_data_pos[-dim1_offset - 1] - cur_data_pos[-dim0_offset - 1] - cur_data_pos[-dim0_offset - dim1_offset] + cur_data_pos[-dim0_offset - dim1_offset - 1];
+		pred_reg = reg_params_pos[0] * s + reg_params_pos[params_offset_b] * s + reg_params_pos[params_offset_c] * s + reg_params_pos[params_offset_d];
+		err_sz += use_mean ? MIN(fabs(pred_sz - curData) + noise, fabs(mean - curData)) : fabs(pred_sz - curData) + noise;
+		err_reg += fabs(pred_reg - curData);
+
+		bmi = min_size - s;
+		cur_data_pos = data_pos + s*dim0_offset + s*dim1_offset + bmi;
+		curData = *cur_data_pos;
+		pred_sz = cur_data_pos[-1] + cur_data_pos[-dim1_offset]+ cur_data_pos[-dim0_offset] - cur_data_pos[-dim1_offset - 1] - cur_data_pos[-dim0_offset - 1] - cur_data_pos[-dim0_offset - dim1_offset] + cur_data_pos[-dim0_offset - dim1_offset - 1];
+		pred_reg = reg_params_pos[0] * s + reg_params_pos[params_offset_b] * s + reg_params_pos[params_offset_c] * bmi + reg_params_pos[params_offset_d];
+		err_sz += use_mean ? MIN(fabs(pred_sz - curData) + noise, fabs(mean - curData)) : fabs(pred_sz - curData) + noise;
+		err_reg += fabs(pred_reg - curData);
+
+		cur_data_pos = data_pos + s*dim0_offset + bmi*dim1_offset + s;
+		curData = *cur_data_pos;
+		pred_sz = cur_data_pos[-1] + cur_data_pos[-dim1_offset]+ cur_data_pos[-dim0_offset] - cur_data_pos[-dim1_offset - 1] - cur_data_pos[-dim0_offset - 1] - cur_data_pos[-dim0_offset - dim1_offset] + cur_data_pos[-dim0_offset - dim1_offset - 1];
+		pred_reg = reg_params_pos[0] * s + reg_params_pos[params_offset_b] * bmi + reg_params_pos[params_offset_c] * s + reg_params_pos[params_offset_d];
+		err_sz += use_mean ? MIN(fabs(pred_sz - curData) + noise, fabs(mean - curData)) : fabs(pred_sz - curData) + noise;
+		err_reg += fabs(pred_reg - curData);
+
+		cur_data_pos = data_pos + s*dim0_offset + bmi*dim1_offset + bmi;
+		curData = *cur_data_pos;
+		pred_sz = cur_data_pos[-1] + cur_data_pos[-dim1_offset]+ cur_data_pos[-dim0_offset] - cur_data_pos[-dim1_offset - 1] - cur_data_pos[-dim0_offset - 1] - cur_data_pos[-dim0_offset - dim1_offset] + cur_data_pos[-dim0_offset - dim1_offset - 1];
+		pred_reg = reg_params_pos[0] * s + reg_params_pos[params_offset_b] * bmi + reg_params_pos[params_offset_c] * bmi + reg_params_pos[params_offset_d];
+		err_sz += use_mean ? MIN(fabs(pred_sz - curData) + noise, fabs(mean - curData)) : fabs(pred_sz - curData) + noise;
+		err_reg += fabs(pred_reg - curData);
+	}
+	return (err_reg < err_sz) ? 0 : 1;
+}
+
+/**
+ * Choose the predictor of every block (see choose_block_predictor_double_3D).
+ * indicator[b] is set to 1 for the blocks using Lorenzo and to 0 for the blocks using regression.
+ * Only the original data and the coefficients are read, so the blocks are processed in parallel.
+ * */
+void select_block_predictors_double_3D(double *oriData, size_t r1, size_t r2, size_t r3, size_t block_size, double * reg_params, 
+double noise, unsigned char use_mean, double mean, unsigned char * indicator)
+{
+	size_t num_x, num_y, num_z;
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r1, num_x, block_size);
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r2, num_y, block_size);
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r3, num_z, block_size);
+
+	size_t split_index_x, split_index_y, split_index_z;
+	size_t early_blockcount_x, early_blockcount_y, early_blockcount_z;
+	size_t late_blockcount_x, late_blockcount_y, late_blockcount_z;
+	SZ_COMPUTE_BLOCKCOUNT(r1, num_x, split_index_x, early_blockcount_x, late_blockcount_x);
+	SZ_COMPUTE_BLOCKCOUNT(r2, num_y, split_index_y, early_blockcount_y, late_blockcount_y);
+	SZ_COMPUTE_BLOCKCOUNT(r3, num_z, split_index_z, early_blockcount_z, late_blockcount_z);
+
+	size_t num_blocks = num_x * num_y * num_z;
+	size_t dim0_offset = r2 * r3;
+	size_t dim1_offset = r3;
+	long b;
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for(b=0; b<(long)num_blocks; b++){
+		size_t i = b / (num_y * num_z);
+		size_t j = (b / num_z) % num_y;
+		size_t k = b % num_z;
+		size_t current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
+		size_t current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
+		size_t current_blockcount_z = (k < split_index_z) ? early_blockcount_z : late_blockcount_z;
+		size_t offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
+		size_t offset_y = (j < split_index_y) ? j * early_blockcount_y : j * late_blockcount_y + split_index_y;
+		size_t offset_z = (k < split_index_z) ? k * early_blockcount_z : k * late_blockcount_z + split_index_z;
+		double * data_pos = oriData + offset_x * dim0_offset + offset_y * dim1_offset + offset_z;
+		indicator[b] = choose_block_predictor_double_3D(data_pos, current_blockcount_x, current_blockcount_y, current_blockcount_z, dim0_offset, dim1_offset, 
+			num_blocks, reg_params + b, noise, use_mean, mean);
+	}
+}
+
+/**
+ * Fused sampling stage of the blocked regression compressor: a single sweep over the blocks fits the
+ * regression coefficients and, while the block is still in cache, either picks its predictor (use_mean == 0)
+ * or accumulates the sum of the values around dense_pos for the mean (use_mean == 1).
+ * The per-block partial sums are reduced in block order, so the mean does not depend on the number of threads.
+ * With use_mean, the predictors can only be chosen once the mean is known, which costs an extra sampled pass.
+ * */
+void sample_blocked_regression_double_3D(double *oriData, size_t r1, size_t r2, size_t r3, size_t block_size, double realPrecision, 
+unsigned char use_mean, double dense_pos, double noise, double * mean, double * reg_params, unsigned char * indicator)
+{
+	size_t num_x, num_y, num_z;
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r1, num_x, block_size);
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r2, num_y, block_size);
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r3, num_z, block_size);
+
+	size_t split_index_x, split_index_y, split_index_z;
+	size_t early_blockcount_x, early_blockcount_y, early_blockcount_z;
+	size_t late_blockcount_x, late_blockcount_y, late_blockcount_z;
+	SZ_COMPUTE_BLOCKCOUNT(r1, num_x, split_index_x, early_blockcount_x, late_blockcount_x);
+	SZ_COMPUTE_BLOCKCOUNT(r2, num_y, split_index_y, early_blockcount_y, late_blockcount_y);
+	SZ_COMPUTE_BLOCKCOUNT(r3, num_z, split_index_z, early_blockcount_z, late_blockcount_z);
+
+	size_t num_blocks = num_x * num_y * num_z;
+	size_t dim0_offset = r2 * r3;
+	size_t dim1_offset = r3;
+	double * mean_sum = NULL;
+	size_t * mean_count = NULL;
+	if(use_mean){
+		mean_sum = (double *) malloc(num_blocks * sizeof(double));
+		mean_count = (size_t *) malloc(num_blocks * sizeof(size_t));
+	}
+	long b;
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for(b=0; b<(long)num_blocks; b++){
+		size_t i = b / (num_y * num_z);
+		size_t j = (b / num_z) % num_y;
+		size_t k = b % num_z;
+		size_t current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
+		size_t current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
+		size_t current_blockcount_z = (k < split_index_z) ? early_blockcount_z : late_blockcount_z;
+		size_t offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
+		size_t offset_y = (j < split_index_y) ? j * early_blockcount_y : j * late_blockcount_y + split_index_y;
+		size_t offset_z = (k < split_index_z) ? k * early_blockcount_z : k * late_blockcount_z + split_index_z;
+		double * data_pos = oriData + offset_x * dim0_offset + offset_y * dim1_offset + offset_z;
+		fit_block_regression_double_3D(data_pos, current_blockcount_x, current_blockcount_y, current_blockcount_z, dim0_offset, dim1_offset, num_blocks, reg_params + b);
+		if(use_mean){
+			double sum = 0;
+			size_t count = 0;
+			for(size_t ii=0; ii<current_blockcount_x; ii++){
+				for(size_t jj=0; jj<current_blockcount_y; jj++){
+					double * cur_data_pos = data_pos + ii*dim0_offset + jj*dim1_offset;
+					for(size_t kk=0; kk<current_blockcount_z; kk++){
+						if(fabs(cur_data_pos[kk] - dense_pos) < realPrecision){
+							sum += cur_data_pos[kk];
+							count ++;
+						}
+					}
+				}
+			}
+			mean_sum[b] = sum;
+			mean_count[b] = count;
+		}
+		else
+			indicator[b] = choose_block_predictor_double_3D(data_pos, current_blockcount_x, current_blockcount_y, current_blockcount_z, dim0_offset, dim1_offset, 
+				num_blocks, reg_params + b, noise, 0, 0);
+	}
+	*mean = 0;
+	if(use_mean){
+		double sum = 0;
+		size_t count = 0;
+		for(size_t i=0; i<num_blocks; i++){
+			sum += mean_sum[i];
+			count += mean_count[i];
+		}
+		if(count > 0) *mean = sum / count;
+		free(mean_sum);
+		free(mean_count);
+		select_block_predictors_double_3D(oriData, r1, r2, r3, block_size, reg_params, noise, use_mean, *mean, indicator);
+	}
+}
+
 unsigned char * SZ_compress_double_3D_MDQ_nonblocked_with_blocked_regression(double *oriData, size_t r1, size_t r2, size_t r3, double realPrecision, size_t * comp_size){
 
 #ifdef HAVE_TIMECMPR	
 	double* decData = NULL;
 	if(confparams_cpr->szMode == SZ_TEMPORAL_COMPRESSION)
-		decData = (double*)(multisteps->hist_data);
+		decData = (double*)getHistDecBuffer(multisteps);
 #endif
 
 	unsigned int quantization_intervals;
 	double sz_sample_correct_freq = -1;//0.5; //-1
-	double dense_pos;
+	double dense_pos = 0;
 	double mean_flush_freq;
 	unsigned char use_mean = 0;
 
 	// calculate block dims
 	size_t num_x, num_y, num_z;
-	size_t block_size = 6;
+	size_t block_size;
+	if(confparams_cpr->regressionBlockSize > 0)
+		block_size = confparams_cpr->regressionBlockSize;
+	else
+		block_size = optimize_regression_block_size_double_3D(oriData, r1, r2, r3, realPrecision);
 	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r1, num_x, block_size);
 	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r2, num_y, block_size);
 	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r3, num_z, block_size);
@@ -5897,68 +6342,11 @@ unsigned char * SZ_compress_double_3D_MDQ_nonblocked_with_blocked_regression(dou
 	double * data_pos = oriData;
 	int * type = result_type;
 	size_t type_offset;
-	size_t offset_x, offset_y, offset_z;
-	size_t current_blockcount_x, current_blockcount_y, current_blockcount_z;
+	size_t offset_x, offset_y;
+	size_t current_blockcount_x, current_blockcount_y;
 
 	double * reg_params = (double *) malloc(num_blocks * 4 * sizeof(double));
-	double * reg_params_pos = reg_params;
-	// move regression part out
-	size_t params_offset_b = num_blocks;
-	size_t params_offset_c = 2*num_blocks;
-	size_t params_offset_d = 3*num_blocks;
-	for(size_t i=0; i<num_x; i++){
-		for(size_t j=0; j<num_y; j++){
-			for(size_t k=0; k<num_z; k++){
-				current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
-				current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
-				current_blockcount_z = (k < split_index_z) ? early_blockcount_z : late_blockcount_z;
-				offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
-				offset_y = (j < split_index_y) ? j * early_blockcount_y : j * late_blockcount_y + split_index_y;
-				offset_z = (k < split_index_z) ? k * early_blockcount_z : k * late_blockcount_z + split_index_z;
-	
-				data_pos = oriData + offset_x * dim0_offset + offset_y * dim1_offset + offset_z;
-				/*Calculate regression coefficients*/
-				{
-					double * cur_data_pos = data_pos;
-					double fx = 0.0;
-					double fy = 0.0;
-					double fz = 0.0;
-					double f = 0;
-					double sum_x, sum_y; 
-					double curData;
-					for(size_t i=0; i<current_blockcount_x; i++){
-						sum_x = 0;
-						for(size_t j=0; j<current_blockcount_y; j++){
-							sum_y = 0;
-							for(size_t k=0; k<current_blockcount_z; k++){
-								curData = *cur_data_pos;
-								// f += curData;
-								// fx += curData * i;
-								// fy += curData * j;
-								// fz += curData * k;
-								sum_y += curData;
-								fz += curData * k;
-								cur_data_pos ++;
-							}
-							fy += sum_y * j;
-							sum_x += sum_y;
-							cur_data_pos += dim1_offset - current_blockcount_z;
-						}
-						fx += sum_x * i;
-						f += sum_x;
-						cur_data_pos += dim0_offset - current_blockcount_y * dim1_offset;
-					}
-					double coeff = 1.0 / (current_blockcount_x * current_blockcount_y * current_blockcount_z);
-					reg_params_pos[0] = (2 * fx / (current_blockcount_x - 1) - f) * 6 * coeff / (current_blockcount_x + 1);
-					reg_params_pos[params_offset_b] = (2 * fy / (current_blockcount_y - 1) - f) * 6 * coeff / (current_blockcount_y + 1);
-					reg_params_pos[params_offset_c] = (2 * fz / (current_blockcount_z - 1) - f) * 6 * coeff / (current_blockcount_z + 1);
-					reg_params_pos[params_offset_d] = f * coeff - ((current_blockcount_x - 1) * reg_params_pos[0] / 2 + (current_blockcount_y - 1) * reg_params_pos[params_offset_b] / 2 + (current_blockcount_z - 1) * reg_params_pos[params_offset_c] / 2);
-				}
-				reg_params_pos ++;
-			}
-		}
-	}
-	
+	double * reg_params_pos;
 	//Compress coefficient arrays
 	double precision_a, precision_b, precision_c, precision_d;
 	double rel_param_err = 0.025;
@@ -5978,18 +6366,6 @@ unsigned char * SZ_compress_double_3D_MDQ_nonblocked_with_blocked_regression(dou
 	}
 
 	double mean = 0;
-	if(use_mean){
-		// compute mean
-		double sum = 0.0;
-		size_t mean_count = 0;
-		for(size_t i=0; i<num_elements; i++){
-			if(fabs(oriData[i] - dense_pos) < realPrecision){
-				sum += oriData[i];
-				mean_count ++;
-			}
-		}
-		if(mean_count > 0) mean = sum / mean_count;
-	}
 
 	// use two prediction buffers for higher performance
 	double * unpredictable_data = result_unpredictable_data;
@@ -6016,6 +6392,8 @@ unsigned char * SZ_compress_double_3D_MDQ_nonblocked_with_blocked_regression(dou
 	int intvRadius = exe_params->intvRadius;	
 	int use_reg = 0;
 	double noise = realPrecision * 1.22;
+	// fit the coefficients, compute the mean and choose the predictor of each block in one sweep
+	sample_blocked_regression_double_3D(oriData, r1, r2, r3, block_size, realPrecision, use_mean, dense_pos, noise, &mean, reg_params, indicator);
 
 	reg_params_pos = reg_params;
 	// compress the regression coefficients on the fly
@@ -6067,47 +6445,7 @@ unsigned char * SZ_compress_double_3D_MDQ_nonblocked_with_blocked_regression(dou
 					size_t block_offset = offset_x * dim0_offset + offset_y * dim1_offset + offset_z;
 #endif
 
-					/*sampling and decide which predictor*/
-					{
-						// sample point [1, 1, 1] [1, 1, 4] [1, 4, 1] [1, 4, 4] [4, 1, 1] [4, 1, 4] [4, 4, 1] [4, 4, 4]
-						double * cur_data_pos;
-						double curData;
-						double pred_reg, pred_sz;
-						double err_sz = 0.0, err_reg = 0.0;
-						int bmi = 0;
-						int block_size = MIN(current_blockcount_x, (MIN(current_blockcount_y, current_blockcount_z)));
-						for(int i=1; i<block_size; i++){
-							cur_data_pos = data_pos + i*dim0_offset + i*dim1_offset + i;
-							curData = *cur_data_pos;
-							pred_sz = cur_data_pos[-1] + cur_data_pos[-dim1_offset]+ cur_data_pos[-dim0_offset] - cur_data_pos[-dim1_offset - 1] - cur_data_pos[-dim0_offset - 1] - cur_data_pos[-dim0_offset - dim1_offset] + cur_data_pos[-dim0_offset - dim1_offset - 1];
-							pred_reg = reg_params_pos[0] * i + reg_params_pos[params_offset_b] * i + reg_params_pos[params_offset_c] * i + reg_params_pos[params_offset_d];							
-							err_sz += MIN(fabs(pred_sz - curData) + noise, fabs(mean - curData));
-							err_reg += fabs(pred_reg - curData);
-
-							bmi = block_size - i;
-							cur_data_pos = data_pos + i*dim0_offset + i*dim1_offset + bmi;
-							curData = *cur_data_pos;
-							pred_sz = cur_data_pos[-1] + cur_data_pos[-dim1_offset]+ cur_data_pos[-dim0_offset] - cur_data_pos[-dim1_offset - 1] - cur_data_pos[-dim0_offset - 1] - cur_data_pos[-dim0_offset - dim1_offset] + cur_data_pos[-dim0_offset - dim1_offset - 1];
-							pred_reg = reg_params_pos[0] * i + reg_params_pos[params_offset_b] * i + reg_params_pos[params_offset_c] * bmi + reg_params_pos[params_offset_d];							
-							err_sz += MIN(fabs(pred_sz - curData) + noise, fabs(mean - curData));
-							err_reg += fabs(pred_reg - curData);								
-
-							cur_data_pos = data_pos + i*dim0_offset + bmi*dim1_offset + i;
-							curData = *cur_data_pos;
-							pred_sz = cur_data_pos[-1] + cur_data_pos[-dim1_offset]+ cur_data_pos[-dim0_offset] - cur_data_pos[-dim1_offset - 1] - cur_data_pos[-dim0_offset - 1] - cur_data_pos[-dim0_offset - dim1_offset] + cur_data_pos[-dim0_offset - dim1_offset - 1];
-							pred_reg = reg_params_pos[0] * i + reg_params_pos[params_offset_b] * bmi + reg_params_pos[params_offset_c] * i + reg_params_pos[params_offset_d];							
-							err_sz += MIN(fabs(pred_sz - curData) + noise, fabs(mean - curData));
-							err_reg += fabs(pred_reg - curData);								
-
-							cur_data_pos = data_pos + i*dim0_offset + bmi*dim1_offset + bmi;
-							curData = *cur_data_pos;
-							pred_sz = cur_data_pos[-1] + cur_data_pos[-dim1_offset]+ cur_data_pos[-dim0_offset] - cur_data_pos[-dim1_offset - 1] - cur_data_pos[-dim0_offset - 1] - cur_data_pos[-dim0_offset - dim1_offset] + cur_data_pos[-dim0_offset - dim1_offset - 1];
-							pred_reg = reg_params_pos[0] * i + reg_params_pos[params_offset_b] * bmi + reg_params_pos[params_offset_c] * bmi + reg_params_pos[params_offset_d];							
-							err_sz += MIN(fabs(pred_sz - curData) + noise, fabs(mean - curData));
-							err_reg += fabs(pred_reg - curData);
-						}
-						use_reg = (err_reg < err_sz);
-					}
+					use_reg = !indicator_pos[k];
 					if(use_reg){
 						{
 							/*predict coefficients in current block via previous reg_block*/
@@ -6351,8 +6689,6 @@ unsigned char * SZ_compress_double_3D_MDQ_nonblocked_with_blocked_regression(dou
 						}
 						strip_unpredictable_count += unpredictable_count;
 						unpredictable_data += unpredictable_count;
-						// change indicator
-						indicator_pos[k] = 1;
 					}// end SZ
 					
 					reg_params_pos ++;
@@ -6406,48 +6742,7 @@ unsigned char * SZ_compress_double_3D_MDQ_nonblocked_with_blocked_regression(dou
 					size_t block_offset = offset_x * dim0_offset + offset_y * dim1_offset + offset_z;
 #endif							
 					
-					/*sampling*/
-					{
-						// sample point [1, 1, 1] [1, 1, 4] [1, 4, 1] [1, 4, 4] [4, 1, 1] [4, 1, 4] [4, 4, 1] [4, 4, 4]
-						double * cur_data_pos;
-						double curData;
-						double pred_reg, pred_sz;
-						double err_sz = 0.0, err_reg = 0.0;
-						int bmi = 0;
-						int block_size = MIN(current_blockcount_x, (MIN(current_blockcount_y, current_blockcount_z)));
-						for(int i=1; i<block_size; i++){
-							cur_data_pos = data_pos + i*dim0_offset + i*dim1_offset + i;
-							curData = *cur_data_pos;
-							pred_sz = cur_data_pos[-1] + cur_data_pos[-dim1_offset]+ cur_data_pos[-dim0_offset] - cur_data_pos[-dim1_offset - 1] - cur_data_pos[-dim0_offset - 1] - cur_data_pos[-dim0_offset - dim1_offset] + cur_data_pos[-dim0_offset - dim1_offset - 1];
-							pred_reg = reg_params_pos[0] * i + reg_params_pos[params_offset_b] * i + reg_params_pos[params_offset_c] * i + reg_params_pos[params_offset_d];							
-							err_sz += fabs(pred_sz - curData) + noise;
-							err_reg += fabs(pred_reg - curData);
-
-							bmi = block_size - i;
-							cur_data_pos = data_pos + i*dim0_offset + i*dim1_offset + bmi;
-							curData = *cur_data_pos;
-							pred_sz = cur_data_pos[-1] + cur_data_pos[-dim1_offset]+ cur_data_pos[-dim0_offset] - cur_data_pos[-dim1_offset - 1] - cur_data_pos[-dim0_offset - 1] - cur_data_pos[-dim0_offset - dim1_offset] + cur_data_pos[-dim0_offset - dim1_offset - 1];
-							pred_reg = reg_params_pos[0] * i + reg_params_pos[params_offset_b] * i + reg_params_pos[params_offset_c] * bmi + reg_params_pos[params_offset_d];							
-							err_sz += fabs(pred_sz - curData) + noise;
-							err_reg += fabs(pred_reg - curData);								
-
-							cur_data_pos = data_pos + i*dim0_offset + bmi*dim1_offset + i;
-							curData = *cur_data_pos;
-							pred_sz = cur_data_pos[-1] + cur_data_pos[-dim1_offset]+ cur_data_pos[-dim0_offset] - cur_data_pos[-dim1_offset - 1] - cur_data_pos[-dim0_offset - 1] - cur_data_pos[-dim0_offset - dim1_offset] + cur_data_pos[-dim0_offset - dim1_offset - 1];
-							pred_reg = reg_params_pos[0] * i + reg_params_pos[params_offset_b] * bmi + reg_params_pos[params_offset_c] * i + reg_params_pos[params_offset_d];							
-							err_sz += fabs(pred_sz - curData) + noise;
-							err_reg += fabs(pred_reg - curData);								
-
-							cur_data_pos = data_pos + i*dim0_offset + bmi*dim1_offset + bmi;
-							curData = *cur_data_pos;
-							pred_sz = cur_data_pos[-1] + cur_data_pos[-dim1_offset]+ cur_data_pos[-dim0_offset] - cur_data_pos[-dim1_offset - 1] - cur_data_pos[-dim0_offset - 1] - cur_data_pos[-dim0_offset - dim1_offset] + cur_data_pos[-dim0_offset - dim1_offset - 1];
-							pred_reg = reg_params_pos[0] * i + reg_params_pos[params_offset_b] * bmi + reg_params_pos[params_offset_c] * bmi + reg_params_pos[params_offset_d];							
-							err_sz += fabs(pred_sz - curData) + noise;
-							err_reg += fabs(pred_reg - curData);
-						}
-						use_reg = (err_reg < err_sz);
-
-					}
+					use_reg = !indicator_pos[k];
 					if(use_reg)
 					{
 						{
@@ -6675,8 +6970,6 @@ unsigned char * SZ_compress_double_3D_MDQ_nonblocked_with_blocked_regression(dou
 						}
 						strip_unpredictable_count += unpredictable_count;
 						unpredictable_data += unpredictable_count;
-						// change indicator
-						indicator_pos[k] = 1;
 					}// end SZ
 					
 					reg_params_pos ++;
@@ -6704,6 +6997,7 @@ unsigned char * SZ_compress_double_3D_MDQ_nonblocked_with_blocked_regression(dou
 	free(prediction_buffer_2);
 
 	int stateNum = 2*quantization_intervals;
+	SZ_STATS_BEGIN(huffmanStart);
 	HuffmanTree* huffmanTree = createHuffmanTree(stateNum);
 
 	size_t nodeCount = 0;
@@ -6715,6 +7009,7 @@ unsigned char * SZ_compress_double_3D_MDQ_nonblocked_with_blocked_regression(dou
 
 	unsigned char *treeBytes;
 	unsigned int treeByteSize = convert_HuffTree_to_bytes_anyStates(huffmanTree, nodeCount, &treeBytes);
+	SZ_STATS_END(huffmanTime, huffmanStart);
 
 	unsigned int meta_data_offset = 3 + 1 + MetaDataByteLength_double;
 	// total size 										metadata		  # elements     real precision		intervals	nodeCount		huffman 	 	block index 						unpredicatable count						mean 					 	unpred size 				elements
@@ -6792,7 +7087,9 @@ unsigned char * SZ_compress_double_3D_MDQ_nonblocked_with_blocked_regression(dou
 	memcpy(result_pos, result_unpredictable_data, total_unpred * sizeof(double));
 	result_pos += total_unpred * sizeof(double);
 	size_t typeArray_size = 0;
+	SZ_STATS_BEGIN(encodeStart);
 	encode(huffmanTree, result_type, num_elements, result_pos, &typeArray_size);
+	SZ_STATS_END(huffmanTime, encodeStart);
 	result_pos += typeArray_size;
 	size_t totalEncodeSize = result_pos - result;
 	free(indicator);
@@ -6802,6 +7099,11 @@ unsigned char * SZ_compress_double_3D_MDQ_nonblocked_with_blocked_regression(dou
 
 	
 	SZ_ReleaseHuffman(huffmanTree);
+	SZ_STATS_ADD(huffmanBytes, treeByteSize + typeArray_size);
+	SZ_STATS_ADD(huffmanTreeBytes, treeByteSize);
+	SZ_STATS_ADD(unpredCount, total_unpred);
+	SZ_STATS_SET(intervals, quantization_intervals);
+	SZ_STATS_SET(regressionBlockFraction, (double)reg_count/num_blocks);
 	*comp_size = totalEncodeSize;
 	return result;
 }
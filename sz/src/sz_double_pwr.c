@@ -729,14 +729,7 @@ size_t dataLength, size_t *outSize, double min, double max)
 			(*newByteData)[k++] = dsLengthBytes[i];
 
 		
-		if(sysEndianType==BIG_ENDIAN_SYSTEM)
-			memcpy((*newByteData)+4+exe_params->SZ_SIZE_TYPE, oriData, dataLength*doubleSize);
-		else
-		{
-			unsigned char* p = (*newByteData)+4+exe_params->SZ_SIZE_TYPE;
-			for(i=0;i<dataLength;i++,p+=doubleSize)
-				doubleToBytes(p, oriData[i]);
-		}
+		copyArrayWithEndian((*newByteData)+4+exe_params->SZ_SIZE_TYPE, (unsigned char*)oriData, dataLength, doubleSize, sysEndianType==LITTLE_ENDIAN_SYSTEM);
 		*outSize = totalByteLength;
 	}
 	
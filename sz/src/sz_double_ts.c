@@ -67,10 +67,8 @@ TightDataPointStorageD* SZ_compress_double_1D_MDQ_ts(double *oriData, size_t dat
 double realPrecision, double valueRangeSize, double medianValue_d)
 {
 	double* preStepData = (double*)(multisteps->hist_data);
-	//store the decompressed data
-	//double* decData = (double*)malloc(sizeof(double)*dataLength);
-	//memset(decData, 0, sizeof(double)*dataLength);
-	double* decData = preStepData;
+	//store the decompressed data into the history buffer of the step
+	double* decData = (double*)getHistDecBuffer(multisteps);
 	
 	unsigned int quantization_intervals;
 	if(exe_params->optQuantMode==1)
@@ -167,12 +165,12 @@ double realPrecision, double valueRangeSize, double medianValue_d)
 	
 	TightDataPointStorageD* tdps;
 			
-	new_TightDataPointStorageD(&tdps, dataLength, exactDataNum, 
+	new_TightDataPointStorageD_ts(&tdps, &(multisteps->cmprHuffTree), dataLength, exactDataNum, 
 			type, exactMidByteArray->array, exactMidByteArray->size,  
 			exactLeadNumArray->array,  
 			resiBitArray->array, resiBitArray->size, 
 			resiBitsLength, 
-			realPrecision, medianValue, (char)reqLength, quantization_intervals, NULL, 0, 0);
+			realPrecision, medianValue, (char)reqLength, quantization_intervals);
 	
 	//free memory
 	free_DIA(exactLeadNumArray);
@@ -189,3 +187,202 @@ double realPrecision, double valueRangeSize, double medianValue_d)
 }
 
 
+
+/**
+ * Select the predictor of the block [i0,ie)x[j0,je)x[k0,ke) by the prediction errors on the
+ * already decompressed faces in front of the block (i0-1, j0-1 and k0-1), so the selection can be
+ * reproduced by the decompressor without storing anything. The temporal predictor is used if the
+ * block has no such face (i.e., the first block).
+ * 
+ * @param double* cur : the current step (only the decompressed part is read)
+ * @param double* pre : the previous (decompressed) step
+ * 
+ * @return the predictor (TS_PRED_TEMPORAL, TS_PRED_HYBRID or TS_PRED_SPATIAL)
+ * */
+int select_ts_predictor_double_3D(double* cur, double* pre, size_t r2, size_t r3,
+size_t i0, size_t j0, size_t k0, size_t ie, size_t je, size_t ke)
+{
+	size_t i, j, k, index;
+	double err[3] = {0, 0, 0};
+	int p, count = 0, best = TS_PRED_TEMPORAL;
+	if(i0>0)
+	{
+		i = i0-1;
+		for(j=j0;j<je;j++)
+			for(k=k0;k<ke;k++)
+			{
+				index = i*r2*r3+j*r3+k;
+				for(p=0;p<3;p++)
+					err[p] += fabs(cur[index] - predict_double_3D_ts(p, cur, pre, r2, r3, i, j, k));
+				count++;
+			}
+	}
+	if(j0>0)
+	{
+		j = j0-1;
+		for(i=i0;i<ie;i++)
+			for(k=k0;k<ke;k++)
+			{
+				index = i*r2*r3+j*r3+k;
+				for(p=0;p<3;p++)
+					err[p] += fabs(cur[index] - predict_double_3D_ts(p, cur, pre, r2, r3, i, j, k));
+				count++;
+			}
+	}
+	if(k0>0)
+	{
+		k = k0-1;
+		for(i=i0;i<ie;i++)
+			for(j=j0;j<je;j++)
+			{
+				index = i*r2*r3+j*r3+k;
+				for(p=0;p<3;p++)
+					err[p] += fabs(cur[index] - predict_double_3D_ts(p, cur, pre, r2, r3, i, j, k));
+				count++;
+			}
+	}
+	if(count==0)
+		return TS_PRED_TEMPORAL;
+	for(p=1;p<3;p++)
+		if(err[p]<err[best])
+			best = p;
+	return best;
+}
+
+TightDataPointStorageD* SZ_compress_double_2D_MDQ_ts(double *oriData, size_t r1, size_t r2, sz_multisteps* multisteps,
+double realPrecision, double valueRangeSize, double medianValue_d)
+{
+	return SZ_compress_double_3D_MDQ_ts(oriData, 1, r1, r2, multisteps, realPrecision, valueRangeSize, medianValue_d);
+}
+
+/**
+ * 
+ * Time-series compression of 2D/3D data: each block is predicted by the previous step, by the
+ * spatial (Lorenzo) predictor or by the combination of both, as selected by select_ts_predictor_double_3D().
+ * The data points are visited block by block, so type[] and the exact data follow the same order.
+ * 
+ * Note: @r1 is high dimension
+ * 		 @r3 is low dimension
+ * */
+TightDataPointStorageD* SZ_compress_double_3D_MDQ_ts(double *oriData, size_t r1, size_t r2, size_t r3, sz_multisteps* multisteps,
+double realPrecision, double valueRangeSize, double medianValue_d)
+{
+	size_t dataLength = r1*r2*r3;
+	double* preStepData = (double*)(multisteps->hist_data);
+
+	//store the decompressed data into the history buffer of the step: the prediction reads the
+	//neighbors in the previous step, which stays unchanged until the step is committed
+	double* decData = (double*)getHistDecBuffer(multisteps);
+	
+	unsigned int quantization_intervals;
+	if(exe_params->optQuantMode==1)
+		quantization_intervals = optimize_intervals_double_1D_ts(oriData, dataLength, preStepData, realPrecision);
+	else
+		quantization_intervals = exe_params->intvCapacity;
+	updateQuantizationInfo(quantization_intervals);	
+
+	size_t i, j, k, index, count = 0;
+	size_t b1, b2, b3, i0, j0, k0, ie, je, ke;
+	int reqLength, predictor;
+	double medianValue = medianValue_d;
+	short radExpo = getExponent_double(valueRangeSize/2);
+	
+	computeReqLength_double(realPrecision, radExpo, &reqLength, &medianValue);	
+
+	int* type = (int*) malloc(dataLength*sizeof(int));
+	
+	DynamicIntArray *exactLeadNumArray;
+	new_DIA(&exactLeadNumArray, DynArrayInitLen);
+	
+	DynamicByteArray *exactMidByteArray;
+	new_DBA(&exactMidByteArray, DynArrayInitLen);
+	
+	DynamicIntArray *resiBitArray;
+	new_DIA(&resiBitArray, DynArrayInitLen);
+	
+	unsigned char preDataBytes[8];
+	longToBytes_bigEndian(preDataBytes, 0);
+	
+	int reqBytesLength = reqLength/8;
+	int resiBitsLength = reqLength%8;
+
+	DoubleValueCompressElement *vce = (DoubleValueCompressElement*)malloc(sizeof(DoubleValueCompressElement));
+	LossyCompressionElement *lce = (LossyCompressionElement*)malloc(sizeof(LossyCompressionElement));
+	
+	int state = 0;
+	double checkRadius = (exe_params->intvCapacity-1)*realPrecision;
+	double interval = 2*realPrecision;
+	double curData = 0, pred = 0, predAbsErr = 0;
+	
+	computeBlockSize_ts(r1, &b1, &b2, &b3);
+	for(i0=0;i0<r1;i0+=b1)
+	for(j0=0;j0<r2;j0+=b2)
+	for(k0=0;k0<r3;k0+=b3)
+	{
+		ie = i0+b1<r1 ? i0+b1 : r1;
+		je = j0+b2<r2 ? j0+b2 : r2;
+		ke = k0+b3<r3 ? k0+b3 : r3;
+		predictor = select_ts_predictor_double_3D(decData, preStepData, r2, r3, i0, j0, k0, ie, je, ke);
+		for(i=i0;i<ie;i++)
+		for(j=j0;j<je;j++)
+		for(k=k0;k<ke;k++)
+		{
+			index = i*r2*r3+j*r3+k;
+			curData = oriData[index];
+			pred = predict_double_3D_ts(predictor, decData, preStepData, r2, r3, i, j, k);
+			predAbsErr = fabs(curData - pred);	
+			if(predAbsErr<=checkRadius)
+			{
+				state = (predAbsErr/realPrecision+1)/2;
+				if(curData>=pred)
+				{
+					type[count] = exe_params->intvRadius+state;
+					pred = pred + state*interval;
+				}
+				else //curData<pred
+				{
+					type[count] = exe_params->intvRadius-state;
+					pred = pred - state*interval;
+				}
+				
+				//double-check the prediction error in case of machine-epsilon impact	
+				if(fabs(curData-pred)<=realPrecision)
+				{
+					decData[index] = pred;
+					count++;
+					continue;
+				}
+			}
+			
+			//unpredictable data processing		
+			type[count] = 0;		
+			compressSingleDoubleValue(vce, curData, realPrecision, medianValue, reqLength, reqBytesLength, resiBitsLength);
+			updateLossyCompElement_Double(vce->curBytes, preDataBytes, reqBytesLength, resiBitsLength, lce);
+			memcpy(preDataBytes,vce->curBytes,8);
+			addExactData(exactMidByteArray, exactLeadNumArray, resiBitArray, lce);
+			decData[index] = vce->data;
+			count++;
+		}
+	}
+		
+	size_t exactDataNum = exactLeadNumArray->size;
+	
+	TightDataPointStorageD* tdps;
+			
+	new_TightDataPointStorageD_ts(&tdps, &(multisteps->cmprHuffTree), dataLength, exactDataNum, 
+			type, exactMidByteArray->array, exactMidByteArray->size,  
+			exactLeadNumArray->array,  
+			resiBitArray->array, resiBitArray->size, 
+			resiBitsLength,
+			realPrecision, medianValue, (char)reqLength, quantization_intervals);
+
+	//free memory
+	free_DIA(exactLeadNumArray);
+	free_DIA(resiBitArray);
+	free(type);	
+	free(vce);
+	free(lce);	
+	free(exactMidByteArray); //exactMidByteArray->array has been released in free_TightDataPointStorageD(tdps);
+	
+	return tdps;
+}
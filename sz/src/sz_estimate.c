@@ -0,0 +1,1148 @@
+/**
+ *  @file sz_estimate.c
+ *  @date Oct, 2026
+ *  @brief Estimation of the compression ratio and time of SZ_compress() from a sample of the blocks of a field
+ *  and from compressed boxes of it.
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "sz.h"
+#include "sz_estimate.h"
+
+#define SZ_ESTIMATE_MIN_BLOCKS 64 //at least 64 blocks are sampled (or all the blocks of small fields)
+#define SZ_ESTIMATE_MAX_STRIDE 64 //at least 1 block out of 64 is sampled
+#define SZ_ESTIMATE_1D_BLOCK_SIZE 256
+#define SZ_ESTIMATE_2D_BLOCK_SIZE 16
+#define SZ_ESTIMATE_3D_BLOCK_SIZE 6
+#define SZ_ESTIMATE_BOX_FRACTION 64 //the stream is measured on boxes of about 1/64 of the field
+#define SZ_ESTIMATE_MIN_BOX_POINTS 65536 //and at least 65536 points
+#define SZ_ESTIMATE_BOX_GRID 2 //the boxes are on a 2*2 grid (4 segments of 1D fields)
+
+/**
+ * The quantization codes of the sampled blocks and their counters.
+ * */
+typedef struct sz_estimate_sample
+{
+	int *codes;
+	size_t count;
+	size_t unpredCount;
+	size_t numBlocks;
+	size_t sampledBlocks;
+	size_t regBlocks;
+	int coeffCount; //regression coefficients per block
+	double coeffCodeSum[4]; //sum of the distances of the coefficient codes to the center of the intervals
+	size_t coeffCoded[4]; //number of coefficients predicted from the previous block
+	size_t coeffUnpred[4]; //number of unpredictable coefficients
+	size_t processed; //number of the points quantized, with the warm-up margins
+} sz_estimate_sample;
+
+/**
+ * The output of the SZ stage on the half-thickness boxes and on the boxes of the field (see compress_boxes_float()).
+ * */
+typedef struct sz_estimate_boxes
+{
+	unsigned char *bytes[2]; //NULL if not compressed
+	size_t size[2];
+	size_t length[2]; //number of points
+	size_t treeBytes[2]; //serialized Huffman trees among the bytes
+} sz_estimate_boxes;
+
+/**
+ * Quantize the sampled blocks of a r1*r2*r3 field (r1 = 1 for 2D fields, r1 = r2 = 1 for 1D fields) the way the
+ * compressor does. With regDim = 2 or 3, each block first chooses between Lorenzo and the linear regression with
+ * the same test as the blocked regression compressor.
+ * The Lorenzo predictor of the compressor reads reconstructed values, whose errors build up along the field; so a
+ * Lorenzo block is quantized after a warm-up margin of one block in each dimension, which starts from the original
+ * values, and only the codes of the block itself are kept.
+ * */
+static void sample_quantization_codes_float(float *oriData, size_t r1, size_t r2, size_t r3, size_t block_size, int regDim,
+float realPrecision, unsigned int intervals, unsigned char use_mean, float mean, sz_estimate_sample *sample)
+{
+	size_t num_x, num_y, num_z;
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r1, num_x, block_size);
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r2, num_y, block_size);
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r3, num_z, block_size);
+
+	size_t split_index_x, split_index_y, split_index_z;
+	size_t early_blockcount_x, early_blockcount_y, early_blockcount_z;
+	size_t late_blockcount_x, late_blockcount_y, late_blockcount_z;
+	SZ_COMPUTE_BLOCKCOUNT(r1, num_x, split_index_x, early_blockcount_x, late_blockcount_x);
+	SZ_COMPUTE_BLOCKCOUNT(r2, num_y, split_index_y, early_blockcount_y, late_blockcount_y);
+	SZ_COMPUTE_BLOCKCOUNT(r3, num_z, split_index_z, early_blockcount_z, late_blockcount_z);
+
+	size_t num_blocks = num_x * num_y * num_z;
+	size_t stride = num_blocks / SZ_ESTIMATE_MIN_BLOCKS;
+	if(stride > SZ_ESTIMATE_MAX_STRIDE) stride = SZ_ESTIMATE_MAX_STRIDE;
+	if(stride == 0) stride = 1;
+	size_t num_samples = (num_blocks + stride - 1) / stride;
+
+	size_t dim0_offset = r2 * r3;
+	size_t dim1_offset = r3;
+	// warm-up margin of one block in the dimensions which are split into blocks
+	size_t margin_x = num_x > 1 ? early_blockcount_x : 0;
+	size_t margin_y = num_y > 1 ? early_blockcount_y : 0;
+	size_t margin_z = num_z > 1 ? early_blockcount_z : 0;
+	size_t buf_dim1_offset = margin_z + early_blockcount_z + 1;
+	size_t buf_dim0_offset = (margin_y + early_blockcount_y + 1) * buf_dim1_offset;
+	float * buf = (float *) malloc((margin_x + early_blockcount_x + 1) * buf_dim0_offset * sizeof(float));
+	size_t max_count = num_samples * early_blockcount_x * early_blockcount_y * early_blockcount_z;
+	sample->codes = (int *) malloc(max_count * sizeof(int));
+	sample->count = 0;
+	sample->unpredCount = 0;
+	sample->numBlocks = num_blocks;
+	sample->sampledBlocks = 0;
+	sample->regBlocks = 0;
+	sample->coeffCount = regDim == 3 ? 4 : 3;
+	sample->processed = 0;
+	memset(sample->coeffCodeSum, 0, sizeof(sample->coeffCodeSum));
+	memset(sample->coeffCoded, 0, sizeof(sample->coeffCoded));
+	memset(sample->coeffUnpred, 0, sizeof(sample->coeffUnpred));
+
+	float recip_realPrecision = 1/realPrecision;
+	float noise = realPrecision * (regDim == 3 ? 1.22 : 0.81);
+	int intvCapacity = intervals;
+	int intvRadius = intervals/2;
+	int intvCapacity_sz = use_mean ? intvCapacity - 2 : intvCapacity;
+	float reg_params[4], last_reg_params[4];
+	// precisions of the coefficients in the blocked regression compressors
+	float coeff_precision[4];
+	float rel_param_err = regDim == 3 ? 0.025 : 0.15/3;
+	coeff_precision[0] = rel_param_err * realPrecision / (regDim == 3 ? late_blockcount_x : late_blockcount_y);
+	coeff_precision[1] = rel_param_err * realPrecision / (regDim == 3 ? late_blockcount_y : late_blockcount_z);
+	coeff_precision[2] = regDim == 3 ? rel_param_err * realPrecision / late_blockcount_z : rel_param_err * realPrecision;
+	coeff_precision[3] = rel_param_err * realPrecision;
+
+	for(size_t s=0; s<num_samples; s++){
+		// shift the sampled block inside its stride so that the samples do not align with a dimension
+		size_t b = s * stride + (s * 37 + stride / 2) % stride;
+		if(b >= num_blocks) break;
+		size_t i = b / (num_y * num_z);
+		size_t j = (b / num_z) % num_y;
+		size_t k = b % num_z;
+		size_t current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
+		size_t current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
+		size_t current_blockcount_z = (k < split_index_z) ? early_blockcount_z : late_blockcount_z;
+		size_t offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
+		size_t offset_y = (j < split_index_y) ? j * early_blockcount_y : j * late_blockcount_y + split_index_y;
+		size_t offset_z = (k < split_index_z) ? k * early_blockcount_z : k * late_blockcount_z + split_index_z;
+		float * data_pos = oriData + offset_x * dim0_offset + offset_y * dim1_offset + offset_z;
+
+		int use_reg = 0;
+		if(regDim == 3 && current_blockcount_x > 1 && current_blockcount_y > 1 && current_blockcount_z > 1){
+			fit_block_regression_float_3D(data_pos, current_blockcount_x, current_blockcount_y, current_blockcount_z, dim0_offset, dim1_offset, 1, reg_params);
+			use_reg = !choose_block_predictor_float_3D(data_pos, current_blockcount_x, current_blockcount_y, current_blockcount_z, dim0_offset, dim1_offset,
+				1, reg_params, noise, use_mean, mean);
+		}
+		else if(regDim == 2 && current_blockcount_y > 1 && current_blockcount_z > 1){
+			fit_block_regression_float_2D(data_pos, current_blockcount_y, current_blockcount_z, dim1_offset, 1, reg_params);
+			use_reg = !choose_block_predictor_float_2D(data_pos, current_blockcount_y, current_blockcount_z, dim1_offset, 1, reg_params, noise, use_mean, mean);
+		}
+		if(use_reg){
+			// the coefficients are predicted by those of the previous block, approximated by its neighbour along the last dimension
+			size_t last_blockcount_z = (k - 1 < split_index_z) ? early_blockcount_z : late_blockcount_z;
+			memset(last_reg_params, 0, sizeof(last_reg_params));
+			if(k > 0 && last_blockcount_z > 1){
+				if(regDim == 3)
+					fit_block_regression_float_3D(data_pos - last_blockcount_z, current_blockcount_x, current_blockcount_y, last_blockcount_z, dim0_offset, dim1_offset, 1, last_reg_params);
+				else
+					fit_block_regression_float_2D(data_pos - last_blockcount_z, current_blockcount_y, last_blockcount_z, dim1_offset, 1, last_reg_params);
+			}
+			for(int e=0; e<sample->coeffCount; e++){
+				float itvNum = fabsf(reg_params[e] - last_reg_params[e]) / coeff_precision[e] + 1;
+				if(itvNum < 65536){
+					sample->coeffCodeSum[e] += (int) (itvNum/2);
+					sample->coeffCoded[e] ++;
+				}
+				else
+					sample->coeffUnpred[e] ++;
+			}
+		}
+
+		// the quantized region: the block, preceded by the warm-up margin for Lorenzo
+		size_t start_x = use_reg || offset_x < margin_x ? 0 : margin_x;
+		size_t start_y = use_reg || offset_y < margin_y ? 0 : margin_y;
+		size_t start_z = use_reg || offset_z < margin_z ? 0 : margin_z;
+		float * region_pos = data_pos - start_x * dim0_offset - start_y * dim1_offset - start_z;
+		size_t region_x = start_x + current_blockcount_x;
+		size_t region_y = start_y + current_blockcount_y;
+		size_t region_z = start_z + current_blockcount_z;
+		size_t region_offset_x = offset_x - start_x;
+		size_t region_offset_y = offset_y - start_y;
+		size_t region_offset_z = offset_z - start_z;
+
+		// borders of the region (0 outside of the field, as in the compressor)
+		for(ptrdiff_t ii=-1; ii<(ptrdiff_t)region_x; ii++){
+			for(ptrdiff_t jj=-1; jj<(ptrdiff_t)region_y; jj++){
+				for(ptrdiff_t kk=-1; kk<(ptrdiff_t)region_z; kk++){
+					if(ii >= 0 && jj >= 0 && kk >= 0) break;
+					float value = 0;
+					if((ptrdiff_t)region_offset_x + ii >= 0 && (ptrdiff_t)region_offset_y + jj >= 0 && (ptrdiff_t)region_offset_z + kk >= 0)
+						value = region_pos[ii * (ptrdiff_t)dim0_offset + jj * (ptrdiff_t)dim1_offset + kk];
+					buf[(ii + 1) * buf_dim0_offset + (jj + 1) * buf_dim1_offset + kk + 1] = value;
+				}
+			}
+		}
+
+		int * type = sample->codes + sample->count;
+		size_t index = 0;
+		for(size_t ii=0; ii<region_x; ii++){
+			for(size_t jj=0; jj<region_y; jj++){
+				float * cur_data_pos = region_pos + ii * dim0_offset + jj * dim1_offset;
+				float * cur_buf_pos = buf + (ii + 1) * buf_dim0_offset + (jj + 1) * buf_dim1_offset + 1;
+				int in_block_xy = ii >= start_x && jj >= start_y;
+				for(size_t kk=0; kk<region_z; kk++){
+					float curData = cur_data_pos[kk];
+					float * p = cur_buf_pos + kk;
+					int in_block = in_block_xy && kk >= start_z;
+					int code;
+					float pred;
+					if(use_reg){
+						if(regDim == 3)
+							pred = reg_params[0] * ii + reg_params[1] * jj + reg_params[2] * kk + reg_params[3];
+						else
+							pred = reg_params[0] * jj + reg_params[1] * kk + reg_params[2];
+					}
+					else if(use_mean && fabsf(curData - mean) <= realPrecision){
+						*p = mean;
+						if(in_block) type[index ++] = 1;
+						continue;
+					}
+					else
+						pred = p[-1] + p[-buf_dim1_offset] + p[-buf_dim0_offset] - p[-buf_dim1_offset - 1] - p[-buf_dim0_offset - 1]
+							- p[-buf_dim0_offset - buf_dim1_offset] + p[-buf_dim0_offset - buf_dim1_offset - 1];
+					float diff = curData - pred;
+					float itvNum = fabsf(diff)*recip_realPrecision + 1;
+					if (itvNum < intvCapacity_sz){
+						if (diff < 0) itvNum = -itvNum;
+						code = (int) (itvNum/2) + intvRadius;
+						pred = pred + 2 * (code - intvRadius) * realPrecision;
+						if(fabsf(curData - pred)>realPrecision){
+							code = 0;
+							pred = curData;
+						}
+					}
+					else{
+						code = 0;
+						pred = curData;
+					}
+					*p = pred;
+					if(in_block){
+						type[index ++] = code;
+						if(code == 0)
+							sample->unpredCount ++;
+					}
+				}
+			}
+		}
+		sample->count += index;
+		sample->processed += region_x * region_y * region_z;
+		sample->sampledBlocks ++;
+		if(use_reg) sample->regBlocks ++;
+	}
+	free(buf);
+}
+
+static void sample_quantization_codes_double(double *oriData, size_t r1, size_t r2, size_t r3, size_t block_size, int regDim,
+double realPrecision, unsigned int intervals, unsigned char use_mean, double mean, sz_estimate_sample *sample)
+{
+	size_t num_x, num_y, num_z;
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r1, num_x, block_size);
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r2, num_y, block_size);
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r3, num_z, block_size);
+
+	size_t split_index_x, split_index_y, split_index_z;
+	size_t early_blockcount_x, early_blockcount_y, early_blockcount_z;
+	size_t late_blockcount_x, late_blockcount_y, late_blockcount_z;
+	SZ_COMPUTE_BLOCKCOUNT(r1, num_x, split_index_x, early_blockcount_x, late_blockcount_x);
+	SZ_COMPUTE_BLOCKCOUNT(r2, num_y, split_index_y, early_blockcount_y, late_blockcount_y);
+	SZ_COMPUTE_BLOCKCOUNT(r3, num_z, split_index_z, early_blockcount_z, late_blockcount_z);
+
+	size_t num_blocks = num_x * num_y * num_z;
+	size_t stride = num_blocks / SZ_ESTIMATE_MIN_BLOCKS;
+	if(stride > SZ_ESTIMATE_MAX_STRIDE) stride = SZ_ESTIMATE_MAX_STRIDE;
+	if(stride == 0) stride = 1;
+	size_t num_samples = (num_blocks + stride - 1) / stride;
+
+	size_t dim0_offset = r2 * r3;
+	size_t dim1_offset = r3;
+	// warm-up margin of one block in the dimensions which are split into blocks
+	size_t margin_x = num_x > 1 ? early_blockcount_x : 0;
+	size_t margin_y = num_y > 1 ? early_blockcount_y : 0;
+	size_t margin_z = num_z > 1 ? early_blockcount_z : 0;
+	size_t buf_dim1_offset = margin_z + early_blockcount_z + 1;
+	size_t buf_dim0_offset = (margin_y + early_blockcount_y + 1) * buf_dim1_offset;
+	double * buf = (double *) malloc((margin_x + early_blockcount_x + 1) * buf_dim0_offset * sizeof(double));
+	size_t max_count = num_samples * early_blockcount_x * early_blockcount_y * early_blockcount_z;
+	sample->codes = (int *) malloc(max_count * sizeof(int));
+	sample->count = 0;
+	sample->unpredCount = 0;
+	sample->numBlocks = num_blocks;
+	sample->sampledBlocks = 0;
+	sample->regBlocks = 0;
+	sample->coeffCount = regDim == 3 ? 4 : 3;
+	sample->processed = 0;
+	memset(sample->coeffCodeSum, 0, sizeof(sample->coeffCodeSum));
+	memset(sample->coeffCoded, 0, sizeof(sample->coeffCoded));
+	memset(sample->coeffUnpred, 0, sizeof(sample->coeffUnpred));
+
+	double recip_realPrecision = 1/realPrecision;
+	double noise = realPrecision * (regDim == 3 ? 1.22 : 0.81);
+	int intvCapacity = intervals;
+	int intvRadius = intervals/2;
+	int intvCapacity_sz = use_mean ? intvCapacity - 2 : intvCapacity;
+	double reg_params[4], last_reg_params[4];
+	// precisions of the coefficients in the blocked regression compressors
+	double coeff_precision[4];
+	double rel_param_err = regDim == 3 ? 0.025 : 0.15/3;
+	coeff_precision[0] = rel_param_err * realPrecision / (regDim == 3 ? late_blockcount_x : late_blockcount_y);
+	coeff_precision[1] = rel_param_err * realPrecision / (regDim == 3 ? late_blockcount_y : late_blockcount_z);
+	coeff_precision[2] = regDim == 3 ? rel_param_err * realPrecision / late_blockcount_z : rel_param_err * realPrecision;
+	coeff_precision[3] = rel_param_err * realPrecision;
+
+	for(size_t s=0; s<num_samples; s++){
+		// shift the sampled block inside its stride so that the samples do not align with a dimension
+		size_t b = s * stride + (s * 37 + stride / 2) % stride;
+		if(b >= num_blocks) break;
+		size_t i = b / (num_y * num_z);
+		size_t j = (b / num_z) % num_y;
+		size_t k = b % num_z;
+		size_t current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
+		size_t current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
+		size_t current_blockcount_z = (k < split_index_z) ? early_blockcount_z : late_blockcount_z;
+		size_t offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
+		size_t offset_y = (j < split_index_y) ? j * early_blockcount_y : j * late_blockcount_y + split_index_y;
+		size_t offset_z = (k < split_index_z) ? k * early_blockcount_z : k * late_blockcount_z + split_index_z;
+		double * data_pos = oriData + offset_x * dim0_offset + offset_y * dim1_offset + offset_z;
+
+		int use_reg = 0;
+		if(regDim == 3 && current_blockcount_x > 1 && current_blockcount_y > 1 && current_blockcount_z > 1){
+			fit_block_regression_double_3D(data_pos, current_blockcount_x, current_blockcount_y, current_blockcount_z, dim0_offset, dim1_offset, 1, reg_params);
+			use_reg = !choose_block_predictor_double_3D(data_pos, current_blockcount_x, current_blockcount_y, current_blockcount_z, dim0_offset, dim1_offset,
+				1, reg_params, noise, use_mean, mean);
+		}
+		else if(regDim == 2 && current_blockcount_y > 1 && current_blockcount_z > 1){
+			fit_block_regression_double_2D(data_pos, current_blockcount_y, current_blockcount_z, dim1_offset, 1, reg_params);
+			use_reg = !choose_block_predictor_double_2D(data_pos, current_blockcount_y, current_blockcount_z, dim1_offset, 1, reg_params, noise, use_mean, mean);
+		}
+		if(use_reg){
+			// the coefficients are predicted by those of the previous block, approximated by its neighbour along the last dimension
+			size_t last_blockcount_z = (k - 1 < split_index_z) ? early_blockcount_z : late_blockcount_z;
+			memset(last_reg_params, 0, sizeof(last_reg_params));
+			if(k > 0 && last_blockcount_z > 1){
+				if(regDim == 3)
+					fit_block_regression_double_3D(data_pos - last_blockcount_z, current_blockcount_x, current_blockcount_y, last_blockcount_z, dim0_offset, dim1_offset, 1, last_reg_params);
+				else
+					fit_block_regression_double_2D(data_pos - last_blockcount_z, current_blockcount_y, last_blockcount_z, dim1_offset, 1, last_reg_params);
+			}
+			for(int e=0; e<sample->coeffCount; e++){
+				double itvNum = fabs(reg_params[e] - last_reg_params[e]) / coeff_precision[e] + 1;
+				if(itvNum < 65536){
+					sample->coeffCodeSum[e] += (int) (itvNum/2);
+					sample->coeffCoded[e] ++;
+				}
+				else
+					sample->coeffUnpred[e] ++;
+			}
+		}
+
+		// the quantized region: the block, preceded by the warm-up margin for Lorenzo
+		size_t start_x = use_reg || offset_x < margin_x ? 0 : margin_x;
+		size_t start_y = use_reg || offset_y < margin_y ? 0 : margin_y;
+		size_t start_z = use_reg || offset_z < margin_z ? 0 : margin_z;
+		double * region_pos = data_pos - start_x * dim0_offset - start_y * dim1_offset - start_z;
+		size_t region_x = start_x + current_blockcount_x;
+		size_t region_y = start_y + current_blockcount_y;
+		size_t region_z = start_z + current_blockcount_z;
+		size_t region_offset_x = offset_x - start_x;
+		size_t region_offset_y = offset_y - start_y;
+		size_t region_offset_z = offset_z - start_z;
+
+		// borders of the region (0 outside of the field, as in the compressor)
+		for(ptrdiff_t ii=-1; ii<(ptrdiff_t)region_x; ii++){
+			for(ptrdiff_t jj=-1; jj<(ptrdiff_t)region_y; jj++){
+				for(ptrdiff_t kk=-1; kk<(ptrdiff_t)region_z; kk++){
+					if(ii >= 0 && jj >= 0 && kk >= 0) break;
+					double value = 0;
+					if((ptrdiff_t)region_offset_x + ii >= 0 && (ptrdiff_t)region_offset_y + jj >= 0 && (ptrdiff_t)region_offset_z + kk >= 0)
+						value = region_pos[ii * (ptrdiff_t)dim0_offset + jj * (ptrdiff_t)dim1_offset + kk];
+					buf[(ii + 1) * buf_dim0_offset + (jj + 1) * buf_dim1_offset + kk + 1] = value;
+				}
+			}
+		}
+
+		int * type = sample->codes + sample->count;
+		size_t index = 0;
+		for(size_t ii=0; ii<region_x; ii++){
+			for(size_t jj=0; jj<region_y; jj++){
+				double * cur_data_pos = region_pos + ii * dim0_offset + jj * dim1_offset;
+				double * cur_buf_pos = buf + (ii + 1) * buf_dim0_offset + (jj + 1) * buf_dim1_offset + 1;
+				int in_block_xy = ii >= start_x && jj >= start_y;
+				for(size_t kk=0; kk<region_z; kk++){
+					double curData = cur_data_pos[kk];
+					double * p = cur_buf_pos + kk;
+					int in_block = in_block_xy && kk >= start_z;
+					int code;
+					double pred;
+					if(use_reg){
+						if(regDim == 3)
+							pred = reg_params[0] * ii + reg_params[1] * jj + reg_params[2] * kk + reg_params[3];
+						else
+							pred = reg_params[0] * jj + reg_params[1] * kk + reg_params[2];
+					}
+					else if(use_mean && fabs(curData - mean) <= realPrecision){
+						*p = mean;
+						if(in_block) type[index ++] = 1;
+						continue;
+					}
+					else
+						pred = p[-1] + p[-buf_dim1_offset] + p[-buf_dim0_offset] - p[-buf_dim1_offset - 1] - p[-buf_dim0_offset - 1]
+							- p[-buf_dim0_offset - buf_dim1_offset] + p[-buf_dim0_offset - buf_dim1_offset - 1];
+					double diff = curData - pred;
+					double itvNum = fabs(diff)*recip_realPrecision + 1;
+					if (itvNum < intvCapacity_sz){
+						if (diff < 0) itvNum = -itvNum;
+						code = (int) (itvNum/2) + intvRadius;
+						pred = pred + 2 * (code - intvRadius) * realPrecision;
+						if(fabs(curData - pred)>realPrecision){
+							code = 0;
+							pred = curData;
+						}
+					}
+					else{
+						code = 0;
+						pred = curData;
+					}
+					*p = pred;
+					if(in_block){
+						type[index ++] = code;
+						if(code == 0)
+							sample->unpredCount ++;
+					}
+				}
+			}
+		}
+		sample->count += index;
+		sample->processed += region_x * region_y * region_z;
+		sample->sampledBlocks ++;
+		if(use_reg) sample->regBlocks ++;
+	}
+	free(buf);
+}
+
+/**
+ * The bytes of the SZ stage (the compressor without its lossless stage) on boxes of the field: a grid of
+ * SZ_ESTIMATE_BOX_GRID^2 boxes of whole rows (planes of 1D fields: segments), about 1/SZ_ESTIMATE_BOX_FRACTION
+ * of the points in all, stacked and compressed as one field. The boxes are compressed at half of their thickness
+ * too, with the same faces, so that the cost of the faces cancels out between the two.
+ * The compressions of the boxes leave no trace in the settings or the statistics of the compression.
+ * */
+static void compress_boxes_float(float *data, size_t n1, size_t n2, size_t n3, int dim, int regDim, size_t block_size,
+double realPrecision, float valueRangeSize, float medianValue, sz_estimate_boxes *boxes)
+{
+	// the field is seen as p*q*r points, and the boxes are h*w*r points
+	size_t p = dim == 1 ? n3 : (dim == 2 ? n2 : n1);
+	size_t q = dim == 3 ? n2 : (dim == 2 ? n3 : 1);
+	size_t r = dim == 3 ? n3 : 1;
+	size_t unit = regDim ? block_size : (dim == 1 ? 1 : 4); //whole regression blocks, or at least four planes
+	size_t gx = dim == 1 ? SZ_ESTIMATE_BOX_GRID * SZ_ESTIMATE_BOX_GRID : SZ_ESTIMATE_BOX_GRID;
+	size_t gy = dim == 1 ? 1 : SZ_ESTIMATE_BOX_GRID;
+	size_t target = computeDataLength(0, 0, n1, n2, n3) / SZ_ESTIMATE_BOX_FRACTION;
+	if(target < SZ_ESTIMATE_MIN_BOX_POINTS)
+		target = SZ_ESTIMATE_MIN_BOX_POINTS;
+	size_t h = 2 * unit, w = q;
+	if(dim > 1)
+	{
+		w = (target / (gx * gy * h * r) + unit - 1) / unit * unit;
+		if(w < 2 * unit)
+			w = 2 * unit;
+	}
+	if(dim == 1 || gy * w > q)
+	{
+		gy = 1;
+		w = q;
+		h = (target / (gx * q * r) + unit - 1) / unit * unit;
+		if(h < 2 * unit)
+			h = 2 * unit;
+	}
+	while(gx > 1 && 2 * gx * h > p)
+		gx--;
+	if(h > p)
+		h = p;
+
+	// the boxes are centered in the cells of a gx*gy grid over the field and stacked along its first dimension,
+	// at their full thickness and at half of it
+	size_t thickness[2] = {h / 2 / unit * unit, h};
+	size_t a, b, i, j, k;
+	float *boxData = (float *) malloc(gx * gy * h * w * r * sizeof(float));
+	int savedBlockSize = confparams_cpr->regressionBlockSize;
+	int savedIntvCapacity = exe_params->intvCapacity, savedIntvRadius = exe_params->intvRadius;
+	int savedStatsEnabled = sz_stats_enabled;
+	sz_stats savedStats = sz_curStats;
+	sz_stats_enabled = 1; //for the size of the trees
+	confparams_cpr->regressionBlockSize = block_size;
+	for(k=0;k<2;k++)
+	{
+		size_t t = gx * gy * thickness[k];
+		boxes->bytes[k] = NULL;
+		boxes->size[k] = 0;
+		boxes->length[k] = t * w * r;
+		boxes->treeBytes[k] = 0;
+		if(t == 0)
+			continue;
+		float *pos = boxData;
+		for(a=0;a<gx;a++)
+			for(b=0;b<gy;b++)
+			{
+				size_t x = (p - h) * (2*a + 1) / (2*gx);
+				size_t y = (q - w) * (2*b + 1) / (2*gy);
+				for(i=0;i<thickness[k];i++)
+					for(j=0;j<w;j++, pos+=r)
+						memcpy(pos, data + ((x + i)*q + y + j)*r, r*sizeof(float));
+			}
+		memset(&sz_curStats, 0, sizeof(sz_stats));
+		if(regDim == 2)
+			boxes->bytes[k] = SZ_compress_float_2D_MDQ_nonblocked_with_blocked_regression(boxData, t, w, realPrecision, &boxes->size[k]);
+		else if(regDim == 3)
+			boxes->bytes[k] = SZ_compress_float_3D_MDQ_nonblocked_with_blocked_regression(boxData, t, w, r, realPrecision, &boxes->size[k]);
+		else if(dim == 1)
+			SZ_compress_args_float_NoCkRngeNoGzip_1D(-1, &boxes->bytes[k], boxData, t, realPrecision, &boxes->size[k], valueRangeSize, medianValue);
+		else if(dim == 2)
+			SZ_compress_args_float_NoCkRngeNoGzip_2D(-1, &boxes->bytes[k], boxData, t, w, realPrecision, &boxes->size[k], valueRangeSize, medianValue);
+		else
+			SZ_compress_args_float_NoCkRngeNoGzip_3D(-1, &boxes->bytes[k], boxData, t, w, r, realPrecision, &boxes->size[k], valueRangeSize, medianValue);
+		boxes->treeBytes[k] = sz_curStats.huffmanTreeBytes;
+	}
+	confparams_cpr->regressionBlockSize = savedBlockSize;
+	exe_params->intvCapacity = savedIntvCapacity;
+	exe_params->intvRadius = savedIntvRadius;
+	sz_curStats = savedStats;
+	sz_stats_enabled = savedStatsEnabled;
+	free(boxData);
+}
+
+static void compress_boxes_double(double *data, size_t n1, size_t n2, size_t n3, int dim, int regDim, size_t block_size,
+double realPrecision, double valueRangeSize, double medianValue, sz_estimate_boxes *boxes)
+{
+	// the field is seen as p*q*r points, and the boxes are h*w*r points
+	size_t p = dim == 1 ? n3 : (dim == 2 ? n2 : n1);
+	size_t q = dim == 3 ? n2 : (dim == 2 ? n3 : 1);
+	size_t r = dim == 3 ? n3 : 1;
+	size_t unit = regDim ? block_size : (dim == 1 ? 1 : 4); //whole regression blocks, or at least four planes
+	size_t gx = dim == 1 ? SZ_ESTIMATE_BOX_GRID * SZ_ESTIMATE_BOX_GRID : SZ_ESTIMATE_BOX_GRID;
+	size_t gy = dim == 1 ? 1 : SZ_ESTIMATE_BOX_GRID;
+	size_t target = computeDataLength(0, 0, n1, n2, n3) / SZ_ESTIMATE_BOX_FRACTION;
+	if(target < SZ_ESTIMATE_MIN_BOX_POINTS)
+		target = SZ_ESTIMATE_MIN_BOX_POINTS;
+	size_t h = 2 * unit, w = q;
+	if(dim > 1)
+	{
+		w = (target / (gx * gy * h * r) + unit - 1) / unit * unit;
+		if(w < 2 * unit)
+			w = 2 * unit;
+	}
+	if(dim == 1 || gy * w > q)
+	{
+		gy = 1;
+		w = q;
+		h = (target / (gx * q * r) + unit - 1) / unit * unit;
+		if(h < 2 * unit)
+			h = 2 * unit;
+	}
+	while(gx > 1 && 2 * gx * h > p)
+		gx--;
+	if(h > p)
+		h = p;
+
+	// the boxes are centered in the cells of a gx*gy grid over the field and stacked along its first dimension,
+	// at their full thickness and at half of it
+	size_t thickness[2] = {h / 2 / unit * unit, h};
+	size_t a, b, i, j, k;
+	double *boxData = (double *) malloc(gx * gy * h * w * r * sizeof(double));
+	int savedBlockSize = confparams_cpr->regressionBlockSize;
+	int savedIntvCapacity = exe_params->intvCapacity, savedIntvRadius = exe_params->intvRadius;
+	int savedStatsEnabled = sz_stats_enabled;
+	sz_stats savedStats = sz_curStats;
+	sz_stats_enabled = 1; //for the size of the trees
+	confparams_cpr->regressionBlockSize = block_size;
+	for(k=0;k<2;k++)
+	{
+		size_t t = gx * gy * thickness[k];
+		boxes->bytes[k] = NULL;
+		boxes->size[k] = 0;
+		boxes->length[k] = t * w * r;
+		boxes->treeBytes[k] = 0;
+		if(t == 0)
+			continue;
+		double *pos = boxData;
+		for(a=0;a<gx;a++)
+			for(b=0;b<gy;b++)
+			{
+				size_t x = (p - h) * (2*a + 1) / (2*gx);
+				size_t y = (q - w) * (2*b + 1) / (2*gy);
+				for(i=0;i<thickness[k];i++)
+					for(j=0;j<w;j++, pos+=r)
+						memcpy(pos, data + ((x + i)*q + y + j)*r, r*sizeof(double));
+			}
+		memset(&sz_curStats, 0, sizeof(sz_stats));
+		if(regDim == 2)
+			boxes->bytes[k] = SZ_compress_double_2D_MDQ_nonblocked_with_blocked_regression(boxData, t, w, realPrecision, &boxes->size[k]);
+		else if(regDim == 3)
+			boxes->bytes[k] = SZ_compress_double_3D_MDQ_nonblocked_with_blocked_regression(boxData, t, w, r, realPrecision, &boxes->size[k]);
+		else if(dim == 1)
+			SZ_compress_args_double_NoCkRngeNoGzip_1D(-1, &boxes->bytes[k], boxData, t, realPrecision, &boxes->size[k], valueRangeSize, medianValue);
+		else if(dim == 2)
+			SZ_compress_args_double_NoCkRngeNoGzip_2D(-1, &boxes->bytes[k], boxData, t, w, realPrecision, &boxes->size[k], valueRangeSize, medianValue);
+		else
+			SZ_compress_args_double_NoCkRngeNoGzip_3D(-1, &boxes->bytes[k], boxData, t, w, r, realPrecision, &boxes->size[k], valueRangeSize, medianValue);
+		boxes->treeBytes[k] = sz_curStats.huffmanTreeBytes;
+	}
+	confparams_cpr->regressionBlockSize = savedBlockSize;
+	exe_params->intvCapacity = savedIntvCapacity;
+	exe_params->intvRadius = savedIntvRadius;
+	sz_curStats = savedStats;
+	sz_stats_enabled = savedStatsEnabled;
+	free(boxData);
+}
+
+/**
+ * Time of building a Huffman tree of stateNum states, which the compressor pays once whatever the number of points.
+ * It is proportional to the number of states (the tree allocates and clears its nodes), so the time of the largest
+ * tree is measured once and scaled.
+ * */
+static double huffman_tree_time(int stateNum)
+{
+	static double maxTreeTime = -1;
+	int maxStateNum = 2*65536;
+	if(maxTreeTime < 0)
+	{
+		int code = 0;
+		double start = sz_stats_time();
+		HuffmanTree* huffmanTree = createHuffmanTree(maxStateNum);
+		init(huffmanTree, &code, 1);
+		SZ_ReleaseHuffman(huffmanTree);
+		maxTreeTime = sz_stats_time() - start;
+	}
+	return maxTreeTime * stateNum / maxStateNum;
+}
+
+/**
+ * Size of a serialized Huffman tree of the given number of distinct codes (with its node count and intervals).
+ * */
+static double huffman_tree_bytes(double distinctCodes)
+{
+	double nodeBytes = distinctCodes <= 128 ? 7 : (distinctCodes <= 32768 ? 9 : 13);
+	return (2 * distinctCodes - 1) * nodeBytes + 8;
+}
+
+/**
+ * Number of distinct codes among n codes, given the counts of the codes seen in a sample of sampleCount codes:
+ * distinct codes in all, and those seen once and twice. The codes never seen in the sample are estimated with the
+ * Chao1 estimator, and those among them drawn in the other n - sampleCount codes follow their expected count.
+ * */
+static double distinct_codes(size_t sampleCount, size_t distinct, size_t once, size_t twice, size_t n, int stateNum)
+{
+	double codes = distinct;
+	double unseen = once > 1 ? (double)once * (once - 1) / (2 * (twice + 1)) : 0;
+	if(unseen > 0 && n > sampleCount)
+		codes += unseen * (1 - pow(1 - once / (sampleCount * unseen + once), (double)(n - sampleCount)));
+	return codes < stateNum ? codes : stateNum;
+}
+
+/**
+ * Turn the sampled quantization codes and the compressed boxes into the predicted size and time of the compression.
+ * The Huffman trees grow with the number of distinct codes: they grow from the boxes to the field as the main tree
+ * does, whose distinct codes are extrapolated from the sampled blocks. The rest of the stream of the SZ stage costs,
+ * per point of the field, what the points added from the half-thickness boxes to the boxes cost: the two have the same
+ * faces, where the prediction starts again. The lossless stage compresses the field as it compresses these points, and
+ * at least as well as the boxes.
+ * When the boxes were stored as they are, the stream is predicted from the Huffman encoding of the sampled codes.
+ * */
+static void estimate_from_sample(sz_estimate_sample *sample, sz_params *params, size_t dataLength, int typeSize, int headerSize,
+unsigned int intervals, double fullPassTime, double sampleTime, sz_estimate_boxes *boxes, sz_estimate *estimate)
+{
+	size_t i;
+	int stateNum = 2*intervals;
+	size_t * freq = (size_t *) calloc(stateNum, sizeof(size_t));
+	for(i=0;i<sample->count;i++)
+		freq[sample->codes[i]]++;
+	double entropy = 0;
+	size_t distinct = 0, once = 0, twice = 0;
+	for(i=0;i<(size_t)stateNum;i++)
+		if(freq[i] > 0)
+		{
+			double p = (double)freq[i] / sample->count;
+			entropy -= p * log2(p);
+			distinct++;
+			if(freq[i] == 1) once++;
+			else if(freq[i] == 2) twice++;
+		}
+
+	double huffmanStart = sz_stats_time();
+	HuffmanTree* huffmanTree = createHuffmanTree(stateNum);
+	unsigned char * huffmanBytes = NULL;
+	size_t huffmanSize = 0;
+	encode_withTree(huffmanTree, sample->codes, sample->count, &huffmanBytes, &huffmanSize);
+	double huffmanTime = sz_stats_time() - huffmanStart;
+	double codeBits = 0;
+	for(i=0;i<(size_t)stateNum;i++)
+		codeBits += (double)freq[i] * huffmanTree->cout[i];
+	SZ_ReleaseHuffman(huffmanTree);
+	free(huffmanBytes);
+	free(freq);
+	double treeTime = huffman_tree_time(stateNum);
+	if(sample->regBlocks > 0) //one more tree per regression coefficient
+		treeTime += sample->coeffCount * huffman_tree_time(2*65536);
+
+	double scale = (double)dataLength / sample->count;
+	double treeBytes = huffman_tree_bytes(distinct_codes(sample->count, distinct, once, twice, dataLength, stateNum));
+
+	double payloadBytes = codeBits / 8;
+	size_t unpredSize = sample->unpredCount * typeSize;
+	double unpredBytes = (double)unpredSize * scale;
+	double regFraction = sample->sampledBlocks > 0 ? (double)sample->regBlocks / sample->sampledBlocks : 0;
+	double regBytes = 0;
+	if(sample->regBlocks > 0)
+	{
+		// every coefficient has its own Huffman tree, whose codes spread around the center of the intervals
+		double regCount = regFraction * sample->numBlocks;
+		for(int e=0; e<sample->coeffCount; e++)
+		{
+			size_t sampled = sample->coeffCoded[e] + sample->coeffUnpred[e];
+			double meanCode = sample->coeffCoded[e] > 0 ? sample->coeffCodeSum[e] / sample->coeffCoded[e] : 0;
+			double codedBits = 2 * M_E * meanCode > 2 ? log2(2 * M_E * meanCode) : 1;
+			// distinct values among regCount draws of a Laplace distribution of mean meanCode
+			double spread = 2 * meanCode > 1 ? 2 * meanCode : 1;
+			double distinctCodes = spread * (log(regCount > spread ? regCount / spread : 1) + 0.5772) + 1;
+			if(distinctCodes > regCount) distinctCodes = regCount;
+			regBytes += regCount * (sample->coeffCoded[e] * codedBits / 8 + sample->coeffUnpred[e] * typeSize) / sampled;
+			treeBytes += huffman_tree_bytes(distinctCodes);
+		}
+		regBytes += sample->numBlocks / 8.0; //a predictor bit per block
+	}
+
+	double szBytes = payloadBytes * scale + treeBytes + regBytes + unpredBytes;
+	double streamBytes = -1, losslessRatio = 1, losslessTime = 0;
+	// boxes stored as they are (their stream was larger than their data) tell nothing of the stream of the field
+	if(boxes->bytes[1] != NULL && boxes->size[1] > boxes->treeBytes[1] && boxes->size[1] < boxes->length[1] * typeSize)
+	{
+		// the trees of the boxes grow as their main tree from the number of points of the boxes to the one of the field
+		double fieldTrees = boxes->treeBytes[1] * huffman_tree_bytes(distinct_codes(sample->count, distinct, once, twice, dataLength, stateNum))
+			/ huffman_tree_bytes(distinct_codes(sample->count, distinct, once, twice, boxes->length[1], stateNum));
+		szBytes = (double)(boxes->size[1] - boxes->treeBytes[1]) * dataLength / boxes->length[1] + fieldTrees;
+		// without the faces of the boxes
+		if(boxes->bytes[0] != NULL && boxes->size[0] > boxes->treeBytes[0] && boxes->length[1] > boxes->length[0]
+		&& boxes->size[1] - boxes->treeBytes[1] > boxes->size[0] - boxes->treeBytes[0])
+			szBytes = (double)((boxes->size[1] - boxes->treeBytes[1]) - (boxes->size[0] - boxes->treeBytes[0])) * dataLength / (boxes->length[1] - boxes->length[0]) + fieldTrees;
+		double lossless[2] = {0, 0};
+		losslessRatio = 1;
+		for(int k=0;k<2;k++)
+		{
+			if(boxes->bytes[k] == NULL || boxes->size[k] >= boxes->length[k] * typeSize)
+				continue;
+			lossless[k] = boxes->size[k];
+			if(params->szMode != SZ_BEST_SPEED)
+			{
+				unsigned char * losslessBytes = NULL;
+				double losslessStart = sz_stats_time();
+				unsigned long losslessSize = sz_lossless_compress(params->losslessCompressor, params->gzipMode, boxes->bytes[k], boxes->size[k], &losslessBytes);
+				if(k == 1)
+					losslessTime = (sz_stats_time() - losslessStart) * dataLength / boxes->length[1];
+				free(losslessBytes);
+				if(losslessSize > 0)
+					lossless[k] = losslessSize;
+			}
+		}
+		if(lossless[1] > 0)
+			losslessRatio = boxes->size[1] / lossless[1];
+		// repetitive streams are compressed better the longer they are
+		double marginalRatio = losslessRatio;
+		if(lossless[0] > 0 && lossless[1] > lossless[0] && boxes->size[1] > boxes->size[0]
+		&& (boxes->size[1] - boxes->size[0]) / (lossless[1] - lossless[0]) > marginalRatio)
+			marginalRatio = (boxes->size[1] - boxes->size[0]) / (lossless[1] - lossless[0]);
+		streamBytes = (szBytes - fieldTrees) / marginalRatio + fieldTrees / losslessRatio;
+	}
+
+	double outBytes;
+	if(szBytes >= (double)dataLength * typeSize)
+		outBytes = (double)dataLength * typeSize + headerSize; //the compressor would store the original data
+	else if(streamBytes >= 0)
+	{
+		outBytes = streamBytes + headerSize;
+		losslessRatio = szBytes / streamBytes;
+	}
+	else
+		outBytes = szBytes / losslessRatio + headerSize;
+	double encodeTime = huffmanTime > treeTime ? huffmanTime - treeTime : 0;
+	double processedScale = (double)dataLength / sample->processed;
+
+	estimate->compressedSize = (size_t)outBytes;
+	estimate->compressionRatio = (double)dataLength * typeSize / outBytes;
+	estimate->bitRate = outBytes * 8 / dataLength;
+	estimate->compressionTime = fullPassTime + treeTime + sampleTime * processedScale + encodeTime * scale + losslessTime;
+	estimate->entropy = entropy;
+	estimate->huffmanBitRate = codeBits / sample->count;
+	estimate->losslessRatio = losslessRatio;
+	estimate->unpredRatio = (double)sample->unpredCount / sample->count;
+	estimate->regressionBlockFraction = regFraction;
+	estimate->intervals = intervals;
+	estimate->sampleRatio = 1 / scale;
+}
+
+/**
+ * The fields which are not sampled: too small to be compressed, or within one error bound of their median.
+ * */
+static void estimate_stored_size(size_t dataLength, int typeSize, size_t outSize, sz_estimate *estimate)
+{
+	estimate->compressedSize = outSize;
+	estimate->compressionRatio = (double)dataLength * typeSize / outSize;
+	estimate->bitRate = (double)outSize * 8 / dataLength;
+	estimate->losslessRatio = 1;
+	estimate->sampleRatio = 1;
+}
+
+/**
+ * Estimate each of the modes on the same sample: the value range is computed once, and the intervals and the
+ * sample once per predictor (with or without regression), so the lossless settings only cost their lossless stage.
+ * */
+static int SZ_estimate_float(float *data, size_t r4, size_t r3, size_t r2, size_t r1, sz_params *params, double knownRange,
+sz_mode *modes, int modeCount, sz_estimate *estimates)
+{
+	int status = SZ_SCES;
+	int m;
+	double start = sz_stats_time();
+	size_t dataLength = computeDataLength(0, r4, r3, r2, r1);
+	int headerSize = 4 + MetaDataByteLength + exe_params->SZ_SIZE_TYPE;
+	if(dataLength <= MIN_NUM_OF_ELEMENTS)
+	{
+		for(m=0;m<modeCount;m++)
+		{
+			estimate_stored_size(dataLength, sizeof(float), dataLength * sizeof(float) + headerSize, &estimates[m]);
+			estimates[m].estimateTime = sz_stats_time() - start;
+		}
+		return status;
+	}
+
+	float valueRangeSize = knownRange, medianValue = 0;
+	if(knownRange < 0)
+		computeRangeSize_float(data, dataLength, &valueRangeSize, &medianValue);
+	double realPrecision;
+	if(params->errorBoundMode==PSNR)
+		realPrecision = computeABSErrBoundFromPSNR(params->psnr, (double)params->predThreshold, (double)valueRangeSize);
+	else if(params->errorBoundMode==NORM)
+		realPrecision = computeABSErrBoundFromNORM_ERR(params->normErr, dataLength);
+	else
+		realPrecision = getRealPrecision_float(valueRangeSize, params->errorBoundMode, params->absErrBound, params->relBoundRatio, &status);
+	if(status != SZ_SCES)
+		return status;
+	double rangeTime = sz_stats_time() - start;
+	if(valueRangeSize <= realPrecision)
+	{
+		for(m=0;m<modeCount;m++)
+		{
+			estimate_stored_size(dataLength, sizeof(float), headerSize + sizeof(float), &estimates[m]);
+			estimates[m].compressionTime = estimates[m].estimateTime = sz_stats_time() - start;
+		}
+		return status;
+	}
+
+	// the shape of the field as seen by the compressor (r1 is the slowest dimension)
+	size_t n1 = 1, n2 = 1, n3 = r1;
+	int dim = 1;
+	if(r2 != 0)
+	{
+		n2 = r2;
+		dim = 2;
+	}
+	if(r3 != 0)
+	{
+		n1 = r4 == 0 ? r3 : r4 * r3;
+		dim = 3;
+	}
+
+	for(int withReg=0; withReg<2; withReg++)
+	{
+		int regDim = withReg && dim >= 2 ? dim : 0;
+		for(m=0;m<modeCount;m++)
+			if((modes[m].withRegression != SZ_NO_REGRESSION && dim >= 2 ? dim : 0) == regDim)
+				break;
+		if(m == modeCount)
+			continue;
+
+		double passStart = sz_stats_time();
+		unsigned int intervals;
+		unsigned char use_mean = 0;
+		float dense_pos = 0, max_freq = 0, mean_freq = 0;
+		if(exe_params->optQuantMode==1)
+		{
+			// the same optimizers as the compressor: with the density of the values for the blocked regression
+			if(regDim == 2)
+				intervals = optimize_intervals_float_2D_with_freq_and_dense_pos(data, n2, n3, realPrecision, &dense_pos, &max_freq, &mean_freq);
+			else if(regDim == 3)
+				intervals = optimize_intervals_float_3D_with_freq_and_dense_pos(data, n1, n2, n3, realPrecision, &dense_pos, &max_freq, &mean_freq);
+			else if(dim == 1)
+				intervals = optimize_intervals_float_1D_opt(data, dataLength, realPrecision);
+			else if(dim == 2)
+				intervals = optimize_intervals_float_2D_opt(data, n2, n3, realPrecision);
+			else
+				intervals = optimize_intervals_float_3D_opt(data, n1, n2, n3, realPrecision);
+			if(regDim && (mean_freq > 0.5 || mean_freq > max_freq)) use_mean = 1;
+		}
+		else
+			intervals = exe_params->intvCapacity;
+
+		size_t block_size = dim == 1 ? SZ_ESTIMATE_1D_BLOCK_SIZE : (dim == 2 ? SZ_ESTIMATE_2D_BLOCK_SIZE : SZ_ESTIMATE_3D_BLOCK_SIZE);
+		if(regDim && params->regressionBlockSize > 0)
+			block_size = params->regressionBlockSize;
+		double fullPassTime = rangeTime + sz_stats_time() - passStart;
+
+		sz_estimate_sample sample;
+		double sampleStart = sz_stats_time();
+		sample_quantization_codes_float(data, n1, n2, n3, block_size, regDim, realPrecision, intervals, use_mean, dense_pos, &sample);
+		double sampleTime = sz_stats_time() - sampleStart;
+
+		sz_estimate_boxes boxes;
+		compress_boxes_float(data, n1, n2, n3, dim, regDim, block_size, realPrecision, valueRangeSize, medianValue, &boxes);
+
+		for(;m<modeCount;m++)
+		{
+			if((modes[m].withRegression != SZ_NO_REGRESSION && dim >= 2 ? dim : 0) != regDim)
+				continue;
+			sz_params modeParams = *params;
+			modeParams.withRegression = modes[m].withRegression;
+			modeParams.szMode = modes[m].szMode;
+			modeParams.losslessCompressor = modes[m].losslessCompressor;
+			modeParams.gzipMode = modes[m].gzipMode;
+			estimate_from_sample(&sample, &modeParams, dataLength, sizeof(float), headerSize, intervals, fullPassTime, sampleTime, &boxes, &estimates[m]);
+		}
+		free(boxes.bytes[0]);
+		free(boxes.bytes[1]);
+		free(sample.codes);
+	}
+	for(m=0;m<modeCount;m++)
+		estimates[m].estimateTime = sz_stats_time() - start;
+	return status;
+}
+
+static int SZ_estimate_double(double *data, size_t r4, size_t r3, size_t r2, size_t r1, sz_params *params, double knownRange,
+sz_mode *modes, int modeCount, sz_estimate *estimates)
+{
+	int status = SZ_SCES;
+	int m;
+	double start = sz_stats_time();
+	size_t dataLength = computeDataLength(0, r4, r3, r2, r1);
+	int headerSize = 4 + MetaDataByteLength_double + exe_params->SZ_SIZE_TYPE;
+	if(dataLength <= MIN_NUM_OF_ELEMENTS)
+	{
+		for(m=0;m<modeCount;m++)
+		{
+			estimate_stored_size(dataLength, sizeof(double), dataLength * sizeof(double) + headerSize, &estimates[m]);
+			estimates[m].estimateTime = sz_stats_time() - start;
+		}
+		return status;
+	}
+
+	double valueRangeSize = knownRange, medianValue = 0;
+	if(knownRange < 0)
+		computeRangeSize_double(data, dataLength, &valueRangeSize, &medianValue);
+	double realPrecision;
+	if(params->errorBoundMode==PSNR)
+		realPrecision = computeABSErrBoundFromPSNR(params->psnr, (double)params->predThreshold, valueRangeSize);
+	else if(params->errorBoundMode==NORM)
+		realPrecision = computeABSErrBoundFromNORM_ERR(params->normErr, dataLength);
+	else
+		realPrecision = getRealPrecision_double(valueRangeSize, params->errorBoundMode, params->absErrBound, params->relBoundRatio, &status);
+	if(status != SZ_SCES)
+		return status;
+	double rangeTime = sz_stats_time() - start;
+	if(valueRangeSize <= realPrecision)
+	{
+		for(m=0;m<modeCount;m++)
+		{
+			estimate_stored_size(dataLength, sizeof(double), headerSize + sizeof(double), &estimates[m]);
+			estimates[m].compressionTime = estimates[m].estimateTime = sz_stats_time() - start;
+		}
+		return status;
+	}
+
+	// the shape of the field as seen by the compressor (r1 is the slowest dimension)
+	size_t n1 = 1, n2 = 1, n3 = r1;
+	int dim = 1;
+	if(r2 != 0)
+	{
+		n2 = r2;
+		dim = 2;
+	}
+	if(r3 != 0)
+	{
+		n1 = r4 == 0 ? r3 : r4 * r3;
+		dim = 3;
+	}
+
+	for(int withReg=0; withReg<2; withReg++)
+	{
+		int regDim = withReg && dim >= 2 ? dim : 0;
+		for(m=0;m<modeCount;m++)
+			if((modes[m].withRegression != SZ_NO_REGRESSION && dim >= 2 ? dim : 0) == regDim)
+				break;
+		if(m == modeCount)
+			continue;
+
+		double passStart = sz_stats_time();
+		unsigned int intervals;
+		unsigned char use_mean = 0;
+		double dense_pos = 0, max_freq = 0, mean_freq = 0;
+		if(exe_params->optQuantMode==1)
+		{
+			// the same optimizers as the compressor: with the density of the values for the blocked regression
+			if(regDim == 2)
+				intervals = optimize_intervals_double_2D_with_freq_and_dense_pos(data, n2, n3, realPrecision, &dense_pos, &max_freq, &mean_freq);
+			else if(regDim == 3)
+				intervals = optimize_intervals_double_3D_with_freq_and_dense_pos(data, n1, n2, n3, realPrecision, &dense_pos, &max_freq, &mean_freq);
+			else if(dim == 1)
+				intervals = optimize_intervals_double_1D_opt(data, dataLength, realPrecision);
+			else if(dim == 2)
+				intervals = optimize_intervals_double_2D_opt(data, n2, n3, realPrecision);
+			else
+				intervals = optimize_intervals_double_3D_opt(data, n1, n2, n3, realPrecision);
+			if(regDim && (mean_freq > 0.5 || mean_freq > max_freq)) use_mean = 1;
+		}
+		else
+			intervals = exe_params->intvCapacity;
+
+		size_t block_size = dim == 1 ? SZ_ESTIMATE_1D_BLOCK_SIZE : (dim == 2 ? SZ_ESTIMATE_2D_BLOCK_SIZE : SZ_ESTIMATE_3D_BLOCK_SIZE);
+		if(regDim && params->regressionBlockSize > 0)
+			block_size = params->regressionBlockSize;
+		double fullPassTime = rangeTime + sz_stats_time() - passStart;
+
+		sz_estimate_sample sample;
+		double sampleStart = sz_stats_time();
+		sample_quantization_codes_double(data, n1, n2, n3, block_size, regDim, realPrecision, intervals, use_mean, dense_pos, &sample);
+		double sampleTime = sz_stats_time() - sampleStart;
+
+		sz_estimate_boxes boxes;
+		compress_boxes_double(data, n1, n2, n3, dim, regDim, block_size, realPrecision, valueRangeSize, medianValue, &boxes);
+
+		for(;m<modeCount;m++)
+		{
+			if((modes[m].withRegression != SZ_NO_REGRESSION && dim >= 2 ? dim : 0) != regDim)
+				continue;
+			sz_params modeParams = *params;
+			modeParams.withRegression = modes[m].withRegression;
+			modeParams.szMode = modes[m].szMode;
+			modeParams.losslessCompressor = modes[m].losslessCompressor;
+			modeParams.gzipMode = modes[m].gzipMode;
+			estimate_from_sample(&sample, &modeParams, dataLength, sizeof(double), headerSize, intervals, fullPassTime, sampleTime, &boxes, &estimates[m]);
+		}
+		free(boxes.bytes[0]);
+		free(boxes.bytes[1]);
+		free(sample.codes);
+	}
+	for(m=0;m<modeCount;m++)
+		estimates[m].estimateTime = sz_stats_time() - start;
+	return status;
+}
+
+/**
+ * Estimate the compressed size and the compression time of SZ_compress() without compressing the whole field.
+ * The value range and the quantization intervals are computed as in the compressor (they only read a sample of the
+ * points, apart from the range), then about 1/64 of the blocks (at least 64 blocks) are predicted and quantized with
+ * the compressor's predictors, for the statistics of the codes and the size of the Huffman trees. The size of the
+ * stream and the ratio of the lossless stage are measured on contiguous boxes of the field (about 1/64 of the points,
+ * at least 65536), which are compressed by the SZ stage and passed to the lossless stage at their full thickness and
+ * at half of it: the points added between the two sizes give the cost of a point away from the faces of the boxes,
+ * and how the lossless stage compresses a longer stream.
+ * The estimation costs 15-20% of the compression on fields of tens of MB. On fields of a few MB it costs 20-40%, and
+ * up to as much as the compression with the blocked regression, whose Huffman trees (one per coefficient) cost as much
+ * on the boxes as on the field.
+ *
+ * Measured on synthetic fields (smooth, smooth with a noise below the error bound, multi-scale, random, lognormal;
+ * REL 1E-2 to 1E-5, with and without regression), the mean error of the compressed size is 12-30% on 64x128x128,
+ * 1024x1024, 128x128x128 and 256x256x256 fields. The worst errors are on fields compressed more than 1000 times (to
+ * a few KB), which are overestimated up to 6 times (1D fields: 14 times), and on a few multi-scale fields which are
+ * underestimated up to 5 times. The time is within about 25% (1D fields: 50%).
+ *
+ * @param sz_params* params : the error bound and the compression settings (NULL: those of SZ_Init())
+ * @param sz_estimate* estimate : the prediction and its statistics
+ *
+ * @return SZ_SCES, or an error status (unsupported type, point-wise relative error bound, 5D field)
+ * */
+int SZ_estimate(int dataType, void *data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, sz_params *params, sz_estimate *estimate)
+{
+	if(confparams_cpr == NULL)
+	{
+		printf("Error: SZ_Init() has to be called before SZ_estimate()\n");
+		return SZ_NSCS;
+	}
+	if(params == NULL)
+		params = confparams_cpr;
+	sz_mode mode;
+	mode.withRegression = params->withRegression;
+	mode.szMode = params->szMode;
+	mode.losslessCompressor = params->losslessCompressor;
+	mode.gzipMode = params->gzipMode;
+	return SZ_estimateModes(dataType, data, r5, r4, r3, r2, r1, params, &mode, 1, estimate);
+}
+
+/**
+ * Estimate the compression of a field in several modes (see SZ_estimate()). The modes share the value range, and
+ * the modes with the same predictor share the sample, so they cost much less than as many calls to SZ_estimate().
+ *
+ * @param sz_params* params : the error bound and the other compression settings (NULL: those of SZ_Init())
+ * @param sz_mode* modes : the modes to estimate
+ * @param sz_estimate* estimates : the prediction of each mode
+ *
+ * @return SZ_SCES, or an error status (unsupported type, point-wise relative error bound, 5D field)
+ * */
+int SZ_estimateModes(int dataType, void *data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, sz_params *params,
+sz_mode *modes, int modeCount, sz_estimate *estimates)
+{
+	if(confparams_cpr == NULL)
+	{
+		printf("Error: SZ_Init() has to be called before SZ_estimate()\n");
+		return SZ_NSCS;
+	}
+	if(params == NULL)
+		params = confparams_cpr;
+	if(r5 != 0)
+	{
+		printf("Error: doesn't support 5 dimensions for now.\n");
+		return SZ_DERR;
+	}
+	if(params->errorBoundMode >= PW_REL)
+	{
+		printf("Error: SZ_estimate() does not support the point-wise relative error bounds\n");
+		return SZ_NSCS;
+	}
+	memset(estimates, 0, modeCount * sizeof(sz_estimate));
+	if(dataType == SZ_FLOAT)
+		return SZ_estimate_float((float *)data, r4, r3, r2, r1, params, -1, modes, modeCount, estimates);
+	else if(dataType == SZ_DOUBLE)
+		return SZ_estimate_double((double *)data, r4, r3, r2, r1, params, -1, modes, modeCount, estimates);
+	printf("Error: SZ_estimate() only supports SZ_FLOAT and SZ_DOUBLE\n");
+	return SZ_NSCS;
+}
+
+/**
+ * SZ_estimate() with the value range computed by the caller, for the repeated estimations of a field with different
+ * error bounds. The predicted time does not include the range.
+ * */
+int sz_estimate_with_range(int dataType, void *data, size_t r4, size_t r3, size_t r2, size_t r1, sz_params *params,
+double valueRangeSize, sz_estimate *estimate)
+{
+	sz_mode mode;
+	mode.withRegression = params->withRegression;
+	mode.szMode = params->szMode;
+	mode.losslessCompressor = params->losslessCompressor;
+	mode.gzipMode = params->gzipMode;
+	memset(estimate, 0, sizeof(sz_estimate));
+	if(dataType == SZ_FLOAT)
+		return SZ_estimate_float((float *)data, r4, r3, r2, r1, params, valueRangeSize, &mode, 1, estimate);
+	else if(dataType == SZ_DOUBLE)
+		return SZ_estimate_double((double *)data, r4, r3, r2, r1, params, valueRangeSize, &mode, 1, estimate);
+	return SZ_NSCS;
+}
@@ -733,14 +733,7 @@ size_t dataLength, size_t *outSize, float min, float max)
 			(*newByteData)[k++] = dsLengthBytes[i];
 
 		
-		if(sysEndianType==BIG_ENDIAN_SYSTEM)
-			memcpy((*newByteData)+4+exe_params->SZ_SIZE_TYPE, oriData, dataLength*floatSize);
-		else
-		{
-			unsigned char* p = (*newByteData)+4+exe_params->SZ_SIZE_TYPE;
-			for(i=0;i<dataLength;i++,p+=floatSize)
-				floatToBytes(p, oriData[i]);
-		}
+		copyArrayWithEndian((*newByteData)+4+exe_params->SZ_SIZE_TYPE, (unsigned char*)oriData, dataLength, floatSize, sysEndianType==LITTLE_ENDIAN_SYSTEM);
 		*outSize = totalByteLength;
 	}
 
@@ -342,14 +342,7 @@ unsigned char** newByteData, size_t *outSize)
 	for (i = 0; i < exe_params->SZ_SIZE_TYPE; i++)
 		(*newByteData)[k++] = dsLengthBytes[i];
 		
-	if(sysEndianType==BIG_ENDIAN_SYSTEM)
-		memcpy((*newByteData)+4+MetaDataByteLength+exe_params->SZ_SIZE_TYPE, oriData, dataLength*intSize);
-	else
-	{
-		unsigned char* p = (*newByteData)+4+MetaDataByteLength+exe_params->SZ_SIZE_TYPE;
-		for(i=0;i<dataLength;i++,p+=intSize)
-			int64ToBytes_bigEndian(p, oriData[i]);
-	}	
+	copyArrayWithEndian((*newByteData)+4+MetaDataByteLength+exe_params->SZ_SIZE_TYPE, (unsigned char*)oriData, dataLength, intSize, sysEndianType==LITTLE_ENDIAN_SYSTEM);
 	*outSize = totalByteLength;
 }
 
@@ -1219,6 +1212,10 @@ int errBoundMode, double absErr_Bound, double relBoundRatio)
 	{
 		SZ_compress_args_int64_withinRange(newByteData, oriData, dataLength, outSize);
 	}
+	else if(realPrecision < 1) //every value has to be kept exactly, so use the dedicated lossless mode
+	{
+		status = SZ_compress_args_int_lossless(newByteData, oriData, SZ_INT64, r5, r4, r3, r2, r1, outSize);
+	}
 	else
 	{
 		size_t tmpOutSize = 0;
@@ -0,0 +1,283 @@
+/**
+ *  @file sz_int_lossless.c
+ *  @date Oct, 2026
+ *  @brief Lossless compression of integer data (used when the error bound is below 1):
+ *  Lorenzo delta + zigzag + byte-plane shuffle, followed by the lossless back end (Zstd/Gzip).
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sz.h"
+#include "sz_int_lossless.h"
+
+int getIntTypeSize(int dataType)
+{
+	int intSize = 0;
+	switch(dataType)
+	{
+	case SZ_INT8:
+	case SZ_UINT8:
+		intSize = 1;
+		break;
+	case SZ_INT16:
+	case SZ_UINT16:
+		intSize = 2;
+		break;
+	case SZ_INT32:
+	case SZ_UINT32:
+		intSize = 4;
+		break;
+	case SZ_INT64:
+	case SZ_UINT64:
+		intSize = 8;
+		break;
+	}
+	return intSize;
+}
+
+/**
+ * The lossless mode always works on at most 3 dimensions: 4D/5D data are folded into the slowest dimension.
+ * */
+void collapseIntDims_lossless(size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, size_t* n3, size_t* n2, size_t* n1)
+{
+	*n1 = r1;
+	if(r2==0)
+	{
+		*n2 = 1;
+		*n3 = 1;
+	}
+	else if(r3==0)
+	{
+		*n2 = r2;
+		*n3 = 1;
+	}
+	else
+	{
+		*n2 = r2;
+		*n3 = r3*(r4==0?1:r4)*(r5==0?1:r5);
+	}
+}
+
+static void loadIntRow(void* data, int intSize, size_t offset, size_t n, uint64_t* row)
+{
+	size_t i;
+	switch(intSize)
+	{
+	case 1:
+	{
+		uint8_t* p = (uint8_t*)data + offset;
+		for(i=0;i<n;i++)
+			row[i] = p[i];
+		break;
+	}
+	case 2:
+	{
+		uint16_t* p = (uint16_t*)data + offset;
+		for(i=0;i<n;i++)
+			row[i] = p[i];
+		break;
+	}
+	case 4:
+	{
+		uint32_t* p = (uint32_t*)data + offset;
+		for(i=0;i<n;i++)
+			row[i] = p[i];
+		break;
+	}
+	case 8:
+		memcpy(row, (uint64_t*)data + offset, n*sizeof(uint64_t));
+		break;
+	}
+}
+
+static void storeIntRow(void* data, int intSize, size_t offset, size_t n, uint64_t* row)
+{
+	size_t i;
+	switch(intSize)
+	{
+	case 1:
+	{
+		uint8_t* p = (uint8_t*)data + offset;
+		for(i=0;i<n;i++)
+			p[i] = (uint8_t)row[i];
+		break;
+	}
+	case 2:
+	{
+		uint16_t* p = (uint16_t*)data + offset;
+		for(i=0;i<n;i++)
+			p[i] = (uint16_t)row[i];
+		break;
+	}
+	case 4:
+	{
+		uint32_t* p = (uint32_t*)data + offset;
+		for(i=0;i<n;i++)
+			p[i] = (uint32_t)row[i];
+		break;
+	}
+	case 8:
+		memcpy((uint64_t*)data + offset, row, n*sizeof(uint64_t));
+		break;
+	}
+}
+
+/**
+ *
+ * Compute the Lorenzo residuals of the integer array and store them (zigzag coded) as byte planes:
+ * planes[b*n+i] is the b-th byte (from the least significant one) of the i-th residual.
+ * All the arithmetic is performed modulo 2^(8*intSize), so signed and unsigned types share the code
+ * and the transform is exactly invertible.
+ *
+ * @param void* oriData : input data (any of SZ_INT8/16/32/64 or SZ_UINT8/16/32/64)
+ * @param int intSize : the number of bytes per value (1, 2, 4 or 8)
+ * @param unsigned char* planes : output buffer of r3*r2*r1*intSize bytes
+ *
+ * */
+void encodeLosslessIntResiduals(void* oriData, int intSize, size_t r3, size_t r2, size_t r1, unsigned char* planes)
+{
+	size_t i, j, k, index = 0;
+	size_t n = r3*r2*r1;
+	int b, bits = intSize*8;
+	uint64_t mask = bits==64 ? ~(uint64_t)0 : (((uint64_t)1 << bits) - 1);
+	uint64_t signBit = (uint64_t)1 << (bits-1);
+
+	//each row has a leading zero so that the left neighbor of column 0 is 0
+	uint64_t* rows = (uint64_t*)calloc(5*(r1+1), sizeof(uint64_t));
+	uint64_t* zero = rows;
+	uint64_t* cur = rows + (r1+1);
+	uint64_t* up = rows + 2*(r1+1);
+	uint64_t* back = rows + 3*(r1+1);
+	uint64_t* backUp = rows + 4*(r1+1);
+	uint64_t *u, *bk, *bu, *tmp;
+	uint64_t pred, diff, zz;
+
+	for(i=0;i<r3;i++)
+	{
+		for(j=0;j<r2;j++)
+		{
+			loadIntRow(oriData, intSize, (i*r2+j)*r1, r1, cur+1);
+			if(i>0)
+				loadIntRow(oriData, intSize, ((i-1)*r2+j)*r1, r1, back+1);
+			u = j>0 ? up : zero;
+			bk = i>0 ? back : zero;
+			bu = (i>0 && j>0) ? backUp : zero;
+			for(k=1;k<=r1;k++)
+			{
+				pred = cur[k-1] + u[k] - u[k-1] + bk[k] - bk[k-1] - bu[k] + bu[k-1];
+				diff = (cur[k] - pred) & mask;
+				zz = ((diff << 1) ^ ((diff & signBit) ? mask : 0)) & mask;
+				for(b=0;b<intSize;b++)
+					planes[b*n+index] = (unsigned char)(zz >> (b*8));
+				index++;
+			}
+			tmp = up; up = cur; cur = tmp;
+			tmp = backUp; backUp = back; back = tmp;
+		}
+	}
+	free(rows);
+}
+
+void decodeLosslessIntResiduals(unsigned char* planes, int intSize, size_t r3, size_t r2, size_t r1, void* data)
+{
+	size_t i, j, k, index = 0;
+	size_t n = r3*r2*r1;
+	int b, bits = intSize*8;
+	uint64_t mask = bits==64 ? ~(uint64_t)0 : (((uint64_t)1 << bits) - 1);
+
+	uint64_t* rows = (uint64_t*)calloc(5*(r1+1), sizeof(uint64_t));
+	uint64_t* zero = rows;
+	uint64_t* cur = rows + (r1+1);
+	uint64_t* up = rows + 2*(r1+1);
+	uint64_t* back = rows + 3*(r1+1);
+	uint64_t* backUp = rows + 4*(r1+1);
+	uint64_t *u, *bk, *bu, *tmp;
+	uint64_t pred, diff, zz;
+
+	for(i=0;i<r3;i++)
+	{
+		for(j=0;j<r2;j++)
+		{
+			if(i>0)
+				loadIntRow(data, intSize, ((i-1)*r2+j)*r1, r1, back+1);
+			u = j>0 ? up : zero;
+			bk = i>0 ? back : zero;
+			bu = (i>0 && j>0) ? backUp : zero;
+			for(k=1;k<=r1;k++)
+			{
+				zz = 0;
+				for(b=0;b<intSize;b++)
+					zz |= (uint64_t)planes[b*n+index] << (b*8);
+				diff = (zz >> 1) ^ ((zz & 1) ? mask : 0);
+				pred = cur[k-1] + u[k] - u[k-1] + bk[k] - bk[k-1] - bu[k] + bu[k-1];
+				cur[k] = (pred + diff) & mask;
+				index++;
+			}
+			storeIntRow(data, intSize, (i*r2+j)*r1, r1, cur+1);
+			tmp = up; up = cur; cur = tmp;
+			tmp = backUp; backUp = back; back = tmp;
+		}
+	}
+	free(rows);
+}
+
+/**
+ *
+ * Lossless compression of integer data, used instead of the quantization-based predictor when
+ * the error bound is less than 1 (i.e., every value has to be kept exactly).
+ *
+ * The output is: 3(version) + 1(sameRByte: 0011,xx00) + MetaDataByteLength + SZ_SIZE_TYPE(dataLength) + byte planes,
+ * which is then passed to the lossless compressor (confparams_cpr->losslessCompressor), except in SZ_BEST_SPEED mode.
+ *
+ * */
+int SZ_compress_args_int_lossless(unsigned char** newByteData, void* oriData, int dataType,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, size_t *outSize)
+{
+	size_t i, k = 0, n3, n2, n1;
+	int intSize = getIntTypeSize(dataType);
+	size_t dataLength = computeDataLength(r5,r4,r3,r2,r1);
+	collapseIntDims_lossless(r5, r4, r3, r2, r1, &n3, &n2, &n1);
+
+	size_t totalByteLength = 3 + 1 + MetaDataByteLength + exe_params->SZ_SIZE_TYPE + intSize*dataLength;
+	unsigned char* tmpByteData = (unsigned char*)malloc(totalByteLength);
+
+	unsigned char dsLengthBytes[8];
+	for (i = 0; i < 3; i++)//3
+		tmpByteData[k++] = versionNumber[i];
+
+	unsigned char sameByte = (unsigned char)(0x30 | convertDataTypeSize(intSize)); //0011,0000: lossless + delta coded
+	if(exe_params->SZ_SIZE_TYPE==8)
+		sameByte = (unsigned char) (sameByte | 0x40); // 01000000, the 6th bit
+	tmpByteData[k++] = sameByte;
+
+	convertSZParamsToBytes(confparams_cpr, &(tmpByteData[k]));
+	k = k + MetaDataByteLength;
+
+	sizeToBytes(dsLengthBytes, dataLength); //SZ_SIZE_TYPE: 4 or 8
+	for (i = 0; i < exe_params->SZ_SIZE_TYPE; i++)
+		tmpByteData[k++] = dsLengthBytes[i];
+
+	encodeLosslessIntResiduals(oriData, intSize, n3, n2, n1, &(tmpByteData[k]));
+
+	if(confparams_cpr->szMode==SZ_BEST_SPEED)
+	{
+		*outSize = totalByteLength;
+		*newByteData = tmpByteData;
+	}
+	else
+	{
+		*outSize = sz_lossless_compress(confparams_cpr->losslessCompressor, confparams_cpr->gzipMode, tmpByteData, totalByteLength, newByteData);
+		free(tmpByteData);
+	}
+	return SZ_SCES;
+}
+
+void decompressDataSeries_int_lossless(void* data, int dataType, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, unsigned char* planes)
+{
+	size_t n3, n2, n1;
+	collapseIntDims_lossless(r5, r4, r3, r2, r1, &n3, &n2, &n1);
+	decodeLosslessIntResiduals(planes, getIntTypeSize(dataType), n3, n2, n1, data);
+}
@@ -53,26 +53,26 @@ unsigned char * SZ_compress_float_2D_MDQ_openmp(float *oriData, size_t r1, size_
 
 unsigned char * SZ_compress_float_3D_MDQ_openmp(float *oriData, size_t r1, size_t r2, size_t r3, float realPrecision, size_t * comp_size){
 
-	float elapsed_time = 0.0;
+	SZ_STATS_BEGIN(startTime);
+	sz_stats_begin(r1*r2*r3*sizeof(float));
 
-	elapsed_time = -sz_wtime();
 	unsigned int quantization_intervals;
+	SZ_STATS_BEGIN(intervalStart);
 	if(exe_params->optQuantMode==1)
 	{
 		// quantization_intervals = optimize_intervals_float_3D(oriData, r1, realPrecision);
 		quantization_intervals = optimize_intervals_float_3D_opt(oriData, r1, r2, r3, realPrecision);
 		//quantization_intervals = 32768;
-		printf("3D number of bins: %d\nerror bound %.20f\n", quantization_intervals, realPrecision);
 		// exit(0);		
 		updateQuantizationInfo(quantization_intervals);
 	}	
 	else{
 		quantization_intervals = exe_params->intvCapacity;
 	}
-	elapsed_time += sz_wtime();
-	printf("opt interval time: %.4f\n", elapsed_time);
+	SZ_STATS_END(intervalTime, intervalStart);
+	SZ_STATS_SET(intervals, quantization_intervals);
 
-	elapsed_time = -sz_wtime();
+	SZ_STATS_BEGIN(predQuantStart);
 	int thread_num = sz_get_max_threads();
 	int thread_order = (int)log2(thread_num);
 	size_t num_x = 0, num_y = 0, num_z = 0;
@@ -102,7 +102,6 @@ unsigned char * SZ_compress_float_3D_MDQ_openmp(float *oriData, size_t r1, size_
 	}
 	sz_set_num_threads(thread_num);
 	// calculate block dims
-	printf("number of blocks: %zu %zu %zu\n", num_x, num_y, num_z);
 
 	size_t split_index_x, split_index_y, split_index_z;
 	size_t early_blockcount_x, early_blockcount_y, early_blockcount_z;
@@ -170,9 +169,8 @@ unsigned char * SZ_compress_float_3D_MDQ_openmp(float *oriData, size_t r1, size_
 		// free(P0);
 		// free(P1);
 	}
-	elapsed_time += sz_wtime();
-	printf("compression and quantization time: %.4f\n", elapsed_time);
-	elapsed_time = -sz_wtime();
+	SZ_STATS_END(predQuantTime, predQuantStart);
+	SZ_STATS_BEGIN(treeStart);
 	// printf("unpred count:\n");
 	// for(int i=0; i<num_blocks; i++){
 	// 	printf("%d ", unpredictable_count[i]);
@@ -184,9 +182,8 @@ unsigned char * SZ_compress_float_3D_MDQ_openmp(float *oriData, size_t r1, size_
 
 	size_t nodeCount = 0;
 	Huffman_init_openmp(huffmanTree, result_type, num_elements, thread_num, freq);
-	elapsed_time += sz_wtime();
-	printf("Build Huffman: %.4f\n", elapsed_time);
-	elapsed_time = -sz_wtime();
+	SZ_STATS_END(huffmanTime, treeStart);
+	SZ_STATS_BEGIN(unpredStart);
 	for (size_t i = 0; i < stateNum; i++)
 		if (huffmanTree->code[i]) nodeCount++;
 	nodeCount = nodeCount*2-1;
@@ -242,9 +239,8 @@ unsigned char * SZ_compress_float_3D_MDQ_openmp(float *oriData, size_t r1, size_
 	}
 	result_pos += total_unpred * sizeof(float);
 
-	elapsed_time += sz_wtime();
-	printf("write misc time: %.4f\n", elapsed_time);
-	elapsed_time = -sz_wtime();
+	SZ_STATS_END(predQuantTime, unpredStart);
+	SZ_STATS_BEGIN(encodeStart);
 
 	size_t * block_pos = (size_t *) result_pos;
 	result_pos += num_blocks * sizeof(size_t);
@@ -268,9 +264,8 @@ unsigned char * SZ_compress_float_3D_MDQ_openmp(float *oriData, size_t r1, size_
 		encode(huffmanTree, type, current_block_elements, encoding_buffer_pos, &enCodeSize);
 		block_pos[id] = enCodeSize;
 	}
-	elapsed_time += sz_wtime();
-	printf("Parallel Huffman encoding elapsed time: %.4f\n", elapsed_time);
-	elapsed_time = -sz_wtime();
+	SZ_STATS_END(huffmanTime, encodeStart);
+	SZ_STATS_BEGIN(copyStart);
 	// for(int t=0; t<thread_num; t++){
 	// 	memcpy(result_pos, encoding_buffer + t * max_num_block_elements * sizeof(int), block_pos[t]);
 	// 	result_pos += block_pos[t];
@@ -286,8 +281,10 @@ unsigned char * SZ_compress_float_3D_MDQ_openmp(float *oriData, size_t r1, size_
 	}
 	result_pos += block_offset[thread_num - 1] + block_pos[thread_num - 1];
 
-	elapsed_time += sz_wtime();
-	printf("Final copy elapsed time: %.4f\n", elapsed_time);
+	SZ_STATS_END(predQuantTime, copyStart);
+	SZ_STATS_ADD(huffmanBytes, treeByteSize + block_offset[thread_num - 1] + block_pos[thread_num - 1]);
+	SZ_STATS_ADD(huffmanTreeBytes, treeByteSize);
+	SZ_STATS_ADD(unpredCount, total_unpred);
 	// {
 	// 	int status;
 	// 	writeIntData_inBytes(result_type, num_elements, "/Users/LiangXin/github/SZ-develop/example/openmp/comp001_type.dat", &status);
@@ -314,6 +311,8 @@ unsigned char * SZ_compress_float_3D_MDQ_openmp(float *oriData, size_t r1, size_
 	SZ_ReleaseHuffman(huffmanTree);
 
 	*comp_size = totalEncodeSize;
+	SZ_STATS_SET(szBytes, totalEncodeSize);
+	sz_stats_end(startTime, totalEncodeSize);
 	return result;
 }
 
@@ -334,8 +333,6 @@ void decompressDataSeries_float_3D_openmp(float** data, size_t r1, size_t r2, si
 	
 	// printf("num_block_elements %d num_blocks %d\n", max_num_block_elements, num_blocks);
 	// fflush(stdout);
-	double elapsed_time = 0.0;
-	elapsed_time = -sz_wtime();
 
 	size_t dim0_offset = r2 * r3;
 	size_t dim1_offset = r3;
@@ -373,7 +370,6 @@ void decompressDataSeries_float_3D_openmp(float** data, size_t r1, size_t r2, si
 		}
 	}
 	
-	printf("number of blocks: %zu %zu %zu, thread_num %d\n", num_x, num_y, num_z, thread_num);
 	sz_set_num_threads(thread_num);
 	size_t split_index_x, split_index_y, split_index_z;
 	size_t early_blockcount_x, early_blockcount_y, early_blockcount_z;
@@ -448,9 +444,6 @@ void decompressDataSeries_float_3D_openmp(float** data, size_t r1, size_t r2, si
 		block_offset[t] = block_pos[t-1] + block_offset[t-1];
 	}
 	int num_yz = num_y * num_z;
-	elapsed_time += sz_wtime();
-	printf("Read data info elapsed time: %.4f\n", elapsed_time);
-	elapsed_time = -sz_wtime();
 	#pragma omp parallel for
 	for(int t=0; t<thread_num; t++){
 		int id = sz_get_thread_num();
@@ -467,9 +460,6 @@ void decompressDataSeries_float_3D_openmp(float** data, size_t r1, size_t r2, si
 		int * type = result_type + type_offset;
 		decode(comp_data_pos + block_offset[id], current_blockcount_x*current_blockcount_y*current_blockcount_z, root, type);
 	}
-	elapsed_time += sz_wtime();
-	printf("Parallel Huffman decoding elapsed time: %.4f\n", elapsed_time);
-	elapsed_time = -sz_wtime();
 
 	#pragma omp parallel for
 	for(int t=0; t<thread_num; t++){
@@ -499,8 +489,6 @@ void decompressDataSeries_float_3D_openmp(float** data, size_t r1, size_t r2, si
 		// printf("\n\n");
 		decompressDataSeries_float_3D_RA_block(data_pos, mean, r1, r2, r3, current_blockcount_x, current_blockcount_y, current_blockcount_z, realPrecision, type, unpredictable_data);
 	}	
-	elapsed_time += sz_wtime();
-	printf("Parallel decompress elapsed time: %.4f\n", elapsed_time);
 
 	free(block_offset);
 	free(result_type);
@@ -520,26 +508,26 @@ unsigned char * SZ_compress_double_2D_MDQ_openmp(double *oriData, size_t r1, siz
 
 unsigned char * SZ_compress_double_3D_MDQ_openmp(double *oriData, size_t r1, size_t r2, size_t r3, double realPrecision, size_t * comp_size){
 
-	float elapsed_time = 0.0;
+	SZ_STATS_BEGIN(startTime);
+	sz_stats_begin(r1*r2*r3*sizeof(double));
 
-	elapsed_time = -sz_wtime();
 	unsigned int quantization_intervals;
+	SZ_STATS_BEGIN(intervalStart);
 	if(exe_params->optQuantMode==1)
 	{
 		// quantization_intervals = optimize_intervals_float_3D(oriData, r1, realPrecision);
 		quantization_intervals = optimize_intervals_double_3D_opt(oriData, r1, r2, r3, realPrecision);
 		//quantization_intervals = 32768;
-		printf("3D number of bins: %d\nerror bound %.20f\n", quantization_intervals, realPrecision);
 		// exit(0);		
 		updateQuantizationInfo(quantization_intervals);
 	}	
 	else{
 		quantization_intervals = exe_params->intvCapacity;
 	}
-	elapsed_time += sz_wtime();
-	printf("opt interval time: %.4f\n", elapsed_time);
+	SZ_STATS_END(intervalTime, intervalStart);
+	SZ_STATS_SET(intervals, quantization_intervals);
 
-	elapsed_time = -sz_wtime();
+	SZ_STATS_BEGIN(predQuantStart);
 	int thread_num = sz_get_max_threads();
 	int thread_order = (int)log2(thread_num);
 	size_t num_x = 0, num_y = 0, num_z = 0;
@@ -569,7 +557,6 @@ unsigned char * SZ_compress_double_3D_MDQ_openmp(double *oriData, size_t r1, siz
 	}
 	sz_set_num_threads(thread_num);
 	// calculate block dims
-	printf("number of blocks: %zu %zu %zu\n", num_x, num_y, num_z);
 
 	size_t split_index_x, split_index_y, split_index_z;
 	size_t early_blockcount_x, early_blockcount_y, early_blockcount_z;
@@ -634,9 +621,8 @@ unsigned char * SZ_compress_double_3D_MDQ_openmp(double *oriData, size_t r1, siz
 		P1 = buffer1 + id * early_blockcount_y * early_blockcount_z;
 		unpredictable_count[id] = SZ_compress_double_3D_MDQ_RA_block(data_pos, mean + id, r1, r2, r3, current_blockcount_x, current_blockcount_y, current_blockcount_z, realPrecision, P0, P1, type, unpredictable_data);
 	}
-	elapsed_time += sz_wtime();
-	printf("compression and quantization time: %.4f\n", elapsed_time);
-	elapsed_time = -sz_wtime();
+	SZ_STATS_END(predQuantTime, predQuantStart);
+	SZ_STATS_BEGIN(treeStart);
 	// printf("unpred count:\n");
 	// for(int i=0; i<num_blocks; i++){
 	// 	printf("%d ", unpredictable_count[i]);
@@ -648,9 +634,8 @@ unsigned char * SZ_compress_double_3D_MDQ_openmp(double *oriData, size_t r1, siz
 
 	size_t nodeCount = 0;
 	Huffman_init_openmp(huffmanTree, result_type, num_elements, thread_num, freq);
-	elapsed_time += sz_wtime();
-	printf("Build Huffman: %.4f\n", elapsed_time);
-	elapsed_time = -sz_wtime();
+	SZ_STATS_END(huffmanTime, treeStart);
+	SZ_STATS_BEGIN(unpredStart);
 	for (size_t i = 0; i < stateNum; i++)
 		if (huffmanTree->code[i]) nodeCount++;
 	nodeCount = nodeCount*2-1;
@@ -700,9 +685,8 @@ unsigned char * SZ_compress_double_3D_MDQ_openmp(double *oriData, size_t r1, siz
 	}
 	result_pos += total_unpred * sizeof(double);
 
-	elapsed_time += sz_wtime();
-	printf("write misc time: %.4f\n", elapsed_time);
-	elapsed_time = -sz_wtime();
+	SZ_STATS_END(predQuantTime, unpredStart);
+	SZ_STATS_BEGIN(encodeStart);
 
 	size_t * block_pos = (size_t *) result_pos;
 	result_pos += num_blocks * sizeof(size_t);
@@ -726,9 +710,8 @@ unsigned char * SZ_compress_double_3D_MDQ_openmp(double *oriData, size_t r1, siz
 		encode(huffmanTree, type, current_block_elements, encoding_buffer_pos, &enCodeSize);
 		block_pos[id] = enCodeSize;
 	}
-	elapsed_time += sz_wtime();
-	printf("Parallel Huffman encoding elapsed time: %.4f\n", elapsed_time);
-	elapsed_time = -sz_wtime();
+	SZ_STATS_END(huffmanTime, encodeStart);
+	SZ_STATS_BEGIN(copyStart);
 	// for(int t=0; t<thread_num; t++){
 	// 	memcpy(result_pos, encoding_buffer + t * max_num_block_elements * sizeof(int), block_pos[t]);
 	// 	result_pos += block_pos[t];
@@ -744,8 +727,10 @@ unsigned char * SZ_compress_double_3D_MDQ_openmp(double *oriData, size_t r1, siz
 	}
 	result_pos += block_offset[thread_num - 1] + block_pos[thread_num - 1];
 
-	elapsed_time += sz_wtime();
-	printf("Final copy elapsed time: %.4f\n", elapsed_time);
+	SZ_STATS_END(predQuantTime, copyStart);
+	SZ_STATS_ADD(huffmanBytes, treeByteSize + block_offset[thread_num - 1] + block_pos[thread_num - 1]);
+	SZ_STATS_ADD(huffmanTreeBytes, treeByteSize);
+	SZ_STATS_ADD(unpredCount, total_unpred);
 	// {
 	// 	int status;
 	// 	writeIntData_inBytes(result_type, num_elements, "/Users/LiangXin/github/SZ-develop/example/openmp/comp001_type.dat", &status);
@@ -772,6 +757,8 @@ unsigned char * SZ_compress_double_3D_MDQ_openmp(double *oriData, size_t r1, siz
 	SZ_ReleaseHuffman(huffmanTree);
 
 	*comp_size = totalEncodeSize;
+	SZ_STATS_SET(szBytes, totalEncodeSize);
+	sz_stats_end(startTime, totalEncodeSize);
 	return result;
 }
 
@@ -792,8 +779,6 @@ void decompressDataSeries_double_3D_openmp(double** data, size_t r1, size_t r2,
 	
 	// printf("num_block_elements %d num_blocks %d\n", max_num_block_elements, num_blocks);
 	// fflush(stdout);
-	double elapsed_time = 0.0;
-	elapsed_time = -sz_wtime();
 
 	size_t dim0_offset = r2 * r3;
 	size_t dim1_offset = r3;
@@ -831,7 +816,6 @@ void decompressDataSeries_double_3D_openmp(double** data, size_t r1, size_t r2,
 		}
 	}
 	
-	printf("number of blocks: %zu %zu %zu, thread_num %d\n", num_x, num_y, num_z, thread_num);
 	sz_set_num_threads(thread_num);
 	size_t split_index_x, split_index_y, split_index_z;
 	size_t early_blockcount_x, early_blockcount_y, early_blockcount_z;
@@ -885,9 +869,6 @@ void decompressDataSeries_double_3D_openmp(double** data, size_t r1, size_t r2,
 		block_offset[t] = block_pos[t-1] + block_offset[t-1];
 	}
 	int num_yz = num_y * num_z;
-	elapsed_time += sz_wtime();
-	printf("Read data info elapsed time: %.4f\n", elapsed_time);
-	elapsed_time = -sz_wtime();
 	#pragma omp parallel for
 	for(int t=0; t<thread_num; t++){
 		int id = sz_get_thread_num();
@@ -904,9 +885,6 @@ void decompressDataSeries_double_3D_openmp(double** data, size_t r1, size_t r2,
 		int * type = result_type + type_offset;
 		decode(comp_data_pos + block_offset[id], current_blockcount_x*current_blockcount_y*current_blockcount_z, root, type);
 	}
-	elapsed_time += sz_wtime();
-	printf("Parallel Huffman decoding elapsed time: %.4f\n", elapsed_time);
-	elapsed_time = -sz_wtime();
 
 	#pragma omp parallel for
 	for(int t=0; t<thread_num; t++){
@@ -931,8 +909,6 @@ void decompressDataSeries_double_3D_openmp(double** data, size_t r1, size_t r2,
 
 		decompressDataSeries_double_3D_RA_block(data_pos, mean, r1, r2, r3, current_blockcount_x, current_blockcount_y, current_blockcount_z, realPrecision, type, unpredictable_data);
 	}	
-	elapsed_time += sz_wtime();
-	printf("Parallel decompress elapsed time: %.4f\n", elapsed_time);
 
 	free(block_offset);
 	free(result_type);
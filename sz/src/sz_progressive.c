@@ -0,0 +1,288 @@
+/**
+ *  @file sz_progressive.c
+ *  @date Oct, 2026
+ *  @brief Progressive streams: a base layer compressed at a loose error bound, followed by refinement layers
+ *  which compress the residual of the previous layers at tighter bounds. The decompression can stop after any
+ *  layer, reading only the bytes of the layers decoded.
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "sz.h"
+#include "sz_progressive.h"
+
+static void subtract_float(float *residual, float *data, float *reconstructed, size_t nbEle)
+{
+	size_t i;
+	for(i=0;i<nbEle;i++)
+		residual[i] = data[i] - reconstructed[i];
+}
+
+static void subtract_double(double *residual, double *data, double *reconstructed, size_t nbEle)
+{
+	size_t i;
+	for(i=0;i<nbEle;i++)
+		residual[i] = data[i] - reconstructed[i];
+}
+
+static double max_abs_float(float *data, size_t nbEle)
+{
+	size_t i;
+	double maxAbs = 0;
+	for(i=0;i<nbEle;i++)
+		if(fabs(data[i]) > maxAbs)
+			maxAbs = fabs(data[i]);
+	return maxAbs;
+}
+
+static double max_abs_double(double *data, size_t nbEle)
+{
+	size_t i;
+	double maxAbs = 0;
+	for(i=0;i<nbEle;i++)
+		if(fabs(data[i]) > maxAbs)
+			maxAbs = fabs(data[i]);
+	return maxAbs;
+}
+
+static void add_float(float *reconstructed, float *refinement, size_t nbEle)
+{
+	size_t i;
+	for(i=0;i<nbEle;i++)
+		reconstructed[i] += refinement[i];
+}
+
+static void add_double(double *reconstructed, double *refinement, size_t nbEle)
+{
+	size_t i;
+	for(i=0;i<nbEle;i++)
+		reconstructed[i] += refinement[i];
+}
+
+/**
+ * Compress a field into a progressive stream of nbLayers layers: the layer 0 is the field compressed with the
+ * absolute error bound errBounds[0], and the layer i the residual of the layers 0..i-1 compressed with errBounds[i].
+ * The decompression of the first i+1 layers is thus within errBounds[i] of the field: the refinement layers are
+ * compressed with their bound minus the rounding of the sum of the layers in the data type (one epsilon of the
+ * largest magnitude). The bounds of the refinement layers have to be above twice that rounding, i.e. above
+ * 2.4E-7 (float) or 4.5E-16 (double) times the largest magnitude of the field: a tighter bound cannot be met by
+ * a sum in the data type, and is rejected. The other settings are those of SZ_Init().
+ *
+ * The stream starts with the number of layers, then the error bound and the end offset of each layer, so that a
+ * reader can fetch the header (SZ_PROGRESSIVE_HEADER_SIZE(nbLayers) bytes) and then only the layers it needs.
+ * Each layer costs a compression and a decompression (to compute the next residual).
+ *
+ * @param double* errBounds : the absolute error bounds of the layers, in decreasing order
+ * @param int nbLayers : the number of layers (1 to SZ_PROGRESSIVE_MAX_LAYERS)
+ *
+ * @return the progressive stream, or NULL in case of error (or of a bound below the precision of the sum)
+ * */
+unsigned char* SZ_compress_progressive(int dataType, void *data, size_t *outSize, double *errBounds, int nbLayers,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	if(confparams_cpr == NULL)
+	{
+		printf("Error: SZ_Init() has to be called before SZ_compress_progressive()\n");
+		return NULL;
+	}
+	if(dataType != SZ_FLOAT && dataType != SZ_DOUBLE)
+	{
+		printf("Error: SZ_compress_progressive() only supports SZ_FLOAT and SZ_DOUBLE\n");
+		return NULL;
+	}
+	if(nbLayers < 1 || nbLayers > SZ_PROGRESSIVE_MAX_LAYERS)
+	{
+		printf("Error: the number of layers has to be between 1 and %d\n", SZ_PROGRESSIVE_MAX_LAYERS);
+		return NULL;
+	}
+	int i;
+	for(i=0;i<nbLayers;i++)
+		if(errBounds[i] <= 0 || (i > 0 && errBounds[i] >= errBounds[i-1]))
+		{
+			printf("Error: the error bounds of the layers have to be positive and decreasing\n");
+			return NULL;
+		}
+
+	size_t nbEle = computeDataLength(r5, r4, r3, r2, r1);
+	double rounding = dataType == SZ_FLOAT ? max_abs_float((float *)data, nbEle) * FLT_EPSILON
+		: max_abs_double((double *)data, nbEle) * DBL_EPSILON;
+	for(i=1;i<nbLayers;i++)
+		if(errBounds[i] <= 2 * rounding)
+		{
+			printf("Error: the error bound %g of the layer %d is below the precision of the sum of the layers (%g)\n", errBounds[i], i, 2 * rounding);
+			return NULL;
+		}
+
+	int typeSize = dataType == SZ_FLOAT ? sizeof(float) : sizeof(double);
+	unsigned char* layers[SZ_PROGRESSIVE_MAX_LAYERS];
+	size_t layerSizes[SZ_PROGRESSIVE_MAX_LAYERS];
+	void *residual = malloc(nbEle * typeSize);
+	void *reconstructed = NULL;
+	sz_params saved = *confparams_cpr;
+	int status = SZ_SCES;
+
+	for(i=0;i<nbLayers && status==SZ_SCES;i++)
+	{
+		void *layerData = data;
+		double layerBound = errBounds[i];
+		if(i > 0)
+		{
+			if(dataType == SZ_FLOAT)
+				subtract_float((float *)residual, (float *)data, (float *)reconstructed, nbEle);
+			else
+				subtract_double((double *)residual, (double *)data, (double *)reconstructed, nbEle);
+			layerData = residual;
+			layerBound -= rounding;
+		}
+		layers[i] = SZ_compress_args(dataType, layerData, &layerSizes[i], ABS, layerBound, 0, 0, r5, r4, r3, r2, r1);
+		*confparams_cpr = saved;
+		if(layers[i] == NULL)
+		{
+			status = SZ_NSCS;
+			break;
+		}
+		if(i == nbLayers - 1)
+			break; //the last layer has no residual to compute
+		// the residual is computed against the decompressed layers, exactly as the decompression will sum them
+		void *refinement = SZ_decompress(dataType, layers[i], layerSizes[i], r5, r4, r3, r2, r1);
+		if(refinement == NULL)
+		{
+			free(layers[i]);
+			status = SZ_NSCS;
+			break;
+		}
+		if(reconstructed == NULL)
+			reconstructed = refinement;
+		else
+		{
+			if(dataType == SZ_FLOAT)
+				add_float((float *)reconstructed, (float *)refinement, nbEle);
+			else
+				add_double((double *)reconstructed, (double *)refinement, nbEle);
+			free(refinement);
+		}
+	}
+	free(residual);
+	free(reconstructed);
+	if(status != SZ_SCES)
+	{
+		int j;
+		for(j=0;j<i;j++)
+			free(layers[j]);
+		return NULL;
+	}
+
+	size_t headerSize = SZ_PROGRESSIVE_HEADER_SIZE(nbLayers);
+	size_t totalSize = headerSize;
+	for(i=0;i<nbLayers;i++)
+		totalSize += layerSizes[i];
+	unsigned char* bytes = (unsigned char*) malloc(totalSize);
+	unsigned char* p = bytes + headerSize;
+	bytes[0] = (unsigned char)nbLayers;
+	for(i=0;i<nbLayers;i++)
+	{
+		memcpy(p, layers[i], layerSizes[i]);
+		p += layerSizes[i];
+		doubleToBytes(&bytes[1+16*i], errBounds[i]);
+		longToBytes_bigEndian(&bytes[1+16*i+8], (unsigned long)(p - bytes));
+		free(layers[i]);
+	}
+	*outSize = totalSize;
+	return bytes;
+}
+
+/**
+ * Read the header of a progressive stream.
+ *
+ * @param size_t byteLength : the number of bytes available (at least the header)
+ * @param double* errBounds : the error bounds of the layers (may be NULL)
+ * @param size_t* layerEnds : the number of bytes needed to decompress the layers 0..i (may be NULL)
+ *
+ * @return SZ_SCES, or SZ_NSCS if the bytes are not a progressive stream header
+ * */
+int SZ_progressiveInfo(unsigned char *bytes, size_t byteLength, int *nbLayers, double *errBounds, size_t *layerEnds)
+{
+	if(byteLength < 1 || bytes[0] < 1 || bytes[0] > SZ_PROGRESSIVE_MAX_LAYERS
+	|| byteLength < SZ_PROGRESSIVE_HEADER_SIZE(bytes[0]))
+	{
+		printf("Error: the bytes do not start with a progressive stream header\n");
+		return SZ_NSCS;
+	}
+	int i;
+	*nbLayers = bytes[0];
+	for(i=0;i<*nbLayers;i++)
+	{
+		if(errBounds != NULL)
+			errBounds[i] = bytesToDouble(&bytes[1+16*i]);
+		if(layerEnds != NULL)
+			layerEnds[i] = (size_t)bytesToLong_bigEndian(&bytes[1+16*i+8]);
+	}
+	return SZ_SCES;
+}
+
+/**
+ * Decompress the first nbLayers layers of a progressive stream (see SZ_compress_progressive()). The stream may be
+ * truncated: only the layers entirely within the byteLength bytes are decompressed, so that a preview only needs
+ * the header and the first layers.
+ *
+ * @param int nbLayers : the number of layers to decompress (0: all the available layers)
+ * @param double* errBound : the error bound of the decompressed data (may be NULL)
+ *
+ * @return the decompressed data, or NULL in case of error
+ * */
+void *SZ_decompress_progressive(int dataType, unsigned char *bytes, size_t byteLength, int nbLayers, double *errBound,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	if(dataType != SZ_FLOAT && dataType != SZ_DOUBLE)
+	{
+		printf("Error: SZ_decompress_progressive() only supports SZ_FLOAT and SZ_DOUBLE\n");
+		return NULL;
+	}
+	int streamLayers;
+	double errBounds[SZ_PROGRESSIVE_MAX_LAYERS];
+	size_t layerEnds[SZ_PROGRESSIVE_MAX_LAYERS];
+	if(SZ_progressiveInfo(bytes, byteLength, &streamLayers, errBounds, layerEnds) != SZ_SCES)
+		return NULL;
+	if(nbLayers <= 0 || nbLayers > streamLayers)
+		nbLayers = streamLayers;
+	while(nbLayers > 0 && layerEnds[nbLayers-1] > byteLength)
+		nbLayers--;
+	if(nbLayers == 0)
+	{
+		printf("Error: the base layer of the progressive stream is incomplete\n");
+		return NULL;
+	}
+
+	size_t nbEle = computeDataLength(r5, r4, r3, r2, r1);
+	size_t layerStart = SZ_PROGRESSIVE_HEADER_SIZE(streamLayers);
+	void *reconstructed = NULL;
+	int i;
+	for(i=0;i<nbLayers;i++)
+	{
+		void *refinement = SZ_decompress(dataType, bytes + layerStart, layerEnds[i] - layerStart, r5, r4, r3, r2, r1);
+		if(refinement == NULL)
+		{
+			free(reconstructed);
+			return NULL;
+		}
+		if(reconstructed == NULL)
+			reconstructed = refinement;
+		else
+		{
+			if(dataType == SZ_FLOAT)
+				add_float((float *)reconstructed, (float *)refinement, nbEle);
+			else
+				add_double((double *)reconstructed, (double *)refinement, nbEle);
+			free(refinement);
+		}
+		layerStart = layerEnds[i];
+	}
+	if(errBound != NULL)
+		*errBound = errBounds[nbLayers-1];
+	return reconstructed;
+}
@@ -0,0 +1,249 @@
+/**
+ *  @file sz_registry.c
+ *  @date Oct, 2026
+ *  @brief Registry of the compressors behind SZ_compress_customize()/SZ_decompress_customize():
+ *  the built-in ones (SZ, SZ1.4, SZ_Transpose, ExaFEL) and those registered by the users.
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sz.h"
+#include "sz_registry.h"
+
+/**
+ *
+ * Inits the compressor for SZ_compress_customize
+ *
+ * with SZ_Init(NULL) if not previously initialized and no params passed
+ * with SZ_InitParam(userPara) otherwise if params are passed
+ * and doesn't not initialize otherwise
+ *
+ * @param sz_params* userPara : the user configuration or null
+ * @param sz_params* confparams : the current configuration
+ */
+static void sz_maybe_init_with_user_params(struct sz_params* userPara, struct sz_params* current_params) {
+		if(userPara==NULL && current_params == NULL)
+			SZ_Init(NULL);
+		else if(userPara != NULL)
+			SZ_Init_Params((sz_params*)userPara);
+}
+
+static unsigned char* sz_compress_sz(void* userPara, int dataType, void* data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, size_t *outSize, int *status)
+{
+	sz_maybe_init_with_user_params(userPara, confparams_cpr);
+	unsigned char* result = SZ_compress(dataType, data, outSize, r5, r4, r3, r2, r1);
+	*status = result==NULL ? SZ_NSCS : SZ_SCES;
+	return result;
+}
+
+static unsigned char* sz_compress_sz14(void* userPara, int dataType, void* data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, size_t *outSize, int *status)
+{
+	sz_maybe_init_with_user_params(userPara, confparams_cpr);
+	confparams_cpr->withRegression = SZ_NO_REGRESSION;
+	unsigned char* result = SZ_compress(dataType, data, outSize, r5, r4, r3, r2, r1);
+	*status = result==NULL ? SZ_NSCS : SZ_SCES;
+	return result;
+}
+
+static int sz_compress_sz_to_buffer(void* userPara, int dataType, void* data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, unsigned char* bytes, size_t capacity, size_t *outSize)
+{
+	sz_maybe_init_with_user_params(userPara, confparams_cpr);
+	return SZ_compress_args_to_buffer(dataType, data, bytes, capacity, outSize, confparams_cpr->errorBoundMode, confparams_cpr->absErrBound, 
+	confparams_cpr->relBoundRatio, confparams_cpr->pw_relBoundRatio, r5, r4, r3, r2, r1);
+}
+
+static int sz_compress_sz14_to_buffer(void* userPara, int dataType, void* data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, unsigned char* bytes, size_t capacity, size_t *outSize)
+{
+	sz_maybe_init_with_user_params(userPara, confparams_cpr);
+	confparams_cpr->withRegression = SZ_NO_REGRESSION;
+	return SZ_compress_args_to_buffer(dataType, data, bytes, capacity, outSize, confparams_cpr->errorBoundMode, confparams_cpr->absErrBound, 
+	confparams_cpr->relBoundRatio, confparams_cpr->pw_relBoundRatio, r5, r4, r3, r2, r1);
+}
+
+static void* sz_decompress_sz(void* userPara, int dataType, unsigned char* bytes, size_t byteLength, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, int *status)
+{
+	void* result = SZ_decompress(dataType, bytes, byteLength, r5, r4, r3, r2, r1);
+	*status = result==NULL ? SZ_NSCS : SZ_SCES;
+	return result;
+}
+
+static size_t sz_bound_sz(void* userPara, int dataType, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	return SZ_compress_bound(dataType, r5, r4, r3, r2, r1);
+}
+
+static unsigned char* sz_compress_transpose(void* userPara, int dataType, void* data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, size_t *outSize, int *status)
+{
+	unsigned char* result = NULL;
+	void* transData = transposeData(data, dataType, r5, r4, r3, r2, r1);
+	if(transData != NULL)
+	{
+		sz_maybe_init_with_user_params(userPara, confparams_cpr);
+		size_t n = computeDataLength(r5, r4, r3, r2, r1);
+		result = SZ_compress(dataType, transData, outSize, 0, 0, 0, 0, n);
+		free(transData);
+	}
+	*status = result==NULL ? SZ_NSCS : SZ_SCES;
+	return result;
+}
+
+static int sz_compress_transpose_to_buffer(void* userPara, int dataType, void* data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, unsigned char* bytes, size_t capacity, size_t *outSize)
+{
+	int status = SZ_NSCS;
+	void* transData = transposeData(data, dataType, r5, r4, r3, r2, r1);
+	if(transData != NULL)
+	{
+		sz_maybe_init_with_user_params(userPara, confparams_cpr);
+		size_t n = computeDataLength(r5, r4, r3, r2, r1);
+		status = SZ_compress_args_to_buffer(dataType, transData, bytes, capacity, outSize, confparams_cpr->errorBoundMode, confparams_cpr->absErrBound, 
+		confparams_cpr->relBoundRatio, confparams_cpr->pw_relBoundRatio, 0, 0, 0, 0, n);
+		free(transData);
+	}
+	return status;
+}
+
+static void* sz_decompress_transpose(void* userPara, int dataType, unsigned char* bytes, size_t byteLength, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, int *status)
+{
+	void* result = NULL;
+	size_t n = computeDataLength(r5, r4, r3, r2, r1);
+	void* tmpData = SZ_decompress(dataType, bytes, byteLength, 0, 0, 0, 0, n);
+	if(tmpData != NULL)
+	{
+		result = detransposeData(tmpData, dataType, r5, r4, r3, r2, r1);
+		free(tmpData);
+	}
+	*status = result==NULL ? SZ_NSCS : SZ_SCES;
+	return result;
+}
+
+static size_t sz_bound_transpose(void* userPara, int dataType, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	return SZ_compress_bound(dataType, 0, 0, 0, 0, computeDataLength(r5, r4, r3, r2, r1));
+}
+
+static unsigned char* sz_compress_exafel(void* userPara, int dataType, void* data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, size_t *outSize, int *status)
+{
+	if(r5 != 0)
+	{
+		printf("Error: ExaFEL supports at most 4 dimensions\n");
+		*status = SZ_NSCS;
+		return NULL;
+	}
+	unsigned char* result = exafelSZ_Compress(userPara, data, r4, r3, r2, r1, outSize);
+	*status = result==NULL ? SZ_NSCS : SZ_SCES;
+	return result;
+}
+
+static void* sz_decompress_exafel(void* userPara, int dataType, unsigned char* bytes, size_t byteLength, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, int *status)
+{
+	if(r5 != 0)
+	{
+		printf("Error: ExaFEL supports at most 4 dimensions\n");
+		*status = SZ_NSCS;
+		return NULL;
+	}
+	void* result = exafelSZ_Decompress(userPara, bytes, r4, r3, r2, r1, byteLength);
+	*status = result==NULL ? SZ_NSCS : SZ_SCES;
+	return result;
+}
+
+#define SZ_TRANSPOSE_TYPES (SZ_CMPR_TYPE(SZ_FLOAT)|SZ_CMPR_TYPE(SZ_DOUBLE)|SZ_CMPR_TYPE(SZ_INT16)|SZ_CMPR_TYPE(SZ_UINT16))
+
+static sz_compressor szCompressors[SZ_MAX_COMPRESSORS] = {
+	{"SZ", "SZ2.0", SZ_CMPR_SZ, SZ_CMPR_ALL_TYPES|SZ_CMPR_SZ_FORMAT, sz_compress_sz, sz_decompress_sz, sz_bound_sz, sz_compress_sz_to_buffer},
+	{"SZ1.4", NULL, SZ_CMPR_SZ14, SZ_CMPR_ALL_TYPES|SZ_CMPR_SZ_FORMAT, sz_compress_sz14, sz_decompress_sz, sz_bound_sz, sz_compress_sz14_to_buffer},
+	{"SZ_Transpose", NULL, SZ_CMPR_TRANSPOSE, SZ_TRANSPOSE_TYPES|SZ_CMPR_SZ_FORMAT, sz_compress_transpose, sz_decompress_transpose, sz_bound_transpose, sz_compress_transpose_to_buffer},
+	{"ExaFEL", NULL, SZ_CMPR_EXAFEL, SZ_CMPR_TYPE(SZ_FLOAT), sz_compress_exafel, sz_decompress_exafel, NULL, NULL}
+};
+static int szNbCompressors = 4;
+static sz_compressor* szLastCompressor = NULL; //the last compressor looked up by its name
+
+/**
+ * Register a compressor, which is then available to SZ_compress_customize() under its name and to
+ * SZ_decompress_customize() under its ID. The registry is not protected by a lock: the compressors
+ * should be registered at the start of the application.
+ *
+ * @param sz_compressor* compressor : the compressor (copied by the registry); its name must stay valid
+ *
+ * @return SZ_SCES, or SZ_NSCS if the name or the ID is taken already or the registry is full
+ * */
+int SZ_registerCompressor(sz_compressor* compressor)
+{
+	if(compressor->id < 1 || compressor->id > 255 || compressor->name == NULL || compressor->compress == NULL || compressor->decompress == NULL)
+	{
+		printf("Error: invalid compressor in SZ_registerCompressor()\n");
+		return SZ_NSCS;
+	}
+	if(SZ_getCompressorByID(compressor->id) != NULL || SZ_getCompressor(compressor->name) != NULL
+	|| (compressor->alias != NULL && SZ_getCompressor(compressor->alias) != NULL))
+	{
+		printf("Error: the compressor %s (ID %d) is registered already\n", compressor->name, compressor->id);
+		return SZ_NSCS;
+	}
+	if(szNbCompressors == SZ_MAX_COMPRESSORS)
+	{
+		printf("Error: no more than %d compressors can be registered\n", SZ_MAX_COMPRESSORS);
+		return SZ_NSCS;
+	}
+	szCompressors[szNbCompressors++] = *compressor;
+	return SZ_SCES;
+}
+
+/**
+ * @return the compressor registered under the name (or alias) cmprName, or NULL
+ * */
+sz_compressor* SZ_getCompressor(const char* cmprName)
+{
+	int i;
+	sz_compressor* p = szLastCompressor;
+	if(p != NULL && (strcmp(p->name, cmprName)==0 || (p->alias != NULL && strcmp(p->alias, cmprName)==0)))
+		return p;
+	for(i=0;i<szNbCompressors;i++)
+	{
+		p = &szCompressors[i];
+		if(strcmp(p->name, cmprName)==0 || (p->alias != NULL && strcmp(p->alias, cmprName)==0))
+		{
+			szLastCompressor = p;
+			return p;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @return the compressor registered under the ID, or NULL
+ * */
+sz_compressor* SZ_getCompressorByID(int id)
+{
+	int i;
+	for(i=0;i<szNbCompressors;i++)
+		if(szCompressors[i].id == id)
+			return &szCompressors[i];
+	return NULL;
+}
+
+/**
+ * @return the ID of the compressor registered under the name cmprName, or -1
+ * */
+int SZ_getCompressorID(const char* cmprName)
+{
+	sz_compressor* p = SZ_getCompressor(cmprName);
+	return p==NULL ? -1 : p->id;
+}
+
+/**
+ * @return 1 if the bytes start with the header written by SZ_compress_customize(), 0 otherwise
+ * */
+int SZ_hasCompressorHeader(unsigned char* bytes, size_t byteLength)
+{
+	return byteLength > SZ_CMPR_HEADER_LENGTH && memcmp(bytes, SZ_CMPR_MAGIC, SZ_CMPR_MAGIC_LENGTH)==0;
+}
+
+void SZ_writeCompressorHeader(unsigned char* bytes, int id)
+{
+	memcpy(bytes, SZ_CMPR_MAGIC, SZ_CMPR_MAGIC_LENGTH);
+	bytes[SZ_CMPR_MAGIC_LENGTH] = (unsigned char)id;
+}
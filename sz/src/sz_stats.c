@@ -0,0 +1,90 @@
+/**
+ *  @file sz_stats.c
+ *  @date Oct, 2026
+ *  @brief Per-stage timing and counters of the compression, recorded when SZ_enableStats(1) is set.
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#include <string.h>
+#include <time.h>
+#include "sz.h"
+#include "sz_stats.h"
+
+int sz_stats_enabled = 0;
+sz_stats sz_curStats;
+
+static sz_stats_callback statsCallback = NULL;
+static void* statsUserData = NULL;
+
+/**
+ * Enable (1) or disable (0) the recording of the statistics of the compression.
+ * Like the compression parameters, the statistics are global: they are not meant for
+ * concurrent compressions.
+ * */
+void SZ_enableStats(int enable)
+{
+	sz_stats_enabled = enable;
+	if(enable)
+		memset(&sz_curStats, 0, sizeof(sz_stats));
+}
+
+/**
+ * Get the statistics of the last compression.
+ *
+ * @return SZ_SCES, or SZ_NSCS if the statistics are disabled
+ * */
+int SZ_getStats(sz_stats* stats)
+{
+	if(!sz_stats_enabled)
+		return SZ_NSCS;
+	memcpy(stats, &sz_curStats, sizeof(sz_stats));
+	return SZ_SCES;
+}
+
+/**
+ * Set a function called at the end of each compression with its statistics (NULL: none).
+ * The statistics must be enabled by SZ_enableStats(1).
+ * */
+void SZ_setStatsCallback(sz_stats_callback callback, void* userData)
+{
+	statsCallback = callback;
+	statsUserData = userData;
+}
+
+double sz_stats_time()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+/**
+ * Start the statistics of a compression (called by the entry points of the compression).
+ * */
+void sz_stats_begin(size_t rawBytes)
+{
+	if(!sz_stats_enabled)
+		return;
+	memset(&sz_curStats, 0, sizeof(sz_stats));
+	sz_curStats.rawBytes = rawBytes;
+}
+
+/**
+ * Complete the statistics of a compression: the time of the SZ stage not attributed to the
+ * other stages goes to the prediction+quantization.
+ * */
+void sz_stats_end(double start, size_t outBytes)
+{
+	if(!sz_stats_enabled)
+		return;
+	sz_curStats.totalTime = sz_stats_time() - start;
+	sz_curStats.outBytes = outBytes;
+	if(sz_curStats.predQuantTime == 0)
+	{
+		double rest = sz_curStats.totalTime - sz_curStats.rangeTime - sz_curStats.intervalTime - sz_curStats.huffmanTime - sz_curStats.losslessTime;
+		sz_curStats.predQuantTime = rest > 0 ? rest : 0;
+	}
+	if(statsCallback != NULL)
+		statsCallback(&sz_curStats, statsUserData);
+}
@@ -0,0 +1,221 @@
+/**
+ *  @file sz_target.c
+ *  @date Oct, 2026
+ *  @brief Compression to a target size or ratio: the absolute error bound is searched with the sampled estimation
+ *  of the compressed size (see SZ_estimate()), and the field is compressed once with the bound found.
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "sz.h"
+#include "sz_target.h"
+
+#define SZ_TARGET_TOLERANCE 0.05 //a compressed size within 5% below the target ends the search
+#define SZ_TARGET_MARGIN (1 - SZ_TARGET_TOLERANCE / 2) //the estimations aim at the middle of the accepted sizes
+#define SZ_TARGET_ESTIMATE_TOLERANCE 0.04 //an estimation within 4% of the aim ends the search of the estimations
+#define SZ_TARGET_MIN_BOUND 1E-8 //smallest error bound searched, relative to the value range
+#define SZ_TARGET_FIRST_BOUND 1E-4 //first error bound estimated, relative to the value range
+#define SZ_TARGET_DEFAULT_SLOPE -0.5 //d(log size)/d(log bound), when the search does not measure it
+#define SZ_TARGET_MIN_STEP M_LN2 //smallest step of log(bound) while the target is not bracketed
+#define SZ_TARGET_MIN_BRACKET 1E-3 //the bisection stops when the bracket of log(bound) is narrower
+
+static double estimate_size(int dataType, void *data, size_t r4, size_t r3, size_t r2, size_t r1, sz_params *params,
+double valueRangeSize, double errBound, int *status)
+{
+	sz_estimate estimate;
+	params->errorBoundMode = ABS;
+	params->absErrBound = errBound;
+	*status = sz_estimate_with_range(dataType, data, r4, r3, r2, r1, params, valueRangeSize, &estimate);
+	return (double)estimate.compressedSize;
+}
+
+static unsigned char* compress_with_bound(int dataType, void *data, size_t *outSize, double errBound,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	sz_params saved = *confparams_cpr;
+	unsigned char* bytes = SZ_compress_args(dataType, data, outSize, ABS, errBound, 0, 0, r5, r4, r3, r2, r1);
+	*confparams_cpr = saved;
+	return bytes;
+}
+
+/**
+ * Compress a field into targetSize bytes at most, with the smallest absolute error bound found for that size, and
+ * the other settings of SZ_Init().
+ *
+ * The error bound is searched between 1E-8 and 1 times the value range. A first bound is found with the sampled
+ * estimation of SZ_estimate(), by secant steps on log(size) as a function of log(bound), kept inside the bracket of
+ * the previous estimations; the value range is computed once for all the estimations, which cost 5-10% of a
+ * compression each, and the search usually takes 3 to 6 of them. The field is then compressed with this bound, and
+ * the bound is moved along the slope measured by the estimations until the compressed sizes bracket the target;
+ * the bracket is then bisected on log(bound). The search ends on a compressed size within 5% below the target
+ * (usually after 3 to 6 compressions), or when the bracket is narrower than 0.1% of the bound, where the size does
+ * not change continuously with the bound: the largest compressed size below the target is returned.
+ *
+ * @param size_t targetSize : the largest size of the compressed bytes
+ * @param size_t* outSize : the size of the compressed bytes (not set if the target cannot be met)
+ * @param double* absErrBound : the absolute error bound of the compression (not set if the target cannot be met)
+ *
+ * @return the compressed bytes, or NULL if the target cannot be met (or in case of error)
+ * */
+unsigned char* SZ_compress_target_size(int dataType, void *data, size_t targetSize, size_t *outSize, double *absErrBound,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	if(confparams_cpr == NULL)
+	{
+		printf("Error: SZ_Init() has to be called before SZ_compress_target_size()\n");
+		return NULL;
+	}
+	if(dataType != SZ_FLOAT && dataType != SZ_DOUBLE)
+	{
+		printf("Error: SZ_compress_target_size() only supports SZ_FLOAT and SZ_DOUBLE\n");
+		return NULL;
+	}
+	if(r5 != 0)
+	{
+		printf("Error: doesn't support 5 dimensions for now.\n");
+		return NULL;
+	}
+	if(confparams_cpr->szMode == SZ_TEMPORAL_COMPRESSION)
+	{
+		printf("Error: SZ_compress_target_size() does not support the time-series compression\n");
+		return NULL;
+	}
+
+	size_t dataLength = computeDataLength(r5, r4, r3, r2, r1);
+	double valueRangeSize;
+	if(dataType == SZ_FLOAT)
+	{
+		float range = 0, median = 0;
+		computeRangeSize_float((float *)data, dataLength, &range, &median);
+		valueRangeSize = range;
+	}
+	else
+	{
+		double median = 0;
+		computeRangeSize_double((double *)data, dataLength, &valueRangeSize, &median);
+	}
+	double searchRange = valueRangeSize > 0 ? valueRangeSize : 1;
+	double xmin = log(searchRange * SZ_TARGET_MIN_BOUND), xmax = log(searchRange);
+
+	// search of log(bound) for the estimated size of the aim: the first step assumes that the bits per value decrease
+	// by 1 when the bound doubles, the next ones are secant steps on log(size), kept inside the bracket of the estimations
+	int status = SZ_SCES;
+	sz_params params = *confparams_cpr;
+	double aim = targetSize * SZ_TARGET_MARGIN;
+	double xlo = xmin, xhi = xmax;
+	double x = log(searchRange * SZ_TARGET_FIRST_BOUND), xp = 0, fp = 0;
+	double xbest = x, fbest = 0;
+	double slope = SZ_TARGET_DEFAULT_SLOPE;
+	for(int i=0; i<SZ_TARGET_MAX_ESTIMATES; i++)
+	{
+		double size = estimate_size(dataType, data, r4, r3, r2, r1, &params, valueRangeSize, exp(x), &status);
+		if(status != SZ_SCES)
+			return NULL;
+		double f = log(size / aim);
+		if(i == 0 || fabs(f) < fabs(fbest))
+			xbest = x, fbest = f;
+		if(fabs(size / aim - 1) < SZ_TARGET_ESTIMATE_TOLERANCE || xhi - xlo < SZ_TARGET_MIN_BRACKET)
+			break;
+		if(f > 0)
+			xlo = x;
+		else
+			xhi = x;
+		double next;
+		if(i > 0 && f != fp)
+		{
+			next = x - f * (x - xp) / (f - fp);
+			if((f - fp) / (x - xp) < 0)
+				slope = (f - fp) / (x - xp);
+		}
+		else
+			next = x + (size - aim) * 8.0 / dataLength * M_LN2;
+		if(!(next > xlo && next < xhi))
+			next = (xlo + xhi) / 2;
+		xp = x, fp = f;
+		x = next;
+	}
+
+	// search of log(bound) on the compressed sizes: steps along the slope of the estimations until a bound fits the
+	// target (xfit) and a smaller one does not (xover), then bisection of [xover, xfit]
+	unsigned char* best = NULL; //largest compressed bytes which fit the target
+	size_t bestSize = 0;
+	double bestBound = 0;
+	double xfit = 0, xover = 0;
+	int fits = 0, overs = 0;
+	x = xbest;
+	while(1)
+	{
+		size_t size = 0;
+		unsigned char* bytes = compress_with_bound(dataType, data, &size, exp(x), r5, r4, r3, r2, r1);
+		if(bytes == NULL)
+		{
+			free(best);
+			return NULL;
+		}
+		if(size <= targetSize)
+		{
+			if(best == NULL || size > bestSize)
+			{
+				free(best);
+				best = bytes, bestSize = size, bestBound = exp(x);
+			}
+			else
+				free(bytes);
+			if(!fits || x < xfit)
+				xfit = x;
+			fits = 1;
+			if(size >= targetSize * (1 - SZ_TARGET_TOLERANCE))
+				break;
+		}
+		else
+		{
+			free(bytes);
+			if(!overs || x > xover)
+				xover = x;
+			overs = 1;
+		}
+
+		double step = (log((double)targetSize) - log((double)size)) / slope;
+		if(fits && overs)
+		{
+			if(xfit - xover < SZ_TARGET_MIN_BRACKET)
+				break;
+			x = (xover + xfit) / 2;
+		}
+		else if(fits) //all the sizes are below the target: decrease the bound
+		{
+			if(x <= xmin)
+				break;
+			x += step < -SZ_TARGET_MIN_STEP ? step : -SZ_TARGET_MIN_STEP;
+			if(x < xmin) x = xmin;
+		}
+		else //all the sizes exceed the target: increase the bound
+		{
+			if(x >= xmax)
+			{
+				printf("Error: the target size (%zu bytes) is below the smallest compressed size (%zu bytes)\n", targetSize, size);
+				return NULL;
+			}
+			x += step > SZ_TARGET_MIN_STEP ? step : SZ_TARGET_MIN_STEP;
+			if(x > xmax) x = xmax;
+		}
+	}
+	*outSize = bestSize;
+	*absErrBound = bestBound;
+	return best;
+}
+
+/**
+ * Compress a field at the compression ratio targetRatio at least (see SZ_compress_target_size()).
+ * */
+unsigned char* SZ_compress_target_ratio(int dataType, void *data, double targetRatio, size_t *outSize, double *absErrBound,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	int typeSize = dataType == SZ_DOUBLE ? sizeof(double) : sizeof(float);
+	size_t targetSize = (size_t)(computeDataLength(r5, r4, r3, r2, r1) * typeSize / targetRatio);
+	return SZ_compress_target_size(dataType, data, targetSize, outSize, absErrBound, r5, r4, r3, r2, r1);
+}
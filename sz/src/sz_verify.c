@@ -0,0 +1,218 @@
+/**
+ *  @file sz_verify.c
+ *  @date Oct, 2026
+ *  @brief Decompression with the error statistics (max error, RMSE, NRMSE, PSNR) against the original data,
+ *  accumulated by the decoders while they reconstruct the values.
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+#include "sz.h"
+#include "sz_verify.h"
+#ifdef _OPENMP
+#include "omp.h"
+#define SZ_VERIFY_OMP_FOR _Pragma("omp parallel for schedule(static) reduction(min:min_) reduction(max:max_, maxErr_) reduction(+:sum_) if(n_ >= SZ_VERIFY_OMP_THRESHOLD)")
+#else
+#define SZ_VERIFY_OMP_FOR
+#endif
+
+sz_verify_state sz_verifyState = {NULL, 0, 0, 0, 0, 0, 0};
+
+/**
+ * Accumulate the values [start, end) in the range of the original data, the max error and the sum of the squared
+ * errors, in parallel with OpenMP reductions for the large arrays.
+ * */
+#define SZ_ACCUMULATE_ERRORS(type, oriData, decData, start, end, state) \
+{ \
+	type *ori_ = (type *)(oriData); \
+	type *dec_ = (type *)(decData); \
+	long long i_, s_ = (long long)(start), n_ = (long long)(end) - s_; \
+	double min_ = (state)->minValue, max_ = (state)->maxValue, maxErr_ = (state)->maxAbsError, sum_ = 0; \
+	SZ_VERIFY_OMP_FOR \
+	for(i_=s_;i_<s_+n_;i_++) \
+	{ \
+		double ori = (double)ori_[i_]; \
+		double err = fabs((double)dec_[i_] - ori); \
+		if(ori < min_) min_ = ori; \
+		if(ori > max_) max_ = ori; \
+		if(err > maxErr_) maxErr_ = err; \
+		sum_ += err * err; \
+	} \
+	(state)->minValue = min_, (state)->maxValue = max_, (state)->maxAbsError = maxErr_, (state)->sumSquare += sum_; \
+}
+
+static void begin_errors(sz_verify_state *state, int dataType, void *oriData)
+{
+	state->oriData = oriData;
+	state->dataType = dataType;
+	state->count = 0;
+	state->minValue = INFINITY;
+	state->maxValue = -INFINITY;
+	state->maxAbsError = 0;
+	state->sumSquare = 0;
+}
+
+/**
+ * Accumulate the values of decData after the ones accumulated already, up to end (excluded).
+ *
+ * @return SZ_SCES, or SZ_NSCS for an unknown data type
+ * */
+static int accumulate_errors(sz_verify_state *state, void *decData, size_t end)
+{
+	size_t start = state->count;
+	if(end <= start)
+		return SZ_SCES;
+	switch(state->dataType)
+	{
+	case SZ_FLOAT:
+		SZ_ACCUMULATE_ERRORS(float, state->oriData, decData, start, end, state);
+		break;
+	case SZ_DOUBLE:
+		SZ_ACCUMULATE_ERRORS(double, state->oriData, decData, start, end, state);
+		break;
+	case SZ_INT8:
+		SZ_ACCUMULATE_ERRORS(int8_t, state->oriData, decData, start, end, state);
+		break;
+	case SZ_INT16:
+		SZ_ACCUMULATE_ERRORS(int16_t, state->oriData, decData, start, end, state);
+		break;
+	case SZ_INT32:
+		SZ_ACCUMULATE_ERRORS(int32_t, state->oriData, decData, start, end, state);
+		break;
+	case SZ_INT64:
+		SZ_ACCUMULATE_ERRORS(int64_t, state->oriData, decData, start, end, state);
+		break;
+	case SZ_UINT8:
+		SZ_ACCUMULATE_ERRORS(uint8_t, state->oriData, decData, start, end, state);
+		break;
+	case SZ_UINT16:
+		SZ_ACCUMULATE_ERRORS(uint16_t, state->oriData, decData, start, end, state);
+		break;
+	case SZ_UINT32:
+		SZ_ACCUMULATE_ERRORS(uint32_t, state->oriData, decData, start, end, state);
+		break;
+	case SZ_UINT64:
+		SZ_ACCUMULATE_ERRORS(uint64_t, state->oriData, decData, start, end, state);
+		break;
+	default:
+		printf("Error: SZ_computeErrorStats() does not support the data type %d\n", state->dataType);
+		return SZ_NSCS;
+	}
+	state->count = end;
+	return SZ_SCES;
+}
+
+static void finish_errors(sz_verify_state *state, sz_error_stats *stats)
+{
+	memset(stats, 0, sizeof(sz_error_stats));
+	if(state->count == 0)
+		return;
+	stats->count = state->count;
+	stats->minValue = state->minValue;
+	stats->maxValue = state->maxValue;
+	stats->valueRange = state->maxValue - state->minValue;
+	stats->maxAbsError = state->maxAbsError;
+	stats->mse = state->sumSquare / state->count;
+	stats->rmse = sqrt(stats->mse);
+	if(stats->valueRange > 0)
+	{
+		stats->maxRelError = stats->maxAbsError / stats->valueRange;
+		stats->nrmse = stats->rmse / stats->valueRange;
+	}
+	if(stats->mse == 0)
+		stats->psnr = INFINITY; //lossless
+	else if(stats->valueRange > 0)
+		stats->psnr = 20 * log10(stats->valueRange) - 10 * log10(stats->mse);
+	else
+		stats->psnr = 0; //constant original data: no range to compare the errors with
+}
+
+/**
+ * Called by the decoders (see SZ_VERIFY_ADD()) on the values they have reconstructed up to end (excluded).
+ * */
+void sz_verify_accumulate(void *decData, size_t end)
+{
+	accumulate_errors(&sz_verifyState, decData, end);
+}
+
+/**
+ * Compute the errors of the decompressed data decData against the original data oriData (nbEle values of type
+ * dataType), in one pass over both arrays. The integer values are compared as doubles.
+ *
+ * @return SZ_SCES, or SZ_NSCS for an unknown data type
+ * */
+int SZ_computeErrorStats(int dataType, void *oriData, void *decData, size_t nbEle, sz_error_stats *stats)
+{
+	sz_verify_state state;
+	begin_errors(&state, dataType, oriData);
+	int status = accumulate_errors(&state, decData, nbEle);
+	finish_errors(&state, stats);
+	return status;
+}
+
+/**
+ * End a verify-mode decompression: the values the decoder has not accumulated (lossless or constant data, PW_REL,
+ * the other decoders) are accumulated in one pass after the decompression.
+ * */
+static int end_verify(void *decData, size_t nbEle, sz_error_stats *stats)
+{
+	sz_verify_state state = sz_verifyState;
+	sz_verifyState.oriData = NULL;
+	int status = accumulate_errors(&state, decData, nbEle);
+	finish_errors(&state, stats);
+	return status;
+}
+
+/**
+ * Same as SZ_decompress(), with the errors of the decompressed data against the original data oriData (see
+ * SZ_computeErrorStats()). The float, double and integer decoders of the default modes (Lorenzo and blocked
+ * regression predictors, ABS and REL error bounds) accumulate the errors of each row, plane or slab of blocks
+ * right after reconstructing it, instead of a separate pass over both arrays after the decompression. The others
+ * fall back to that pass. Like the compression parameters, the accumulation is global: it is not meant for
+ * concurrent decompressions.
+ *
+ * @return the decompressed data, or NULL in case of error
+ * */
+void *SZ_decompress_verify(int dataType, unsigned char *bytes, size_t byteLength, void *oriData,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, sz_error_stats *stats)
+{
+	begin_errors(&sz_verifyState, dataType, oriData);
+	void *decData = SZ_decompress(dataType, bytes, byteLength, r5, r4, r3, r2, r1);
+	if(decData == NULL)
+	{
+		sz_verifyState.oriData = NULL;
+		return NULL;
+	}
+	if(end_verify(decData, computeDataLength(r5, r4, r3, r2, r1), stats) != SZ_SCES)
+	{
+		free(decData);
+		return NULL;
+	}
+	return decData;
+}
+
+/**
+ * Same as SZ_decompress_args() (decompression into decompressed_array), with the errors of the decompressed data
+ * against the original data oriData (see SZ_decompress_verify()).
+ *
+ * @return the number of the elements, or SZ_NSCS in case of error
+ * */
+size_t SZ_decompress_args_verify(int dataType, unsigned char *bytes, size_t byteLength, void *decompressed_array, void *oriData,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, sz_error_stats *stats)
+{
+	begin_errors(&sz_verifyState, dataType, oriData);
+	size_t nbEle = SZ_decompress_args(dataType, bytes, byteLength, decompressed_array, r5, r4, r3, r2, r1);
+	if(nbEle == (size_t)SZ_NSCS)
+	{
+		sz_verifyState.oriData = NULL;
+		return nbEle;
+	}
+	if(end_verify(decompressed_array, nbEle, stats) != SZ_SCES)
+		return SZ_NSCS;
+	return nbEle;
+}
@@ -18,6 +18,10 @@
 #include "szd_double_ts.h"
 #include "utility.h"
 
+/**
+ * newData: if *newData is not NULL, the data are decompressed into the caller's array (r5*r4*r3*r2*r1 elements), 
+ * otherwise the array is allocated here
+ * */
 int SZ_decompress_args_double(double** newData, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, unsigned char* cmpBytes, 
 size_t cmpSize, int compressionType, double* hist_data)
 {
@@ -72,17 +76,9 @@ size_t cmpSize, int compressionType, double* hist_data)
 	int doubleSize = sizeof(double);
 	if(tdps->isLossless)
 	{
-		*newData = (double*)malloc(doubleSize*dataLength);
-		if(sysEndianType==BIG_ENDIAN_SYSTEM)
-		{
-			memcpy(*newData, szTmpBytes+4+MetaDataByteLength_double+exe_params->SZ_SIZE_TYPE, dataLength*doubleSize);
-		}
-		else
-		{
-			unsigned char* p = szTmpBytes+4+MetaDataByteLength_double+exe_params->SZ_SIZE_TYPE;
-			for(i=0;i<dataLength;i++,p+=doubleSize)
-				(*newData)[i] = bytesToDouble(p);
-		}		
+		if(*newData==NULL)
+			*newData = (double*)malloc(doubleSize*dataLength);
+		copyArrayWithEndian((unsigned char*)*newData, szTmpBytes+4+MetaDataByteLength_double+exe_params->SZ_SIZE_TYPE, dataLength, doubleSize, sysEndianType==LITTLE_ENDIAN_SYSTEM);
 	}
 	else if(confparams_dec->sol_ID==SZ_Transpose)
 	{
@@ -161,7 +157,8 @@ void decompressDataSeries_double_1D(double** data, size_t dataSeriesLength, doub
 	double interval = tdps->realPrecision*2;
 	
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
-	*data = (double*)malloc(sizeof(double)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (double*)malloc(sizeof(double)*dataSeriesLength);
 
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
@@ -236,6 +233,8 @@ void decompressDataSeries_double_1D(double** data, size_t dataSeriesLength, doub
 			break;
 		}
 		//printf("%.30G\n",(*data)[i]);
+		if(i % SZ_VERIFY_CHUNK == SZ_VERIFY_CHUNK - 1)
+			SZ_VERIFY_ADD(*data, i + 1);
 	}
 	
 #ifdef HAVE_TIMECMPR	
@@ -265,7 +264,8 @@ void decompressDataSeries_double_2D(double** data, size_t r1, size_t r2, double*
 
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (double*)malloc(sizeof(double)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (double*)malloc(sizeof(double)*dataSeriesLength);
 
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
@@ -551,6 +551,7 @@ void decompressDataSeries_double_2D(double** data, size_t r1, size_t r2, double*
 				memcpy(preBytes,curBytes,8);
 			}
 		}
+		SZ_VERIFY_ADD(*data, (ii + 1) * r2);
 	}
 
 #ifdef HAVE_TIMECMPR	
@@ -579,7 +580,8 @@ void decompressDataSeries_double_3D(double** data, size_t r1, size_t r2, size_t
 
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (double*)malloc(sizeof(double)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (double*)malloc(sizeof(double)*dataSeriesLength);
 
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
@@ -1095,6 +1097,7 @@ void decompressDataSeries_double_3D(double** data, size_t r1, size_t r2, size_t
 				}
 			}
 		}
+		SZ_VERIFY_ADD(*data, (kk + 1) * r23);
 	}
 
 #ifdef HAVE_TIMECMPR	
@@ -1124,7 +1127,8 @@ void decompressDataSeries_double_4D(double** data, size_t r1, size_t r2, size_t
 
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (double*)malloc(sizeof(double)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (double*)malloc(sizeof(double)*dataSeriesLength);
 
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
@@ -1655,6 +1659,7 @@ void decompressDataSeries_double_4D(double** data, size_t r1, size_t r2, size_t
 					}
 				}
 			}
+			SZ_VERIFY_ADD(*data, ll * r234 + (kk + 1) * r34);
 		}
 	}
 
@@ -1681,7 +1686,8 @@ void decompressDataSeries_double_1D_MSST19(double** data, size_t dataSeriesLengt
 	//double interval = tdps->realPrecision*2;
 	
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
-	*data = (double*)malloc(sizeof(double)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (double*)malloc(sizeof(double)*dataSeriesLength);
 
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 	
@@ -1767,7 +1773,7 @@ void decompressDataSeries_double_1D_MSST19(double** data, size_t dataSeriesLengt
 	
 #ifdef HAVE_TIMECMPR	
 	if(confparams_dec->szMode == SZ_TEMPORAL_COMPRESSION)
-		memcpy(multisteps->hist_data, (*data), dataSeriesLength*sizeof(double));
+		memcpy(getDecHistData(multisteps), (*data), dataSeriesLength*sizeof(double));
 #endif	
 	free(precisionTable);
 	free(leadNum);
@@ -1790,7 +1796,8 @@ void decompressDataSeries_double_2D_MSST19(double** data, size_t r1, size_t r2,
 
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (double*)malloc(sizeof(double)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (double*)malloc(sizeof(double)*dataSeriesLength);
 
     int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
@@ -2088,7 +2095,7 @@ void decompressDataSeries_double_2D_MSST19(double** data, size_t r1, size_t r2,
 
 #ifdef HAVE_TIMECMPR	
 	if(confparams_dec->szMode == SZ_TEMPORAL_COMPRESSION)
-		memcpy(multisteps->hist_data, (*data), dataSeriesLength*sizeof(double));
+		memcpy(getDecHistData(multisteps), (*data), dataSeriesLength*sizeof(double));
 #endif	
 
 	free(leadNum);
@@ -2110,7 +2117,8 @@ void decompressDataSeries_double_3D_MSST19(double** data, size_t r1, size_t r2,
 
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (double*)malloc(sizeof(double)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (double*)malloc(sizeof(double)*dataSeriesLength);
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
 	double* precisionTable = (double*)malloc(sizeof(double) * exe_params->intvCapacity);
@@ -2642,7 +2650,7 @@ void decompressDataSeries_double_3D_MSST19(double** data, size_t r1, size_t r2,
 	
 #ifdef HAVE_TIMECMPR	
 	if(confparams_dec->szMode == SZ_TEMPORAL_COMPRESSION)
-		memcpy(multisteps->hist_data, (*data), dataSeriesLength*sizeof(double));
+		memcpy(getDecHistData(multisteps), (*data), dataSeriesLength*sizeof(double));
 #endif		
 
 	free(leadNum);
@@ -2655,7 +2663,8 @@ void getSnapshotData_double_1D(double** data, size_t dataSeriesLength, TightData
 	size_t i;
 	if (tdps->allSameData) {
 		double value = bytesToDouble(tdps->exactMidBytes);
-		*data = (double*)malloc(sizeof(double)*dataSeriesLength);
+		if(*data==NULL)
+			*data = (double*)malloc(sizeof(double)*dataSeriesLength);
 		for (i = 0; i < dataSeriesLength; i++)
 			(*data)[i] = value;
 	} else {
@@ -2695,7 +2704,8 @@ void getSnapshotData_double_2D(double** data, size_t r1, size_t r2, TightDataPoi
 	size_t dataSeriesLength = r1*r2;
 	if (tdps->allSameData) {
 		double value = bytesToDouble(tdps->exactMidBytes);
-		*data = (double*)malloc(sizeof(double)*dataSeriesLength);
+		if(*data==NULL)
+			*data = (double*)malloc(sizeof(double)*dataSeriesLength);
 		for (i = 0; i < dataSeriesLength; i++)
 			(*data)[i] = value;
 	} else {
@@ -2707,6 +2717,8 @@ void getSnapshotData_double_2D(double** data, size_t r1, size_t r2, TightDataPoi
 				{
 					if(compressionType == 0) //snapshot
 						decompressDataSeries_double_2D(data, r1, r2, hist_data, tdps);
+					else if(compressionType == 2)
+						decompressDataSeries_double_2D_ts(data, r1, r2, hist_data, tdps);
 					else
 						decompressDataSeries_double_1D_ts(data, dataSeriesLength, hist_data, tdps);					
 				}
@@ -2733,7 +2745,8 @@ void getSnapshotData_double_3D(double** data, size_t r1, size_t r2, size_t r3, T
 	size_t dataSeriesLength = r1*r2*r3;
 	if (tdps->allSameData) {
 		double value = bytesToDouble(tdps->exactMidBytes);
-		*data = (double*)malloc(sizeof(double)*dataSeriesLength);
+		if(*data==NULL)
+			*data = (double*)malloc(sizeof(double)*dataSeriesLength);
 		for (i = 0; i < dataSeriesLength; i++)
 			(*data)[i] = value;
 	} else {
@@ -2745,6 +2758,8 @@ void getSnapshotData_double_3D(double** data, size_t r1, size_t r2, size_t r3, T
 				{
 					if(compressionType == 0) //snapshot
 						decompressDataSeries_double_3D(data, r1, r2, r3, hist_data, tdps);
+					else if(compressionType == 2)
+						decompressDataSeries_double_3D_ts(data, r1, r2, r3, hist_data, tdps);
 					else
 						decompressDataSeries_double_1D_ts(data, dataSeriesLength, hist_data, tdps);					
 				}
@@ -2773,7 +2788,8 @@ void getSnapshotData_double_4D(double** data, size_t r1, size_t r2, size_t r3, s
 	size_t dataSeriesLength = r1*r2*r3*r4;
 	if (tdps->allSameData) {
 		double value = bytesToDouble(tdps->exactMidBytes);
-		*data = (double*)malloc(sizeof(double)*dataSeriesLength);
+		if(*data==NULL)
+			*data = (double*)malloc(sizeof(double)*dataSeriesLength);
 		for (i = 0; i < dataSeriesLength; i++)
 			(*data)[i] = value;
 	} else {
@@ -2965,7 +2981,8 @@ void decompressDataSeries_double_2D_nonblocked_with_blocked_regression(double**
 	size_t dim0_offset = r2;
 	size_t num_elements = r1 * r2;
 
-	*data = (double*)malloc(sizeof(double)*num_elements);
+	if(*data==NULL)
+		*data = (double*)malloc(sizeof(double)*num_elements);
 
 	unsigned char * comp_data_pos = comp_data;
 
@@ -3081,6 +3098,8 @@ void decompressDataSeries_double_2D_nonblocked_with_blocked_regression(double**
 				offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
 				offset_y = (j < split_index_y) ? j * early_blockcount_y : j * late_blockcount_y + split_index_y;
 				data_pos = *data + offset_x * dim0_offset + offset_y;
+				if(j == 0) //the previous row of blocks
+					SZ_VERIFY_ADD(*data, offset_x * dim0_offset);
 
 				current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
 				current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
@@ -3191,6 +3210,8 @@ void decompressDataSeries_double_2D_nonblocked_with_blocked_regression(double**
 				offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
 				offset_y = (j < split_index_y) ? j * early_blockcount_y : j * late_blockcount_y + split_index_y;
 				data_pos = *data + offset_x * dim0_offset + offset_y;
+				if(j == 0) //the previous row of blocks
+					SZ_VERIFY_ADD(*data, offset_x * dim0_offset);
 
 				current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
 				current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
@@ -3289,6 +3310,7 @@ void decompressDataSeries_double_2D_nonblocked_with_blocked_regression(double**
 			}
 		}
 	}
+	SZ_VERIFY_ADD(*data, num_elements); //the last row of blocks
 	
 #ifdef HAVE_TIMECMPR	
 	if(confparams_dec->szMode == SZ_TEMPORAL_COMPRESSION)
@@ -3308,7 +3330,8 @@ void decompressDataSeries_double_3D_nonblocked_with_blocked_regression(double**
 	size_t dim1_offset = r3;
 	size_t num_elements = r1 * r2 * r3;
 
-	*data = (double*)malloc(sizeof(double)*num_elements);
+	if(*data==NULL)
+		*data = (double*)malloc(sizeof(double)*num_elements);
 
 	unsigned char * comp_data_pos = comp_data;
 
@@ -4220,6 +4243,7 @@ void decompressDataSeries_double_3D_nonblocked_with_blocked_regression(double**
 				{
 					offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
 					data_pos = *data + offset_x * dim0_offset;
+					SZ_VERIFY_ADD(*data, offset_x * dim0_offset); //the previous slab of blocks
 
 					current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
 					current_blockcount_y = early_blockcount_y;
@@ -5255,6 +5279,7 @@ void decompressDataSeries_double_3D_nonblocked_with_blocked_regression(double**
 				{
 					offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
 					data_pos = *data + offset_x * dim0_offset;
+					SZ_VERIFY_ADD(*data, offset_x * dim0_offset); //the previous slab of blocks
 
 					current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
 					current_blockcount_y = early_blockcount_y;
@@ -5675,6 +5700,7 @@ void decompressDataSeries_double_3D_nonblocked_with_blocked_regression(double**
 			}
 		}
 	}
+	SZ_VERIFY_ADD(*data, num_elements); //the last slab of blocks
 
 #ifdef HAVE_TIMECMPR	
 	if(confparams_dec->szMode == SZ_TEMPORAL_COMPRESSION)
@@ -5686,3 +5712,251 @@ void decompressDataSeries_double_3D_nonblocked_with_blocked_regression(double**
 	free(indicator);
 	free(result_type);
 }
+
+/**
+ * Downsampled decompression of the blocked-regression stream: one value per block of the 3D grid of blocks
+ * (num_x * num_y * num_z values, typically 1/6 of the grid per axis), decoded from the coefficient section only,
+ * without decoding the type array of the data points. A block gives its regression plane at the center of the
+ * block, i.e., the mean of the original block (the plane is fitted by least squares) up to the quantization of the
+ * coefficients (0.025 times the error bound each): the values are within about the error bound of the block means
+ * of the full decompression.
+ * The blocks predicted by Lorenzo carry no coefficient, and their mean depends on all the data points decoded
+ * before them: the stream is only downsampled this way when all the blocks use the regression.
+ *
+ * @return SZ_SCES, or SZ_NSCS if some blocks are predicted by Lorenzo (the caller has to decompress the data
+ * entirely)
+ * */
+int decompressDataSeries_double_3D_downsampled_with_blocked_regression(double** data, size_t r1, size_t r2, size_t r3, unsigned char* comp_data, 
+size_t* num_blocks_x, size_t* num_blocks_y, size_t* num_blocks_z){
+
+	unsigned char * comp_data_pos = comp_data;
+
+	size_t block_size = bytesToInt_bigEndian(comp_data_pos);
+	comp_data_pos += sizeof(int);
+	// calculate block dims
+	size_t num_x, num_y, num_z;
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r1, num_x, block_size);
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r2, num_y, block_size);
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r3, num_z, block_size);
+
+	size_t split_index_x, split_index_y, split_index_z;
+	size_t early_blockcount_x, early_blockcount_y, early_blockcount_z;
+	size_t late_blockcount_x, late_blockcount_y, late_blockcount_z;
+	SZ_COMPUTE_BLOCKCOUNT(r1, num_x, split_index_x, early_blockcount_x, late_blockcount_x);
+	SZ_COMPUTE_BLOCKCOUNT(r2, num_y, split_index_y, early_blockcount_y, late_blockcount_y);
+	SZ_COMPUTE_BLOCKCOUNT(r3, num_z, split_index_z, early_blockcount_z, late_blockcount_z);
+
+	size_t num_blocks = num_x * num_y * num_z;
+	*num_blocks_x = num_x;
+	*num_blocks_y = num_y;
+	*num_blocks_z = num_z;
+
+	// skip the error bound, the intervals and the Huffman tree of the data points
+	comp_data_pos += sizeof(double) + sizeof(int);
+	unsigned int tree_size = bytesToInt_bigEndian(comp_data_pos);
+	comp_data_pos += sizeof(int);
+	comp_data_pos += sizeof(int) + tree_size;
+	comp_data_pos += sizeof(unsigned char) + sizeof(double); // use_mean, mean
+
+	size_t reg_count = 0;
+	unsigned char * indicator;
+	size_t indicator_bitlength = (num_blocks - 1)/8 + 1;
+	convertByteArray2IntArray_fast_1b(num_blocks, comp_data_pos, indicator_bitlength, &indicator);
+	comp_data_pos += indicator_bitlength;
+	for(size_t i=0; i<num_blocks; i++){
+		if(!indicator[i]) reg_count ++;
+	}
+	if(reg_count < num_blocks){
+		free(indicator);
+		return SZ_NSCS;
+	}
+
+	int coeff_intvRadius[4];
+	int * coeff_result_type = (int *) malloc(num_blocks*4*sizeof(int));
+	int * coeff_type[4];
+	double precision[4];
+	double * coeff_unpred_data[4];
+	for(int i=0; i<4; i++){
+		precision[i] = bytesToDouble(comp_data_pos);
+		comp_data_pos += sizeof(double);
+		coeff_intvRadius[i] = bytesToInt_bigEndian(comp_data_pos);
+		comp_data_pos += sizeof(int);
+		unsigned int tree_size = bytesToInt_bigEndian(comp_data_pos);
+		comp_data_pos += sizeof(int);
+		int stateNum = 2*coeff_intvRadius[i]*2;
+		HuffmanTree* huffmanTree = createHuffmanTree(stateNum);	
+		int nodeCount = bytesToInt_bigEndian(comp_data_pos);
+		node root = reconstruct_HuffTree_from_bytes_anyStates(huffmanTree, comp_data_pos+sizeof(int), nodeCount);
+		comp_data_pos += sizeof(int) + tree_size;
+
+		coeff_type[i] = coeff_result_type + i * num_blocks;
+		size_t typeArray_size = bytesToSize(comp_data_pos);
+		decode(comp_data_pos + sizeof(size_t), reg_count, root, coeff_type[i]);
+		comp_data_pos += sizeof(size_t) + typeArray_size;
+		int coeff_unpred_count = bytesToInt_bigEndian(comp_data_pos);
+		comp_data_pos += sizeof(int);
+		coeff_unpred_data[i] = (double *) comp_data_pos;
+		comp_data_pos += coeff_unpred_count * sizeof(double);
+		SZ_ReleaseHuffman(huffmanTree);
+	}
+
+	if(*data==NULL)
+		*data = (double*)malloc(sizeof(double)*num_blocks);
+	double * block_value = *data;
+	double last_coefficients[4] = {0.0};
+	int coeff_unpred_data_count[4] = {0};
+	size_t index = 0;
+	for(size_t i=0; i<num_x; i++){
+		size_t current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
+		for(size_t j=0; j<num_y; j++){
+			size_t current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
+			for(size_t k=0; k<num_z; k++){
+				size_t current_blockcount_z = (k < split_index_z) ? early_blockcount_z : late_blockcount_z;
+				//restore regression coefficients, as in the full decompression
+				for(int e=0; e<4; e++){
+					int type_ = coeff_type[e][index];
+					if (type_ != 0){
+						double pred = last_coefficients[e];
+						last_coefficients[e] = pred + 2 * (type_ - coeff_intvRadius[e]) * precision[e];
+					}
+					else{
+						last_coefficients[e] = coeff_unpred_data[e][coeff_unpred_data_count[e]];
+						coeff_unpred_data_count[e] ++;
+					}
+				}
+				block_value[index] = last_coefficients[0] * (current_blockcount_x - 1) * 0.5 + last_coefficients[1] * (current_blockcount_y - 1) * 0.5
+					+ last_coefficients[2] * (current_blockcount_z - 1) * 0.5 + last_coefficients[3];
+				index ++;
+			}
+		}
+	}
+
+	free(coeff_result_type);
+	free(indicator);
+	return SZ_SCES;
+}
+
+/**
+ * Average the data (r1 * r2 * r3, r3 the fastest dimension) over the same grid of blocks as the blocked regression.
+ * */
+static void downsample_double_3D(double* data, size_t r1, size_t r2, size_t r3, size_t block_size, double** newData, 
+size_t* num_blocks_x, size_t* num_blocks_y, size_t* num_blocks_z)
+{
+	size_t num_x, num_y, num_z;
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r1, num_x, block_size);
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r2, num_y, block_size);
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r3, num_z, block_size);
+	size_t split_index_x, split_index_y, split_index_z;
+	size_t early_blockcount_x, early_blockcount_y, early_blockcount_z;
+	size_t late_blockcount_x, late_blockcount_y, late_blockcount_z;
+	SZ_COMPUTE_BLOCKCOUNT(r1, num_x, split_index_x, early_blockcount_x, late_blockcount_x);
+	SZ_COMPUTE_BLOCKCOUNT(r2, num_y, split_index_y, early_blockcount_y, late_blockcount_y);
+	SZ_COMPUTE_BLOCKCOUNT(r3, num_z, split_index_z, early_blockcount_z, late_blockcount_z);
+
+	if(*newData==NULL)
+		*newData = (double*)malloc(sizeof(double)*num_x*num_y*num_z);
+	double * block_value = *newData;
+	size_t index = 0;
+	for(size_t i=0; i<num_x; i++){
+		size_t offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
+		size_t current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
+		for(size_t j=0; j<num_y; j++){
+			size_t offset_y = (j < split_index_y) ? j * early_blockcount_y : j * late_blockcount_y + split_index_y;
+			size_t current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
+			for(size_t k=0; k<num_z; k++){
+				size_t offset_z = (k < split_index_z) ? k * early_blockcount_z : k * late_blockcount_z + split_index_z;
+				size_t current_blockcount_z = (k < split_index_z) ? early_blockcount_z : late_blockcount_z;
+				double sum = 0;
+				for(size_t ii=0; ii<current_blockcount_x; ii++)
+					for(size_t jj=0; jj<current_blockcount_y; jj++){
+						double * block_data_pos = data + (offset_x + ii) * r2 * r3 + (offset_y + jj) * r3 + offset_z;
+						for(size_t kk=0; kk<current_blockcount_z; kk++)
+							sum += block_data_pos[kk];
+					}
+				block_value[index ++] = (sum / (current_blockcount_x * current_blockcount_y * current_blockcount_z));
+			}
+		}
+	}
+	*num_blocks_x = num_x;
+	*num_blocks_y = num_y;
+	*num_blocks_z = num_z;
+}
+
+/**
+ * Downsampled decompression: one value per block of SZ_DOWNSAMPLE_BLOCK_SIZE points per axis (the blocks of the
+ * blocked regression), with the 4th and the 5th dimensions merged into the 3rd one as in the decompression.
+ * The 3D and 4D blocked-regression streams entirely predicted by regression are decoded from their regression
+ * coefficients only, within about the error bound of the block means of the full decompression (see
+ * decompressDataSeries_double_3D_downsampled_with_blocked_regression()); the other streams are decompressed entirely
+ * and averaged per block.
+ *
+ * @param size_t* d3, d2, d1 : the dimensions of the downsampled data (d1 the fastest)
+ *
+ * @return status SUCCESSFUL (SZ_SCES) or not (other error codes)
+ * */
+int SZ_decompress_args_downsampled_double(double** newData, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, 
+unsigned char* cmpBytes, size_t cmpSize, size_t* d3, size_t* d2, size_t* d1)
+{
+	int status = SZ_SCES;
+	size_t dataLength = computeDataLength(r5,r4,r3,r2,r1);
+	int dim = computeDimension(r5,r4,r3,r2,r1);
+	size_t n3 = (r3==0?1:r3) * (r4==0?1:r4) * (r5==0?1:r5), n2 = r2==0?1:r2;
+	
+	size_t targetUncompressSize = dataLength <<3; //i.e., *8
+	size_t tmpSize = 8+MetaDataByteLength+exe_params->SZ_SIZE_TYPE;
+	unsigned char* szTmpBytes;	
+	
+	if(cmpSize!=8+4+MetaDataByteLength && cmpSize!=8+8+MetaDataByteLength) //4,8 means two posibilities of SZ_SIZE_TYPE
+	{
+		confparams_dec->losslessCompressor = is_lossless_compressed_data(cmpBytes, cmpSize);
+		if(confparams_dec->szMode!=SZ_TEMPORAL_COMPRESSION)
+		{
+			if(confparams_dec->losslessCompressor!=-1)
+				confparams_dec->szMode = SZ_BEST_COMPRESSION;
+			else
+				confparams_dec->szMode = SZ_BEST_SPEED;			
+		}
+		
+		if(confparams_dec->szMode==SZ_BEST_SPEED)
+		{
+			tmpSize = cmpSize;
+			szTmpBytes = cmpBytes;	
+		}
+		else if(confparams_dec->szMode==SZ_BEST_COMPRESSION || confparams_dec->szMode==SZ_DEFAULT_COMPRESSION || confparams_dec->szMode==SZ_TEMPORAL_COMPRESSION)
+		{
+			if(targetUncompressSize<MIN_ZLIB_DEC_ALLOMEM_BYTES) //Considering the minimum size
+				targetUncompressSize = MIN_ZLIB_DEC_ALLOMEM_BYTES; 
+			tmpSize = sz_lossless_decompress(confparams_dec->losslessCompressor, cmpBytes, (unsigned long)cmpSize, &szTmpBytes, (unsigned long)targetUncompressSize+4+MetaDataByteLength+exe_params->SZ_SIZE_TYPE);
+		}
+		else
+		{
+			printf("Wrong value of confparams_dec->szMode in the double compressed bytes.\n");
+			status = SZ_MERR;
+			return status;
+		}	
+	}
+	else
+		szTmpBytes = cmpBytes;	
+		
+	confparams_dec->sol_ID = szTmpBytes[4+14];
+	TightDataPointStorageD* tdps;
+	new_TightDataPointStorageD_fromFlatBytes(&tdps, szTmpBytes, tmpSize);
+
+	status = SZ_NSCS;
+	if(!tdps->isLossless && confparams_dec->sol_ID==SZ && tdps->raBytes_size > 0 && (dim == 3 || dim == 4))
+		status = decompressDataSeries_double_3D_downsampled_with_blocked_regression(newData, n3, n2, r1, tdps->raBytes, d3, d2, d1);
+
+	free_TightDataPointStorageD2(tdps);
+	if(confparams_dec->szMode!=SZ_BEST_SPEED && cmpSize!=8+MetaDataByteLength+exe_params->SZ_SIZE_TYPE)
+		free(szTmpBytes);
+	if(status == SZ_SCES)
+		return status;
+
+	// no regression coefficients to decode: decompress the data and average them per block
+	double* data = NULL;
+	status = SZ_decompress_args_double(&data, r5, r4, r3, r2, r1, cmpBytes, cmpSize, 0, NULL);
+	if(status == SZ_SCES)
+		downsample_double_3D(data, n3, n2, r1, SZ_DOWNSAMPLE_BLOCK_SIZE, newData, d3, d2, d1);
+	free(data);
+	return status;
+}
@@ -36,7 +36,8 @@ void decompressDataSeries_double_1D_pwr(double** data, size_t dataSeriesLength,
 	double interval = 0;// = (double)tdps->realPrecision*2;
 	
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
-	*data = (double*)malloc(sizeof(double)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (double*)malloc(sizeof(double)*dataSeriesLength);
 
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
@@ -168,7 +169,8 @@ void decompressDataSeries_double_2D_pwr(double** data, size_t r1, size_t r2, Tig
 
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (double*)malloc(sizeof(double)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (double*)malloc(sizeof(double)*dataSeriesLength);
 
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
@@ -548,7 +550,8 @@ void decompressDataSeries_double_3D_pwr(double** data, size_t r1, size_t r2, siz
 
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (double*)malloc(sizeof(double)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (double*)malloc(sizeof(double)*dataSeriesLength);
 
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
@@ -1191,7 +1194,8 @@ void decompressDataSeries_double_1D_pwrgroup(double** data, size_t dataSeriesLen
 	
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (double*)malloc(sizeof(double)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (double*)malloc(sizeof(double)*dataSeriesLength);
 
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
@@ -1354,7 +1358,9 @@ void decompressDataSeries_double_1D_pwrgroup(double** data, size_t dataSeriesLen
 
 void decompressDataSeries_double_1D_pwr_pre_log(double** data, size_t dataSeriesLength, TightDataPointStorageD* tdps) {
 
+	SZ_VERIFY_SUSPEND(verifyData); //the decoded values are the logarithms
 	decompressDataSeries_double_1D(data, dataSeriesLength, NULL, tdps);
+	SZ_VERIFY_RESUME(verifyData);
 	double threshold = tdps->minLogValue;
 	if(tdps->pwrErrBoundBytes_size > 0){
 		unsigned char * signs;
@@ -1379,7 +1385,9 @@ void decompressDataSeries_double_1D_pwr_pre_log(double** data, size_t dataSeries
 void decompressDataSeries_double_2D_pwr_pre_log(double** data, size_t r1, size_t r2, TightDataPointStorageD* tdps) {
 
 	size_t dataSeriesLength = r1 * r2;
+	SZ_VERIFY_SUSPEND(verifyData); //the decoded values are the logarithms
 	decompressDataSeries_double_2D(data, r1, r2, NULL, tdps);
+	SZ_VERIFY_RESUME(verifyData);
 	double threshold = tdps->minLogValue;
 	if(tdps->pwrErrBoundBytes_size > 0){
 		unsigned char * signs;
@@ -1403,7 +1411,9 @@ void decompressDataSeries_double_2D_pwr_pre_log(double** data, size_t r1, size_t
 void decompressDataSeries_double_3D_pwr_pre_log(double** data, size_t r1, size_t r2, size_t r3, TightDataPointStorageD* tdps) {
 
 	size_t dataSeriesLength = r1 * r2 * r3;
+	SZ_VERIFY_SUSPEND(verifyData); //the decoded values are the logarithms
 	decompressDataSeries_double_3D(data, r1, r2, r3, NULL, tdps);
+	SZ_VERIFY_RESUME(verifyData);
 	double threshold = tdps->minLogValue;
 	if(tdps->pwrErrBoundBytes_size > 0){
 		unsigned char * signs;
@@ -44,6 +44,8 @@ void cost_end_()
  * 
  * int compressionType: 1 (time-based compression) ; 0 (space-based compression)
  * hist_data: only valid when compressionType==1, hist_data is the historical dataset such as the data in previous time step
+ * newData: if *newData is not NULL, the data are decompressed into the caller's array (r5*r4*r3*r2*r1 elements), 
+ * otherwise the array is allocated here
  * 
  * @return status SUCCESSFUL (SZ_SCES) or not (other error codes) f
  * */
@@ -105,17 +107,9 @@ size_t cmpSize, int compressionType, float* hist_data)
 	int floatSize = sizeof(float);
 	if(tdps->isLossless)
 	{
-		*newData = (float*)malloc(floatSize*dataLength);
-		if(sysEndianType==BIG_ENDIAN_SYSTEM)
-		{
-			memcpy(*newData, szTmpBytes+4+MetaDataByteLength+exe_params->SZ_SIZE_TYPE, dataLength*floatSize);
-		}
-		else
-		{
-			unsigned char* p = szTmpBytes+4+MetaDataByteLength+exe_params->SZ_SIZE_TYPE;
-			for(i=0;i<dataLength;i++,p+=floatSize)
-				(*newData)[i] = bytesToFloat(p);
-		}		
+		if(*newData==NULL)
+			*newData = (float*)malloc(floatSize*dataLength);
+		copyArrayWithEndian((unsigned char*)*newData, szTmpBytes+4+MetaDataByteLength+exe_params->SZ_SIZE_TYPE, dataLength, floatSize, sysEndianType==LITTLE_ENDIAN_SYSTEM);
 	}
 	else if(confparams_dec->sol_ID==SZ_Transpose)
 	{
@@ -193,7 +187,8 @@ void decompressDataSeries_float_1D(float** data, size_t dataSeriesLength, float*
 	float interval = tdps->realPrecision*2;
 	
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
-	*data = (float*)malloc(sizeof(float)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*dataSeriesLength);
 
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 	
@@ -268,6 +263,8 @@ void decompressDataSeries_float_1D(float** data, size_t dataSeriesLength, float*
 			break;
 		}
 		//printf("%.30G\n",(*data)[i]);
+		if(i % SZ_VERIFY_CHUNK == SZ_VERIFY_CHUNK - 1)
+			SZ_VERIFY_ADD(*data, i + 1);
 	}
 	
 #ifdef HAVE_TIMECMPR	
@@ -297,7 +294,8 @@ void decompressDataSeries_float_2D(float** data, size_t r1, size_t r2, float* hi
 
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (float*)malloc(sizeof(float)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*dataSeriesLength);
 
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
@@ -583,6 +581,7 @@ void decompressDataSeries_float_2D(float** data, size_t r1, size_t r2, float* hi
 				memcpy(preBytes,curBytes,4);
 			}
 		}
+		SZ_VERIFY_ADD(*data, (ii + 1) * r2);
 	}
 
 #ifdef HAVE_TIMECMPR	
@@ -610,7 +609,8 @@ void decompressDataSeries_float_3D(float** data, size_t r1, size_t r2, size_t r3
 	//TODO
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (float*)malloc(sizeof(float)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*dataSeriesLength);
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
 	HuffmanTree* huffmanTree = createHuffmanTree(tdps->stateNum);
@@ -1122,6 +1122,7 @@ void decompressDataSeries_float_3D(float** data, size_t r1, size_t r2, size_t r3
 				}
 			}
 		}
+		SZ_VERIFY_ADD(*data, (kk + 1) * r23);
 	}
 	
 #ifdef HAVE_TIMECMPR	
@@ -1150,7 +1151,8 @@ void decompressDataSeries_float_4D(float** data, size_t r1, size_t r2, size_t r3
 
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (float*)malloc(sizeof(float)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*dataSeriesLength);
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
 	HuffmanTree* huffmanTree = createHuffmanTree(tdps->stateNum);
@@ -1680,6 +1682,7 @@ void decompressDataSeries_float_4D(float** data, size_t r1, size_t r2, size_t r3
 				}
 			}
 
+			SZ_VERIFY_ADD(*data, ll * r234 + (kk + 1) * r34);
 		}
 	}
 
@@ -1706,7 +1709,8 @@ void decompressDataSeries_float_1D_MSST19(float** data, size_t dataSeriesLength,
 	//double interval = tdps->realPrecision*2;
 	
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
-	*data = (float*)malloc(sizeof(float)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*dataSeriesLength);
 
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 	
@@ -1791,7 +1795,7 @@ void decompressDataSeries_float_1D_MSST19(float** data, size_t dataSeriesLength,
 	
 #ifdef HAVE_TIMECMPR	
 	if(confparams_dec->szMode == SZ_TEMPORAL_COMPRESSION)
-		memcpy(multisteps->hist_data, (*data), dataSeriesLength*sizeof(float));
+		memcpy(getDecHistData(multisteps), (*data), dataSeriesLength*sizeof(float));
 #endif	
 	free(precisionTable);
 	free(leadNum);
@@ -1814,7 +1818,8 @@ void decompressDataSeries_float_2D_MSST19(float** data, size_t r1, size_t r2, Ti
 
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (float*)malloc(sizeof(float)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*dataSeriesLength);
 
     int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
@@ -2110,7 +2115,7 @@ void decompressDataSeries_float_2D_MSST19(float** data, size_t r1, size_t r2, Ti
 
 #ifdef HAVE_TIMECMPR	
 	if(confparams_dec->szMode == SZ_TEMPORAL_COMPRESSION)
-		memcpy(multisteps->hist_data, (*data), dataSeriesLength*sizeof(float));
+		memcpy(getDecHistData(multisteps), (*data), dataSeriesLength*sizeof(float));
 #endif	
 
 	free(leadNum);
@@ -2132,7 +2137,8 @@ void decompressDataSeries_float_3D_MSST19(float** data, size_t r1, size_t r2, si
 
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (float*)malloc(sizeof(float)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*dataSeriesLength);
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
 	double* precisionTable = (double*)malloc(sizeof(double) * exe_params->intvCapacity);
@@ -2665,7 +2671,7 @@ void decompressDataSeries_float_3D_MSST19(float** data, size_t r1, size_t r2, si
 	
 #ifdef HAVE_TIMECMPR	
 	if(confparams_dec->szMode == SZ_TEMPORAL_COMPRESSION)
-		memcpy(multisteps->hist_data, (*data), dataSeriesLength*sizeof(float));
+		memcpy(getDecHistData(multisteps), (*data), dataSeriesLength*sizeof(float));
 #endif		
 
 	free(leadNum);
@@ -2679,7 +2685,8 @@ void getSnapshotData_float_1D(float** data, size_t dataSeriesLength, TightDataPo
 
 	if (tdps->allSameData) {
 		float value = bytesToFloat(tdps->exactMidBytes);
-		*data = (float*)malloc(sizeof(float)*dataSeriesLength);
+		if(*data==NULL)
+			*data = (float*)malloc(sizeof(float)*dataSeriesLength);
 		for (i = 0; i < dataSeriesLength; i++)
 			(*data)[i] = value;
 	} else {
@@ -2719,7 +2726,8 @@ void getSnapshotData_float_2D(float** data, size_t r1, size_t r2, TightDataPoint
 	size_t dataSeriesLength = r1*r2;
 	if (tdps->allSameData) {
 		float value = bytesToFloat(tdps->exactMidBytes);
-		*data = (float*)malloc(sizeof(float)*dataSeriesLength);
+		if(*data==NULL)
+			*data = (float*)malloc(sizeof(float)*dataSeriesLength);
 		for (i = 0; i < dataSeriesLength; i++)
 			(*data)[i] = value;
 	} else {
@@ -2731,6 +2739,8 @@ void getSnapshotData_float_2D(float** data, size_t r1, size_t r2, TightDataPoint
 				{
 					if(compressionType == 0)
 						decompressDataSeries_float_2D(data, r1, r2, hist_data, tdps);
+					else if(compressionType == 2)
+						decompressDataSeries_float_2D_ts(data, r1, r2, hist_data, tdps);
 					else
 						decompressDataSeries_float_1D_ts(data, dataSeriesLength, hist_data, tdps);					
 				}
@@ -2760,7 +2770,8 @@ void getSnapshotData_float_3D(float** data, size_t r1, size_t r2, size_t r3, Tig
 	size_t dataSeriesLength = r1*r2*r3;
 	if (tdps->allSameData) {
 		float value = bytesToFloat(tdps->exactMidBytes);
-		*data = (float*)malloc(sizeof(float)*dataSeriesLength);
+		if(*data==NULL)
+			*data = (float*)malloc(sizeof(float)*dataSeriesLength);
 		for (i = 0; i < dataSeriesLength; i++)
 			(*data)[i] = value;
 	} else {
@@ -2772,6 +2783,8 @@ void getSnapshotData_float_3D(float** data, size_t r1, size_t r2, size_t r3, Tig
 				{
 					if(compressionType == 0)
 						decompressDataSeries_float_3D(data, r1, r2, r3, hist_data, tdps);
+					else if(compressionType == 2)
+						decompressDataSeries_float_3D_ts(data, r1, r2, r3, hist_data, tdps);
 					else
 						decompressDataSeries_float_1D_ts(data, dataSeriesLength, hist_data, tdps);					
 				}
@@ -2801,7 +2814,8 @@ void getSnapshotData_float_4D(float** data, size_t r1, size_t r2, size_t r3, siz
 	size_t dataSeriesLength = r1*r2*r3*r4;
 	if (tdps->allSameData) {
 		float value = bytesToFloat(tdps->exactMidBytes);
-		*data = (float*)malloc(sizeof(float)*dataSeriesLength);
+		if(*data==NULL)
+			*data = (float*)malloc(sizeof(float)*dataSeriesLength);
 		for (i = 0; i < dataSeriesLength; i++)
 			(*data)[i] = value;
 	} else {
@@ -3133,7 +3147,8 @@ void decompressDataSeries_float_2D_nonblocked_with_blocked_regression(float** da
 	size_t dim0_offset = r2;
 	size_t num_elements = r1 * r2;
 
-	*data = (float*)malloc(sizeof(float)*num_elements);
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*num_elements);
 
 	unsigned char * comp_data_pos = comp_data;
 
@@ -3249,6 +3264,8 @@ void decompressDataSeries_float_2D_nonblocked_with_blocked_regression(float** da
 				offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
 				offset_y = (j < split_index_y) ? j * early_blockcount_y : j * late_blockcount_y + split_index_y;
 				data_pos = *data + offset_x * dim0_offset + offset_y;
+				if(j == 0) //the previous row of blocks
+					SZ_VERIFY_ADD(*data, offset_x * dim0_offset);
 
 				current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
 				current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
@@ -3359,6 +3376,8 @@ void decompressDataSeries_float_2D_nonblocked_with_blocked_regression(float** da
 				offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
 				offset_y = (j < split_index_y) ? j * early_blockcount_y : j * late_blockcount_y + split_index_y;
 				data_pos = *data + offset_x * dim0_offset + offset_y;
+				if(j == 0) //the previous row of blocks
+					SZ_VERIFY_ADD(*data, offset_x * dim0_offset);
 
 				current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
 				current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
@@ -3457,6 +3476,7 @@ void decompressDataSeries_float_2D_nonblocked_with_blocked_regression(float** da
 			}
 		}
 	}
+	SZ_VERIFY_ADD(*data, num_elements); //the last row of blocks
 	
 #ifdef HAVE_TIMECMPR	
 	if(confparams_dec->szMode == SZ_TEMPORAL_COMPRESSION)
@@ -3476,7 +3496,8 @@ void decompressDataSeries_float_3D_nonblocked_with_blocked_regression(float** da
 	size_t dim1_offset = r3;
 	size_t num_elements = r1 * r2 * r3;
 
-	*data = (float*)malloc(sizeof(float)*num_elements);
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*num_elements);
 
 	unsigned char * comp_data_pos = comp_data;
 
@@ -4388,6 +4409,7 @@ void decompressDataSeries_float_3D_nonblocked_with_blocked_regression(float** da
 				{
 					offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
 					data_pos = *data + offset_x * dim0_offset;
+					SZ_VERIFY_ADD(*data, offset_x * dim0_offset); //the previous slab of blocks
 
 					current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
 					current_blockcount_y = early_blockcount_y;
@@ -5423,6 +5445,7 @@ void decompressDataSeries_float_3D_nonblocked_with_blocked_regression(float** da
 				{
 					offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
 					data_pos = *data + offset_x * dim0_offset;
+					SZ_VERIFY_ADD(*data, offset_x * dim0_offset); //the previous slab of blocks
 
 					current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
 					current_blockcount_y = early_blockcount_y;
@@ -5843,6 +5866,7 @@ void decompressDataSeries_float_3D_nonblocked_with_blocked_regression(float** da
 			}
 		}
 	}
+	SZ_VERIFY_ADD(*data, num_elements); //the last slab of blocks
 	
 #ifdef HAVE_TIMECMPR	
 	if(confparams_dec->szMode == SZ_TEMPORAL_COMPRESSION)
@@ -5855,13 +5879,262 @@ void decompressDataSeries_float_3D_nonblocked_with_blocked_regression(float** da
 	free(result_type);
 }
 
+/**
+ * Downsampled decompression of the blocked-regression stream: one value per block of the 3D grid of blocks
+ * (num_x * num_y * num_z values, typically 1/6 of the grid per axis), decoded from the coefficient section only,
+ * without decoding the type array of the data points. A block gives its regression plane at the center of the
+ * block, i.e., the mean of the original block (the plane is fitted by least squares) up to the quantization of the
+ * coefficients (0.025 times the error bound each): the values are within about the error bound of the block means
+ * of the full decompression.
+ * The blocks predicted by Lorenzo carry no coefficient, and their mean depends on all the data points decoded
+ * before them: the stream is only downsampled this way when all the blocks use the regression.
+ *
+ * @return SZ_SCES, or SZ_NSCS if some blocks are predicted by Lorenzo (the caller has to decompress the data
+ * entirely)
+ * */
+int decompressDataSeries_float_3D_downsampled_with_blocked_regression(float** data, size_t r1, size_t r2, size_t r3, unsigned char* comp_data, 
+size_t* num_blocks_x, size_t* num_blocks_y, size_t* num_blocks_z){
+
+	unsigned char * comp_data_pos = comp_data;
+
+	size_t block_size = bytesToInt_bigEndian(comp_data_pos);
+	comp_data_pos += sizeof(int);
+	// calculate block dims
+	size_t num_x, num_y, num_z;
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r1, num_x, block_size);
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r2, num_y, block_size);
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r3, num_z, block_size);
+
+	size_t split_index_x, split_index_y, split_index_z;
+	size_t early_blockcount_x, early_blockcount_y, early_blockcount_z;
+	size_t late_blockcount_x, late_blockcount_y, late_blockcount_z;
+	SZ_COMPUTE_BLOCKCOUNT(r1, num_x, split_index_x, early_blockcount_x, late_blockcount_x);
+	SZ_COMPUTE_BLOCKCOUNT(r2, num_y, split_index_y, early_blockcount_y, late_blockcount_y);
+	SZ_COMPUTE_BLOCKCOUNT(r3, num_z, split_index_z, early_blockcount_z, late_blockcount_z);
+
+	size_t num_blocks = num_x * num_y * num_z;
+	*num_blocks_x = num_x;
+	*num_blocks_y = num_y;
+	*num_blocks_z = num_z;
+
+	// skip the error bound, the intervals and the Huffman tree of the data points
+	comp_data_pos += sizeof(float) + sizeof(int);
+	unsigned int tree_size = bytesToInt_bigEndian(comp_data_pos);
+	comp_data_pos += sizeof(int);
+	comp_data_pos += sizeof(int) + tree_size;
+	comp_data_pos += sizeof(unsigned char) + sizeof(float); // use_mean, mean
+
+	size_t reg_count = 0;
+	unsigned char * indicator;
+	size_t indicator_bitlength = (num_blocks - 1)/8 + 1;
+	convertByteArray2IntArray_fast_1b(num_blocks, comp_data_pos, indicator_bitlength, &indicator);
+	comp_data_pos += indicator_bitlength;
+	for(size_t i=0; i<num_blocks; i++){
+		if(!indicator[i]) reg_count ++;
+	}
+	if(reg_count < num_blocks){
+		free(indicator);
+		return SZ_NSCS;
+	}
+
+	int coeff_intvRadius[4];
+	int * coeff_result_type = (int *) malloc(num_blocks*4*sizeof(int));
+	int * coeff_type[4];
+	float precision[4];
+	float * coeff_unpred_data[4];
+	for(int i=0; i<4; i++){
+		precision[i] = bytesToFloat(comp_data_pos);
+		comp_data_pos += sizeof(float);
+		coeff_intvRadius[i] = bytesToInt_bigEndian(comp_data_pos);
+		comp_data_pos += sizeof(int);
+		unsigned int tree_size = bytesToInt_bigEndian(comp_data_pos);
+		comp_data_pos += sizeof(int);
+		int stateNum = 2*coeff_intvRadius[i]*2;
+		HuffmanTree* huffmanTree = createHuffmanTree(stateNum);	
+		int nodeCount = bytesToInt_bigEndian(comp_data_pos);
+		node root = reconstruct_HuffTree_from_bytes_anyStates(huffmanTree, comp_data_pos+sizeof(int), nodeCount);
+		comp_data_pos += sizeof(int) + tree_size;
+
+		coeff_type[i] = coeff_result_type + i * num_blocks;
+		size_t typeArray_size = bytesToSize(comp_data_pos);
+		decode(comp_data_pos + sizeof(size_t), reg_count, root, coeff_type[i]);
+		comp_data_pos += sizeof(size_t) + typeArray_size;
+		int coeff_unpred_count = bytesToInt_bigEndian(comp_data_pos);
+		comp_data_pos += sizeof(int);
+		coeff_unpred_data[i] = (float *) comp_data_pos;
+		comp_data_pos += coeff_unpred_count * sizeof(float);
+		SZ_ReleaseHuffman(huffmanTree);
+	}
+
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*num_blocks);
+	float * block_value = *data;
+	float last_coefficients[4] = {0.0};
+	int coeff_unpred_data_count[4] = {0};
+	size_t index = 0;
+	for(size_t i=0; i<num_x; i++){
+		size_t current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
+		for(size_t j=0; j<num_y; j++){
+			size_t current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
+			for(size_t k=0; k<num_z; k++){
+				size_t current_blockcount_z = (k < split_index_z) ? early_blockcount_z : late_blockcount_z;
+				//restore regression coefficients, as in the full decompression
+				for(int e=0; e<4; e++){
+					int type_ = coeff_type[e][index];
+					if (type_ != 0){
+						float pred = last_coefficients[e];
+						last_coefficients[e] = pred + 2 * (type_ - coeff_intvRadius[e]) * precision[e];
+					}
+					else{
+						last_coefficients[e] = coeff_unpred_data[e][coeff_unpred_data_count[e]];
+						coeff_unpred_data_count[e] ++;
+					}
+				}
+				block_value[index] = last_coefficients[0] * (current_blockcount_x - 1) * 0.5f + last_coefficients[1] * (current_blockcount_y - 1) * 0.5f
+					+ last_coefficients[2] * (current_blockcount_z - 1) * 0.5f + last_coefficients[3];
+				index ++;
+			}
+		}
+	}
+
+	free(coeff_result_type);
+	free(indicator);
+	return SZ_SCES;
+}
+
+/**
+ * Average the data (r1 * r2 * r3, r3 the fastest dimension) over the same grid of blocks as the blocked regression.
+ * */
+static void downsample_float_3D(float* data, size_t r1, size_t r2, size_t r3, size_t block_size, float** newData, 
+size_t* num_blocks_x, size_t* num_blocks_y, size_t* num_blocks_z)
+{
+	size_t num_x, num_y, num_z;
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r1, num_x, block_size);
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r2, num_y, block_size);
+	SZ_COMPUTE_3D_NUMBER_OF_BLOCKS(r3, num_z, block_size);
+	size_t split_index_x, split_index_y, split_index_z;
+	size_t early_blockcount_x, early_blockcount_y, early_blockcount_z;
+	size_t late_blockcount_x, late_blockcount_y, late_blockcount_z;
+	SZ_COMPUTE_BLOCKCOUNT(r1, num_x, split_index_x, early_blockcount_x, late_blockcount_x);
+	SZ_COMPUTE_BLOCKCOUNT(r2, num_y, split_index_y, early_blockcount_y, late_blockcount_y);
+	SZ_COMPUTE_BLOCKCOUNT(r3, num_z, split_index_z, early_blockcount_z, late_blockcount_z);
+
+	if(*newData==NULL)
+		*newData = (float*)malloc(sizeof(float)*num_x*num_y*num_z);
+	float * block_value = *newData;
+	size_t index = 0;
+	for(size_t i=0; i<num_x; i++){
+		size_t offset_x = (i < split_index_x) ? i * early_blockcount_x : i * late_blockcount_x + split_index_x;
+		size_t current_blockcount_x = (i < split_index_x) ? early_blockcount_x : late_blockcount_x;
+		for(size_t j=0; j<num_y; j++){
+			size_t offset_y = (j < split_index_y) ? j * early_blockcount_y : j * late_blockcount_y + split_index_y;
+			size_t current_blockcount_y = (j < split_index_y) ? early_blockcount_y : late_blockcount_y;
+			for(size_t k=0; k<num_z; k++){
+				size_t offset_z = (k < split_index_z) ? k * early_blockcount_z : k * late_blockcount_z + split_index_z;
+				size_t current_blockcount_z = (k < split_index_z) ? early_blockcount_z : late_blockcount_z;
+				double sum = 0;
+				for(size_t ii=0; ii<current_blockcount_x; ii++)
+					for(size_t jj=0; jj<current_blockcount_y; jj++){
+						float * block_data_pos = data + (offset_x + ii) * r2 * r3 + (offset_y + jj) * r3 + offset_z;
+						for(size_t kk=0; kk<current_blockcount_z; kk++)
+							sum += block_data_pos[kk];
+					}
+				block_value[index ++] = (float)(sum / (current_blockcount_x * current_blockcount_y * current_blockcount_z));
+			}
+		}
+	}
+	*num_blocks_x = num_x;
+	*num_blocks_y = num_y;
+	*num_blocks_z = num_z;
+}
+
+/**
+ * Downsampled decompression: one value per block of SZ_DOWNSAMPLE_BLOCK_SIZE points per axis (the blocks of the
+ * blocked regression), with the 4th and the 5th dimensions merged into the 3rd one as in the decompression.
+ * The 3D and 4D blocked-regression streams entirely predicted by regression are decoded from their regression
+ * coefficients only, within about the error bound of the block means of the full decompression (see
+ * decompressDataSeries_float_3D_downsampled_with_blocked_regression()); the other streams are decompressed entirely
+ * and averaged per block.
+ *
+ * @param size_t* d3, d2, d1 : the dimensions of the downsampled data (d1 the fastest)
+ *
+ * @return status SUCCESSFUL (SZ_SCES) or not (other error codes)
+ * */
+int SZ_decompress_args_downsampled_float(float** newData, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, 
+unsigned char* cmpBytes, size_t cmpSize, size_t* d3, size_t* d2, size_t* d1)
+{
+	int status = SZ_SCES;
+	size_t dataLength = computeDataLength(r5,r4,r3,r2,r1);
+	int dim = computeDimension(r5,r4,r3,r2,r1);
+	size_t n3 = (r3==0?1:r3) * (r4==0?1:r4) * (r5==0?1:r5), n2 = r2==0?1:r2;
+	
+	size_t targetUncompressSize = dataLength <<2; //i.e., *4
+	size_t tmpSize = 8+MetaDataByteLength+exe_params->SZ_SIZE_TYPE;
+	unsigned char* szTmpBytes;	
+	
+	if(cmpSize!=8+4+MetaDataByteLength && cmpSize!=8+8+MetaDataByteLength) //4,8 means two posibilities of SZ_SIZE_TYPE
+	{
+		confparams_dec->losslessCompressor = is_lossless_compressed_data(cmpBytes, cmpSize);
+		if(confparams_dec->szMode!=SZ_TEMPORAL_COMPRESSION)
+		{
+			if(confparams_dec->losslessCompressor!=-1)
+				confparams_dec->szMode = SZ_BEST_COMPRESSION;
+			else
+				confparams_dec->szMode = SZ_BEST_SPEED;			
+		}
+		
+		if(confparams_dec->szMode==SZ_BEST_SPEED)
+		{
+			tmpSize = cmpSize;
+			szTmpBytes = cmpBytes;	
+		}
+		else if(confparams_dec->szMode==SZ_BEST_COMPRESSION || confparams_dec->szMode==SZ_DEFAULT_COMPRESSION || confparams_dec->szMode==SZ_TEMPORAL_COMPRESSION)
+		{
+			if(targetUncompressSize<MIN_ZLIB_DEC_ALLOMEM_BYTES) //Considering the minimum size
+				targetUncompressSize = MIN_ZLIB_DEC_ALLOMEM_BYTES; 
+			tmpSize = sz_lossless_decompress(confparams_dec->losslessCompressor, cmpBytes, (unsigned long)cmpSize, &szTmpBytes, (unsigned long)targetUncompressSize+4+MetaDataByteLength+exe_params->SZ_SIZE_TYPE);
+		}
+		else
+		{
+			printf("Wrong value of confparams_dec->szMode in the double compressed bytes.\n");
+			status = SZ_MERR;
+			return status;
+		}	
+	}
+	else
+		szTmpBytes = cmpBytes;	
+		
+	confparams_dec->sol_ID = szTmpBytes[4+14];
+	TightDataPointStorageF* tdps;
+	new_TightDataPointStorageF_fromFlatBytes(&tdps, szTmpBytes, tmpSize);
+
+	status = SZ_NSCS;
+	if(!tdps->isLossless && confparams_dec->sol_ID==SZ && tdps->raBytes_size > 0 && (dim == 3 || dim == 4))
+		status = decompressDataSeries_float_3D_downsampled_with_blocked_regression(newData, n3, n2, r1, tdps->raBytes, d3, d2, d1);
+
+	free_TightDataPointStorageF2(tdps);
+	if(confparams_dec->szMode!=SZ_BEST_SPEED && cmpSize!=8+MetaDataByteLength+exe_params->SZ_SIZE_TYPE)
+		free(szTmpBytes);
+	if(status == SZ_SCES)
+		return status;
+
+	// no regression coefficients to decode: decompress the data and average them per block
+	float* data = NULL;
+	status = SZ_decompress_args_float(&data, r5, r4, r3, r2, r1, cmpBytes, cmpSize, 0, NULL);
+	if(status == SZ_SCES)
+		downsample_float_3D(data, n3, n2, r1, SZ_DOWNSAMPLE_BLOCK_SIZE, newData, d3, d2, d1);
+	free(data);
+	return status;
+}
+
 void decompressDataSeries_float_3D_random_access_with_blocked_regression(float** data, size_t r1, size_t r2, size_t r3, unsigned char* comp_data){
 
 	size_t dim0_offset = r2 * r3;
 	size_t dim1_offset = r3;
 	size_t num_elements = r1 * r2 * r3;
 
-	*data = (float*)malloc(sizeof(float)*num_elements);
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*num_elements);
 
 	unsigned char * comp_data_pos = comp_data;
 
@@ -6197,7 +6470,8 @@ void decompressDataSeries_float_3D_decompression_random_access_with_blocked_regr
 	size_t dim1_offset = r3;
 	size_t num_elements = r1 * r2 * r3;
 
-	*data = (float*)malloc(sizeof(float)*num_elements);
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*num_elements);
 
 	unsigned char * comp_data_pos = comp_data;
 
@@ -7655,16 +7929,7 @@ unsigned char* cmpBytes, size_t cmpSize)
 	if(tdps->isLossless)
 	{
 		*newData = (float*)malloc(floatSize*dataLength);
-		if(sysEndianType==BIG_ENDIAN_SYSTEM)
-		{
-			memcpy(*newData, szTmpBytes+4+MetaDataByteLength+exe_params->SZ_SIZE_TYPE, dataLength*floatSize);
-		}
-		else
-		{
-			unsigned char* p = szTmpBytes+4+MetaDataByteLength+exe_params->SZ_SIZE_TYPE;
-			for(i=0;i<dataLength;i++,p+=floatSize)
-				(*newData)[i] = bytesToFloat(p);
-		}		
+		copyArrayWithEndian((unsigned char*)*newData, szTmpBytes+4+MetaDataByteLength+exe_params->SZ_SIZE_TYPE, dataLength, floatSize, sysEndianType==LITTLE_ENDIAN_SYSTEM);
 	}
 	else 
 	{
@@ -37,7 +37,8 @@ void decompressDataSeries_float_1D_pwr(float** data, size_t dataSeriesLength, Ti
 	
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (float*)malloc(sizeof(float)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*dataSeriesLength);
 
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
@@ -173,7 +174,8 @@ void decompressDataSeries_float_2D_pwr(float** data, size_t r1, size_t r2, Tight
 
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (float*)malloc(sizeof(float)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*dataSeriesLength);
 
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
@@ -553,7 +555,8 @@ void decompressDataSeries_float_3D_pwr(float** data, size_t r1, size_t r2, size_
 
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (float*)malloc(sizeof(float)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*dataSeriesLength);
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
 	HuffmanTree* huffmanTree = createHuffmanTree(tdps->stateNum);
@@ -1192,7 +1195,8 @@ void decompressDataSeries_float_1D_pwrgroup(float** data, size_t dataSeriesLengt
 	
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (float*)malloc(sizeof(float)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*dataSeriesLength);
 
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 
@@ -1353,7 +1357,9 @@ void decompressDataSeries_float_1D_pwrgroup(float** data, size_t dataSeriesLengt
 
 void decompressDataSeries_float_1D_pwr_pre_log(float** data, size_t dataSeriesLength, TightDataPointStorageF* tdps) {
 
+	SZ_VERIFY_SUSPEND(verifyData); //the decoded values are the logarithms
 	decompressDataSeries_float_1D(data, dataSeriesLength, NULL, tdps);
+	SZ_VERIFY_RESUME(verifyData);
 	float threshold = tdps->minLogValue;
 	if(tdps->pwrErrBoundBytes_size > 0){
 		unsigned char * signs;
@@ -1377,7 +1383,9 @@ void decompressDataSeries_float_1D_pwr_pre_log(float** data, size_t dataSeriesLe
 void decompressDataSeries_float_2D_pwr_pre_log(float** data, size_t r1, size_t r2, TightDataPointStorageF* tdps) {
 
 	size_t dataSeriesLength = r1 * r2;
+	SZ_VERIFY_SUSPEND(verifyData); //the decoded values are the logarithms
 	decompressDataSeries_float_2D(data, r1, r2, NULL, tdps);
+	SZ_VERIFY_RESUME(verifyData);
 	float threshold = tdps->minLogValue;
 	if(tdps->pwrErrBoundBytes_size > 0){
 		unsigned char * signs;
@@ -1401,7 +1409,9 @@ void decompressDataSeries_float_2D_pwr_pre_log(float** data, size_t r1, size_t r
 void decompressDataSeries_float_3D_pwr_pre_log(float** data, size_t r1, size_t r2, size_t r3, TightDataPointStorageF* tdps) {
 
 	size_t dataSeriesLength = r1 * r2 * r3;
+	SZ_VERIFY_SUSPEND(verifyData); //the decoded values are the logarithms
 	decompressDataSeries_float_3D(data, r1, r2, r3, NULL, tdps);
+	SZ_VERIFY_RESUME(verifyData);
 	float threshold = tdps->minLogValue;
 	if(tdps->pwrErrBoundBytes_size > 0){
 		unsigned char * signs;
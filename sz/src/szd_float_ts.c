@@ -29,13 +29,24 @@ void decompressDataSeries_float_1D_ts(float** data, size_t dataSeriesLength, flo
 	
 	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
 
-	*data = (float*)malloc(sizeof(float)*dataSeriesLength);
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*dataSeriesLength);
 
 	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
 	
-	HuffmanTree* huffmanTree = createHuffmanTree(tdps->stateNum);
-	decode_withTree(huffmanTree, tdps->typeArray, dataSeriesLength, type);
-	SZ_ReleaseHuffman(huffmanTree);	
+	//the Huffman tree may be the one of the previous step (kept in the variable's multisteps)
+	HuffmanTree* huffmanTree = NULL;
+	HuffmanTree** prevTree = multisteps!=NULL ? &(multisteps->decHuffTree) : &huffmanTree;
+	int status = decode_withTree_ts(prevTree, tdps->typeArray, dataSeriesLength, type);
+	if(huffmanTree!=NULL)
+		SZ_ReleaseHuffman(huffmanTree);
+	if(status!=SZ_SCES) //the step cannot be decoded: keep the data of the previous step
+	{
+		memcpy((*data), hist_data, dataSeriesLength*sizeof(float));
+		free(leadNum);
+		free(type);
+		return;
+	}
 
 	unsigned char preBytes[4];
 	unsigned char curBytes[4];
@@ -86,7 +97,7 @@ void decompressDataSeries_float_1D_ts(float** data, size_t dataSeriesLength, flo
 			memset(curBytes, 0, 4);
 			leadingNum = leadNum[l++];
 			memcpy(curBytes, preBytes, leadingNum);
-			for (j = leadingNum; j < reqBytesLength; j++)
+			for (j = leadingNum; j < (size_t)reqBytesLength; j++)
 				curBytes[j] = tdps->exactMidBytes[curByteIndex++];
 			if (resiBitsLength != 0) {
 				unsigned char resiByte = (unsigned char) (resiBits << (8 - resiBitsLength));
@@ -113,3 +124,134 @@ void decompressDataSeries_float_1D_ts(float** data, size_t dataSeriesLength, flo
 	free(type);
 	return;
 }
+
+void decompressDataSeries_float_2D_ts(float** data, size_t r1, size_t r2, float* hist_data, TightDataPointStorageF* tdps)
+{
+	decompressDataSeries_float_3D_ts(data, 1, r1, r2, hist_data, tdps);
+}
+
+/**
+ * Decompress the steps compressed by SZ_compress_float_3D_MDQ_ts(): the blocks are visited in the
+ * same order and each block selects its predictor from the already decompressed data.
+ * */
+void decompressDataSeries_float_3D_ts(float** data, size_t r1, size_t r2, size_t r3, float* hist_data, TightDataPointStorageF* tdps)
+{
+	size_t dataSeriesLength = r1*r2*r3;
+	updateQuantizationInfo(tdps->intervals);
+	size_t j, k = 0, p = 0, l = 0; // k is to track the location of residual_bit
+								// in resiMidBits, p is to track the
+								// byte_index of resiMidBits, l is for
+								// leadNum
+	size_t ii, jj, kk, index, count = 0;
+	size_t b1, b2, b3, i0, j0, k0, ie, je, ke;
+	int predictor;
+	unsigned char* leadNum;
+	double interval = tdps->realPrecision*2;
+	
+	convertByteArray2IntArray_fast_2b(tdps->exactDataNum, tdps->leadNumArray, tdps->leadNumArray_size, &leadNum);
+
+	if(*data==NULL)
+		*data = (float*)malloc(sizeof(float)*dataSeriesLength);
+
+	int* type = (int*)malloc(dataSeriesLength*sizeof(int));
+	
+	HuffmanTree* huffmanTree = NULL;
+	HuffmanTree** prevTree = multisteps!=NULL ? &(multisteps->decHuffTree) : &huffmanTree;
+	int status = decode_withTree_ts(prevTree, tdps->typeArray, dataSeriesLength, type);
+	if(huffmanTree!=NULL)
+		SZ_ReleaseHuffman(huffmanTree);
+	if(status!=SZ_SCES) //the step cannot be decoded: keep the data of the previous step
+	{
+		memcpy((*data), hist_data, dataSeriesLength*sizeof(float));
+		free(leadNum);
+		free(type);
+		return;
+	}
+
+	unsigned char preBytes[4];
+	unsigned char curBytes[4];
+	
+	memset(preBytes, 0, 4);
+
+	size_t curByteIndex = 0;
+	int reqBytesLength, resiBitsLength, resiBits; 
+	unsigned char leadingNum;	
+	float medianValue, exactData, predValue;
+	
+	reqBytesLength = tdps->reqLength/8;
+	resiBitsLength = tdps->reqLength%8;
+	medianValue = tdps->medianValue;
+	
+	int type_;
+	computeBlockSize_ts(r1, &b1, &b2, &b3);
+	for(i0=0;i0<r1;i0+=b1)
+	for(j0=0;j0<r2;j0+=b2)
+	for(k0=0;k0<r3;k0+=b3)
+	{
+		ie = i0+b1<r1 ? i0+b1 : r1;
+		je = j0+b2<r2 ? j0+b2 : r2;
+		ke = k0+b3<r3 ? k0+b3 : r3;
+		predictor = select_ts_predictor_float_3D(*data, hist_data, r2, r3, i0, j0, k0, ie, je, ke);
+		for(ii=i0;ii<ie;ii++)
+		for(jj=j0;jj<je;jj++)
+		for(kk=k0;kk<ke;kk++)
+		{
+			index = ii*r2*r3+jj*r3+kk;
+			type_ = type[count++];
+			if(type_ == 0)
+			{
+				// compute resiBits
+				resiBits = 0;
+				if (resiBitsLength != 0) {
+					int kMod8 = k % 8;
+					int rightMovSteps = getRightMovingSteps(kMod8, resiBitsLength);
+					if (rightMovSteps > 0) {
+						int code = getRightMovingCode(kMod8, resiBitsLength);
+						resiBits = (tdps->residualMidBits[p] & code) >> rightMovSteps;
+					} else if (rightMovSteps < 0) {
+						int code1 = getLeftMovingCode(kMod8);
+						int code2 = getRightMovingCode(kMod8, resiBitsLength);
+						int leftMovSteps = -rightMovSteps;
+						rightMovSteps = 8 - leftMovSteps;
+						resiBits = (tdps->residualMidBits[p] & code1) << leftMovSteps;
+						p++;
+						resiBits = resiBits
+								| ((tdps->residualMidBits[p] & code2) >> rightMovSteps);
+					} else // rightMovSteps == 0
+					{
+						int code = getRightMovingCode(kMod8, resiBitsLength);
+						resiBits = (tdps->residualMidBits[p] & code);
+						p++;
+					}
+					k += resiBitsLength;
+				}
+
+				// recover the exact data	
+				memset(curBytes, 0, 4);
+				leadingNum = leadNum[l++];
+				memcpy(curBytes, preBytes, leadingNum);
+				for (j = leadingNum; j < (size_t)reqBytesLength; j++)
+					curBytes[j] = tdps->exactMidBytes[curByteIndex++];
+				if (resiBitsLength != 0) {
+					unsigned char resiByte = (unsigned char) (resiBits << (8 - resiBitsLength));
+					curBytes[reqBytesLength] = resiByte;
+				}
+				
+				exactData = bytesToFloat(curBytes);
+				(*data)[index] = exactData + medianValue;
+				memcpy(preBytes,curBytes,4);
+			}
+			else
+			{
+				predValue = predict_float_3D_ts(predictor, *data, hist_data, r2, r3, ii, jj, kk);
+				(*data)[index] = predValue + (type_-exe_params->intvRadius)*interval;
+			}
+		}
+	}
+	
+	memcpy(hist_data, (*data), dataSeriesLength*sizeof(float));
+	
+	free(leadNum);
+	free(type);
+	return;
+}
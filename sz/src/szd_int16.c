@@ -30,7 +30,7 @@ int SZ_decompress_args_int16(int16_t** newData, size_t r5, size_t r4, size_t r3,
 	//unsigned char* tmpBytes;
 	size_t targetUncompressSize = dataLength <<2; //i.e., *4
 	//tmpSize must be "much" smaller than dataLength
-	size_t i, tmpSize = 3+MetaDataByteLength+1+sizeof(int16_t)+exe_params->SZ_SIZE_TYPE;
+	size_t tmpSize = 3+MetaDataByteLength+1+sizeof(int16_t)+exe_params->SZ_SIZE_TYPE;
 	unsigned char* szTmpBytes;	
 		
 	if(cmpSize!=4+2+4+MetaDataByteLength && cmpSize!=4+2+8+MetaDataByteLength)
@@ -69,19 +69,15 @@ int SZ_decompress_args_int16(int16_t** newData, size_t r5, size_t r4, size_t r3,
 	//writeByteData(tdps->typeArray, tdps->typeArray_size, "decompress-typebytes.tbt");
 	int dim = computeDimension(r5,r4,r3,r2,r1);	
 	int intSize = sizeof(int16_t);
-	if(tdps->isLossless)
+	if(tdps->isLossless==SZ_LOSSLESS_INT_DELTA)
 	{
 		*newData = (int16_t*)malloc(intSize*dataLength);
-		if(sysEndianType==BIG_ENDIAN_SYSTEM)
-		{
-			memcpy(*newData, szTmpBytes+4+MetaDataByteLength+exe_params->SZ_SIZE_TYPE, dataLength*intSize);
-		}
-		else
-		{
-			unsigned char* p = szTmpBytes+4+MetaDataByteLength+exe_params->SZ_SIZE_TYPE;
-			for(i=0;i<dataLength;i++,p+=intSize)
-				(*newData)[i] = bytesToInt16_bigEndian(p);
-		}		
+		decompressDataSeries_int_lossless(*newData, SZ_INT16, r5, r4, r3, r2, r1, szTmpBytes+4+MetaDataByteLength+exe_params->SZ_SIZE_TYPE);
+	}
+	else if(tdps->isLossless)
+	{
+		*newData = (int16_t*)malloc(intSize*dataLength);
+		copyArrayWithEndian((unsigned char*)*newData, szTmpBytes+4+MetaDataByteLength+exe_params->SZ_SIZE_TYPE, dataLength, intSize, sysEndianType==LITTLE_ENDIAN_SYSTEM);
 	}
 	else if(confparams_dec->sol_ID==SZ_Transpose)
 	{
@@ -172,6 +168,8 @@ void decompressDataSeries_int16_1D(int16_t** data, size_t dataSeriesLength, Tigh
 			break;
 		}
 		//printf("%.30G\n",(*data)[i]);
+		if(i % SZ_VERIFY_CHUNK == SZ_VERIFY_CHUNK - 1)
+			SZ_VERIFY_ADD(*data, i + 1);
 	}
 	free(type);
 	return;
@@ -324,6 +322,7 @@ void decompressDataSeries_int16_2D(int16_t** data, size_t r1, size_t r2, TightDa
 				(*data)[index] = exactData + minValue;
 			}
 		}
+		SZ_VERIFY_ADD(*data, (ii + 1) * r2);
 	}
 
 	free(type);
@@ -582,6 +581,7 @@ void decompressDataSeries_int16_3D(int16_t** data, size_t r1, size_t r2, size_t
 				}
 			}
 		}
+		SZ_VERIFY_ADD(*data, (kk + 1) * r23);
 	}
 
 	free(type);
@@ -860,6 +860,7 @@ void decompressDataSeries_int16_4D(int16_t** data, size_t r1, size_t r2, size_t
 					}
 				}
 			}
+			SZ_VERIFY_ADD(*data, ll * r234 + (kk + 1) * r34);
 		}
 	}
 
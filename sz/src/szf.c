@@ -315,92 +315,92 @@ void sz_compress_d5_double_rev_args_(double* data, double *reservedValue, unsign
 	free(tmp_bytes);
 }
 
-//decompress
+//decompress (straight into the Fortran array, without temporary array)
 
 void sz_decompress_d1_float_(unsigned char *bytes, size_t *byteLength, float *data, size_t *r1)
 {
-	float *tmp_data = SZ_decompress(SZ_FLOAT, bytes, *byteLength, 0, 0, 0, 0, *r1);
-	memcpy(data, tmp_data, (*r1)*sizeof(float));
-	free(tmp_data);
+	SZ_decompress_args(SZ_FLOAT, bytes, *byteLength, data, 0, 0, 0, 0, *r1);
 }
 
 void sz_decompress_d2_float_(unsigned char *bytes, size_t *byteLength, float *data, size_t *r1, size_t *r2)
 {
-	size_t r;
-	float *tmp_data = SZ_decompress(SZ_FLOAT, bytes, *byteLength, 0, 0, 0, *r2, *r1);
-	r=(*r1)*(*r2);
-	memcpy(data, tmp_data, r*sizeof(float));
-	free(tmp_data);
+	SZ_decompress_args(SZ_FLOAT, bytes, *byteLength, data, 0, 0, 0, *r2, *r1);
 }
 
 void sz_decompress_d3_float_(unsigned char *bytes, size_t *byteLength, float *data, size_t *r1, size_t *r2, size_t *r3)
 {
-	size_t r;
-	float *tmp_data = SZ_decompress(SZ_FLOAT, bytes, *byteLength, 0, 0, *r3, *r2, *r1);
-	r=(*r1)*(*r2)*(*r3);
-	memcpy(data, tmp_data, r*sizeof(float));
-	free(tmp_data);
+	SZ_decompress_args(SZ_FLOAT, bytes, *byteLength, data, 0, 0, *r3, *r2, *r1);
 }
 
 void sz_decompress_d4_float_(unsigned char *bytes, size_t *byteLength, float *data, size_t *r1, size_t *r2, size_t *r3, size_t *r4)
 {
-	size_t r;
-	float *tmp_data = SZ_decompress(SZ_FLOAT, bytes, *byteLength, 0, *r4, *r3, *r2, *r1);
-	r=(*r1)*(*r2)*(*r3)*(*r4);
-	memcpy(data, tmp_data, r*sizeof(float));
-	free(tmp_data);
+	SZ_decompress_args(SZ_FLOAT, bytes, *byteLength, data, 0, *r4, *r3, *r2, *r1);
 }
 
 void sz_decompress_d5_float_(unsigned char *bytes, size_t *byteLength, float *data, size_t *r1, size_t *r2, size_t *r3, size_t *r4, size_t *r5)
 {
-	size_t r;
-	float *tmp_data = SZ_decompress(SZ_FLOAT, bytes, *byteLength, *r5, *r4, *r3, *r2, *r1);
-	r=(*r1)*(*r2)*(*r3)*(*r4)*(*r5);
-	memcpy(data, tmp_data, r*sizeof(float));
-	free(tmp_data);
+	SZ_decompress_args(SZ_FLOAT, bytes, *byteLength, data, *r5, *r4, *r3, *r2, *r1);
 }
 
 void sz_decompress_d1_double_(unsigned char *bytes, size_t *byteLength, double *data, size_t *r1)
 {
-	double *tmp_data = SZ_decompress(SZ_DOUBLE, bytes, *byteLength, 0, 0, 0, 0, *r1);
-	memcpy(data, tmp_data, (*r1)*sizeof(double));
-	free(tmp_data);
+	SZ_decompress_args(SZ_DOUBLE, bytes, *byteLength, data, 0, 0, 0, 0, *r1);
 }
 
 void sz_decompress_d2_double_(unsigned char *bytes, size_t *byteLength, double *data, size_t *r1, size_t *r2)
 {
-	size_t r;
-	double *tmp_data = SZ_decompress(SZ_DOUBLE, bytes, *byteLength, 0, 0, 0, *r2, *r1);
-	r=(*r1)*(*r2);
-	memcpy(data, tmp_data, r*sizeof(double));
-	free(tmp_data);
+	SZ_decompress_args(SZ_DOUBLE, bytes, *byteLength, data, 0, 0, 0, *r2, *r1);
 }
 
 void sz_decompress_d3_double_(unsigned char *bytes, size_t *byteLength, double *data, size_t *r1, size_t *r2, size_t *r3)
 {
-	size_t r;
-	double *tmp_data = SZ_decompress(SZ_DOUBLE, bytes, *byteLength, 0, 0, *r3, *r2, *r1);
-	r=(*r1)*(*r2)*(*r3);
-	memcpy(data, tmp_data, r*sizeof(double));
-	free(tmp_data);
+	SZ_decompress_args(SZ_DOUBLE, bytes, *byteLength, data, 0, 0, *r3, *r2, *r1);
 }
 
 void sz_decompress_d4_double_(unsigned char *bytes, size_t *byteLength, double *data, size_t *r1, size_t *r2, size_t *r3, size_t *r4)
 {
-	size_t r;
-	double *tmp_data = SZ_decompress(SZ_DOUBLE, bytes, *byteLength, 0, *r4, *r3, *r2, *r1);
-	r=(*r1)*(*r2)*(*r3)*(*r4);
-	memcpy(data, tmp_data, r*sizeof(double));
-	free(tmp_data);
+	SZ_decompress_args(SZ_DOUBLE, bytes, *byteLength, data, 0, *r4, *r3, *r2, *r1);
 }
 
 void sz_decompress_d5_double_(unsigned char *bytes, size_t *byteLength, double *data, size_t *r1, size_t *r2, size_t *r3, size_t *r4, size_t *r5)
 {
-	size_t r;
-	double *tmp_data = SZ_decompress(SZ_DOUBLE, bytes, *byteLength, *r5, *r4, *r3, *r2, *r1);
-	r=(*r1)*(*r2)*(*r3)*(*r4)*(*r5);
-	memcpy(data, tmp_data, r*sizeof(double));
-	free(tmp_data);
+	SZ_decompress_args(SZ_DOUBLE, bytes, *byteLength, data, *r5, *r4, *r3, *r2, *r1);
+}
+
+//compress into / decompress from the caller's buffers: the Fortran arrays of the lower dimensions give 0 for r2..r5
+
+void sz_compress_bound_float_(size_t *bound, size_t *r1, size_t *r2, size_t *r3, size_t *r4, size_t *r5)
+{
+	*bound = SZ_compress_bound(SZ_FLOAT, *r5, *r4, *r3, *r2, *r1);
+}
+
+void sz_compress_buffer_float_(float* data, unsigned char *bytes, size_t *capacity, size_t *outSize, int *errBoundMode, float *absErrBound, float *relBoundRatio, 
+size_t *r1, size_t *r2, size_t *r3, size_t *r4, size_t *r5, int *ierr)
+{
+	*ierr = SZ_compress_args_to_buffer(SZ_FLOAT, data, bytes, *capacity, outSize, *errBoundMode, *absErrBound, *relBoundRatio, 0.1, *r5, *r4, *r3, *r2, *r1);
+}
+
+void sz_decompress_buffer_float_(unsigned char *bytes, size_t *byteLength, float *data, size_t *r1, size_t *r2, size_t *r3, size_t *r4, size_t *r5, int *ierr)
+{
+	size_t nbEle = SZ_decompress_args(SZ_FLOAT, bytes, *byteLength, data, *r5, *r4, *r3, *r2, *r1);
+	*ierr = nbEle==(size_t)SZ_NSCS ? SZ_NSCS : SZ_SCES;
+}
+
+void sz_compress_bound_double_(size_t *bound, size_t *r1, size_t *r2, size_t *r3, size_t *r4, size_t *r5)
+{
+	*bound = SZ_compress_bound(SZ_DOUBLE, *r5, *r4, *r3, *r2, *r1);
+}
+
+void sz_compress_buffer_double_(double* data, unsigned char *bytes, size_t *capacity, size_t *outSize, int *errBoundMode, double *absErrBound, double *relBoundRatio, 
+size_t *r1, size_t *r2, size_t *r3, size_t *r4, size_t *r5, int *ierr)
+{
+	*ierr = SZ_compress_args_to_buffer(SZ_DOUBLE, data, bytes, *capacity, outSize, *errBoundMode, *absErrBound, *relBoundRatio, 0.1, *r5, *r4, *r3, *r2, *r1);
+}
+
+void sz_decompress_buffer_double_(unsigned char *bytes, size_t *byteLength, double *data, size_t *r1, size_t *r2, size_t *r3, size_t *r4, size_t *r5, int *ierr)
+{
+	size_t nbEle = SZ_decompress_args(SZ_DOUBLE, bytes, *byteLength, data, *r5, *r4, *r3, *r2, *r1);
+	*ierr = nbEle==(size_t)SZ_NSCS ? SZ_NSCS : SZ_SCES;
 }
 
 //-----------------TODO: batch mode-----------
@@ -14,7 +14,17 @@
 #include "utility.h"
 #include "sz.h"
 #include "callZlib.h"
+#include "zlib.h"
 #include "zstd.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#ifdef _OPENMP
+#include "omp.h"
+#endif
+
+#define TRANSPOSE_TILE 32 //edge of the tiles of the transposition (in elements)
+#define TRANSPOSE_OMP_THRESHOLD 65536 //the transposition of fewer elements is not parallelized
 
 int compare_struct(const void* obj1, const void* obj2){
 	struct sort_ast_particle * srt1 = (struct sort_ast_particle*)obj1;
@@ -194,6 +204,65 @@ unsigned long sz_lossless_compress(int losslessCompressor, int level, unsigned c
 	return outSize;
 }
 
+/**
+ * Same as sz_lossless_compress(), but the compressed bytes are written into the caller's buffer.
+ * 
+ * @return the compressed size, or 0 if the buffer (of 'capacity' bytes) is too small
+ * */
+unsigned long sz_lossless_compress_to_buffer(int losslessCompressor, int level, unsigned char* data, unsigned long dataLength, unsigned char* compressBytes, unsigned long capacity)
+{
+	unsigned long outSize = 0;
+	uLongf zlibOutSize = capacity;
+	switch(losslessCompressor)
+	{
+	case GZIP_COMPRESSOR:
+		if(compress2(compressBytes, &zlibOutSize, data, dataLength, level)==Z_OK)
+			outSize = zlibOutSize;
+		break;
+	case ZSTD_COMPRESSOR:
+		outSize = ZSTD_compress(compressBytes, capacity, data, dataLength, level);
+		if(ZSTD_isError(outSize))
+			outSize = 0;
+		break;
+	default:
+		printf("Error: Unrecognized lossless compressor in sz_lossless_compress_to_buffer()\n");
+	}
+	return outSize;
+}
+
+/**
+ * @return the largest size of the lossless compression of dataLength bytes (by either GZIP or ZSTD)
+ * */
+unsigned long sz_lossless_compress_bound(unsigned long dataLength)
+{
+	unsigned long zlibBound = compressBound(dataLength);
+	unsigned long zstdBound = ZSTD_compressBound(dataLength);
+	return zlibBound > zstdBound ? zlibBound : zstdBound;
+}
+
+/**
+ * Move the compressed bytes (*bytes, outSize bytes) into the caller's buffer if there is one.
+ * *bytes is released and points to userBytes afterwards, or is NULL if the buffer is too small.
+ * 
+ * @return SZ_SCES, or SZ_NSCS if the buffer (of 'capacity' bytes) is too small
+ * */
+int sz_move_to_buffer(unsigned char** bytes, size_t outSize, unsigned char* userBytes, size_t capacity)
+{
+	if(userBytes==NULL || *bytes==userBytes)
+		return SZ_SCES;
+	if(*bytes!=NULL && outSize<=capacity)
+		memcpy(userBytes, *bytes, outSize);
+	free(*bytes);
+	if(outSize>capacity)
+	{
+		printf("Error: the output buffer is too small (%zu bytes for %zu compressed bytes)\n", capacity, outSize);
+		*bytes = NULL;
+		return SZ_NSCS;
+	}
+	*bytes = userBytes;
+	return SZ_SCES;
+}
+
 unsigned long sz_lossless_decompress(int losslessCompressor, unsigned char* compressBytes, unsigned long cmpSize, unsigned char** oriData, unsigned long targetOriSize)
 {
 	unsigned long outSize = 0;
@@ -233,419 +302,196 @@ unsigned long sz_lossless_decompress65536bytes(int losslessCompressor, unsigned
 	return outSize;
 }
 
-void* detransposeData(void* data, int dataType, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+/**
+ * Transpose a tile of rn*cn elements: dst[c*dstLd+r] = src[r*srcLd+c] (r<rn, c<cn).
+ * With SSE2, the tile is transposed by 8x8 (2-byte), 4x4 (4-byte) or 2x2 (8-byte) blocks in registers.
+ * */
+static void transposeTile_2bytes(uint16_t* dst, uint16_t* src, size_t rn, size_t cn, size_t srcLd, size_t dstLd)
 {
-	size_t len = computeDataLength(r5, r4, r3, r2, r1);
-	int dim = computeDimension(r5, r4, r3, r2, r1);
-	if(dataType == SZ_FLOAT)
+	size_t r = 0, c, k;
+#if defined(__SSE2__)
+	for(;r+8<=rn;r+=8)
 	{
-		float* ori_data = data;
-		float* new_data = (float*)malloc(sizeof(float)*len);
-		if(dim==1)
-		{
-			memcpy(new_data, ori_data, sizeof(float)*len);
-			return new_data;			
-		}
-		else if(dim==2)
-		{
-			size_t i, j, s = 0;
-			for(i=0;i<r2;i++)
-				for(j=0;j<r1;j++)
-				{
-					//size_t s = i*r1+j;
-					size_t t = j*r2+i;
-					new_data[t] = ori_data[s++];					
-				}
-		}
-		else if(dim==3)
-		{
-			size_t i, j, k, s = 0;
-			size_t B = r1*r2;
-			for(i=0;i<r2;i++)
-				for(j=0;j<r1;j++)
-					for(k=0;k<r3;k++)
-					{
-						size_t t = k*B+i*r1+j;
-						new_data[t] = ori_data[s++];
-					}
-		}
-		else if(dim==4)
-		{
-			size_t i, j, k, w, s = 0;
-			size_t C = r2*r1;
-			size_t B = r3*C;
-			for(i=0;i<r3;i++)
-				for(j=0;j<r2;j++)
-					for(k=0;k<r1;k++)
-						for(w=0;w<r4;w++)
-						{
-							size_t t = w*B+i*C+j*r1+k;
-							new_data[t] = ori_data[s++];
-						}
-		}
-		return new_data;
+		for(c=0;c+8<=cn;c+=8)
+		{
+			uint16_t* p = src+r*srcLd+c;
+			uint16_t* q = dst+c*dstLd+r;
+			__m128i a0 = _mm_loadu_si128((__m128i*)p), a1 = _mm_loadu_si128((__m128i*)(p+srcLd));
+			__m128i a2 = _mm_loadu_si128((__m128i*)(p+2*srcLd)), a3 = _mm_loadu_si128((__m128i*)(p+3*srcLd));
+			__m128i a4 = _mm_loadu_si128((__m128i*)(p+4*srcLd)), a5 = _mm_loadu_si128((__m128i*)(p+5*srcLd));
+			__m128i a6 = _mm_loadu_si128((__m128i*)(p+6*srcLd)), a7 = _mm_loadu_si128((__m128i*)(p+7*srcLd));
+			__m128i b0 = _mm_unpacklo_epi16(a0, a1), b1 = _mm_unpacklo_epi16(a2, a3);
+			__m128i b2 = _mm_unpacklo_epi16(a4, a5), b3 = _mm_unpacklo_epi16(a6, a7);
+			__m128i b4 = _mm_unpackhi_epi16(a0, a1), b5 = _mm_unpackhi_epi16(a2, a3);
+			__m128i b6 = _mm_unpackhi_epi16(a4, a5), b7 = _mm_unpackhi_epi16(a6, a7);
+			a0 = _mm_unpacklo_epi32(b0, b1); //columns 0,1 of the rows 0-3
+			a1 = _mm_unpackhi_epi32(b0, b1); //columns 2,3 of the rows 0-3
+			a2 = _mm_unpacklo_epi32(b2, b3); //columns 0,1 of the rows 4-7
+			a3 = _mm_unpackhi_epi32(b2, b3);
+			a4 = _mm_unpacklo_epi32(b4, b5); //columns 4,5 of the rows 0-3
+			a5 = _mm_unpackhi_epi32(b4, b5);
+			a6 = _mm_unpacklo_epi32(b6, b7);
+			a7 = _mm_unpackhi_epi32(b6, b7);
+			_mm_storeu_si128((__m128i*)q, _mm_unpacklo_epi64(a0, a2));
+			_mm_storeu_si128((__m128i*)(q+dstLd), _mm_unpackhi_epi64(a0, a2));
+			_mm_storeu_si128((__m128i*)(q+2*dstLd), _mm_unpacklo_epi64(a1, a3));
+			_mm_storeu_si128((__m128i*)(q+3*dstLd), _mm_unpackhi_epi64(a1, a3));
+			_mm_storeu_si128((__m128i*)(q+4*dstLd), _mm_unpacklo_epi64(a4, a6));
+			_mm_storeu_si128((__m128i*)(q+5*dstLd), _mm_unpackhi_epi64(a4, a6));
+			_mm_storeu_si128((__m128i*)(q+6*dstLd), _mm_unpacklo_epi64(a5, a7));
+			_mm_storeu_si128((__m128i*)(q+7*dstLd), _mm_unpackhi_epi64(a5, a7));
+		}
+		for(;c<cn;c++)
+			for(k=0;k<8;k++)
+				dst[c*dstLd+r+k] = src[(r+k)*srcLd+c];
 	}
-	else if(dataType == SZ_DOUBLE)
+#endif
+	for(;r<rn;r++)
+		for(c=0;c<cn;c++)
+			dst[c*dstLd+r] = src[r*srcLd+c];
+}
+
+static void transposeTile_4bytes(uint32_t* dst, uint32_t* src, size_t rn, size_t cn, size_t srcLd, size_t dstLd)
+{
+	size_t r = 0, c, k;
+#if defined(__SSE2__)
+	for(;r+4<=rn;r+=4)
 	{
-		double* ori_data = data;
-		double* new_data = (double*)malloc(sizeof(double)*len);
-		if(dim==1)
-		{
-			memcpy(new_data, ori_data, sizeof(double)*len);
-			return new_data;			
-		}
-		else if(dim==2)
-		{
-			size_t i, j, s = 0;
-			for(i=0;i<r2;i++)
-				for(j=0;j<r1;j++)
-				{
-					//size_t s = i*r1+j;
-					size_t t = j*r2+i;
-					new_data[t] = ori_data[s++];					
-				}
-		}
-		else if(dim==3)
-		{
-			size_t i, j, k, s = 0;
-			size_t B = r1*r2;
-			for(i=0;i<r2;i++)
-				for(j=0;j<r1;j++)
-					for(k=0;k<r3;k++)
-					{
-						size_t t = k*B+i*r1+j;
-						new_data[t] = ori_data[s++];
-					}
-		}
-		else if(dim==4)
-		{
-			size_t i, j, k, w, s = 0;
-			size_t C = r2*r1;
-			size_t B = r3*C;
-			for(i=0;i<r3;i++)
-				for(j=0;j<r2;j++)
-					for(k=0;k<r1;k++)
-						for(w=0;w<r4;w++)
-						{
-							size_t t = w*B+i*C+j*r1+k;
-							new_data[t] = ori_data[s++];
-						}
-		}
-		return new_data;		
+		for(c=0;c+4<=cn;c+=4)
+		{
+			uint32_t* p = src+r*srcLd+c;
+			uint32_t* q = dst+c*dstLd+r;
+			__m128i a0 = _mm_loadu_si128((__m128i*)p), a1 = _mm_loadu_si128((__m128i*)(p+srcLd));
+			__m128i a2 = _mm_loadu_si128((__m128i*)(p+2*srcLd)), a3 = _mm_loadu_si128((__m128i*)(p+3*srcLd));
+			__m128i b0 = _mm_unpacklo_epi32(a0, a1), b1 = _mm_unpacklo_epi32(a2, a3);
+			__m128i b2 = _mm_unpackhi_epi32(a0, a1), b3 = _mm_unpackhi_epi32(a2, a3);
+			_mm_storeu_si128((__m128i*)q, _mm_unpacklo_epi64(b0, b1));
+			_mm_storeu_si128((__m128i*)(q+dstLd), _mm_unpackhi_epi64(b0, b1));
+			_mm_storeu_si128((__m128i*)(q+2*dstLd), _mm_unpacklo_epi64(b2, b3));
+			_mm_storeu_si128((__m128i*)(q+3*dstLd), _mm_unpackhi_epi64(b2, b3));
+		}
+		for(;c<cn;c++)
+			for(k=0;k<4;k++)
+				dst[c*dstLd+r+k] = src[(r+k)*srcLd+c];
 	}
-	else if(dataType == SZ_UINT16)
+#endif
+	for(;r<rn;r++)
+		for(c=0;c<cn;c++)
+			dst[c*dstLd+r] = src[r*srcLd+c];
+}
+
+static void transposeTile_8bytes(uint64_t* dst, uint64_t* src, size_t rn, size_t cn, size_t srcLd, size_t dstLd)
+{
+	size_t r = 0, c;
+#if defined(__SSE2__)
+	for(;r+2<=rn;r+=2)
 	{
-		uint16_t* ori_data = data;
-		uint16_t* new_data = (uint16_t*)malloc(sizeof(uint16_t)*len);
-		if(dim==1)
+		for(c=0;c+2<=cn;c+=2)
 		{
-			memcpy(new_data, ori_data, sizeof(uint16_t)*len);
-			return new_data;			
+			uint64_t* p = src+r*srcLd+c;
+			uint64_t* q = dst+c*dstLd+r;
+			__m128i a0 = _mm_loadu_si128((__m128i*)p), a1 = _mm_loadu_si128((__m128i*)(p+srcLd));
+			_mm_storeu_si128((__m128i*)q, _mm_unpacklo_epi64(a0, a1));
+			_mm_storeu_si128((__m128i*)(q+dstLd), _mm_unpackhi_epi64(a0, a1));
 		}
-		else if(dim==2)
+		if(c<cn)
 		{
-			size_t i, j, s = 0;
-			for(i=0;i<r2;i++)
-				for(j=0;j<r1;j++)
-				{
-					//size_t s = i*r1+j;
-					size_t t = j*r2+i;
-					new_data[t] = ori_data[s++];					
-				}
+			dst[c*dstLd+r] = src[r*srcLd+c];
+			dst[c*dstLd+r+1] = src[(r+1)*srcLd+c];
 		}
-		else if(dim==3)
-		{
-			size_t i, j, k, s = 0;
-			size_t B = r1*r2;
-			for(i=0;i<r2;i++)
-				for(j=0;j<r1;j++)
-					for(k=0;k<r3;k++)
-					{
-						size_t t = k*B+i*r1+j;
-						new_data[t] = ori_data[s++];
-					}
-		}
-		else if(dim==4)
-		{
-			size_t i, j, k, w, s = 0;
-			size_t C = r2*r1;
-			size_t B = r3*C;
-			for(i=0;i<r3;i++)
-				for(j=0;j<r2;j++)
-					for(k=0;k<r1;k++)
-						for(w=0;w<r4;w++)
-						{
-							size_t t = w*B+i*C+j*r1+k;
-							new_data[t] = ori_data[s++];
-						}
-		}
-		return new_data;				
 	}
-	else if(dataType == SZ_INT16)
+#endif
+	for(;r<rn;r++)
+		for(c=0;c<cn;c++)
+			dst[c*dstLd+r] = src[r*srcLd+c];
+}
+
+/**
+ * Transpose the rows*cols matrix src (row stride srcLd) into dst (row stride dstLd): 
+ * dst[c*dstLd+r] = src[r*srcLd+c]. The matrix is processed by TRANSPOSE_TILE x TRANSPOSE_TILE tiles, 
+ * so that both the reads and the writes of a tile stay in the cache; the tiles are spread over the OpenMP threads.
+ * */
+static void transposeMatrix(void* dst, void* src, int typeSize, size_t rows, size_t cols, size_t srcLd, size_t dstLd)
+{
+	long long t;
+	size_t rowTiles = (rows+TRANSPOSE_TILE-1)/TRANSPOSE_TILE;
+	size_t colTiles = (cols+TRANSPOSE_TILE-1)/TRANSPOSE_TILE;
+	long long nbTiles = (long long)(rowTiles*colTiles);
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static) if(rows*cols >= TRANSPOSE_OMP_THRESHOLD)
+#endif
+	for(t=0;t<nbTiles;t++)
 	{
-		int16_t* ori_data = data;
-		int16_t* new_data = (int16_t*)malloc(sizeof(int16_t)*len);
-		if(dim==1)
-		{
-			memcpy(new_data, ori_data, sizeof(int16_t)*len);
-			return new_data;			
-		}
-		else if(dim==2)
-		{
-			size_t i, j, s = 0;
-			for(i=0;i<r2;i++)
-				for(j=0;j<r1;j++)
-				{
-					//size_t s = i*r1+j;
-					size_t t = j*r2+i;
-					new_data[t] = ori_data[s++];					
-				}
-		}
-		else if(dim==3)
-		{
-			size_t i, j, k, s = 0;
-			size_t B = r1*r2;
-			for(i=0;i<r2;i++)
-				for(j=0;j<r1;j++)
-					for(k=0;k<r3;k++)
-					{
-						size_t t = k*B+i*r1+j;
-						new_data[t] = ori_data[s++];
-					}
-		}
-		else if(dim==4)
-		{
-			size_t i, j, k, w, s = 0;
-			size_t C = r2*r1;
-			size_t B = r3*C;
-			for(i=0;i<r3;i++)
-				for(j=0;j<r2;j++)
-					for(k=0;k<r1;k++)
-						for(w=0;w<r4;w++)
-						{
-							size_t t = w*B+i*C+j*r1+k;
-							new_data[t] = ori_data[s++];
-						}
-		}
-		return new_data;			
+		size_t r = ((size_t)t/colTiles)*TRANSPOSE_TILE;
+		size_t c = ((size_t)t%colTiles)*TRANSPOSE_TILE;
+		size_t rn = rows-r < TRANSPOSE_TILE ? rows-r : TRANSPOSE_TILE;
+		size_t cn = cols-c < TRANSPOSE_TILE ? cols-c : TRANSPOSE_TILE;
+		if(typeSize==2)
+			transposeTile_2bytes((uint16_t*)dst+c*dstLd+r, (uint16_t*)src+r*srcLd+c, rn, cn, srcLd, dstLd);
+		else if(typeSize==4)
+			transposeTile_4bytes((uint32_t*)dst+c*dstLd+r, (uint32_t*)src+r*srcLd+c, rn, cn, srcLd, dstLd);
+		else
+			transposeTile_8bytes((uint64_t*)dst+c*dstLd+r, (uint64_t*)src+r*srcLd+c, rn, cn, srcLd, dstLd);
 	}
-	else
+}
+
+static int getTransposeTypeSize(int dataType)
+{
+	switch(dataType)
 	{
+	case SZ_FLOAT:
+		return sizeof(float);
+	case SZ_DOUBLE:
+		return sizeof(double);
+	case SZ_UINT16:
+	case SZ_INT16:
+		return sizeof(uint16_t);
+	default:
+		return 0;
+	}
+}
+
+void* detransposeData(void* data, int dataType, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	size_t len = computeDataLength(r5, r4, r3, r2, r1);
+	int dim = computeDimension(r5, r4, r3, r2, r1);
+	int typeSize = getTransposeTypeSize(dataType);
+	if(typeSize == 0)
 		return NULL;
-	}	
+	unsigned char* new_data = (unsigned char*)malloc(typeSize*len);
+	if(dim==1)
+		memcpy(new_data, data, typeSize*len);
+	else if(dim==2) //new_data[j*r2+i] = data[i*r1+j]
+		transposeMatrix(new_data, data, typeSize, r2, r1, r1, r2);
+	else if(dim==3) //new_data[k*r2*r1+ij] = data[ij*r3+k]
+		transposeMatrix(new_data, data, typeSize, r2*r1, r3, r3, r2*r1);
+	else if(dim==4) //new_data[w*r3*r2*r1+ijk] = data[ijk*r4+w]
+		transposeMatrix(new_data, data, typeSize, r3*r2*r1, r4, r4, r3*r2*r1);
+	return new_data;
 }
 
 void* transposeData(void* data, int dataType, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
 {
 	size_t len = computeDataLength(r5, r4, r3, r2, r1);
 	int dim = computeDimension(r5, r4, r3, r2, r1);
-	if(dataType == SZ_FLOAT)
-	{
-		float* ori_data = data;
-		float* new_data = (float*)malloc(sizeof(float)*len);
-		if(dim==1)
-		{
-			memcpy(new_data, ori_data, sizeof(float)*len);
-		}
-		else if(dim==2)
-		{
-			size_t i, j, s = 0;
-			for(i=0;i<r2;i++)
-				for(j=0;j<r1;j++)
-				{
-					size_t t = j*r2+i;
-					new_data[t] = ori_data[s++];
-				}
-		}
-		else if(dim==3)
-		{
-			size_t i, j, k, s = 0;			
-			//size_t B = r2*r1;
-			for(i=0;i<r3;i++)
-				for(j=0;j<r2;j++)
-					for(k=0;k<r1;k++)
-					{
-						size_t jk = j*r1+k;
-						//size_t s = i*B+jk;
-						size_t t = r3*jk+i;
-						new_data[t] = ori_data[s++];
-					}
-		}
-		else if(dim==4)
-		{
-			size_t C = r2*r1;
-			//size_t B = r3*C;
-			size_t D = C*r4;
-			size_t i, j, k, w, s = 0;			
-			for(i=0;i<r4;i++)
-				for(j=0;j<r3;j++)
-					for(k=0;k<r2;k++)
-						for(w=0;w<r1;w++)
-						{
-							size_t kw = k*r1+w;
-							//size_t s = i*B+j*C+kw;
-							size_t t = j*D+r4*kw+i;
-							new_data[t] = ori_data[s++];
-						}
-		}
-		return new_data;
-	}
-	else if(dataType == SZ_DOUBLE)
-	{
-		double* ori_data = data;
-		double* new_data = (double*)malloc(sizeof(double)*len);
-		if(dim==1)
-		{
-			memcpy(new_data, ori_data, sizeof(double)*len);
-		}
-		else if(dim==2)
-		{
-			size_t i, j, s = 0;
-			for(i=0;i<r2;i++)
-				for(j=0;j<r1;j++)
-				{
-					size_t t = j*r2+i;
-					new_data[t] = ori_data[s++];
-				}
-		}
-		else if(dim==3)
-		{
-			size_t i, j, k, s = 0;			
-			//size_t B = r2*r1;
-			for(i=0;i<r3;i++)
-				for(j=0;j<r2;j++)
-					for(k=0;k<r1;k++)
-					{
-						size_t jk = j*r1+k;
-						//size_t s = i*B+jk;
-						size_t t = r3*jk+i;
-						new_data[t] = ori_data[s++];
-					}
-		}
-		else if(dim==4)
-		{
-			size_t C = r2*r1;
-			//size_t B = r3*C;
-			size_t D = C*r4;
-			size_t i, j, k, w, s = 0;			
-			for(i=0;i<r4;i++)
-				for(j=0;j<r3;j++)
-					for(k=0;k<r2;k++)
-						for(w=0;w<r1;w++)
-						{
-							size_t kw = k*r1+w;
-							//size_t s = i*B+j*C+kw;
-							size_t t = j*D+r4*kw+i;
-							new_data[t] = ori_data[s++];	
-						}
-		}
-		return new_data;	
-	}
-	else if(dataType == SZ_UINT16)
-	{
-		uint16_t* ori_data = data;
-		uint16_t* new_data = (uint16_t*)malloc(sizeof(uint16_t)*len);
-		if(dim==1)
-		{
-			memcpy(new_data, ori_data, sizeof(uint16_t)*len);
-		}
-		else if(dim==2)
-		{
-			size_t i, j, s = 0;
-			for(i=0;i<r2;i++)
-				for(j=0;j<r1;j++)
-				{
-					size_t t = j*r2+i;
-					new_data[t] = ori_data[s++];
-				}
-		}
-		else if(dim==3)
-		{
-			size_t i, j, k, s = 0;			
-			//size_t B = r2*r1;
-			for(i=0;i<r3;i++)
-				for(j=0;j<r2;j++)
-					for(k=0;k<r1;k++)
-					{
-						size_t jk = j*r1+k;
-						//size_t s = i*B+jk;
-						size_t t = r3*jk+i;
-						new_data[t] = ori_data[s++];
-					}
-		}
-		else if(dim==4)
-		{
-			size_t C = r2*r1;
-			//size_t B = r3*C;
-			size_t D = C*r4;
-			size_t i, j, k, w, s = 0;			
-			for(i=0;i<r4;i++)
-				for(j=0;j<r3;j++)
-					for(k=0;k<r2;k++)
-						for(w=0;w<r1;w++)
-						{
-							size_t kw = k*r1+w;
-							//size_t s = i*B+j*C+kw;
-							size_t t = j*D+r4*kw+i;
-							new_data[t] = ori_data[s++];	
-						}
-		}
-		return new_data;		
-	}
-	else if(dataType == SZ_INT16)
-	{
-		int16_t* ori_data = data;
-		int16_t* new_data = (int16_t*)malloc(sizeof(int16_t)*len);
-		if(dim==1)
-		{
-			memcpy(new_data, ori_data, sizeof(int16_t)*len);
-		}
-		else if(dim==2)
-		{
-			size_t i, j, s = 0;
-			for(i=0;i<r2;i++)
-				for(j=0;j<r1;j++)
-				{
-					size_t t = j*r2+i;
-					new_data[t] = ori_data[s++];
-				}
-		}
-		else if(dim==3)
-		{
-			size_t i, j, k, s = 0;			
-			//size_t B = r2*r1;
-			for(i=0;i<r3;i++)
-				for(j=0;j<r2;j++)
-					for(k=0;k<r1;k++)
-					{
-						size_t jk = j*r1+k;
-						//size_t s = i*B+jk;
-						size_t t = r3*jk+i;
-						new_data[t] = ori_data[s++];
-					}
-		}
-		else if(dim==4)
-		{
-			size_t C = r2*r1;
-			//size_t B = r3*C;
-			size_t D = C*r4;
-			size_t i, j, k, w, s = 0;			
-			for(i=0;i<r4;i++)
-				for(j=0;j<r3;j++)
-					for(k=0;k<r2;k++)
-						for(w=0;w<r1;w++)
-						{
-							size_t kw = k*r1+w;
-							//size_t s = i*B+j*C+kw;
-							size_t t = j*D+r4*kw+i;
-							new_data[t] = ori_data[s++];	
-						}
-		}
-		return new_data;		
-	}	
-	else
+	int typeSize = getTransposeTypeSize(dataType);
+	if(typeSize == 0)
 	{
 		printf("Error. transpose data doesn't support data type %d\n", dataType);
 		return NULL;
 	}
+	unsigned char* new_data = (unsigned char*)malloc(typeSize*len);
+	if(dim==1)
+		memcpy(new_data, data, typeSize*len);
+	else if(dim==2) //new_data[j*r2+i] = data[i*r1+j]
+		transposeMatrix(new_data, data, typeSize, r2, r1, r1, r2);
+	else if(dim==3) //new_data[jk*r3+i] = data[i*r2*r1+jk]
+		transposeMatrix(new_data, data, typeSize, r3, r2*r1, r2*r1, r3);
+	else if(dim==4) //each slice j: new_data[j*r2*r1*r4+kw*r4+i] = data[i*r3*r2*r1+j*r2*r1+kw]
+	{
+		size_t j, C = r2*r1;
+		for(j=0;j<r3;j++)
+			transposeMatrix(new_data+j*C*r4*typeSize, (unsigned char*)data+j*C*typeSize, typeSize, r4, C, r3*C, r4);
+	}
+	return new_data;
 }
@@ -108,6 +108,31 @@ void test_symTransform_4bytes(void)
 	CU_ASSERT_EQUAL_ARRAY_BYTE(bytes, expected, 4);	
 }
 
+void test_symTransformArray(void)
+{
+	//37 elements: an odd count, so that a vectorized loop also runs its remainder iterations
+	unsigned char src[37*8], dst[37*8], expected[37*8];
+	int i, k, sizes[3] = {2, 4, 8}, s;
+	for(i=0;i<37*8;i++)
+		src[i] = (unsigned char)i;
+	for(s=0;s<3;s++)
+	{
+		int ts = sizes[s];
+		for(i=0;i<37;i++)
+			for(k=0;k<ts;k++)
+				expected[i*ts+k] = src[i*ts+ts-1-k];
+		if(ts==2)
+			symTransformArray_2bytes(dst, src, 37);
+		else if(ts==4)
+			symTransformArray_4bytes(dst, src, 37);
+		else
+			symTransformArray_8bytes(dst, src, 37);
+		CU_ASSERT_EQUAL_ARRAY_BYTE(dst, expected, 37*ts);
+		copyArrayWithEndian(dst, dst, 37, ts, 1); //in place, back to the original order
+		CU_ASSERT_EQUAL_ARRAY_BYTE(dst, src, 37*ts);
+	}
+}
+
 void test_compressSingleFloatValue(void)
 {
 	//TODO
@@ -167,6 +192,7 @@ int main ( void )
         (NULL == CU_add_test(pSuite, "test_symTransform_8bytes", test_symTransform_8bytes)) ||
         (NULL == CU_add_test(pSuite, "test_symTransform_2bytes", test_symTransform_2bytes)) ||
         (NULL == CU_add_test(pSuite, "test_symTransform_4bytes", test_symTransform_4bytes)) ||
+        (NULL == CU_add_test(pSuite, "test_symTransformArray", test_symTransformArray)) ||
         (NULL == CU_add_test(pSuite, "test_compIdenticalLeadingBytesCount_double", test_compIdenticalLeadingBytesCount_double)) ||        
         (NULL == CU_add_test(pSuite, "test_compIdenticalLeadingBytesCount_float", test_compIdenticalLeadingBytesCount_float))
       )
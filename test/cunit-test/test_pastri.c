@@ -0,0 +1,161 @@
+#include "CUnit/CUnit.h"
+#include "CUnit/Basic.h"
+#include "CUnit_Array.h"
+
+#include "pastri.h"
+
+#include <stdio.h>  // for printf
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+/* Test Suite setup and cleanup functions: */
+
+int
+init_suite(void)
+{
+  return 0;
+}
+
+int
+clean_suite(void)
+{
+  return 0;
+}
+
+/************* Test case functions ****************/
+
+static pastri_params params;
+static double* data = NULL;
+static unsigned char* compressed = NULL;
+static size_t compressedBytes = 0;
+
+//a batch of sparse blocks (a few large values over small ones), as in the two-electron integrals
+static void compress_batch(void)
+{
+	size_t i, n;
+	params.bf[0] = params.bf[1] = params.bf[2] = params.bf[3] = 1;
+	params.originalEb = 1e-3;
+	params.dataSize = 8;
+	params.numBlocks = 50;
+	SZ_pastriPreprocessParameters(&params);
+	n = (size_t)params.numBlocks*params.bSize;
+	data = (double*)malloc(n*sizeof(double));
+	for(i=0;i<n;i++)
+		data[i] = (i%37==0) ? sin(i*0.1) : 0.0001*(i%5);
+	SZ_pastriCompressBatch(&params, (unsigned char*)data, &compressed, &compressedBytes);
+}
+
+void test_pastriBatch_roundtrip(void)
+{
+	pastri_params p;
+	unsigned char* result = NULL;
+	size_t resultBytes = 0, i, n = (size_t)params.numBlocks*params.bSize;
+	CU_ASSERT_EQUAL(SZ_pastriDecompressBatch(compressed, &p, &result, &resultBytes), 0);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(result);
+	CU_ASSERT_EQUAL(resultBytes, n*sizeof(double));
+	CU_ASSERT_EQUAL(p.numBlocks, params.numBlocks);
+	for(i=0;i<n;i++)
+		CU_ASSERT(fabs(((double*)result)[i] - data[i]) <= params.originalEb);
+	free(result);
+}
+
+void test_pastriDecompressBlocks_range(void)
+{
+	pastri_params p;
+	unsigned char *all = NULL, *range = NULL;
+	size_t allBytes = 0, rangeBytes = 0, blockBytes = (size_t)params.bSize*sizeof(double);
+	CU_ASSERT_EQUAL(SZ_pastriDecompressBatch(compressed, &p, &all, &allBytes), 0);
+	CU_ASSERT_EQUAL(SZ_pastriDecompressBlocks(compressed, &p, 7, 20, &range, &rangeBytes), 0);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(all);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(range);
+	CU_ASSERT_EQUAL(rangeBytes, 20*blockBytes);
+	CU_ASSERT_EQUAL_ARRAY_BYTE(range, all+7*blockBytes, 20*blockBytes);
+	free(all);
+	free(range);
+}
+
+void test_pastriDecompressBlocks_unmarked(void)
+{
+	//the layout written before the block size table: pastri_params followed by the blocks
+	size_t headerBytes = sizeof(pastri_params) + 4 + sizeof(uint32_t) + (size_t)params.numBlocks*sizeof(uint32_t);
+	size_t blockBytes = (size_t)params.bSize*sizeof(double);
+	unsigned char* old = (unsigned char*)malloc(compressedBytes);
+	unsigned char *range = NULL, *expected = NULL;
+	size_t rangeBytes = 0, expectedBytes = 0;
+	pastri_params p;
+	memcpy(old, compressed, sizeof(pastri_params));
+	memcpy(old+sizeof(pastri_params), compressed+headerBytes, compressedBytes-headerBytes);
+	CU_ASSERT_EQUAL(SZ_pastriDecompressBlocks(old, &p, 7, 20, &range, &rangeBytes), 0);
+	CU_ASSERT_EQUAL(SZ_pastriDecompressBlocks(compressed, &p, 7, 20, &expected, &expectedBytes), 0);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(range);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(expected);
+	CU_ASSERT_EQUAL(rangeBytes, 20*blockBytes);
+	CU_ASSERT_EQUAL_ARRAY_BYTE(range, expected, 20*blockBytes);
+	free(old);
+	free(range);
+	free(expected);
+}
+
+void test_pastriDecompressBlocks_errors(void)
+{
+	pastri_params p;
+	unsigned char* result = (unsigned char*)&p;
+	size_t resultBytes = 1;
+	uint32_t version = 2;
+	unsigned char* future = (unsigned char*)malloc(compressedBytes);
+	memcpy(future, compressed, compressedBytes);
+	memcpy(future+sizeof(pastri_params)+4, &version, sizeof(uint32_t));
+	CU_ASSERT_EQUAL(SZ_pastriDecompressBatch(future, &p, &result, &resultBytes), -1);
+	CU_ASSERT_PTR_NULL(result);
+	CU_ASSERT_EQUAL(resultBytes, 0);
+	CU_ASSERT_EQUAL(SZ_pastriDecompressBlocks(compressed, &p, 40, 20, &result, &resultBytes), -1);
+	CU_ASSERT_PTR_NULL(result);
+	free(future);
+}
+
+/************* Test Runner Code goes here **************/
+
+int main ( void )
+{
+   CU_pSuite pSuite = NULL;
+
+   compress_batch();
+
+   /* initialize the CUnit test registry */
+   if ( CUE_SUCCESS != CU_initialize_registry() )
+      return CU_get_error();
+
+   /* add a suite to the registry */
+   pSuite = CU_add_suite( "test_pastri_suite", init_suite, clean_suite );
+   if ( NULL == pSuite ) {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   /* add the tests to the suite */
+   if ( (NULL == CU_add_test(pSuite, "test_pastriBatch_roundtrip", test_pastriBatch_roundtrip)) ||
+        (NULL == CU_add_test(pSuite, "test_pastriDecompressBlocks_range", test_pastriDecompressBlocks_range)) ||
+        (NULL == CU_add_test(pSuite, "test_pastriDecompressBlocks_unmarked", test_pastriDecompressBlocks_unmarked)) ||
+        (NULL == CU_add_test(pSuite, "test_pastriDecompressBlocks_errors", test_pastriDecompressBlocks_errors))
+      )
+   {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   // Run all tests using the basic interface
+   CU_basic_set_mode(CU_BRM_VERBOSE);
+   CU_basic_run_tests();
+   printf("\n");
+   CU_basic_show_failures(CU_get_failure_list());
+   unsigned int num_failures = CU_get_number_of_failures();
+   printf("\n\n");
+
+   /* Clean up registry and return */
+   CU_cleanup_registry();
+   free(data);
+   free(compressed);
+   return num_failures || CU_get_error();
+}
@@ -0,0 +1,157 @@
+#include "CUnit/CUnit.h"
+#include "CUnit/Basic.h"
+#include "CUnit_Array.h"
+
+#include "sz.h"
+#include "sz_async.h"
+
+#include <stdio.h>  // for printf
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Test Suite setup and cleanup functions: */
+
+int
+init_suite(void)
+{
+  return 0;
+}
+
+int
+clean_suite(void)
+{
+  return 0;
+}
+
+/************* Test case functions ****************/
+
+#define NB_JOBS 6
+#define R3 20
+#define R2 30
+#define R1 40
+
+static float fdata[NB_JOBS][R3*R2*R1];
+
+static void fill_data(void)
+{
+	size_t i;
+	int t;
+	for(t=0;t<NB_JOBS;t++)
+		for(i=0;i<R3*R2*R1;i++)
+			fdata[t][i] = (float)(sin(0.01*i + t) + 0.1*t);
+}
+
+/**
+ * The asynchronous jobs give the same bytes as the synchronous compression, even if the
+ * caller reuses its buffer right after submitting the job.
+ * */
+void test_SZ_compress_async_matches_sync(void)
+{
+	sz_async_handle handles[NB_JOBS];
+	unsigned char *bytes, *expected;
+	size_t outSize, expectedSize;
+	float buffer[R3*R2*R1];
+	int t;
+	for(t=0;t<NB_JOBS;t++)
+	{
+		memcpy(buffer, fdata[t], sizeof(buffer));
+		handles[t] = SZ_compress_async(SZ_FLOAT, buffer, ABS, 1e-3, 0, 0, 0, 0, R3, R2, R1);
+		CU_ASSERT_PTR_NOT_NULL_FATAL(handles[t]);
+		memset(buffer, 0, sizeof(buffer));
+	}
+	for(t=0;t<NB_JOBS;t++)
+	{
+		CU_ASSERT_EQUAL(SZ_wait(handles[t], &bytes, &outSize), SZ_SCES);
+		expected = SZ_compress_args(SZ_FLOAT, fdata[t], &expectedSize, ABS, 1e-3, 0, 0, 0, 0, R3, R2, R1);
+		CU_ASSERT_EQUAL_FATAL(outSize, expectedSize);
+		CU_ASSERT_EQUAL_ARRAY_BYTE(bytes, expected, outSize);
+		free(bytes);
+		free(expected);
+	}
+}
+
+/**
+ * The parameters of confparams_cpr are copied when the job is submitted, and are given back
+ * to the caller once the jobs are done.
+ * */
+void test_SZ_compress_async_params(void)
+{
+	sz_async_handle handle;
+	unsigned char *bytes, *expected;
+	size_t outSize, expectedSize;
+	int mode = confparams_cpr->szMode;
+	confparams_cpr->szMode = SZ_BEST_SPEED;
+	handle = SZ_compress_async(SZ_FLOAT, fdata[0], REL, 0, 1e-4, 0, 0, 0, R3, R2, R1);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(handle);
+	CU_ASSERT_EQUAL(SZ_wait(handle, &bytes, &outSize), SZ_SCES);
+	CU_ASSERT_EQUAL(confparams_cpr->szMode, SZ_BEST_SPEED);
+	expected = SZ_compress_args(SZ_FLOAT, fdata[0], &expectedSize, REL, 0, 1e-4, 0, 0, 0, R3, R2, R1);
+	CU_ASSERT_EQUAL_FATAL(outSize, expectedSize);
+	CU_ASSERT_EQUAL_ARRAY_BYTE(bytes, expected, outSize);
+	free(bytes);
+	free(expected);
+	confparams_cpr->szMode = mode;
+}
+
+/**
+ * SZ_test() reports the job as done before SZ_wait() collects it.
+ * */
+void test_SZ_test(void)
+{
+	sz_async_handle handle = SZ_compress_async(SZ_FLOAT, fdata[1], ABS, 1e-2, 0, 0, 0, 0, R3, R2, R1);
+	unsigned char *bytes;
+	size_t outSize;
+	CU_ASSERT_PTR_NOT_NULL_FATAL(handle);
+	while(!SZ_test(handle))
+		;
+	CU_ASSERT_EQUAL(SZ_wait(handle, &bytes, &outSize), SZ_SCES);
+	CU_ASSERT(outSize > 0);
+	free(bytes);
+}
+
+/************* Test Runner Code goes here **************/
+
+int main ( void )
+{
+   CU_pSuite pSuite = NULL;
+
+   fill_data();
+   SZ_Init(NULL);
+   //room for two pending inputs: the submission of the other jobs waits for the first ones
+   SZ_async_init(2*sizeof(fdata[0]));
+
+   /* initialize the CUnit test registry */
+   if ( CUE_SUCCESS != CU_initialize_registry() )
+      return CU_get_error();
+
+   /* add a suite to the registry */
+   pSuite = CU_add_suite( "test_sz_async_suite", init_suite, clean_suite );
+   if ( NULL == pSuite ) {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   /* add the tests to the suite */
+   if ( (NULL == CU_add_test(pSuite, "test_SZ_compress_async_matches_sync", test_SZ_compress_async_matches_sync)) ||
+        (NULL == CU_add_test(pSuite, "test_SZ_compress_async_params", test_SZ_compress_async_params)) ||
+        (NULL == CU_add_test(pSuite, "test_SZ_test", test_SZ_test))
+      )
+   {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   // Run all tests using the basic interface
+   CU_basic_set_mode(CU_BRM_VERBOSE);
+   CU_basic_run_tests();
+   printf("\n");
+   CU_basic_show_failures(CU_get_failure_list());
+   unsigned int num_failures = CU_get_number_of_failures();
+   printf("\n\n");
+
+   /* Clean up registry and return */
+   CU_cleanup_registry();
+   SZ_Finalize();
+   return num_failures || CU_get_error();
+}
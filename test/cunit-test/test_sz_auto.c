@@ -0,0 +1,220 @@
+#include "CUnit/CUnit.h"
+#include "CUnit/Basic.h"
+#include "CUnit_Array.h"
+
+#include "sz.h"
+#include "sz_auto.h"
+
+#include <stdio.h>  // for printf
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Test Suite setup and cleanup functions: */
+
+int
+init_suite(void)
+{
+  return 0;
+}
+
+int
+clean_suite(void)
+{
+  return 0;
+}
+
+/************* Test case functions ****************/
+
+#define R3 64
+#define R2 64
+#define R1 64
+#define N (R3*R2*R1)
+
+static float* data = NULL;
+
+/**
+ * A smooth wave plus a uniform noise of +-0.004 (from a fixed linear congruential generator).
+ * */
+static void make_field(void)
+{
+	unsigned int seed = 1;
+	size_t i;
+	data = (float*)malloc(N*sizeof(float));
+	for(i=0;i<N;i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		double x = (double)(i / (R2*R1)) / R3, y = (double)(i / R1 % R2) / R2, z = (double)(i % R1) / R1;
+		data[i] = (float)(sin(6*x) * cos(5*y) + 0.5*sin(4*z + x) + 0.008 * ((seed >> 16) % 32768) / 32768.0 - 0.004);
+	}
+}
+
+static void set_bound(double relBound)
+{
+	confparams_cpr->errorBoundMode = REL;
+	confparams_cpr->relBoundRatio = relBound;
+}
+
+/**
+ * The size of SZ_compress() in a mode.
+ * */
+static size_t compressed_size(sz_mode* mode)
+{
+	size_t outSize = 0;
+	confparams_cpr->withRegression = mode->withRegression;
+	confparams_cpr->szMode = mode->szMode;
+	confparams_cpr->losslessCompressor = mode->losslessCompressor;
+	confparams_cpr->gzipMode = mode->gzipMode;
+	unsigned char* bytes = SZ_compress(SZ_FLOAT, data, &outSize, 0, 0, R3, R2, R1);
+	confparams_cpr->withRegression = SZ_WITH_LINEAR_REGRESSION;
+	confparams_cpr->szMode = SZ_BEST_COMPRESSION;
+	confparams_cpr->losslessCompressor = ZSTD_COMPRESSOR;
+	confparams_cpr->gzipMode = 3;
+	free(bytes);
+	return outSize;
+}
+
+/**
+ * The smallest size of SZ_compress() over the candidate modes of SZ_autoSelectMode().
+ * */
+static size_t best_size(void)
+{
+	int predictors[2] = {SZ_WITH_LINEAR_REGRESSION, SZ_NO_REGRESSION};
+	int lossless[5][2] = {{ZSTD_COMPRESSOR, 1}, {ZSTD_COMPRESSOR, 3}, {ZSTD_COMPRESSOR, 19}, {GZIP_COMPRESSOR, 1}, {GZIP_COMPRESSOR, 9}};
+	size_t best = 0, size;
+	int p, l;
+	for(p=0;p<2;p++)
+	{
+		sz_mode mode = {predictors[p], SZ_BEST_SPEED, ZSTD_COMPRESSOR, 3};
+		size = compressed_size(&mode);
+		if(best == 0 || size < best)
+			best = size;
+		for(l=0;l<5;l++)
+		{
+			sz_mode lmode = {predictors[p], SZ_BEST_COMPRESSION, lossless[l][0], lossless[l][1]};
+			size = compressed_size(&lmode);
+			if(size < best)
+				best = size;
+		}
+	}
+	return best;
+}
+
+/**
+ * The mode selected for the highest ratio compresses within 10% of the best of all the candidate modes.
+ * */
+void test_auto_max_ratio(void)
+{
+	double bounds[2] = {1e-2, 1e-4};
+	int b;
+	for(b=0;b<2;b++)
+	{
+		sz_auto_objective objective = {SZ_AUTO_MAX_RATIO, 0, 0, 0};
+		sz_mode mode;
+		set_bound(bounds[b]);
+		CU_ASSERT_EQUAL_FATAL(SZ_autoSelectMode(NULL, SZ_FLOAT, data, 0, 0, R3, R2, R1, &objective, &mode), SZ_SCES);
+		CU_ASSERT(compressed_size(&mode) <= 1.1 * best_size());
+	}
+}
+
+/**
+ * The mode selected for the highest speed under a minimum ratio reaches most of that ratio.
+ * */
+void test_auto_max_speed(void)
+{
+	set_bound(1e-3);
+	double bestRatio = (double)N * sizeof(float) / best_size();
+	sz_auto_objective objective = {SZ_AUTO_MAX_SPEED, 0, bestRatio / 2, 0};
+	sz_mode mode;
+	CU_ASSERT_EQUAL_FATAL(SZ_autoSelectMode(NULL, SZ_FLOAT, data, 0, 0, R3, R2, R1, &objective, &mode), SZ_SCES);
+	CU_ASSERT((double)N * sizeof(float) / compressed_size(&mode) >= 0.8 * objective.minRatio);
+}
+
+/**
+ * SZ_compress_auto() keeps the error bound and the settings of SZ_Init(), and reuses the mode of a variable until
+ * it is cleared.
+ * */
+void test_compress_auto(void)
+{
+	sz_auto_objective objective = {SZ_AUTO_MAX_RATIO, 0, 0, 0};
+	sz_mode mode, cached;
+	size_t outSize = 0, i;
+	set_bound(1e-3);
+	unsigned char* bytes = SZ_compress_auto("temperature", SZ_FLOAT, data, &outSize, 0, 0, R3, R2, R1, &objective);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(bytes);
+	CU_ASSERT_EQUAL(confparams_cpr->withRegression, SZ_WITH_LINEAR_REGRESSION);
+	CU_ASSERT_EQUAL(confparams_cpr->szMode, SZ_BEST_COMPRESSION);
+	float* result = (float*)SZ_decompress(SZ_FLOAT, bytes, outSize, 0, 0, R3, R2, R1);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(result);
+	float min = data[0], max = data[0];
+	for(i=1;i<N;i++)
+	{
+		if(data[i] < min) min = data[i];
+		if(data[i] > max) max = data[i];
+	}
+	for(i=0;i<N;i++)
+		if(fabs(result[i]-data[i]) > 1e-3*(max-min)*(1+1e-5))
+			break;
+	CU_ASSERT_EQUAL(i, N);
+	free(result);
+	free(bytes);
+
+	CU_ASSERT_EQUAL(SZ_autoSelectMode("temperature", SZ_FLOAT, data, 0, 0, R3, R2, R1, &objective, &mode), SZ_SCES);
+	//the cached mode is returned even for other data
+	float* other = (float*)calloc(N, sizeof(float));
+	CU_ASSERT_EQUAL(SZ_autoSelectMode("temperature", SZ_FLOAT, other, 0, 0, R3, R2, R1, &objective, &cached), SZ_SCES);
+	CU_ASSERT_EQUAL(memcmp(&mode, &cached, sizeof(sz_mode)), 0);
+	SZ_autoClearModes("temperature");
+	CU_ASSERT_EQUAL(SZ_autoSelectMode("temperature", SZ_FLOAT, other, 0, 0, R3, R2, R1, &objective, &cached), SZ_SCES);
+	SZ_autoClearModes(NULL);
+	free(other);
+}
+
+/************* Test Runner Code goes here **************/
+
+int main ( void )
+{
+   CU_pSuite pSuite = NULL;
+
+   SZ_Init(NULL);
+   confparams_cpr->withRegression = SZ_WITH_LINEAR_REGRESSION;
+   confparams_cpr->szMode = SZ_BEST_COMPRESSION;
+   confparams_cpr->losslessCompressor = ZSTD_COMPRESSOR;
+   confparams_cpr->gzipMode = 3;
+   make_field();
+
+   /* initialize the CUnit test registry */
+   if ( CUE_SUCCESS != CU_initialize_registry() )
+      return CU_get_error();
+
+   /* add a suite to the registry */
+   pSuite = CU_add_suite( "test_sz_auto_suite", init_suite, clean_suite );
+   if ( NULL == pSuite ) {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   /* add the tests to the suite */
+   if ( (NULL == CU_add_test(pSuite, "test_auto_max_ratio", test_auto_max_ratio)) ||
+        (NULL == CU_add_test(pSuite, "test_auto_max_speed", test_auto_max_speed)) ||
+        (NULL == CU_add_test(pSuite, "test_compress_auto", test_compress_auto))
+      )
+   {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   // Run all tests using the basic interface
+   CU_basic_set_mode(CU_BRM_VERBOSE);
+   CU_basic_run_tests();
+   printf("\n");
+   CU_basic_show_failures(CU_get_failure_list());
+   unsigned int num_failures = CU_get_number_of_failures();
+   printf("\n\n");
+
+   /* Clean up registry and return */
+   CU_cleanup_registry();
+   free(data);
+   SZ_Finalize();
+   return num_failures || CU_get_error();
+}
@@ -0,0 +1,133 @@
+#include "CUnit/CUnit.h"
+#include "CUnit/Basic.h"
+#include "CUnit_Array.h"
+
+#include "sz.h"
+
+#include <stdio.h>  // for printf
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+/* Test Suite setup and cleanup functions: */
+
+int
+init_suite(void)
+{
+  return 0;
+}
+
+int
+clean_suite(void)
+{
+  return 0;
+}
+
+/************* Test case functions ****************/
+
+#define R3 12
+#define R2 20
+#define R1 30
+#define N (R3*R2*R1)
+
+/**
+ * The bytes written into the caller's buffer are those of SZ_compress_args(), and SZ_decompress_args()
+ * gives the same data as SZ_decompress().
+ * */
+static void check_buffer_roundtrip(int dataType, void* data, size_t typeSize, double errBound)
+{
+	size_t capacity = SZ_compress_bound(dataType, 0, 0, R3, R2, R1), outSize = 0, expectedSize = 0;
+	unsigned char* buffer = (unsigned char*)malloc(capacity);
+	unsigned char* expected = SZ_compress_args(dataType, data, &expectedSize, ABS, errBound, 0, 0, 0, 0, R3, R2, R1);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(expected);
+	CU_ASSERT(expectedSize <= capacity);
+	CU_ASSERT_EQUAL(SZ_compress_args_to_buffer(dataType, data, buffer, capacity, &outSize, ABS, errBound, 0, 0, 0, 0, R3, R2, R1), SZ_SCES);
+	CU_ASSERT_EQUAL_FATAL(outSize, expectedSize);
+	CU_ASSERT_EQUAL_ARRAY_BYTE(buffer, expected, outSize);
+
+	void* result = malloc(N*typeSize);
+	void* reference = SZ_decompress(dataType, buffer, outSize, 0, 0, R3, R2, R1);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(reference);
+	CU_ASSERT_EQUAL(SZ_decompress_args(dataType, buffer, outSize, result, 0, 0, R3, R2, R1), N);
+	CU_ASSERT_EQUAL_ARRAY_BYTE(result, reference, N*typeSize);
+
+	//a buffer smaller than the compressed bytes is rejected
+	CU_ASSERT_EQUAL(SZ_compress_args_to_buffer(dataType, data, buffer, outSize-1, &outSize, ABS, errBound, 0, 0, 0, 0, R3, R2, R1), SZ_NSCS);
+
+	free(buffer);
+	free(expected);
+	free(result);
+	free(reference);
+}
+
+void test_buffer_float(void)
+{
+	float data[N];
+	size_t i;
+	for(i=0;i<N;i++)
+		data[i] = (float)(sin(0.05*i) + cos(0.003*i));
+	check_buffer_roundtrip(SZ_FLOAT, data, sizeof(float), 1e-3);
+}
+
+void test_buffer_double(void)
+{
+	double data[N];
+	size_t i;
+	for(i=0;i<N;i++)
+		data[i] = sin(0.05*i) + cos(0.003*i);
+	check_buffer_roundtrip(SZ_DOUBLE, data, sizeof(double), 1e-6);
+}
+
+void test_buffer_int32(void)
+{
+	int32_t data[N];
+	size_t i;
+	for(i=0;i<N;i++)
+		data[i] = (int32_t)(1000*sin(0.05*i)) + (int32_t)(i%7);
+	check_buffer_roundtrip(SZ_INT32, data, sizeof(int32_t), 0.5);
+	check_buffer_roundtrip(SZ_INT32, data, sizeof(int32_t), 4);
+}
+
+/************* Test Runner Code goes here **************/
+
+int main ( void )
+{
+   CU_pSuite pSuite = NULL;
+
+   SZ_Init(NULL);
+
+   /* initialize the CUnit test registry */
+   if ( CUE_SUCCESS != CU_initialize_registry() )
+      return CU_get_error();
+
+   /* add a suite to the registry */
+   pSuite = CU_add_suite( "test_sz_buffer_suite", init_suite, clean_suite );
+   if ( NULL == pSuite ) {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   /* add the tests to the suite */
+   if ( (NULL == CU_add_test(pSuite, "test_buffer_float", test_buffer_float)) ||
+        (NULL == CU_add_test(pSuite, "test_buffer_double", test_buffer_double)) ||
+        (NULL == CU_add_test(pSuite, "test_buffer_int32", test_buffer_int32))
+      )
+   {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   // Run all tests using the basic interface
+   CU_basic_set_mode(CU_BRM_VERBOSE);
+   CU_basic_run_tests();
+   printf("\n");
+   CU_basic_show_failures(CU_get_failure_list());
+   unsigned int num_failures = CU_get_number_of_failures();
+   printf("\n\n");
+
+   /* Clean up registry and return */
+   CU_cleanup_registry();
+   SZ_Finalize();
+   return num_failures || CU_get_error();
+}
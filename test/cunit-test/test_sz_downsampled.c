@@ -0,0 +1,178 @@
+#include "CUnit/CUnit.h"
+#include "CUnit/Basic.h"
+#include "CUnit_Array.h"
+
+#include "sz.h"
+
+#include <stdio.h>  // for printf
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Test Suite setup and cleanup functions: */
+
+int
+init_suite(void)
+{
+  return 0;
+}
+
+int
+clean_suite(void)
+{
+  return 0;
+}
+
+/************* Test case functions ****************/
+
+#define R3 64
+#define R2 64
+#define R1 64
+#define N (R3*R2*R1)
+
+/**
+ * A smooth wave, plus a uniform noise of +-noise (from a fixed linear congruential generator).
+ * */
+static double wave(size_t i, unsigned int *seed, double noise)
+{
+	*seed = *seed * 1103515245 + 12345;
+	double x = (double)(i / (R2*R1)) / R3, y = (double)(i / R1 % R2) / R2, z = (double)(i % R1) / R1;
+	return sin(6*x) * cos(5*y) + 0.5*sin(4*z + x) + noise * (2.0 * ((*seed >> 16) % 32768) / 32768.0 - 1);
+}
+
+/**
+ * The downsampled data are within errBound of the means of SZ_decompress() over the d3*d2*d1 blocks of the data
+ * (n3*n2*n1, n1 the fastest), split as the blocked regression splits them.
+ * */
+static void check_downsampled(int dataType, void* data, double errBound, size_t n3, size_t n2, size_t n1,
+size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	size_t outSize = 0, d3 = 0, d2 = 0, d1 = 0;
+	unsigned char* bytes = SZ_compress_args(dataType, data, &outSize, ABS, errBound, 0, 0, r5, r4, r3, r2, r1);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(bytes);
+	void* result = SZ_decompress(dataType, bytes, outSize, r5, r4, r3, r2, r1);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(result);
+	void* downsampled = SZ_decompress_downsampled(dataType, bytes, outSize, r5, r4, r3, r2, r1, &d3, &d2, &d1);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(downsampled);
+	CU_ASSERT_FATAL(d3 >= 1 && d3 <= n3 && d2 >= 1 && d2 <= n2 && d1 >= 1 && d1 <= n1);
+
+	size_t split3, early3, late3, split2, early2, late2, split1, early1, late1;
+	SZ_COMPUTE_BLOCKCOUNT(n3, d3, split3, early3, late3);
+	SZ_COMPUTE_BLOCKCOUNT(n2, d2, split2, early2, late2);
+	SZ_COMPUTE_BLOCKCOUNT(n1, d1, split1, early1, late1);
+	double maxErr = 0;
+	size_t index = 0, i, j, k, ii, jj, kk;
+	for(i=0;i<d3;i++)
+	{
+		size_t offset3 = i < split3 ? i * early3 : i * late3 + split3, count3 = i < split3 ? early3 : late3;
+		for(j=0;j<d2;j++)
+		{
+			size_t offset2 = j < split2 ? j * early2 : j * late2 + split2, count2 = j < split2 ? early2 : late2;
+			for(k=0;k<d1;k++)
+			{
+				size_t offset1 = k < split1 ? k * early1 : k * late1 + split1, count1 = k < split1 ? early1 : late1;
+				double sum = 0, value;
+				for(ii=0;ii<count3;ii++)
+					for(jj=0;jj<count2;jj++)
+						for(kk=0;kk<count1;kk++)
+						{
+							size_t p = ((offset3 + ii) * n2 + offset2 + jj) * n1 + offset1 + kk;
+							sum += dataType == SZ_FLOAT ? ((float*)result)[p] : ((double*)result)[p];
+						}
+				value = dataType == SZ_FLOAT ? ((float*)downsampled)[index] : ((double*)downsampled)[index];
+				if(fabs(value - sum / (count3 * count2 * count1)) > maxErr)
+					maxErr = fabs(value - sum / (count3 * count2 * count1));
+				index ++;
+			}
+		}
+	}
+	CU_ASSERT(maxErr <= errBound);
+	free(downsampled);
+	free(result);
+	free(bytes);
+}
+
+/**
+ * A smooth field at a loose bound: all the blocks use the regression, and the downsampled data are decoded from the
+ * regression coefficients.
+ * */
+void test_downsampled_regression(void)
+{
+	float* data = (float*)malloc(N*sizeof(float));
+	double* ddata = (double*)malloc(N*sizeof(double));
+	unsigned int seed = 1;
+	size_t i;
+	for(i=0;i<N;i++)
+		ddata[i] = data[i] = (float)wave(i, &seed, 0);
+	check_downsampled(SZ_FLOAT, data, 2e-2, R3, R2, R1, 0, 0, R3, R2, R1);
+	check_downsampled(SZ_DOUBLE, ddata, 2e-2, R3, R2, R1, 0, 0, R3, R2, R1);
+	//4D: the 4th dimension is merged into the 3rd one
+	check_downsampled(SZ_FLOAT, data, 2e-2, R3, R2, R1, 0, 4, R3/4, R2, R1);
+	free(data);
+	free(ddata);
+}
+
+/**
+ * A noisy field at tighter bounds: some blocks are predicted by Lorenzo, and the downsampled data are averaged from
+ * the full decompression.
+ * */
+void test_downsampled_lorenzo(void)
+{
+	float* data = (float*)malloc(N*sizeof(float));
+	double* ddata = (double*)malloc(N*sizeof(double));
+	unsigned int seed = 1;
+	size_t i;
+	for(i=0;i<N;i++)
+		ddata[i] = data[i] = (float)wave(i, &seed, 0.004);
+	check_downsampled(SZ_FLOAT, data, 2e-3, R3, R2, R1, 0, 0, R3, R2, R1);
+	check_downsampled(SZ_FLOAT, data, 2e-4, R3, R2, R1, 0, 0, R3, R2, R1);
+	check_downsampled(SZ_DOUBLE, ddata, 2e-3, R3, R2, R1, 0, 0, R3, R2, R1);
+	check_downsampled(SZ_DOUBLE, ddata, 2e-4, R3, R2, R1, 0, 0, R3, R2, R1);
+	//2D: no regression coefficients to decode
+	check_downsampled(SZ_FLOAT, data, 2e-3, 1, R3*R2, R1, 0, 0, 0, R3*R2, R1);
+	free(data);
+	free(ddata);
+}
+
+/************* Test Runner Code goes here **************/
+
+int main ( void )
+{
+   CU_pSuite pSuite = NULL;
+
+   SZ_Init(NULL);
+   confparams_cpr->withRegression = SZ_WITH_LINEAR_REGRESSION;
+
+   /* initialize the CUnit test registry */
+   if ( CUE_SUCCESS != CU_initialize_registry() )
+      return CU_get_error();
+
+   /* add a suite to the registry */
+   pSuite = CU_add_suite( "test_sz_downsampled_suite", init_suite, clean_suite );
+   if ( NULL == pSuite ) {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   /* add the tests to the suite */
+   if ( (NULL == CU_add_test(pSuite, "test_downsampled_regression", test_downsampled_regression)) ||
+        (NULL == CU_add_test(pSuite, "test_downsampled_lorenzo", test_downsampled_lorenzo))
+      )
+   {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   // Run all tests using the basic interface
+   CU_basic_set_mode(CU_BRM_VERBOSE);
+   CU_basic_run_tests();
+   printf("\n");
+   CU_basic_show_failures(CU_get_failure_list());
+   unsigned int num_failures = CU_get_number_of_failures();
+   printf("\n\n");
+
+   /* Clean up registry and return */
+   CU_cleanup_registry();
+   SZ_Finalize();
+   return num_failures || CU_get_error();
+}
@@ -0,0 +1,156 @@
+#include "CUnit/CUnit.h"
+#include "CUnit/Basic.h"
+#include "CUnit_Array.h"
+
+#include "sz.h"
+#include "sz_estimate.h"
+
+#include <stdio.h>  // for printf
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Test Suite setup and cleanup functions: */
+
+int
+init_suite(void)
+{
+  return 0;
+}
+
+int
+clean_suite(void)
+{
+  return 0;
+}
+
+/************* Test case functions ****************/
+
+#define R3 64
+#define R2 64
+#define R1 64
+#define N (R3*R2*R1)
+
+/**
+ * A smooth wave plus a uniform noise of +-0.004 (from a fixed linear congruential generator), below the error bounds
+ * of the tests: most of the codes are the same, and the lossless stage compresses the stream of the SZ stage several
+ * times, far less on a whole field than on a scattered sample of its blocks.
+ * */
+static double smooth_noisy(size_t i, unsigned int *seed)
+{
+	*seed = *seed * 1103515245 + 12345;
+	double x = (double)(i / (R2*R1)) / R3, y = (double)(i / R1 % R2) / R2, z = (double)(i % R1) / R1;
+	return sin(6*x) * cos(5*y) + 0.5*sin(4*z + x) + 0.008 * ((*seed >> 16) % 32768) / 32768.0 - 0.004;
+}
+
+/**
+ * The estimated size of the compressed bytes is within a factor of the size of SZ_compress_args(), with the
+ * Lorenzo predictor and with the blocked regression.
+ * */
+static void check_estimate(int dataType, void* data, double relBound, double factor)
+{
+	int withRegression;
+	for(withRegression=0;withRegression<2;withRegression++)
+	{
+		size_t outSize = 0;
+		sz_estimate estimate;
+		confparams_cpr->withRegression = withRegression ? SZ_WITH_LINEAR_REGRESSION : SZ_NO_REGRESSION;
+		confparams_cpr->errorBoundMode = REL;
+		confparams_cpr->relBoundRatio = relBound;
+		unsigned char* bytes = SZ_compress_args(dataType, data, &outSize, REL, 0, relBound, 0, 0, 0, R3, R2, R1);
+		CU_ASSERT_PTR_NOT_NULL_FATAL(bytes);
+		free(bytes);
+		CU_ASSERT_EQUAL_FATAL(SZ_estimate(dataType, data, 0, 0, R3, R2, R1, NULL, &estimate), SZ_SCES);
+		double ratio = (double)estimate.compressedSize / outSize;
+		CU_ASSERT(ratio < factor && ratio > 1 / factor);
+		CU_ASSERT(estimate.compressionTime > 0);
+		CU_ASSERT(estimate.sampleRatio > 0 && estimate.sampleRatio <= 1);
+	}
+}
+
+void test_estimate_float(void)
+{
+	float* data = (float*)malloc(N*sizeof(float));
+	unsigned int seed = 1;
+	size_t i;
+	for(i=0;i<N;i++)
+		data[i] = (float)smooth_noisy(i, &seed);
+	check_estimate(SZ_FLOAT, data, 1e-2, 1.5);
+	check_estimate(SZ_FLOAT, data, 1e-3, 1.5);
+	free(data);
+}
+
+void test_estimate_double(void)
+{
+	double* data = (double*)malloc(N*sizeof(double));
+	unsigned int seed = 1;
+	size_t i;
+	for(i=0;i<N;i++)
+		data[i] = smooth_noisy(i, &seed);
+	check_estimate(SZ_DOUBLE, data, 1e-2, 1.5);
+	check_estimate(SZ_DOUBLE, data, 1e-3, 1.5);
+	free(data);
+}
+
+/**
+ * A field of a constant value compresses to a single value, which SZ_estimate() finds without sampling.
+ * */
+void test_estimate_constant(void)
+{
+	float* data = (float*)malloc(N*sizeof(float));
+	size_t i, outSize = 0;
+	sz_estimate estimate;
+	for(i=0;i<N;i++)
+		data[i] = 1;
+	unsigned char* bytes = SZ_compress_args(SZ_FLOAT, data, &outSize, ABS, 1e-3, 0, 0, 0, 0, R3, R2, R1);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(bytes);
+	confparams_cpr->errorBoundMode = ABS;
+	confparams_cpr->absErrBound = 1e-3;
+	CU_ASSERT_EQUAL(SZ_estimate(SZ_FLOAT, data, 0, 0, R3, R2, R1, NULL, &estimate), SZ_SCES);
+	CU_ASSERT(estimate.compressedSize <= 2*outSize);
+	free(bytes);
+	free(data);
+}
+
+/************* Test Runner Code goes here **************/
+
+int main ( void )
+{
+   CU_pSuite pSuite = NULL;
+
+   SZ_Init(NULL);
+
+   /* initialize the CUnit test registry */
+   if ( CUE_SUCCESS != CU_initialize_registry() )
+      return CU_get_error();
+
+   /* add a suite to the registry */
+   pSuite = CU_add_suite( "test_sz_estimate_suite", init_suite, clean_suite );
+   if ( NULL == pSuite ) {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   /* add the tests to the suite */
+   if ( (NULL == CU_add_test(pSuite, "test_estimate_float", test_estimate_float)) ||
+        (NULL == CU_add_test(pSuite, "test_estimate_double", test_estimate_double)) ||
+        (NULL == CU_add_test(pSuite, "test_estimate_constant", test_estimate_constant))
+      )
+   {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   // Run all tests using the basic interface
+   CU_basic_set_mode(CU_BRM_VERBOSE);
+   CU_basic_run_tests();
+   printf("\n");
+   CU_basic_show_failures(CU_get_failure_list());
+   unsigned int num_failures = CU_get_number_of_failures();
+   printf("\n\n");
+
+   /* Clean up registry and return */
+   CU_cleanup_registry();
+   SZ_Finalize();
+   return num_failures || CU_get_error();
+}
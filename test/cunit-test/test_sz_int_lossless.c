@@ -0,0 +1,157 @@
+#include "CUnit/CUnit.h"
+#include "CUnit/Basic.h"
+#include "CUnit_Array.h"
+
+#include "sz.h"
+
+#include <stdio.h>  // for printf
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/* Test Suite setup and cleanup functions: */
+
+int
+init_suite(void)
+{
+  return 0;
+}
+
+int
+clean_suite(void)
+{
+  return 0;
+}
+
+/************* Test case functions ****************/
+
+void test_encodeLosslessIntResiduals_1D(void)
+{
+	int32_t data[6] = {5, 7, 4, 4, -2, 2147483647};
+	unsigned char planes[24];
+	encodeLosslessIntResiduals(data, 4, 1, 1, 6, planes);
+	//residuals: 5, 2, -3, 0, -6, 2147483649 (mod 2^32) => zigzag: 10, 4, 5, 0, 11, 0xFFFFFFFD
+	unsigned char expected[24] = {10,4,5,0,11,0xFD, 0,0,0,0,0,0xFF, 0,0,0,0,0,0xFF, 0,0,0,0,0,0xFF};
+	CU_ASSERT_EQUAL_ARRAY_BYTE(planes, expected, 24);
+}
+
+void test_encodeLosslessIntResiduals_2D(void)
+{
+	//a plane is predicted exactly by the 2D Lorenzo predictor, so only the first row/column carry information
+	uint16_t data[12];
+	int i, j;
+	for(i=0;i<3;i++)
+		for(j=0;j<4;j++)
+			data[i*4+j] = 100 + 3*i + 2*j;
+	unsigned char planes[24];
+	encodeLosslessIntResiduals(data, 2, 1, 3, 4, planes);
+	unsigned char expected[24] = {200,4,4,4, 6,0,0,0, 6,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0};
+	CU_ASSERT_EQUAL_ARRAY_BYTE(planes, expected, 24);
+}
+
+void test_LosslessIntResiduals_roundtrip(void)
+{
+	size_t i, n = 4*5*6;
+	int sizes[4] = {1, 2, 4, 8};
+	int s;
+	for(s=0;s<4;s++)
+	{
+		int intSize = sizes[s];
+		unsigned char* data = (unsigned char*)malloc(n*intSize);
+		unsigned char* planes = (unsigned char*)malloc(n*intSize);
+		unsigned char* result = (unsigned char*)malloc(n*intSize);
+		for(i=0;i<n*intSize;i++)
+			data[i] = (unsigned char)(rand() & 0xFF);
+		encodeLosslessIntResiduals(data, intSize, 4, 5, 6, planes);
+		decodeLosslessIntResiduals(planes, intSize, 4, 5, 6, result);
+		CU_ASSERT_EQUAL_ARRAY_BYTE(result, data, n*intSize);
+		free(data);
+		free(planes);
+		free(result);
+	}
+}
+
+/**
+ * Compress with an error bound below 1 (i.e., in the lossless integer mode) and decompress through the public API,
+ * with and without the lossless back end.
+ * */
+static void check_int_lossless_roundtrip(int dataType, void* data, int intSize, size_t r3, size_t r2, size_t r1)
+{
+	int modes[2] = {SZ_BEST_COMPRESSION, SZ_BEST_SPEED};
+	int m;
+	for(m=0;m<2;m++)
+	{
+		size_t outSize = 0;
+		confparams_cpr->szMode = modes[m];
+		unsigned char* bytes = SZ_compress_args(dataType, data, &outSize, ABS, 0.5, 0, 0, 0, 0, r3, r2, r1);
+		CU_ASSERT_PTR_NOT_NULL_FATAL(bytes);
+		void* result = SZ_decompress(dataType, bytes, outSize, 0, 0, r3, r2, r1);
+		CU_ASSERT_PTR_NOT_NULL_FATAL(result);
+		CU_ASSERT_EQUAL_ARRAY_BYTE(result, data, r3*r2*r1*intSize);
+		free(bytes);
+		free(result);
+	}
+}
+
+void test_SZ_compress_int_lossless_roundtrip(void)
+{
+	size_t i, n = 7*9*11;
+	int32_t* data32 = (int32_t*)malloc(n*sizeof(int32_t));
+	uint16_t* data16 = (uint16_t*)malloc(n*sizeof(uint16_t));
+	for(i=0;i<n;i++)
+	{
+		data32[i] = (int32_t)(i*37) - 1000 + (rand() % 5) - 2;
+		data16[i] = (uint16_t)(60000 - i*13 + (rand() % 3));
+	}
+	data32[n/2] = INT32_MIN;
+	data16[n/3] = 0;
+
+	SZ_Init(NULL);
+	check_int_lossless_roundtrip(SZ_INT32, data32, sizeof(int32_t), 7, 9, 11);
+	check_int_lossless_roundtrip(SZ_UINT16, data16, sizeof(uint16_t), 7, 9, 11);
+	SZ_Finalize();
+
+	free(data32);
+	free(data16);
+}
+
+/************* Test Runner Code goes here **************/
+
+int main ( void )
+{
+   CU_pSuite pSuite = NULL;
+
+   /* initialize the CUnit test registry */
+   if ( CUE_SUCCESS != CU_initialize_registry() )
+      return CU_get_error();
+
+   /* add a suite to the registry */
+   pSuite = CU_add_suite( "test_sz_int_lossless_suite", init_suite, clean_suite );
+   if ( NULL == pSuite ) {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   /* add the tests to the suite */
+   if ( (NULL == CU_add_test(pSuite, "test_encodeLosslessIntResiduals_1D", test_encodeLosslessIntResiduals_1D)) ||
+        (NULL == CU_add_test(pSuite, "test_encodeLosslessIntResiduals_2D", test_encodeLosslessIntResiduals_2D)) ||
+        (NULL == CU_add_test(pSuite, "test_LosslessIntResiduals_roundtrip", test_LosslessIntResiduals_roundtrip)) ||
+        (NULL == CU_add_test(pSuite, "test_SZ_compress_int_lossless_roundtrip", test_SZ_compress_int_lossless_roundtrip))
+      )
+   {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   // Run all tests using the basic interface
+   CU_basic_set_mode(CU_BRM_VERBOSE);
+   CU_basic_run_tests();
+   printf("\n");
+   CU_basic_show_failures(CU_get_failure_list());
+   unsigned int num_failures = CU_get_number_of_failures();
+   printf("\n\n");
+
+   /* Clean up registry and return */
+   CU_cleanup_registry();
+   return num_failures || CU_get_error();
+}
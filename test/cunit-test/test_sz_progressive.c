@@ -0,0 +1,186 @@
+#include "CUnit/CUnit.h"
+#include "CUnit/Basic.h"
+#include "CUnit_Array.h"
+
+#include "sz.h"
+#include "sz_progressive.h"
+
+#include <stdio.h>  // for printf
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Test Suite setup and cleanup functions: */
+
+int
+init_suite(void)
+{
+  return 0;
+}
+
+int
+clean_suite(void)
+{
+  return 0;
+}
+
+/************* Test case functions ****************/
+
+#define R3 32
+#define R2 64
+#define R1 64
+#define N (R3*R2*R1)
+#define NB_LAYERS 3
+
+/**
+ * A smooth wave plus a uniform noise of +-0.004 (from a fixed linear congruential generator), around an offset.
+ * */
+static double smooth_noisy(size_t i, unsigned int *seed, double offset)
+{
+	*seed = *seed * 1103515245 + 12345;
+	double x = (double)(i / (R2*R1)) / R3, y = (double)(i / R1 % R2) / R2, z = (double)(i % R1) / R1;
+	return offset + sin(6*x) * cos(5*y) + 0.5*sin(4*z + x) + 0.008 * ((*seed >> 16) % 32768) / 32768.0 - 0.004;
+}
+
+static double max_error(int dataType, void* data, void* result)
+{
+	double err = 0, diff;
+	size_t i;
+	for(i=0;i<N;i++)
+	{
+		diff = dataType == SZ_FLOAT ? fabs(((float*)result)[i] - ((float*)data)[i])
+			: fabs(((double*)result)[i] - ((double*)data)[i]);
+		if(diff > err)
+			err = diff;
+	}
+	return err;
+}
+
+/**
+ * The first i+1 layers of a progressive stream decompress within errBounds[i], from the whole stream and from a
+ * stream truncated after them; the header gives the bounds and the ends of the layers.
+ * */
+static void check_progressive(int dataType, void* data, double* errBounds)
+{
+	size_t outSize = 0, layerEnds[NB_LAYERS];
+	int nbLayers, i;
+	double bounds[NB_LAYERS], errBound;
+	unsigned char* bytes = SZ_compress_progressive(dataType, data, &outSize, errBounds, NB_LAYERS, 0, 0, R3, R2, R1);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(bytes);
+
+	CU_ASSERT_EQUAL_FATAL(SZ_progressiveInfo(bytes, outSize, &nbLayers, bounds, layerEnds), SZ_SCES);
+	CU_ASSERT_EQUAL_FATAL(nbLayers, NB_LAYERS);
+	CU_ASSERT_EQUAL(layerEnds[NB_LAYERS-1], outSize);
+	for(i=0;i<NB_LAYERS;i++)
+	{
+		CU_ASSERT_EQUAL(bounds[i], errBounds[i]);
+		CU_ASSERT(layerEnds[i] > (i == 0 ? SZ_PROGRESSIVE_HEADER_SIZE(NB_LAYERS) : layerEnds[i-1]));
+	}
+
+	for(i=0;i<NB_LAYERS;i++)
+	{
+		void* result = SZ_decompress_progressive(dataType, bytes, outSize, i+1, &errBound, 0, 0, R3, R2, R1);
+		CU_ASSERT_PTR_NOT_NULL_FATAL(result);
+		CU_ASSERT_EQUAL(errBound, errBounds[i]);
+		CU_ASSERT(max_error(dataType, data, result) <= errBounds[i]);
+		free(result);
+
+		//a stream truncated in the middle of the next layer decompresses the same layers
+		size_t truncated = i+1 < NB_LAYERS ? (layerEnds[i] + layerEnds[i+1]) / 2 : outSize;
+		result = SZ_decompress_progressive(dataType, bytes, truncated, 0, &errBound, 0, 0, R3, R2, R1);
+		CU_ASSERT_PTR_NOT_NULL_FATAL(result);
+		CU_ASSERT_EQUAL(errBound, errBounds[i]);
+		CU_ASSERT(max_error(dataType, data, result) <= errBounds[i]);
+		free(result);
+	}
+
+	//the base layer is needed
+	CU_ASSERT_PTR_NULL(SZ_decompress_progressive(dataType, bytes, layerEnds[0] - 1, 0, NULL, 0, 0, R3, R2, R1));
+	free(bytes);
+}
+
+void test_progressive_float(void)
+{
+	float* data = (float*)malloc(N*sizeof(float));
+	double errBounds[NB_LAYERS] = {1e-2, 1e-3, 1e-4};
+	unsigned int seed = 1;
+	size_t i;
+	for(i=0;i<N;i++)
+		data[i] = (float)smooth_noisy(i, &seed, 0);
+	check_progressive(SZ_FLOAT, data, errBounds);
+	free(data);
+}
+
+void test_progressive_double(void)
+{
+	double* data = (double*)malloc(N*sizeof(double));
+	double errBounds[NB_LAYERS] = {1e-2, 1e-4, 1e-6};
+	unsigned int seed = 1;
+	size_t i;
+	for(i=0;i<N;i++)
+		data[i] = smooth_noisy(i, &seed, 0);
+	check_progressive(SZ_DOUBLE, data, errBounds);
+	free(data);
+}
+
+/**
+ * A refinement bound within twice the rounding of a float sum (2.4E-7 times the largest magnitude, here 100) cannot
+ * be met, and is rejected; the same bound in double is met.
+ * */
+void test_progressive_rounding(void)
+{
+	float* data = (float*)malloc(N*sizeof(float));
+	double* ddata = (double*)malloc(N*sizeof(double));
+	double errBounds[NB_LAYERS] = {1e-2, 1e-4, 2e-5};
+	unsigned int seed = 1;
+	size_t i, outSize = 0;
+	for(i=0;i<N;i++)
+		ddata[i] = data[i] = (float)smooth_noisy(i, &seed, 99);
+	CU_ASSERT_PTR_NULL(SZ_compress_progressive(SZ_FLOAT, data, &outSize, errBounds, NB_LAYERS, 0, 0, R3, R2, R1));
+	check_progressive(SZ_DOUBLE, ddata, errBounds);
+	free(data);
+	free(ddata);
+}
+
+/************* Test Runner Code goes here **************/
+
+int main ( void )
+{
+   CU_pSuite pSuite = NULL;
+
+   SZ_Init(NULL);
+
+   /* initialize the CUnit test registry */
+   if ( CUE_SUCCESS != CU_initialize_registry() )
+      return CU_get_error();
+
+   /* add a suite to the registry */
+   pSuite = CU_add_suite( "test_sz_progressive_suite", init_suite, clean_suite );
+   if ( NULL == pSuite ) {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   /* add the tests to the suite */
+   if ( (NULL == CU_add_test(pSuite, "test_progressive_float", test_progressive_float)) ||
+        (NULL == CU_add_test(pSuite, "test_progressive_double", test_progressive_double)) ||
+        (NULL == CU_add_test(pSuite, "test_progressive_rounding", test_progressive_rounding))
+      )
+   {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   // Run all tests using the basic interface
+   CU_basic_set_mode(CU_BRM_VERBOSE);
+   CU_basic_run_tests();
+   printf("\n");
+   CU_basic_show_failures(CU_get_failure_list());
+   unsigned int num_failures = CU_get_number_of_failures();
+   printf("\n\n");
+
+   /* Clean up registry and return */
+   CU_cleanup_registry();
+   SZ_Finalize();
+   return num_failures || CU_get_error();
+}
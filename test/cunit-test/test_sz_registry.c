@@ -0,0 +1,183 @@
+#include "CUnit/CUnit.h"
+#include "CUnit/Basic.h"
+#include "CUnit_Array.h"
+
+#include "sz.h"
+#include "sz_registry.h"
+
+#include <stdio.h>  // for printf
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Test Suite setup and cleanup functions: */
+
+int
+init_suite(void)
+{
+  return 0;
+}
+
+int
+clean_suite(void)
+{
+  return 0;
+}
+
+/************* Test case functions ****************/
+
+#define N 1000
+
+static float data[N];
+
+//a user compressor storing the float values as they are
+static unsigned char* copy_compress(void* userPara, int dataType, void* data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, size_t *outSize, int *status)
+{
+	*outSize = computeDataLength(r5, r4, r3, r2, r1)*sizeof(float);
+	unsigned char* bytes = (unsigned char*)malloc(*outSize);
+	memcpy(bytes, data, *outSize);
+	*status = SZ_SCES;
+	return bytes;
+}
+
+static void* copy_decompress(void* userPara, int dataType, unsigned char* bytes, size_t byteLength, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, int *status)
+{
+	void* result = malloc(byteLength);
+	memcpy(result, bytes, byteLength);
+	*status = byteLength==computeDataLength(r5, r4, r3, r2, r1)*sizeof(float) ? SZ_SCES : SZ_NSCS;
+	return result;
+}
+
+static size_t copy_bound(void* userPara, int dataType, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1)
+{
+	return computeDataLength(r5, r4, r3, r2, r1)*sizeof(float);
+}
+
+static int copy_compress_to_buffer(void* userPara, int dataType, void* data, size_t r5, size_t r4, size_t r3, size_t r2, size_t r1, unsigned char* bytes, size_t capacity, size_t *outSize)
+{
+	*outSize = computeDataLength(r5, r4, r3, r2, r1)*sizeof(float);
+	if(*outSize > capacity)
+		return SZ_NSCS;
+	memcpy(bytes, data, *outSize);
+	return SZ_SCES;
+}
+
+void test_SZ_registerCompressor(void)
+{
+	sz_compressor copy = {"copy", NULL, 200, SZ_CMPR_TYPE(SZ_FLOAT), copy_compress, copy_decompress, NULL, NULL};
+	sz_compressor copyToBuffer = {"copy_to_buffer", "copy2", 201, SZ_CMPR_TYPE(SZ_FLOAT), copy_compress, copy_decompress, copy_bound, copy_compress_to_buffer};
+	sz_compressor sameID = {"other", NULL, 200, SZ_CMPR_TYPE(SZ_FLOAT), copy_compress, copy_decompress, NULL, NULL};
+	sz_compressor badID = {"bad", NULL, 0, SZ_CMPR_TYPE(SZ_FLOAT), copy_compress, copy_decompress, NULL, NULL};
+
+	CU_ASSERT_EQUAL(SZ_registerCompressor(&copy), SZ_SCES);
+	CU_ASSERT_EQUAL(SZ_registerCompressor(&copyToBuffer), SZ_SCES);
+	CU_ASSERT_EQUAL(SZ_registerCompressor(&copy), SZ_NSCS);
+	CU_ASSERT_EQUAL(SZ_registerCompressor(&sameID), SZ_NSCS);
+	CU_ASSERT_EQUAL(SZ_registerCompressor(&badID), SZ_NSCS);
+	CU_ASSERT_EQUAL(SZ_getCompressorID("copy"), 200);
+	CU_ASSERT_EQUAL(SZ_getCompressorID("copy2"), 201);
+	CU_ASSERT_EQUAL(SZ_getCompressorID("none"), -1);
+	CU_ASSERT_PTR_EQUAL(SZ_getCompressorByID(201), SZ_getCompressor("copy_to_buffer"));
+}
+
+/**
+ * The bytes start with the header of the compressor, so SZ_decompress_customize() finds the compressor by itself.
+ * */
+static void check_user_compressor(const char* name, int id)
+{
+	size_t outSize = 0;
+	int status = SZ_NSCS;
+	unsigned char* bytes = SZ_compress_customize(name, NULL, SZ_FLOAT, data, 0, 0, 0, 0, N, &outSize, &status);
+	CU_ASSERT_EQUAL(status, SZ_SCES);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(bytes);
+	CU_ASSERT_EQUAL_FATAL(outSize, N*sizeof(float)+SZ_CMPR_HEADER_LENGTH);
+	CU_ASSERT(SZ_hasCompressorHeader(bytes, outSize));
+	CU_ASSERT_EQUAL(bytes[SZ_CMPR_MAGIC_LENGTH], id);
+	CU_ASSERT_EQUAL_ARRAY_BYTE(bytes+SZ_CMPR_HEADER_LENGTH, data, N*sizeof(float));
+
+	float* result = (float*)SZ_decompress_customize(NULL, NULL, SZ_FLOAT, bytes, outSize, 0, 0, 0, 0, N, &status);
+	CU_ASSERT_EQUAL(status, SZ_SCES);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(result);
+	CU_ASSERT_EQUAL_ARRAY_BYTE(result, data, N*sizeof(float));
+	free(result);
+	free(bytes);
+}
+
+void test_SZ_compress_customize_user(void)
+{
+	check_user_compressor("copy", 200);
+	check_user_compressor("copy2", 201);
+}
+
+/**
+ * The built-in SZ compressor writes the bytes of SZ_compress() after the header, which SZ_decompress() skips.
+ * */
+void test_SZ_compress_customize_sz(void)
+{
+	size_t outSize = 0, expectedSize = 0, i;
+	int status = SZ_NSCS;
+	unsigned char* bytes = SZ_compress_customize("SZ", NULL, SZ_FLOAT, data, 0, 0, 0, 0, N, &outSize, &status);
+	unsigned char* expected = SZ_compress(SZ_FLOAT, data, &expectedSize, 0, 0, 0, 0, N);
+	CU_ASSERT_EQUAL(status, SZ_SCES);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(bytes);
+	CU_ASSERT_EQUAL_FATAL(outSize, expectedSize+SZ_CMPR_HEADER_LENGTH);
+	CU_ASSERT(outSize <= SZ_compress_customize_bound("SZ", NULL, SZ_FLOAT, 0, 0, 0, 0, N));
+	CU_ASSERT_EQUAL(bytes[SZ_CMPR_MAGIC_LENGTH], SZ_CMPR_SZ);
+	CU_ASSERT_EQUAL_ARRAY_BYTE(bytes+SZ_CMPR_HEADER_LENGTH, expected, expectedSize);
+
+	float* result = (float*)SZ_decompress(SZ_FLOAT, bytes, outSize, 0, 0, 0, 0, N);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(result);
+	for(i=0;i<N;i++)
+		CU_ASSERT(fabs(result[i]-data[i]) <= confparams_cpr->absErrBound*(1+1e-6));
+	free(result);
+	free(bytes);
+	free(expected);
+}
+
+/************* Test Runner Code goes here **************/
+
+int main ( void )
+{
+   CU_pSuite pSuite = NULL;
+   size_t i;
+
+   for(i=0;i<N;i++)
+      data[i] = (float)sin(0.02*i);
+   SZ_Init(NULL);
+   confparams_cpr->errorBoundMode = ABS;
+   confparams_cpr->absErrBound = 1e-3;
+
+   /* initialize the CUnit test registry */
+   if ( CUE_SUCCESS != CU_initialize_registry() )
+      return CU_get_error();
+
+   /* add a suite to the registry */
+   pSuite = CU_add_suite( "test_sz_registry_suite", init_suite, clean_suite );
+   if ( NULL == pSuite ) {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   /* add the tests to the suite */
+   if ( (NULL == CU_add_test(pSuite, "test_SZ_registerCompressor", test_SZ_registerCompressor)) ||
+        (NULL == CU_add_test(pSuite, "test_SZ_compress_customize_user", test_SZ_compress_customize_user)) ||
+        (NULL == CU_add_test(pSuite, "test_SZ_compress_customize_sz", test_SZ_compress_customize_sz))
+      )
+   {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   // Run all tests using the basic interface
+   CU_basic_set_mode(CU_BRM_VERBOSE);
+   CU_basic_run_tests();
+   printf("\n");
+   CU_basic_show_failures(CU_get_failure_list());
+   unsigned int num_failures = CU_get_number_of_failures();
+   printf("\n\n");
+
+   /* Clean up registry and return */
+   CU_cleanup_registry();
+   SZ_Finalize();
+   return num_failures || CU_get_error();
+}
@@ -0,0 +1,130 @@
+#include "CUnit/CUnit.h"
+#include "CUnit/Basic.h"
+#include "CUnit_Array.h"
+
+#include "sz.h"
+
+#include <stdio.h>  // for printf
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Test Suite setup and cleanup functions: */
+
+int
+init_suite(void)
+{
+  return 0;
+}
+
+int
+clean_suite(void)
+{
+  return 0;
+}
+
+/************* Test case functions ****************/
+
+#define R2 4096
+#define R1 4096
+
+static float smooth(size_t i, size_t j)
+{
+	double x = (double)i / R2, y = (double)j / R1;
+	return (float)(sin(6*x) * cos(5*y) + 0.5*sin(x));
+}
+
+/**
+ * A smooth field of 16M points, on which larger regression blocks fit as well as the default ones with fewer
+ * coefficients: the sample chooses another block size, and the compressed bytes are smaller than with the default.
+ * */
+void test_block_size_smooth_2D(void)
+{
+	float* data = (float*)malloc(R2*R1*sizeof(float));
+	size_t i, j, autoSize = 0, defaultSize = 0;
+	for(i=0;i<R2;i++)
+		for(j=0;j<R1;j++)
+			data[i*R1+j] = smooth(i, j);
+	confparams_cpr->regressionBlockSize = 0;
+	CU_ASSERT_NOT_EQUAL(optimize_regression_block_size_float_2D(data, R2, R1, 2e-2), 16);
+
+	unsigned char* bytes = SZ_compress_args(SZ_FLOAT, data, &autoSize, ABS, 2e-2, 0, 0, 0, 0, 0, R2, R1);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(bytes);
+	float* result = (float*)SZ_decompress(SZ_FLOAT, bytes, autoSize, 0, 0, 0, R2, R1);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(result);
+	for(i=0;i<R2*R1;i++)
+		if(fabs(result[i]-data[i]) > 2e-2*(1+1e-6))
+			break;
+	CU_ASSERT_EQUAL(i, R2*R1);
+	free(result);
+	free(bytes);
+
+	confparams_cpr->regressionBlockSize = 16;
+	bytes = SZ_compress_args(SZ_FLOAT, data, &defaultSize, ABS, 2e-2, 0, 0, 0, 0, 0, R2, R1);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(bytes);
+	free(bytes);
+	confparams_cpr->regressionBlockSize = 0;
+	CU_ASSERT(autoSize < defaultSize);
+	free(data);
+}
+
+/**
+ * Data of fewer than REG_SAMPLE_MIN_POINTS points keep the default block size.
+ * */
+void test_block_size_small(void)
+{
+	size_t n = 64, i;
+	float* data = (float*)malloc(n*n*n*sizeof(float));
+	double* ddata = (double*)malloc(n*n*n*sizeof(double));
+	for(i=0;i<n*n*n;i++)
+		ddata[i] = data[i] = smooth(i / n, i % n);
+	CU_ASSERT_EQUAL(optimize_regression_block_size_float_2D(data, n*n, n, 1e-3), 16);
+	CU_ASSERT_EQUAL(optimize_regression_block_size_float_3D(data, n, n, n, 1e-3), 6);
+	CU_ASSERT_EQUAL(optimize_regression_block_size_double_2D(ddata, n*n, n, 1e-3), 16);
+	CU_ASSERT_EQUAL(optimize_regression_block_size_double_3D(ddata, n, n, n, 1e-3), 6);
+	free(data);
+	free(ddata);
+}
+
+/************* Test Runner Code goes here **************/
+
+int main ( void )
+{
+   CU_pSuite pSuite = NULL;
+
+   SZ_Init(NULL);
+   confparams_cpr->withRegression = SZ_WITH_LINEAR_REGRESSION;
+
+   /* initialize the CUnit test registry */
+   if ( CUE_SUCCESS != CU_initialize_registry() )
+      return CU_get_error();
+
+   /* add a suite to the registry */
+   pSuite = CU_add_suite( "test_sz_regression_block_size_suite", init_suite, clean_suite );
+   if ( NULL == pSuite ) {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   /* add the tests to the suite */
+   if ( (NULL == CU_add_test(pSuite, "test_block_size_smooth_2D", test_block_size_smooth_2D)) ||
+        (NULL == CU_add_test(pSuite, "test_block_size_small", test_block_size_small))
+      )
+   {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   // Run all tests using the basic interface
+   CU_basic_set_mode(CU_BRM_VERBOSE);
+   CU_basic_run_tests();
+   printf("\n");
+   CU_basic_show_failures(CU_get_failure_list());
+   unsigned int num_failures = CU_get_number_of_failures();
+   printf("\n\n");
+
+   /* Clean up registry and return */
+   CU_cleanup_registry();
+   SZ_Finalize();
+   return num_failures || CU_get_error();
+}
@@ -0,0 +1,155 @@
+#include "CUnit/CUnit.h"
+#include "CUnit/Basic.h"
+#include "CUnit_Array.h"
+
+#include "sz.h"
+#include "sz_target.h"
+
+#include <stdio.h>  // for printf
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Test Suite setup and cleanup functions: */
+
+int
+init_suite(void)
+{
+  return 0;
+}
+
+int
+clean_suite(void)
+{
+  return 0;
+}
+
+/************* Test case functions ****************/
+
+#define R3 64
+#define R2 64
+#define R1 64
+#define N (R3*R2*R1)
+
+/**
+ * A smooth wave plus a uniform noise of +-0.004 (from a fixed linear congruential generator).
+ * */
+static double smooth_noisy(size_t i, unsigned int *seed)
+{
+	*seed = *seed * 1103515245 + 12345;
+	double x = (double)(i / (R2*R1)) / R3, y = (double)(i / R1 % R2) / R2, z = (double)(i % R1) / R1;
+	return sin(6*x) * cos(5*y) + 0.5*sin(4*z + x) + 0.008 * ((*seed >> 16) % 32768) / 32768.0 - 0.004;
+}
+
+/**
+ * The compressed bytes reach the target ratio, by 10% at most, and the decompressed data respect the error bound
+ * of the compression.
+ * */
+static void check_target_ratio(int dataType, void* data, double targetRatio)
+{
+	size_t outSize = 0, i;
+	double absErrBound = 0;
+	size_t typeSize = dataType == SZ_FLOAT ? sizeof(float) : sizeof(double);
+	unsigned char* bytes = SZ_compress_target_ratio(dataType, data, targetRatio, &outSize, &absErrBound, 0, 0, R3, R2, R1);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(bytes);
+	double ratio = (double)N * typeSize / outSize;
+	CU_ASSERT(ratio >= targetRatio && ratio <= 1.1 * targetRatio);
+	void* result = SZ_decompress(dataType, bytes, outSize, 0, 0, R3, R2, R1);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(result);
+	for(i=0;i<N;i++)
+	{
+		double value = dataType == SZ_FLOAT ? ((float*)result)[i] : ((double*)result)[i];
+		double original = dataType == SZ_FLOAT ? ((float*)data)[i] : ((double*)data)[i];
+		if(fabs(value - original) > absErrBound*(1+1e-6))
+			break;
+	}
+	CU_ASSERT_EQUAL(i, N);
+	free(result);
+	free(bytes);
+}
+
+void test_target_ratio_float(void)
+{
+	float* data = (float*)malloc(N*sizeof(float));
+	unsigned int seed = 1;
+	size_t i;
+	for(i=0;i<N;i++)
+		data[i] = (float)smooth_noisy(i, &seed);
+	check_target_ratio(SZ_FLOAT, data, 5);
+	check_target_ratio(SZ_FLOAT, data, 20);
+	check_target_ratio(SZ_FLOAT, data, 50);
+	check_target_ratio(SZ_FLOAT, data, 100);
+	free(data);
+}
+
+void test_target_ratio_double(void)
+{
+	double* data = (double*)malloc(N*sizeof(double));
+	unsigned int seed = 1;
+	size_t i;
+	for(i=0;i<N;i++)
+		data[i] = smooth_noisy(i, &seed);
+	check_target_ratio(SZ_DOUBLE, data, 10);
+	check_target_ratio(SZ_DOUBLE, data, 100);
+	free(data);
+}
+
+/**
+ * A target below the size of the largest error bound returns NULL, without setting the size and the bound.
+ * */
+void test_target_size_too_small(void)
+{
+	float* data = (float*)malloc(N*sizeof(float));
+	unsigned int seed = 1;
+	size_t i, outSize = 7;
+	double absErrBound = 7;
+	for(i=0;i<N;i++)
+		data[i] = (float)smooth_noisy(i, &seed);
+	CU_ASSERT_PTR_NULL(SZ_compress_target_size(SZ_FLOAT, data, 16, &outSize, &absErrBound, 0, 0, R3, R2, R1));
+	CU_ASSERT_EQUAL(outSize, 7);
+	CU_ASSERT_EQUAL(absErrBound, 7);
+	free(data);
+}
+
+/************* Test Runner Code goes here **************/
+
+int main ( void )
+{
+   CU_pSuite pSuite = NULL;
+
+   SZ_Init(NULL);
+
+   /* initialize the CUnit test registry */
+   if ( CUE_SUCCESS != CU_initialize_registry() )
+      return CU_get_error();
+
+   /* add a suite to the registry */
+   pSuite = CU_add_suite( "test_sz_target_suite", init_suite, clean_suite );
+   if ( NULL == pSuite ) {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   /* add the tests to the suite */
+   if ( (NULL == CU_add_test(pSuite, "test_target_ratio_float", test_target_ratio_float)) ||
+        (NULL == CU_add_test(pSuite, "test_target_ratio_double", test_target_ratio_double)) ||
+        (NULL == CU_add_test(pSuite, "test_target_size_too_small", test_target_size_too_small))
+      )
+   {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   // Run all tests using the basic interface
+   CU_basic_set_mode(CU_BRM_VERBOSE);
+   CU_basic_run_tests();
+   printf("\n");
+   CU_basic_show_failures(CU_get_failure_list());
+   unsigned int num_failures = CU_get_number_of_failures();
+   printf("\n\n");
+
+   /* Clean up registry and return */
+   CU_cleanup_registry();
+   SZ_Finalize();
+   return num_failures || CU_get_error();
+}
@@ -0,0 +1,202 @@
+#include "CUnit/CUnit.h"
+#include "CUnit/Basic.h"
+#include "CUnit_Array.h"
+
+#include "sz.h"
+
+#include <stdio.h>  // for printf
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Test Suite setup and cleanup functions: */
+
+int
+init_suite(void)
+{
+  return 0;
+}
+
+int
+clean_suite(void)
+{
+  return 0;
+}
+
+/************* Test case functions ****************/
+
+#define N 8
+
+void test_select_ts_predictor_float_3D(void)
+{
+	float cur[N*N*N], pre[N*N*N];
+	size_t i, j, k;
+
+	//a static field is predicted by the previous step
+	for(i=0;i<N;i++)
+		for(j=0;j<N;j++)
+			for(k=0;k<N;k++)
+				cur[(i*N+j)*N+k] = pre[(i*N+j)*N+k] = (float)sin(i+2.0*j+3.0*k);
+	CU_ASSERT_EQUAL(select_ts_predictor_float_3D(cur, pre, N, N, 4, 4, 4, N, N, N), TS_PRED_TEMPORAL);
+
+	//a field shifted by a constant is predicted by the previous step corrected by the Lorenzo change
+	for(i=0;i<N*N*N;i++)
+		cur[i] = pre[i] + 5;
+	CU_ASSERT_EQUAL(select_ts_predictor_float_3D(cur, pre, N, N, 4, 4, 4, N, N, N), TS_PRED_HYBRID);
+
+	//a linear field, unrelated to the previous step, is predicted by the Lorenzo predictor
+	for(i=0;i<N;i++)
+		for(j=0;j<N;j++)
+			for(k=0;k<N;k++)
+				cur[(i*N+j)*N+k] = (float)(i+2*j+3*k);
+	CU_ASSERT_EQUAL(select_ts_predictor_float_3D(cur, pre, N, N, 4, 4, 4, N, N, N), TS_PRED_SPATIAL);
+
+	//nothing decompressed in front of the first block: previous step
+	CU_ASSERT_EQUAL(select_ts_predictor_float_3D(cur, pre, N, N, 0, 0, 0, 4, 4, 4), TS_PRED_TEMPORAL);
+}
+
+/**
+ * Compress a series of steps with the time-series compression (a snapshot every 3 steps) and decompress it,
+ * checking the error bound of every step.
+ * */
+static void check_ts_roundtrip(int dataType, size_t r3, size_t r2, size_t r1)
+{
+	size_t n = r3*r2*r1, i, j, k, outSize[7];
+	int t, steps = 7;
+	double errBound = 1e-3;
+	int typeSize = dataType==SZ_FLOAT ? sizeof(float) : sizeof(double);
+	unsigned char* bytes[7];
+	double* series = (double*)malloc(steps*n*sizeof(double));
+	void* data = malloc(n*typeSize);
+
+	//a wave moving slowly through the domain
+	for(t=0;t<steps;t++)
+		for(i=0;i<r3;i++)
+			for(j=0;j<r2;j++)
+				for(k=0;k<r1;k++)
+					series[t*n+(i*r2+j)*r1+k] = sin(0.2*i+0.3*j+0.25*k-0.1*t) + 0.05*t;
+
+	SZ_Init(NULL);
+	confparams_cpr->snapshotCmprStep = 3;
+	SZ_registerVar(1, "T", dataType, data, ABS, errBound, 0, 0, 0, 0, r3==1?0:r3, r2, r1);
+	for(t=0;t<steps;t++)
+	{
+		for(i=0;i<n;i++)
+		{
+			if(dataType==SZ_FLOAT)
+				((float*)data)[i] = (float)series[t*n+i];
+			else
+				((double*)data)[i] = series[t*n+i];
+		}
+		CU_ASSERT_EQUAL(SZ_compress_ts(SZ_PERIO_TEMPORAL_COMPRESSION, &bytes[t], &outSize[t]), SZ_SCES);
+	}
+	SZ_Finalize();
+
+	SZ_Init(NULL);
+	memset(data, 0, n*typeSize);
+	SZ_registerVar(1, "T", dataType, data, ABS, errBound, 0, 0, 0, 0, r3==1?0:r3, r2, r1);
+	for(t=0;t<steps;t++)
+	{
+		double maxErr = 0;
+		SZ_decompress_ts(bytes[t], outSize[t]);
+		for(i=0;i<n;i++)
+		{
+			//the float steps are checked against the float values that were compressed
+			double v = dataType==SZ_FLOAT ? ((float*)data)[i] : ((double*)data)[i];
+			double o = dataType==SZ_FLOAT ? (float)series[t*n+i] : series[t*n+i];
+			if(fabs(v - o) > maxErr)
+				maxErr = fabs(v - o);
+		}
+		CU_ASSERT(maxErr <= errBound*(1+1e-6));
+		free(bytes[t]);
+	}
+	SZ_Finalize();
+
+	free(series);
+	free(data);
+}
+
+void test_SZ_compress_ts_3D(void)
+{
+	check_ts_roundtrip(SZ_FLOAT, 20, 24, 28);
+	check_ts_roundtrip(SZ_DOUBLE, 20, 24, 28);
+}
+
+void test_SZ_compress_ts_2D(void)
+{
+	check_ts_roundtrip(SZ_FLOAT, 1, 50, 60);
+	check_ts_roundtrip(SZ_DOUBLE, 1, 50, 60);
+}
+
+/**
+ * The step being compressed writes into the second history buffer, which becomes the reference
+ * step (and the old reference the free buffer) once the step is compressed.
+ * */
+void test_hist_double_buffer(void)
+{
+	size_t n = 40*50, i, outSize;
+	int t;
+	float data[40*50];
+	unsigned char* bytes;
+	SZ_Init(NULL);
+	confparams_cpr->snapshotCmprStep = 3;
+	SZ_registerVar(1, "T", SZ_FLOAT, data, ABS, 1e-3, 0, 0, 0, 0, 0, 40, 50);
+	sz_multisteps* ms = SZ_getVariable(1)->multisteps;
+	for(t=0;t<4;t++)
+	{
+		void *ref = ms->hist_data, *dec = ms->hist_dec;
+		float maxErr = 0;
+		for(i=0;i<n;i++)
+			data[i] = (float)sin(0.1*i+0.2*t);
+		CU_ASSERT_EQUAL(SZ_compress_ts(SZ_PERIO_TEMPORAL_COMPRESSION, &bytes, &outSize), SZ_SCES);
+		free(bytes);
+		CU_ASSERT_PTR_EQUAL(ms->hist_data, dec);
+		CU_ASSERT_PTR_EQUAL(ms->hist_dec, ref);
+		for(i=0;i<n;i++)
+			if(fabsf(((float*)ms->hist_data)[i] - data[i]) > maxErr)
+				maxErr = fabsf(((float*)ms->hist_data)[i] - data[i]);
+		CU_ASSERT(maxErr <= 1e-3*(1+1e-6));
+	}
+	SZ_Finalize();
+}
+
+/************* Test Runner Code goes here **************/
+
+int main ( void )
+{
+   CU_pSuite pSuite = NULL;
+
+   /* initialize the CUnit test registry */
+   if ( CUE_SUCCESS != CU_initialize_registry() )
+      return CU_get_error();
+
+   /* add a suite to the registry */
+   pSuite = CU_add_suite( "test_sz_ts_suite", init_suite, clean_suite );
+   if ( NULL == pSuite ) {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   /* add the tests to the suite */
+   if ( (NULL == CU_add_test(pSuite, "test_select_ts_predictor_float_3D", test_select_ts_predictor_float_3D)) ||
+        (NULL == CU_add_test(pSuite, "test_SZ_compress_ts_3D", test_SZ_compress_ts_3D)) ||
+        (NULL == CU_add_test(pSuite, "test_SZ_compress_ts_2D", test_SZ_compress_ts_2D)) ||
+        (NULL == CU_add_test(pSuite, "test_hist_double_buffer", test_hist_double_buffer))
+      )
+   {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   // Run all tests using the basic interface
+   CU_basic_set_mode(CU_BRM_VERBOSE);
+   CU_basic_run_tests();
+   printf("\n");
+   CU_basic_show_failures(CU_get_failure_list());
+   unsigned int num_failures = CU_get_number_of_failures();
+   printf("\n\n");
+
+   /* Clean up registry and return */
+   CU_cleanup_registry();
+   return num_failures || CU_get_error();
+}
@@ -0,0 +1,175 @@
+#include "CUnit/CUnit.h"
+#include "CUnit/Basic.h"
+#include "CUnit_Array.h"
+
+#include "sz.h"
+#include "sz_verify.h"
+
+#include <stdio.h>  // for printf
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Test Suite setup and cleanup functions: */
+
+int
+init_suite(void)
+{
+  return 0;
+}
+
+int
+clean_suite(void)
+{
+  return 0;
+}
+
+/************* Test case functions ****************/
+
+#define R3 64
+#define R2 64
+#define R1 64
+#define N (R3*R2*R1)
+
+static double smooth(size_t i)
+{
+	double x = (double)(i / (R2*R1)) / R3, y = (double)(i / R1 % R2) / R2, z = (double)(i % R1) / R1;
+	return sin(6*x) * cos(5*y) + 0.5*sin(4*z + x);
+}
+
+/**
+ * The statistics of SZ_decompress_verify() are those of SZ_computeErrorStats() on the data of SZ_decompress().
+ * fused tells whether the decoder accumulates them (all of them for the default modes).
+ * */
+static void check_verify(int dataType, void* data, size_t r3, size_t r2, size_t r1, double bound, int fused)
+{
+	size_t outSize = 0;
+	sz_error_stats stats, expected;
+	unsigned char* bytes = SZ_compress(dataType, data, &outSize, 0, 0, r3, r2, r1);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(bytes);
+	void* expectedData = SZ_decompress(dataType, bytes, outSize, 0, 0, r3, r2, r1);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(expectedData);
+	CU_ASSERT_EQUAL(SZ_computeErrorStats(dataType, data, expectedData, N, &expected), SZ_SCES);
+	void* result = SZ_decompress_verify(dataType, bytes, outSize, data, 0, 0, r3, r2, r1, &stats);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(result);
+	CU_ASSERT(fused ? sz_verifyState.count >= N - SZ_VERIFY_CHUNK : sz_verifyState.count == 0);
+	CU_ASSERT_PTR_NULL(sz_verifyState.oriData);
+	CU_ASSERT_EQUAL(stats.count, N);
+	CU_ASSERT_EQUAL(stats.minValue, expected.minValue);
+	CU_ASSERT_EQUAL(stats.maxValue, expected.maxValue);
+	CU_ASSERT_EQUAL(stats.maxAbsError, expected.maxAbsError);
+	CU_ASSERT(fabs(stats.mse - expected.mse) <= 1e-9 * expected.mse);
+	CU_ASSERT(fabs(stats.psnr - expected.psnr) <= 1e-6);
+	CU_ASSERT(stats.maxAbsError > 0 && stats.maxAbsError <= bound * (1+1e-6));
+	free(result);
+	free(expectedData);
+	free(bytes);
+}
+
+void test_verify_float(void)
+{
+	float* data = (float*)malloc(N*sizeof(float));
+	size_t i;
+	for(i=0;i<N;i++)
+		data[i] = (float)smooth(i);
+	confparams_cpr->withRegression = SZ_WITH_LINEAR_REGRESSION;
+	check_verify(SZ_FLOAT, data, R3, R2, R1, 1e-3, 1);
+	check_verify(SZ_FLOAT, data, 0, R3*R2, R1, 1e-3, 1);
+	confparams_cpr->withRegression = SZ_NO_REGRESSION;
+	check_verify(SZ_FLOAT, data, R3, R2, R1, 1e-3, 1);
+	check_verify(SZ_FLOAT, data, 0, R3*R2, R1, 1e-3, 1);
+	check_verify(SZ_FLOAT, data, 0, 0, N, 1e-3, 1);
+	confparams_cpr->withRegression = SZ_WITH_LINEAR_REGRESSION;
+	free(data);
+}
+
+void test_verify_double(void)
+{
+	double* data = (double*)malloc(N*sizeof(double));
+	size_t i;
+	for(i=0;i<N;i++)
+		data[i] = smooth(i);
+	check_verify(SZ_DOUBLE, data, R3, R2, R1, 1e-3, 1);
+	confparams_cpr->withRegression = SZ_NO_REGRESSION;
+	check_verify(SZ_DOUBLE, data, R3, R2, R1, 1e-3, 1);
+	confparams_cpr->withRegression = SZ_WITH_LINEAR_REGRESSION;
+	free(data);
+}
+
+void test_verify_int(void)
+{
+	int32_t* data = (int32_t*)malloc(N*sizeof(int32_t));
+	size_t i;
+	for(i=0;i<N;i++)
+		data[i] = (int32_t)(100000 * smooth(i));
+	confparams_cpr->absErrBound = 10;
+	check_verify(SZ_INT32, data, R3, R2, R1, 10, 1);
+	check_verify(SZ_INT32, data, 0, 0, N, 10, 1);
+	confparams_cpr->absErrBound = 1e-3;
+	free(data);
+}
+
+/**
+ * The values of the point-wise relative error bound are transformed after the decoder: the statistics are computed
+ * after the decompression.
+ * */
+void test_verify_pw_rel(void)
+{
+	float* data = (float*)malloc(N*sizeof(float));
+	size_t i;
+	for(i=0;i<N;i++)
+		data[i] = (float)(2 + smooth(i));
+	confparams_cpr->errorBoundMode = PW_REL;
+	confparams_cpr->pw_relBoundRatio = 1e-3;
+	confparams_cpr->absErrBound = 1e-2; //bound of the maximal values
+	check_verify(SZ_FLOAT, data, R3, R2, R1, 3.5e-3, 0);
+	confparams_cpr->errorBoundMode = ABS;
+	confparams_cpr->absErrBound = 1e-3;
+	free(data);
+}
+
+/************* Test Runner Code goes here **************/
+
+int main ( void )
+{
+   CU_pSuite pSuite = NULL;
+
+   SZ_Init(NULL);
+   confparams_cpr->errorBoundMode = ABS;
+   confparams_cpr->absErrBound = 1e-3;
+
+   /* initialize the CUnit test registry */
+   if ( CUE_SUCCESS != CU_initialize_registry() )
+      return CU_get_error();
+
+   /* add a suite to the registry */
+   pSuite = CU_add_suite( "test_sz_verify_suite", init_suite, clean_suite );
+   if ( NULL == pSuite ) {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   /* add the tests to the suite */
+   if ( (NULL == CU_add_test(pSuite, "test_verify_float", test_verify_float)) ||
+        (NULL == CU_add_test(pSuite, "test_verify_double", test_verify_double)) ||
+        (NULL == CU_add_test(pSuite, "test_verify_int", test_verify_int)) ||
+        (NULL == CU_add_test(pSuite, "test_verify_pw_rel", test_verify_pw_rel))
+      )
+   {
+      CU_cleanup_registry();
+      return CU_get_error();
+   }
+
+   // Run all tests using the basic interface
+   CU_basic_set_mode(CU_BRM_VERBOSE);
+   CU_basic_run_tests();
+   printf("\n");
+   CU_basic_show_failures(CU_get_failure_list());
+   unsigned int num_failures = CU_get_number_of_failures();
+   printf("\n\n");
+
+   /* Clean up registry and return */
+   CU_cleanup_registry();
+   SZ_Finalize();
+   return num_failures || CU_get_error();
+}